@@ -0,0 +1,79 @@
+/**
+ * \copyright
+ * Copyright (c) 2013, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#ifndef ASSEMBLERLIB_COLOREDPARALLELEXECUTOR_H_
+#define ASSEMBLERLIB_COLOREDPARALLELEXECUTOR_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "BaseLib/Profiler.h"
+
+#include "ElementColoring.h"
+
+namespace AssemblerLib
+{
+
+/// Parallel (OpenMP) counterpart of the SerialExecutor.
+///
+/// The items of the container are partitioned by an ElementColoring, which
+/// is passed to execute() in addition to the SerialExecutor's arguments. The
+/// colors are processed one after another and the items of one color are
+/// processed concurrently. Because items of the same color do not share
+/// nodes, the additions into the global matrix and vector done by the
+/// VectorMatrixAssembler do not race, given the global objects tolerate
+/// concurrent writes into distinct rows (e.g. GlobalDenseMatrix, DenseVector).
+///
+/// \attention The function \c f and everything it calls (e.g. the local
+/// assembler) must be safe to be called concurrently.
+/// Without OpenMP the executor behaves like the SerialExecutor, processing the
+/// items color by color.
+struct ColoredParallelExecutor
+{
+    /// Executes a \c f for each element from the input container.
+    /// Return values of the function call are ignored.
+    ///
+    /// The coloring has to be computed by the caller for the container \c c,
+    /// usually once per mesh, and has to be recomputed if the connectivity of
+    /// the items changes.
+    ///
+    /// \tparam F   \c f type.
+    /// \tparam C   input container type.
+    ///
+    /// \param f    a function that accepts a pointer to container's elements and
+    ///             an index as arguments.
+    /// \param c    a container supporting access over operator[]. The
+    ///             container's elements are pointers to mesh elements.
+    /// \param coloring    an ElementColoring of the container \c c.
+    template <typename F, typename C>
+    static
+    void
+#if defined(_MSC_VER) && (_MSC_VER >= 1700)
+    execute(F& f, C const& c, ElementColoring const& coloring)
+#else
+    execute(F const& f, C const& c, ElementColoring const& coloring)
+#endif
+    {
+        BASELIB_PROFILE_SCOPE("ColoredParallelExecutor::execute");
+        for (std::size_t color = 0; color < coloring.size(); color++)
+        {
+            std::vector<std::size_t> const& items = coloring[color];
+            long const n_items = static_cast<long>(items.size());
+#ifdef _OPENMP
+            #pragma omp parallel for schedule(static)
+#endif
+            for (long i = 0; i < n_items; i++)
+                f(c[items[i]], items[i]);
+        }
+    }
+};
+
+}   // namespace AssemblerLib
+
+#endif  // ASSEMBLERLIB_COLOREDPARALLELEXECUTOR_H_
@@ -0,0 +1,197 @@
+/**
+ * \copyright
+ * Copyright (c) 2013, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#include "ComponentGlobalIndexDict.h"
+
+#include <algorithm>
+
+#include "logog/include/logog.hpp"
+
+#include "BaseLib/Profiler.h"
+
+namespace AssemblerLib
+{
+namespace detail
+{
+
+namespace
+{
+/// Copy of the ranges without the ranges repeating the mesh id, item type and
+/// component id of a previous range, which would give duplicate lines.
+std::vector<ItemRange> rejectDuplicateRanges(std::vector<ItemRange> const& ranges)
+{
+    std::vector<ItemRange> unique_ranges;
+    unique_ranges.reserve(ranges.size());
+    for (auto const& r : ranges)
+    {
+        auto const duplicate = std::find_if(unique_ranges.cbegin(),
+            unique_ranges.cend(), [&r](ItemRange const& u)
+            {
+                return u.mesh_id == r.mesh_id && u.item_type == r.item_type
+                    && u.comp_id == r.comp_id;
+            });
+        if (duplicate == unique_ranges.cend())
+        {
+            unique_ranges.push_back(r);
+            continue;
+        }
+        if (r.n_items > 0)
+            ERR("ComponentGlobalIndexDict: rejected duplicate items of "
+                "component %d on mesh %d.", static_cast<int>(r.comp_id),
+                static_cast<int>(r.mesh_id));
+    }
+    return unique_ranges;
+}
+
+bool blockKeyLess(std::size_t mesh_id_a, MeshLib::MeshItemType type_a,
+    std::size_t mesh_id_b, MeshLib::MeshItemType type_b)
+{
+    if (mesh_id_a != mesh_id_b)
+        return mesh_id_a < mesh_id_b;
+    return type_a < type_b;
+}
+}   // namespace
+
+ComponentGlobalIndexDict::ComponentGlobalIndexDict(
+    std::vector<ItemRange> const& all_ranges)
+{
+    BASELIB_PROFILE_SCOPE("ComponentGlobalIndexDict::ComponentGlobalIndexDict");
+    std::vector<ItemRange> const ranges(rejectDuplicateRanges(all_ranges));
+
+    // Create blocks sorted by mesh id and item type.
+    for (auto const& r : ranges)
+    {
+        if (r.n_items == 0 || findBlock(r.mesh_id, r.item_type))
+            continue;
+        auto const it = std::lower_bound(_blocks.begin(), _blocks.end(), r,
+            [](Block const& b, ItemRange const& range)
+            {
+                return blockKeyLess(b.mesh_id, b.item_type,
+                                    range.mesh_id, range.item_type);
+            });
+        _blocks.insert(it, Block(r.mesh_id, r.item_type));
+    }
+
+    // Count lines per item. Every range covers a prefix [0, n_items) of the
+    // block's items; the counts are accumulated as differences.
+    for (auto const& r : ranges)
+    {
+        if (r.n_items == 0)
+            continue;
+        Block& b = _blocks[findBlock(r.mesh_id, r.item_type) - _blocks.data()];
+        if (b.offsets.size() < r.n_items + 1)
+            b.offsets.resize(r.n_items + 1, 0);
+    }
+    for (auto const& r : ranges)
+    {
+        if (r.n_items == 0)
+            continue;
+        Block& b = _blocks[findBlock(r.mesh_id, r.item_type) - _blocks.data()];
+        b.offsets[0]++;
+        b.offsets[r.n_items]--;
+    }
+
+    // Convert counts into offsets continuing over all blocks.
+    std::size_t n_lines = 0;
+    for (auto& b : _blocks)
+    {
+        std::size_t count = 0;
+        std::size_t const n_items = b.offsets.size() - 1;
+        for (std::size_t i = 0; i < n_items; ++i)
+        {
+            count += b.offsets[i];
+            b.offsets[i] = n_lines;
+            n_lines += count;
+        }
+        b.offsets[n_items] = n_lines;
+    }
+
+    _comp_ids.resize(n_lines);
+    _global_indices.resize(n_lines);
+
+    // Fill lines in the order of the ranges, which gives the numbering by
+    // component. Within one item the lines are appended in order of the
+    // ranges, i.e. sorted by component id.
+    std::vector<std::vector<std::size_t>> fill(_blocks.size());
+    for (std::size_t i = 0; i < _blocks.size(); ++i)
+        fill[i].assign(_blocks[i].offsets.size() - 1, 0);
+
+    std::size_t global_index = 0;
+    for (auto const& r : ranges)
+    {
+        if (r.n_items == 0)
+            continue;
+        Block const* const b = findBlock(r.mesh_id, r.item_type);
+        std::vector<std::size_t>& block_fill = fill[b - _blocks.data()];
+        for (std::size_t i = 0; i < r.n_items; ++i)
+        {
+            std::size_t const pos = b->offsets[i] + block_fill[i]++;
+            _comp_ids[pos] = r.comp_id;
+            _global_indices[pos] = global_index++;
+        }
+    }
+}
+
+void ComponentGlobalIndexDict::renumberByLocation(std::size_t offset)
+{
+    for (std::size_t i = 0; i < _global_indices.size(); ++i)
+        _global_indices[i] = offset + i;
+}
+
+void ComponentGlobalIndexDict::permuteGlobalIndices(
+    std::vector<std::size_t> const& po_perm)
+{
+    for (auto& gi : _global_indices)
+        gi = po_perm[gi];
+}
+
+ComponentGlobalIndexDict::LineRange
+ComponentGlobalIndexDict::find(MeshLib::Location const& l) const
+{
+    Block const* const b = findBlock(l.mesh_id, l.item_type);
+    if (!b || l.item_id + 1 >= b->offsets.size())
+        return LineRange(0, 0);
+    return LineRange(b->offsets[l.item_id], b->offsets[l.item_id + 1]);
+}
+
+Line ComponentGlobalIndexDict::getLine(std::size_t const pos) const
+{
+    for (auto const& b : _blocks)
+    {
+        if (pos >= b.offsets.back())
+            continue;
+        // Last item whose offset is not greater than pos.
+        auto const it = std::upper_bound(b.offsets.begin(), b.offsets.end(),
+            pos) - 1;
+        return Line(MeshLib::Location(b.mesh_id, b.item_type,
+                                      it - b.offsets.begin()),
+                    _comp_ids[pos], _global_indices[pos]);
+    }
+    return Line(MeshLib::Location(0, MeshLib::MeshItemType::Node, 0));
+}
+
+ComponentGlobalIndexDict::Block const*
+ComponentGlobalIndexDict::findBlock(std::size_t mesh_id,
+    MeshLib::MeshItemType item_type) const
+{
+    auto const it = std::lower_bound(_blocks.begin(), _blocks.end(),
+        std::make_pair(mesh_id, item_type),
+        [](Block const& b,
+           std::pair<std::size_t, MeshLib::MeshItemType> const& key)
+        {
+            return blockKeyLess(b.mesh_id, b.item_type, key.first, key.second);
+        });
+    if (it == _blocks.end() || it->mesh_id != mesh_id
+        || it->item_type != item_type)
+        return nullptr;
+    return &*it;
+}
+
+}   // namespace detail
+}   // namespace AssemblerLib
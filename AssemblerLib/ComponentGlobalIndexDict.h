@@ -15,11 +15,8 @@
 
 #include <iostream>
 #include <limits>
-
-#include <boost/multi_index/composite_key.hpp>
-#include <boost/multi_index/member.hpp>
-#include <boost/multi_index/ordered_index.hpp>
-#include <boost/multi_index_container.hpp>
+#include <utility>
+#include <vector>
 
 #include "MeshLib/Location.h"
 
@@ -61,61 +58,107 @@ struct Line
     }
 };
 
-struct LineByLocationComparator
+/// Items with ids [0, n_items) of given type on a mesh, all carrying the
+/// component comp_id.
+struct ItemRange
 {
-    bool operator()(Line const& a, Line const& b) const
-    {
-        return a.location < b.location;
-    }
+    std::size_t mesh_id;
+    MeshLib::MeshItemType item_type;
+    std::size_t n_items;
+    std::size_t comp_id;
+
+    ItemRange(std::size_t mesh_id_, MeshLib::MeshItemType item_type_,
+        std::size_t n_items_, std::size_t comp_id_)
+    : mesh_id(mesh_id_), item_type(item_type_), n_items(n_items_),
+        comp_id(comp_id_)
+    {}
 };
 
-struct LineByLocationAndComponentComparator
+/// Compact (Location, component) -> global index dictionary.
+///
+/// The lines are stored contiguously, sorted by location and, within one
+/// location, by component id. For each pair of mesh id and mesh item type a
+/// block holds an offset array, like the row pointer of a CRS matrix, giving
+/// the positions of the lines of each item. Looking up a location is a search
+/// among the few blocks followed by a direct array access.
+class ComponentGlobalIndexDict
 {
-    bool operator()(Line const& a, Line const& b) const
+public:
+    /// Position range [first, second) of lines in the dictionary.
+    typedef std::pair<std::size_t, std::size_t> LineRange;
+
+public:
+    /// Constructs the dictionary from the given item ranges. The global
+    /// indices are numbered consecutively in the order of the ranges and the
+    /// item ids within each range. Ranges of the same mesh id and item type
+    /// must have increasing component ids. A range repeating the mesh id,
+    /// item type and component id of a previous range is rejected with an
+    /// error message, i.e. every (location, component) pair has one line.
+    explicit ComponentGlobalIndexDict(std::vector<ItemRange> const& ranges);
+
+    /// Total number of lines.
+    std::size_t size() const
     {
-        if (a.location < b.location)
-            return true;
-        if (b.location < a.location)
-            return false;
+        return _global_indices.size();
+    }
+
+    /// Renumbers the global indices by location, i.e. in order of the storage.
+    void renumberByLocation(std::size_t offset);
+
+    /// Replaces every global index gi by po_perm[gi].
+    void permuteGlobalIndices(std::vector<std::size_t> const& po_perm);
 
-        // a.loc == b.loc
-        return a.comp_id < b.comp_id;
+    /// Positions of all lines for the location \c l. The range is empty if
+    /// the location is unknown.
+    LineRange find(MeshLib::Location const& l) const;
+
+    std::size_t getComponentID(std::size_t const pos) const
+    {
+        return _comp_ids[pos];
     }
-};
 
-struct ByLocation {};
-struct ByLocationAndComponent {};
-struct ByComponent {};
-struct ByGlobalIndex {};
-
-typedef boost::multi_index::multi_index_container<
-        Line,
-        boost::multi_index::indexed_by
-        <
-            boost::multi_index::ordered_unique
-            <
-                boost::multi_index::tag<ByLocationAndComponent>,
-                boost::multi_index::identity<Line>,
-                LineByLocationAndComponentComparator
-            >,
-            boost::multi_index::ordered_non_unique
-            <
-                boost::multi_index::tag<ByLocation>,
-                boost::multi_index::identity<Line>,
-                LineByLocationComparator
-            >,
-            boost::multi_index::ordered_non_unique
-            <
-                boost::multi_index::tag<ByComponent>,
-                boost::multi_index::member<Line, std::size_t, &Line::comp_id>
-            >,
-            boost::multi_index::ordered_non_unique
-            <
-                boost::multi_index::tag<ByGlobalIndex>,
-                boost::multi_index::member<Line, std::size_t, &Line::global_index>
-            >
-        >
-    > ComponentGlobalIndexDict;
+    std::size_t getGlobalIndex(std::size_t const pos) const
+    {
+        return _global_indices[pos];
+    }
+
+    /// Line at position \c pos. The location is reconstructed and therefore
+    /// this function is not meant to be used in performance critical code.
+    Line getLine(std::size_t const pos) const;
+
+    friend std::ostream& operator<<(std::ostream& os,
+        ComponentGlobalIndexDict const& dict)
+    {
+        for (std::size_t i = 0; i < dict.size(); ++i)
+            os << dict.getLine(i) << "\n";
+        return os;
+    }
+
+private:
+    /// Offsets of the lines of all items of one type on one mesh.
+    struct Block
+    {
+        std::size_t mesh_id;
+        MeshLib::MeshItemType item_type;
+        /// Positions of the lines of item i are
+        /// [offsets[i], offsets[i+1]), the array has n_items+1 entries.
+        std::vector<std::size_t> offsets;
+
+        Block(std::size_t mesh_id_, MeshLib::MeshItemType item_type_)
+        : mesh_id(mesh_id_), item_type(item_type_)
+        {}
+    };
+
+    /// Returns the block for the given mesh and item type, nullptr if there
+    /// is none.
+    Block const* findBlock(std::size_t mesh_id,
+        MeshLib::MeshItemType item_type) const;
+
+private:
+    std::vector<Block> _blocks; ///< Sorted by mesh id and item type.
+    std::vector<std::size_t> _comp_ids;
+    std::vector<std::size_t> _global_indices;
+};
 
 }    // namespace detail
 }    // namespace AssemblerLib
@@ -0,0 +1,74 @@
+/**
+ * \copyright
+ * Copyright (c) 2013, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#include "ComputeSparsityPattern.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace AssemblerLib
+{
+
+MathLib::CRSSparsityPattern computeSparsityPattern(
+    LocalToGlobalIndexMap const& dof_map, std::size_t const n_rows)
+{
+    // Upper bound of the entries per row, counting multiple contributions of
+    // different mesh items to the same entry.
+    std::vector<std::size_t> offsets(n_rows + 1, 0);
+    for (std::size_t i = 0; i < dof_map.size(); i++)
+    {
+        std::size_t const n_columns = dof_map.columnIndices(i).size();
+        for (auto const row : dof_map.rowIndices(i))
+            offsets[row + 1] += n_columns;
+    }
+    for (std::size_t row = 0; row < n_rows; row++)
+        offsets[row + 1] += offsets[row];
+
+    // Collect all column indices including duplicates.
+    std::vector<std::size_t> columns(offsets.back());
+    {
+        std::vector<std::size_t> fill(offsets.begin(), offsets.end() - 1);
+        for (std::size_t i = 0; i < dof_map.size(); i++)
+        {
+            auto const item_columns = dof_map.columnIndices(i);
+            for (auto const row : dof_map.rowIndices(i))
+                fill[row] = std::copy(item_columns.begin(), item_columns.end(),
+                    columns.begin() + fill[row]) - columns.begin();
+        }
+    }
+
+    // Sort each row and remove duplicates. The rows are independent.
+    std::vector<std::size_t> row_lengths(n_rows);
+    long const n = n_rows;
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic, 256)
+#endif
+    for (long row = 0; row < n; row++)
+    {
+        auto const first = columns.begin() + offsets[row];
+        auto const last = columns.begin() + offsets[row + 1];
+        std::sort(first, last);
+        row_lengths[row] = std::unique(first, last) - first;
+    }
+
+    // Compact the rows into the final storage.
+    std::vector<std::size_t> row_ptr(n_rows + 1, 0);
+    for (std::size_t row = 0; row < n_rows; row++)
+        row_ptr[row + 1] = row_ptr[row] + row_lengths[row];
+
+    std::vector<std::size_t> col_idx(row_ptr.back());
+    for (std::size_t row = 0; row < n_rows; row++)
+        std::copy(columns.begin() + offsets[row],
+                  columns.begin() + offsets[row] + row_lengths[row],
+                  col_idx.begin() + row_ptr[row]);
+
+    return MathLib::CRSSparsityPattern(std::move(row_ptr), std::move(col_idx));
+}
+
+}   // namespace AssemblerLib
@@ -0,0 +1,33 @@
+/**
+ * \copyright
+ * Copyright (c) 2013, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#ifndef ASSEMBLERLIB_COMPUTESPARSITYPATTERN_H_
+#define ASSEMBLERLIB_COMPUTESPARSITYPATTERN_H_
+
+#include "MathLib/LinAlg/Sparse/CRSSparsityPattern.h"
+
+#include "LocalToGlobalIndexMap.h"
+
+namespace AssemblerLib
+{
+
+/// Computes the sparsity pattern of a global matrix assembled from the local
+/// matrices of all mesh items of the given map, i.e. entry (i, j) is part of
+/// the pattern if some mesh item has the row index i and the column index j.
+///
+/// \param dof_map  local to global index map, e.g. built from the mesh
+///                 elements and a MeshComponentMap.
+/// \param n_rows   number of rows of the global matrix, e.g.
+///                 MeshComponentMap::size().
+MathLib::CRSSparsityPattern computeSparsityPattern(
+    LocalToGlobalIndexMap const& dof_map, std::size_t const n_rows);
+
+}   // namespace AssemblerLib
+
+#endif  // ASSEMBLERLIB_COMPUTESPARSITYPATTERN_H_
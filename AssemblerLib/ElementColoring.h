@@ -0,0 +1,95 @@
+/**
+ * \copyright
+ * Copyright (c) 2013, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#ifndef ASSEMBLERLIB_ELEMENTCOLORING_H_
+#define ASSEMBLERLIB_ELEMENTCOLORING_H_
+
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace AssemblerLib
+{
+
+/// Partition of mesh items into independent sets (colors).
+///
+/// Two mesh items of the same color do not share a node, therefore their
+/// local contributions are added to disjoint rows of the global matrix and
+/// the global vector and can be assembled concurrently.
+class ElementColoring
+{
+public:
+    /// Computes a greedy coloring of the items of the container \c c. Items
+    /// are expected to be pointers to mesh elements, i.e. to provide
+    /// getNNodes() and getNode(i)->getID().
+    ///
+    /// The item with index i in \c c is assigned the smallest color not used
+    /// by any previously colored item sharing a node with it.
+    template <typename C>
+    explicit ElementColoring(C const& c)
+    {
+        std::size_t const n_items = c.size();
+
+        std::size_t n_nodes = 0;
+        for (std::size_t i = 0; i < n_items; i++)
+            for (unsigned k = 0; k < c[i]->getNNodes(); k++)
+                if (c[i]->getNode(k)->getID() + 1 > n_nodes)
+                    n_nodes = c[i]->getNode(k)->getID() + 1;
+
+        // Colors used so far by the items connected to each node.
+        std::vector<std::vector<std::size_t>> node_colors(n_nodes);
+        // forbidden[color] == i if color is used by a neighbor of item i.
+        std::vector<std::size_t> forbidden;
+
+        for (std::size_t i = 0; i < n_items; i++)
+        {
+            unsigned const n_item_nodes = c[i]->getNNodes();
+            for (unsigned k = 0; k < n_item_nodes; k++)
+            {
+                auto const& colors = node_colors[c[i]->getNode(k)->getID()];
+                for (auto color : colors)
+                    forbidden[color] = i;
+            }
+
+            std::size_t color = 0;
+            while (color < forbidden.size() && forbidden[color] == i)
+                color++;
+
+            if (color == _colors.size())
+            {
+                _colors.emplace_back();
+                forbidden.push_back(std::numeric_limits<std::size_t>::max());
+            }
+            _colors[color].push_back(i);
+
+            for (unsigned k = 0; k < n_item_nodes; k++)
+                node_colors[c[i]->getNode(k)->getID()].push_back(color);
+        }
+    }
+
+    /// Number of colors.
+    std::size_t size() const
+    {
+        return _colors.size();
+    }
+
+    /// Indices of the items (positions in the container used for the
+    /// construction) having the given color.
+    std::vector<std::size_t> const& operator[](std::size_t const color) const
+    {
+        return _colors[color];
+    }
+
+private:
+    std::vector<std::vector<std::size_t>> _colors;
+};
+
+}   // namespace AssemblerLib
+
+#endif  // ASSEMBLERLIB_ELEMENTCOLORING_H_
@@ -0,0 +1,85 @@
+/**
+ * \copyright
+ * Copyright (c) 2013, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#ifndef ASSEMBLERLIB_FIXEDSIZELOCALMATRIXTYPES_H_
+#define ASSEMBLERLIB_FIXEDSIZELOCALMATRIXTYPES_H_
+
+#include <cstddef>
+
+#ifdef OGS_USE_EIGEN
+#include <Eigen/Eigen>
+#endif  // OGS_USE_EIGEN
+
+namespace AssemblerLib
+{
+
+#ifdef OGS_USE_EIGEN
+/// Square row-major local matrix of compile-time size \c N.
+///
+/// The class adds the interface expected by the global matrices' add()
+/// functions (getNRows(), getNCols(), getEntries()) to the Eigen matrix. The
+/// storage is not aligned for vectorization to allow storing the matrices in
+/// standard containers without special allocators.
+template <int N>
+class FixedSizeLocalMatrix
+    : public Eigen::Matrix<double, N, N, Eigen::RowMajor | Eigen::DontAlign>
+{
+public:
+    typedef Eigen::Matrix<double, N, N, Eigen::RowMajor | Eigen::DontAlign>
+        BaseType;
+
+public:
+    FixedSizeLocalMatrix() {}
+
+    FixedSizeLocalMatrix(std::size_t const rows, std::size_t const cols)
+        : BaseType(rows, cols)
+    {}
+
+    template <typename OtherDerived>
+    FixedSizeLocalMatrix(Eigen::MatrixBase<OtherDerived> const& other)
+        : BaseType(other)
+    {}
+
+    template <typename OtherDerived>
+    FixedSizeLocalMatrix& operator=(Eigen::MatrixBase<OtherDerived> const& other)
+    {
+        this->BaseType::operator=(other);
+        return *this;
+    }
+
+    std::size_t getNRows() const { return N; }
+    std::size_t getNCols() const { return N; }
+
+    double const* getEntries() const { return this->data(); }
+};
+
+/// Local matrix and vector types with sizes known at compile time, selected
+/// by the mesh element type, e.g. 4x4 for MeshLib::Quad or 8x8 for
+/// MeshLib::Hex with one component. The types are meant to be used as
+/// LOCAL_MATRIX_ and LOCAL_VECTOR_ template arguments of the
+/// VectorMatrixAssembler.
+///
+/// \tparam MESH_ELEMENT    mesh element type providing n_all_nodes.
+/// \tparam N_COMPONENTS    number of components per node.
+template <typename MESH_ELEMENT, unsigned N_COMPONENTS = 1>
+struct FixedSizeLocalMatrixTypes
+{
+    static const unsigned n_dofs = MESH_ELEMENT::n_all_nodes * N_COMPONENTS;
+
+    typedef FixedSizeLocalMatrix<n_dofs> LocalMatrix;
+    typedef Eigen::Matrix<double, n_dofs, 1, Eigen::DontAlign> LocalVector;
+};
+
+template <typename MESH_ELEMENT, unsigned N_COMPONENTS>
+const unsigned FixedSizeLocalMatrixTypes<MESH_ELEMENT, N_COMPONENTS>::n_dofs;
+#endif  // OGS_USE_EIGEN
+
+}   // namespace AssemblerLib
+
+#endif  // ASSEMBLERLIB_FIXEDSIZELOCALMATRIXTYPES_H_
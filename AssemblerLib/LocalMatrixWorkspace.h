@@ -0,0 +1,144 @@
+/**
+ * \copyright
+ * Copyright (c) 2013, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#ifndef ASSEMBLERLIB_LOCALMATRIXWORKSPACE_H_
+#define ASSEMBLERLIB_LOCALMATRIXWORKSPACE_H_
+
+#include <algorithm>
+#include <cstdlib>
+#include <deque>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "logog/include/logog.hpp"
+
+#include "LocalToGlobalIndexMap.h"
+
+namespace AssemblerLib
+{
+
+/// Preallocated per-thread local matrices and vectors.
+///
+/// For every thread one local matrix and one local vector is allocated for
+/// each distinct local system size found in the LocalToGlobalIndexMap, i.e.
+/// the workspace holds a buffer fitting the largest mesh item. Requesting a
+/// local matrix/vector pair of a preallocated size does not allocate; the
+/// pair is reset to zero. Buffers for other sizes are allocated on the first
+/// request.
+///
+/// \tparam LOCAL_MATRIX_ local matrix type constructible by (rows, columns)
+///                       and providing setZero().
+/// \tparam LOCAL_VECTOR_ local vector type constructible by (rows) and
+///                       providing setZero().
+template <typename LOCAL_MATRIX_, typename LOCAL_VECTOR_>
+class LocalMatrixWorkspace
+{
+public:
+    /// Allocates buffers for all local system sizes of \c data_pos for the
+    /// maximum number of threads, which is the maximum of
+    /// omp_get_max_threads() and omp_get_num_procs() if OpenMP is used and
+    /// one otherwise.
+    explicit LocalMatrixWorkspace(LocalToGlobalIndexMap const& data_pos)
+    {
+        std::deque<Entry> entries;
+        for (std::size_t i = 0; i < data_pos.size(); i++)
+        {
+            std::size_t const n_rows = data_pos.rowIndices(i).size();
+            std::size_t const n_cols = data_pos.columnIndices(i).size();
+            if (find(entries, n_rows, n_cols) == nullptr)
+                entries.emplace_back(n_rows, n_cols);
+        }
+
+#ifdef _OPENMP
+        std::size_t const n_threads = std::max(omp_get_max_threads(),
+                                               omp_get_num_procs());
+#else
+        std::size_t const n_threads = 1;
+#endif
+        _entries.assign(n_threads, entries);
+    }
+
+    /// Local matrix of size \c n_rows x \c n_cols set to zero. The matrix
+    /// belongs to the calling thread and stays valid until the next call of
+    /// matrix() or vector() from the same thread with the same size.
+    LOCAL_MATRIX_& matrix(std::size_t const n_rows, std::size_t const n_cols)
+    {
+        LOCAL_MATRIX_& m = getEntry(n_rows, n_cols).A;
+        m.setZero();
+        return m;
+    }
+
+    /// Local vector of size \c n_rows set to zero. See matrix() for the
+    /// validity of the returned reference.
+    LOCAL_VECTOR_& vector(std::size_t const n_rows, std::size_t const n_cols)
+    {
+        LOCAL_VECTOR_& v = getEntry(n_rows, n_cols).rhs;
+        v.setZero();
+        return v;
+    }
+
+private:
+    struct Entry
+    {
+        Entry(std::size_t const n_rows_, std::size_t const n_cols_)
+            : n_rows(n_rows_), n_cols(n_cols_), A(n_rows_, n_cols_),
+              rhs(n_rows_)
+        {}
+
+        std::size_t n_rows;
+        std::size_t n_cols;
+        LOCAL_MATRIX_ A;
+        LOCAL_VECTOR_ rhs;
+    };
+
+    /// Linear search; there are only as many entries as different mesh item
+    /// types in the mesh.
+    static Entry* find(std::deque<Entry>& entries,
+        std::size_t const n_rows, std::size_t const n_cols)
+    {
+        for (auto& e : entries)
+            if (e.n_rows == n_rows && e.n_cols == n_cols)
+                return &e;
+        return nullptr;
+    }
+
+    Entry& getEntry(std::size_t const n_rows, std::size_t const n_cols)
+    {
+#ifdef _OPENMP
+        std::size_t const thread_id = omp_get_thread_num();
+#else
+        std::size_t const thread_id = 0;
+#endif
+        if (thread_id >= _entries.size())
+        {
+            // The outer vector cannot grow while other threads use it.
+            ERR("LocalMatrixWorkspace: thread %d exceeds the %d preallocated "
+                "thread buffers.", static_cast<int>(thread_id),
+                static_cast<int>(_entries.size()));
+            std::abort();
+        }
+        std::deque<Entry>& entries = _entries[thread_id];
+        if (Entry* const e = find(entries, n_rows, n_cols))
+            return *e;
+        // A deque keeps the references to the other entries valid.
+        entries.emplace_back(n_rows, n_cols);
+        return entries.back();
+    }
+
+private:
+    /// Buffers per thread, only accessed by the owning thread.
+    std::vector<std::deque<Entry>> _entries;
+};
+
+}   // namespace AssemblerLib
+
+#endif  // ASSEMBLERLIB_LOCALMATRIXWORKSPACE_H_
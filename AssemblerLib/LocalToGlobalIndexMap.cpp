@@ -0,0 +1,101 @@
+/**
+ * \copyright
+ * Copyright (c) 2013, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#include "LocalToGlobalIndexMap.h"
+
+#include <algorithm>
+
+#include "MeshLib/Elements/Element.h"
+#include "MeshLib/Location.h"
+#include "MeshLib/Node.h"
+
+namespace AssemblerLib
+{
+
+void LocalToGlobalIndexMap::IndexTable::assign(
+    std::vector<std::vector<std::size_t>> const& lines)
+{
+    offsets.resize(lines.size() + 1);
+    offsets[0] = 0;
+    for (std::size_t i = 0; i < lines.size(); i++)
+        offsets[i + 1] = offsets[i] + lines[i].size();
+
+    indices.resize(offsets.back());
+    for (std::size_t i = 0; i < lines.size(); i++)
+        std::copy(lines[i].begin(), lines[i].end(),
+                  indices.begin() + offsets[i]);
+}
+
+LocalToGlobalIndexMap::LocalToGlobalIndexMap(
+    std::vector<std::vector<std::size_t>> const& rows,
+    std::vector<std::vector<std::size_t>> const& columns)
+{
+    assert(rows.size() == columns.size());
+    assert(!rows.empty());
+    _rows.assign(rows);
+    _columns.assign(columns);
+}
+
+LocalToGlobalIndexMap::LocalToGlobalIndexMap(
+    std::vector<std::vector<std::size_t>> const& rows)
+{
+    _rows.assign(rows);
+}
+
+LocalToGlobalIndexMap::LocalToGlobalIndexMap(
+    std::vector<MeshLib::Element*> const& elements,
+    std::size_t const mesh_id,
+    MeshComponentMap const& mesh_component_map,
+    ComponentOrder const order)
+{
+    long const n_elements = elements.size();
+
+    // First pass: look up the global indices of each element. The component
+    // map is only read, so the elements are independent.
+    std::vector<std::vector<std::size_t>> element_indices(n_elements);
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(static)
+#endif
+    for (long i = 0; i < n_elements; i++)
+    {
+        MeshLib::Element const& e = *elements[i];
+        std::vector<MeshLib::Location> locations;
+        locations.reserve(e.getNNodes());
+        for (unsigned j = 0; j < e.getNNodes(); j++)
+            locations.emplace_back(mesh_id, MeshLib::MeshItemType::Node,
+                                   e.getNode(j)->getID());
+
+        if (order == ComponentOrder::BY_LOCATION)
+            element_indices[i] = mesh_component_map.getGlobalIndices
+                <ComponentOrder::BY_LOCATION>(locations);
+        else
+            element_indices[i] = mesh_component_map.getGlobalIndices
+                <ComponentOrder::BY_COMPONENT>(locations);
+    }
+
+    // Second pass: compute the offsets and copy the indices into the
+    // contiguous storage.
+    _rows.offsets.resize(n_elements + 1);
+    _rows.offsets[0] = 0;
+    for (long i = 0; i < n_elements; i++)
+        _rows.offsets[i + 1] = _rows.offsets[i] + element_indices[i].size();
+
+    _rows.indices.resize(_rows.offsets.back());
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(static)
+#endif
+    for (long i = 0; i < n_elements; i++)
+    {
+        std::copy(element_indices[i].begin(), element_indices[i].end(),
+                  _rows.indices.begin() + _rows.offsets[i]);
+        std::vector<std::size_t>().swap(element_indices[i]);
+    }
+}
+
+}   // namespace AssemblerLib
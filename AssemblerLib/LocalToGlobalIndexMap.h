@@ -10,10 +10,18 @@
 #ifndef ASSEMBLERLIB_LOCALTOGLOBALINDEXMAP_H_
 #define ASSEMBLERLIB_LOCALTOGLOBALINDEXMAP_H_
 
+#include <cassert>
 #include <vector>
 
 #include "MathLib/LinAlg/RowColumnIndices.h"
 
+#include "MeshComponentMap.h"
+
+namespace MeshLib
+{
+    class Element;
+}
+
 namespace AssemblerLib
 {
 
@@ -26,6 +34,11 @@ namespace AssemblerLib
 /// The number of rows should be equal to the number of mesh items and the
 /// number of columns should be equal to the number of the components on that
 /// mesh item.
+///
+/// The indices of all mesh items are stored contiguously in one array
+/// together with an offset array, similar to the row pointers of a CRS matrix.
+/// The map is meant to be built once for a mesh and reused by all subsequent
+/// assemblies, e.g. in every time step.
 class LocalToGlobalIndexMap
 {
 public:
@@ -34,26 +47,33 @@ public:
 
 public:
     LocalToGlobalIndexMap(
-        std::vector<LineIndex> const& rows,
-        std::vector<LineIndex> const & columns)
-        : _rows(rows), _columns(columns)
-    {
-        assert(_rows.size() == _columns.size());
-        assert(!_rows.empty());
-    }
+        std::vector<std::vector<std::size_t>> const& rows,
+        std::vector<std::vector<std::size_t>> const& columns);
 
-    explicit LocalToGlobalIndexMap(std::vector<LineIndex> const& rows)
-        : _rows(rows), _columns(rows)
-    { }
+    explicit LocalToGlobalIndexMap(
+        std::vector<std::vector<std::size_t>> const& rows);
+
+    /// Creates the map for the given elements of the mesh with id \c mesh_id
+    /// by looking up the global indices of all element nodes in the
+    /// \c mesh_component_map. The indices of one element are ordered as given
+    /// by \c order. The global indices are the same for rows and columns.
+    ///
+    /// The elements are processed in parallel if OpenMP is enabled.
+    LocalToGlobalIndexMap(
+        std::vector<MeshLib::Element*> const& elements,
+        std::size_t const mesh_id,
+        MeshComponentMap const& mesh_component_map,
+        ComponentOrder const order);
 
     std::size_t size() const
     {
-        return _rows.size();
+        return _rows.offsets.size() - 1;
     }
 
     RowColumnIndices operator[](std::size_t const mesh_item_id) const
     {
-        return RowColumnIndices(_rows[mesh_item_id], _columns[mesh_item_id]);
+        return RowColumnIndices(rowIndices(mesh_item_id),
+                                columnIndices(mesh_item_id));
     }
 
     LineIndex rowIndices(std::size_t const mesh_item_id) const
@@ -63,12 +83,33 @@ public:
 
     LineIndex columnIndices(std::size_t const mesh_item_id) const
     {
+        if (_columns.offsets.empty())
+            return _rows[mesh_item_id];
         return _columns[mesh_item_id];
     }
 
 private:
-    std::vector<LineIndex> const& _rows;
-    std::vector<LineIndex> const& _columns;
+    /// Indices of all mesh items, the indices of item i are
+    /// indices[offsets[i]] to indices[offsets[i+1]-1].
+    struct IndexTable
+    {
+        std::vector<std::size_t> offsets;
+        std::vector<std::size_t> indices;
+
+        void assign(std::vector<std::vector<std::size_t>> const& lines);
+
+        LineIndex operator[](std::size_t const i) const
+        {
+            assert(i + 1 < offsets.size());
+            return LineIndex(indices.data() + offsets[i],
+                             indices.data() + offsets[i + 1]);
+        }
+    };
+
+private:
+    IndexTable _rows;
+    /// Empty if the column indices are equal to the row indices.
+    IndexTable _columns;
 };
 
 }   // namespace AssemblerLib
@@ -10,10 +10,10 @@
  *
  */
 
+#include <cassert>
 #include <iostream>
 
-#include <boost/range/algorithm/for_each.hpp>
-
+#include "BaseLib/Profiler.h"
 #include "MeshLib/MeshSubsets.h"
 
 #include "MeshComponentMap.h"
@@ -27,9 +27,18 @@ std::size_t const MeshComponentMap::nop = std::numeric_limits<std::size_t>::max(
 
 MeshComponentMap::MeshComponentMap(
     const std::vector<MeshLib::MeshSubsets*> &components, ComponentOrder order)
+    : _dict(createItemRanges(components))
 {
-    // construct dict (and here we number global_index by component type)
-    std::size_t global_index = 0;
+    if (order == ComponentOrder::BY_LOCATION)
+        renumberByLocation();
+}
+
+std::vector<ItemRange> MeshComponentMap::createItemRanges(
+    const std::vector<MeshLib::MeshSubsets*> &components)
+{
+    // the order of the ranges defines the global_index numbering by component
+    // type
+    std::vector<ItemRange> ranges;
     std::size_t comp_id = 0;
     for (auto c = components.cbegin(); c != components.cend(); ++c)
     {
@@ -38,56 +47,54 @@ MeshComponentMap::MeshComponentMap(
             MeshLib::MeshSubset const& mesh_subset = (*c)->getMeshSubset(mesh_subset_index);
             std::size_t const mesh_id = mesh_subset.getMeshID();
             // mesh items are ordered first by node, cell, ....
-            for (std::size_t j=0; j<mesh_subset.getNNodes(); j++)
-                _dict.insert(Line(Location(mesh_id, MeshLib::MeshItemType::Node, j), comp_id, global_index++));
-            for (std::size_t j=0; j<mesh_subset.getNElements(); j++)
-                _dict.insert(Line(Location(mesh_id, MeshLib::MeshItemType::Cell, j), comp_id, global_index++));
+            ranges.emplace_back(mesh_id, MeshLib::MeshItemType::Node, mesh_subset.getNNodes(), comp_id);
+            ranges.emplace_back(mesh_id, MeshLib::MeshItemType::Cell, mesh_subset.getNElements(), comp_id);
         }
         comp_id++;
     }
-
-    if (order == ComponentOrder::BY_LOCATION)
-        renumberByLocation();
+    return ranges;
 }
 
 void MeshComponentMap::renumberByLocation(std::size_t offset)
 {
-    std::size_t global_index = offset;
+    BASELIB_PROFILE_SCOPE("MeshComponentMap::renumberByLocation");
+    _dict.renumberByLocation(offset);
+}
 
-    auto &m = _dict.get<ByLocation>(); // view as sorted by mesh item
-    for (auto itr_mesh_item=m.begin(); itr_mesh_item!=m.end(); ++itr_mesh_item)
-    {
-        Line pos = *itr_mesh_item;
-        pos.global_index = global_index++;
-        m.replace(itr_mesh_item, pos);
-    }
+void MeshComponentMap::permuteGlobalIndices(
+    std::vector<std::size_t> const& po_perm)
+{
+    assert(po_perm.size() == _dict.size());
+    _dict.permuteGlobalIndices(po_perm);
 }
 
 std::vector<std::size_t> MeshComponentMap::getComponentIDs(const Location &l) const
 {
-    auto const &m = _dict.get<ByLocation>();
-    auto const p = m.equal_range(Line(l));
+    auto const p = _dict.find(l);
     std::vector<std::size_t> vec_compID;
-    for (auto itr=p.first; itr!=p.second; ++itr)
-        vec_compID.push_back(itr->comp_id);
+    vec_compID.reserve(p.second - p.first);
+    for (std::size_t i = p.first; i < p.second; ++i)
+        vec_compID.push_back(_dict.getComponentID(i));
     return vec_compID;
 }
 
 std::size_t MeshComponentMap::getGlobalIndex(Location const& l,
     std::size_t const c) const
 {
-    auto const &m = _dict.get<ByLocationAndComponent>();
-    auto const itr = m.find(Line(l, c));
-    return itr!=m.end() ? itr->global_index : nop;
+    auto const p = _dict.find(l);
+    for (std::size_t i = p.first; i < p.second; ++i)
+        if (_dict.getComponentID(i) == c)
+            return _dict.getGlobalIndex(i);
+    return nop;
 }
 
 std::vector<std::size_t> MeshComponentMap::getGlobalIndices(const Location &l) const
 {
-    auto const &m = _dict.get<ByLocation>();
-    auto const p = m.equal_range(Line(l));
+    auto const p = _dict.find(l);
     std::vector<std::size_t> global_indices;
-    for (auto itr=p.first; itr!=p.second; ++itr)
-        global_indices.push_back(itr->global_index);
+    global_indices.reserve(p.second - p.first);
+    for (std::size_t i = p.first; i < p.second; ++i)
+        global_indices.push_back(_dict.getGlobalIndex(i));
     return global_indices;
 }
 
@@ -102,12 +109,11 @@ MeshComponentMap::getGlobalIndices<ComponentOrder::BY_LOCATION>(
     std::vector<std::size_t> global_indices;
     global_indices.reserve(ls.size());
 
-    auto const &m = _dict.get<ByLocation>();
     for (auto l = ls.cbegin(); l != ls.cend(); ++l)
     {
-        auto const p = m.equal_range(Line(*l));
-        for (auto itr = p.first; itr != p.second; ++itr)
-            global_indices.push_back(itr->global_index);
+        auto const p = _dict.find(*l);
+        for (std::size_t i = p.first; i < p.second; ++i)
+            global_indices.push_back(_dict.getGlobalIndex(i));
     }
 
     return global_indices;
@@ -124,12 +130,12 @@ MeshComponentMap::getGlobalIndices<ComponentOrder::BY_COMPONENT>(
     pairs.reserve(ls.size());
 
     // Create a sub dictionary containing all lines with location from ls.
-    auto const &m = _dict.get<ByLocation>();
     for (auto l = ls.cbegin(); l != ls.cend(); ++l)
     {
-        auto const p = m.equal_range(Line(*l));
-        for (auto itr = p.first; itr != p.second; ++itr)
-            pairs.emplace_back(itr->comp_id, itr->global_index);
+        auto const p = _dict.find(*l);
+        for (std::size_t i = p.first; i < p.second; ++i)
+            pairs.emplace_back(_dict.getComponentID(i),
+                               _dict.getGlobalIndex(i));
     }
 
     auto CIPairLess = [](CIPair const& a, CIPair const& b)
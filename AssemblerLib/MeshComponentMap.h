@@ -110,6 +110,13 @@ public:
     template <ComponentOrder ORDER>
     std::vector<std::size_t> getGlobalIndices(const std::vector<Location> &ls) const;
 
+    /// Renumbers the global indices by the permutation \c po_perm mapping
+    /// the current to the new global indices, e.g. the inverse of an ordering
+    /// computed by MathLib::computeOrdering() for the sparsity graph of the
+    /// global matrix. Matrices and vectors assembled afterwards use the new
+    /// numbering.
+    void permuteGlobalIndices(std::vector<std::size_t> const& po_perm);
+
     /// A value returned if no global index was found for the requested
     /// location/component. The value is implementation dependent.
     static std::size_t const nop;
@@ -122,13 +129,14 @@ public:
 
     friend std::ostream& operator<<(std::ostream& os, MeshComponentMap const& m)
     {
-        for (auto l = m._dict.begin(); l != m._dict.end(); ++l)
-            os << *l << "\n";
-        return os;
+        return os << m._dict;
     }
 #endif  // NDEBUG
 
 private:
+    static std::vector<detail::ItemRange> createItemRanges(
+        std::vector<MeshLib::MeshSubsets*> const& components);
+
     void renumberByLocation(std::size_t offset=0);
 
 private:
@@ -13,6 +13,10 @@
 #ifndef ASSEMBLERLIB_SERIALEXECUTOR_H_H
 #define ASSEMBLERLIB_SERIALEXECUTOR_H_H
 
+#include <cstddef>
+
+#include "BaseLib/Profiler.h"
+
 namespace AssemblerLib
 {
 
@@ -36,6 +40,7 @@ struct SerialExecutor
     execute(F const& f, C const& c)
 #endif
     {
+        BASELIB_PROFILE_SCOPE("SerialExecutor::execute");
         for (std::size_t i = 0; i < c.size(); i++)
             f(c[i], i);
     }
@@ -15,6 +15,8 @@
 
 #include "AssemblerLib/MeshComponentMap.h"
 
+#include "MathLib/LinAlg/Sparse/CRSSparsityPattern.h"
+
 namespace AssemblerLib
 {
 
@@ -40,6 +42,18 @@ public:
         return mat;
     }
 
+    /// Creates a matrix with preallocated storage for the entries of the
+    /// given sparsity pattern, see AssemblerLib::computeSparsityPattern().
+    /// The matrix type must provide a constructor taking the number of rows
+    /// and the pattern.
+    static
+    MatrixType* createMatrix(const MeshComponentMap &dist_layout,
+        MathLib::CRSSparsityPattern const& sparsity_pattern)
+    {
+        MatrixType* mat = new MatrixType(dist_layout.size(), sparsity_pattern);
+        return mat;
+    }
+
 };
 
 }   // namespace AssemblerLib
@@ -10,6 +10,9 @@
 #ifndef ASSEMBLERLIB_VECTORMATRIXASSEMBLER_H_
 #define ASSEMBLERLIB_VECTORMATRIXASSEMBLER_H_
 
+#include <memory>
+
+#include "LocalMatrixWorkspace.h"
 #include "LocalToGlobalIndexMap.h"
 
 namespace AssemblerLib
@@ -20,6 +23,11 @@ namespace AssemblerLib
 /// and adds the local vector and matrix entries into the global vector and
 /// the global matrix. The indices in global objects are provided by
 /// the LocalToGlobalIndexMap in the construction.
+///
+/// The local matrices and vectors are taken from a LocalMatrixWorkspace
+/// allocated once in the construction, one set per thread. No allocations are
+/// done in the element loop. Fixed-size local matrix types, see
+/// FixedSizeLocalMatrixTypes, avoid dynamic memory completely.
 template<
     typename GLOBAL_MATRIX_,
     typename GLOBAL_VECTOR_,
@@ -41,7 +49,23 @@ public:
         GLOBAL_VECTOR_ &rhs,
         ASSEMBLER_ &local_assembler,
         LocalToGlobalIndexMap const& data_pos)
-    : _A(A), _rhs(rhs), _local_assembler(local_assembler), _data_pos(data_pos) {}
+    : _A(A), _rhs(rhs), _local_assembler(local_assembler), _data_pos(data_pos),
+      _workspace(data_pos)
+    {}
+
+    /// Same as above for a temporary index map, which is moved into the
+    /// assembler and kept alive as long as the assembler or a copy of it.
+    VectorMatrixAssembler(
+        GLOBAL_MATRIX_ &A,
+        GLOBAL_VECTOR_ &rhs,
+        ASSEMBLER_ &local_assembler,
+        LocalToGlobalIndexMap&& data_pos)
+    : _A(A), _rhs(rhs), _local_assembler(local_assembler),
+      _owned_data_pos(std::make_shared<LocalToGlobalIndexMap const>(
+          std::move(data_pos))),
+      _data_pos(*_owned_data_pos),
+      _workspace(*_owned_data_pos)
+    {}
 
     ~VectorMatrixAssembler() {}
 
@@ -55,8 +79,10 @@ public:
         assert(_data_pos.size() > id);
 
         LocalToGlobalIndexMap::RowColumnIndices const& indices = _data_pos[id];
-        LOCAL_MATRIX_ local_A(indices.rows.size(), indices.columns.size());
-        LOCAL_VECTOR_ local_rhs(indices.rows.size());
+        std::size_t const n_rows = indices.rows.size();
+        std::size_t const n_cols = indices.columns.size();
+        LOCAL_MATRIX_& local_A = _workspace.matrix(n_rows, n_cols);
+        LOCAL_VECTOR_& local_rhs = _workspace.vector(n_rows, n_cols);
 
         _local_assembler(*item, local_A, local_rhs);
         _A.add(indices, local_A);
@@ -67,7 +93,10 @@ protected:
     GLOBAL_MATRIX_ &_A;
     GLOBAL_VECTOR_ &_rhs;
     ASSEMBLER_ &_local_assembler;
+    /// Only set if the index map was passed as a temporary.
+    std::shared_ptr<LocalToGlobalIndexMap const> _owned_data_pos;
     LocalToGlobalIndexMap const& _data_pos;
+    mutable LocalMatrixWorkspace<LOCAL_MATRIX_, LOCAL_VECTOR_> _workspace;
 };
 
 }   // namespace AssemblerLib
@@ -0,0 +1,52 @@
+/**
+ * \file
+ * \brief  Functions for the conversion of the byte order of binary data.
+ *
+ * \copyright
+ * Copyright (c) 2013, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#ifndef ENDIANNESS_H_
+#define ENDIANNESS_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+namespace BaseLib
+{
+
+/// Returns true if the machine stores values in little-endian byte order.
+inline bool isLittleEndian()
+{
+	std::uint16_t const one (1);
+	unsigned char first_byte;
+	std::memcpy(&first_byte, &one, 1);
+	return first_byte == 1;
+}
+
+/// Reverses the byte order of the value.
+template <typename T>
+void swapBytes(T& value)
+{
+	unsigned char* const bytes (reinterpret_cast<unsigned char*>(&value));
+	std::reverse(bytes, bytes + sizeof(T));
+}
+
+/// Converts the value from the native to the little-endian byte order and
+/// vice versa.
+template <typename T>
+T toLittleEndian(T value)
+{
+	if (!isLittleEndian())
+		swapBytes(value);
+	return value;
+}
+
+} // end namespace BaseLib
+
+#endif /* ENDIANNESS_H_ */
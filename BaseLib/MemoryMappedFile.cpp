@@ -0,0 +1,80 @@
+/**
+ * \file
+ * \brief  Implementation of the MemoryMappedFile class.
+ *
+ * \copyright
+ * Copyright (c) 2013, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#include "MemoryMappedFile.h"
+
+#include <fstream>
+
+#ifndef _MSC_VER
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace BaseLib
+{
+
+MemoryMappedFile::MemoryMappedFile(std::string const& file_name,
+	AccessPattern access_pattern)
+	: _data(nullptr), _size(0), _is_mapped(false)
+{
+#ifndef _MSC_VER
+	int const fd (open(file_name.c_str(), O_RDONLY));
+	if (fd == -1)
+		return;
+
+	struct stat file_status;
+	if (fstat(fd, &file_status) == 0 && file_status.st_size > 0)
+	{
+		void* const data (mmap(nullptr, file_status.st_size, PROT_READ, MAP_PRIVATE, fd, 0));
+		if (data != MAP_FAILED)
+		{
+#if defined(MADV_SEQUENTIAL) && defined(MADV_RANDOM)
+			madvise(data, file_status.st_size,
+				access_pattern == AccessPattern::RANDOM ? MADV_RANDOM : MADV_SEQUENTIAL);
+#endif
+			_data = static_cast<char const*>(data);
+			_size = file_status.st_size;
+			_is_mapped = true;
+		}
+	}
+	close(fd);
+	if (_is_mapped)
+		return;
+#else
+	(void) access_pattern;
+#endif
+
+	std::ifstream in(file_name.c_str(), std::ios::binary);
+	if (!in)
+		return;
+	in.seekg(0, std::ios::end);
+	_buffer.resize(static_cast<std::size_t>(in.tellg()));
+	in.seekg(0, std::ios::beg);
+	in.read(_buffer.data(), _buffer.size());
+	if (!in)
+		return;
+	// an empty file is open but has no data
+	_data = _buffer.empty() ? "" : _buffer.data();
+	_size = _buffer.size();
+}
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+#ifndef _MSC_VER
+	if (_is_mapped)
+		munmap(const_cast<char*>(_data), _size);
+#endif
+}
+
+} // end namespace BaseLib
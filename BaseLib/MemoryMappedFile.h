@@ -0,0 +1,68 @@
+/**
+ * \file
+ * \brief  Definition of the MemoryMappedFile class.
+ *
+ * \copyright
+ * Copyright (c) 2013, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#ifndef MEMORYMAPPEDFILE_H_
+#define MEMORYMAPPEDFILE_H_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace BaseLib
+{
+
+/**
+ * Read-only view on the content of a file. On POSIX systems the file is mapped
+ * into memory, i.e. only the pages actually accessed are read by the
+ * operating system. On other systems or if the mapping fails the file is read
+ * into a buffer at once.
+ */
+class MemoryMappedFile
+{
+public:
+	/// Expected order of the accesses, passed to the operating system as a
+	/// hint for reading ahead.
+	enum class AccessPattern
+	{
+		SEQUENTIAL, ///< The file is read from the beginning to the end.
+		RANDOM      ///< Only some parts of the file are read in any order.
+	};
+
+	/// Maps the given file. Use isOpen() to check for success.
+	explicit MemoryMappedFile(std::string const& file_name,
+		AccessPattern access_pattern = AccessPattern::SEQUENTIAL);
+	~MemoryMappedFile();
+
+	MemoryMappedFile(MemoryMappedFile const&) = delete;
+	MemoryMappedFile& operator=(MemoryMappedFile const&) = delete;
+
+	bool isOpen() const { return _data != nullptr; }
+
+	/// Pointer to the first byte of the file.
+	char const* begin() const { return _data; }
+
+	/// Pointer past the last byte of the file.
+	char const* end() const { return _data + _size; }
+
+	/// Size of the file in bytes.
+	std::size_t size() const { return _size; }
+
+private:
+	char const* _data;
+	std::size_t _size;
+	bool _is_mapped;
+	std::vector<char> _buffer;
+};
+
+} // end namespace BaseLib
+
+#endif /* MEMORYMAPPEDFILE_H_ */
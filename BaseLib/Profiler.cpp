@@ -0,0 +1,354 @@
+/**
+ * \file
+ * \brief  Implementation of the Profiler class.
+ *
+ * \copyright
+ * Copyright (c) 2013, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#include "Profiler.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include <time.h>
+
+#include "MemWatch.h"
+#include "RunTime.h"
+
+namespace
+{
+
+/// CPU time of the calling thread in seconds. Falls back to the CPU time of
+/// the process if the thread's CPU clock is not available.
+double getThreadCPUTime()
+{
+#ifdef CLOCK_THREAD_CPUTIME_ID
+	timespec t;
+	if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &t) == 0)
+		return static_cast<double>(t.tv_sec) + 1e-9 * static_cast<double>(t.tv_nsec);
+#endif
+	return static_cast<double>(std::clock()) / CLOCKS_PER_SEC;
+}
+
+void writeJSONString(std::ostream& os, std::string const& str)
+{
+	os << '"';
+	for (char c : str)
+	{
+		if (c == '"' || c == '\\')
+			os << '\\' << c;
+		else if (static_cast<unsigned char>(c) < 0x20)
+			os << ' ';
+		else
+			os << c;
+	}
+	os << '"';
+}
+
+} // end anonymous namespace
+
+namespace BaseLib
+{
+
+struct Profiler::ThreadData
+{
+	struct Region
+	{
+		Region(char const* name_, std::size_t parent_)
+			: name(name_), parent(parent_), calls(0), wall_time(0.0), cpu_time(0.0),
+			  rss_delta(0)
+		{}
+
+		char const* name;
+		std::size_t parent;
+		std::vector<std::size_t> children;
+		std::size_t calls;
+		double wall_time;
+		double cpu_time;
+		long rss_delta;
+	};
+
+	struct ActiveRegion
+	{
+		std::size_t region;
+		RunTime run_time;
+		double cpu_start;
+		long rss_start;
+		bool track_memory;
+	};
+
+	ThreadData() : regions(1, Region("", 0)) {}
+
+	/// Returns the index of the child of the given region with the given
+	/// name, the child is created if it does not exist.
+	std::size_t getChild(std::size_t parent, char const* name)
+	{
+		std::vector<std::size_t> const& children (regions[parent].children);
+		for (std::size_t child : children)
+			if (regions[child].name == name || std::strcmp(regions[child].name, name) == 0)
+				return child;
+		regions.push_back(Region(name, parent));
+		regions[parent].children.push_back(regions.size() - 1);
+		return regions.size() - 1;
+	}
+
+	long getResMemUsage()
+	{
+#ifndef _MSC_VER
+		return static_cast<long>(mem_watch.getResMemUsage());
+#else
+		return 0;
+#endif
+	}
+
+	/// Regions in the order of their first call, the first entry is the root.
+	std::vector<Region> regions;
+	/// Stack of the regions currently entered.
+	std::vector<ActiveRegion> active;
+#ifndef _MSC_VER
+	MemWatch mem_watch;
+#endif
+};
+
+struct Profiler::Summary
+{
+	struct Node
+	{
+		explicit Node(std::string const& name_)
+			: name(name_), calls(0), threads(0), wall_time(0.0), cpu_time(0.0), rss_delta(0)
+		{}
+
+		std::string name;
+		std::size_t calls;
+		std::size_t threads;
+		double wall_time; ///< maximum over all threads
+		double cpu_time;  ///< sum over all threads
+		long rss_delta;   ///< sum over all threads
+		std::vector<std::size_t> children;
+	};
+
+	Summary() : nodes(1, Node("")) {}
+
+	/// Adds the sub tree of the given region of a thread to the given node.
+	void merge(ThreadData const& data, std::size_t region, std::size_t node)
+	{
+		for (std::size_t child : data.regions[region].children)
+		{
+			ThreadData::Region const& r (data.regions[child]);
+			std::size_t const n (getChild(node, r.name));
+			nodes[n].calls += r.calls;
+			nodes[n].threads++;
+			nodes[n].wall_time = std::max(nodes[n].wall_time, r.wall_time);
+			nodes[n].cpu_time += r.cpu_time;
+			nodes[n].rss_delta += r.rss_delta;
+			merge(data, child, n);
+		}
+	}
+
+	std::size_t getChild(std::size_t parent, std::string const& name)
+	{
+		for (std::size_t child : nodes[parent].children)
+			if (nodes[child].name == name)
+				return child;
+		nodes.push_back(Node(name));
+		nodes[parent].children.push_back(nodes.size() - 1);
+		return nodes.size() - 1;
+	}
+
+	/// Width of the indented region names of the sub tree.
+	std::size_t getNameWidth(std::size_t node, std::size_t depth) const
+	{
+		std::size_t width (0);
+		for (std::size_t child : nodes[node].children)
+			width = std::max(width, std::max(2 * depth + nodes[child].name.size(),
+			                                 getNameWidth(child, depth + 1)));
+		return width;
+	}
+
+	void writeRows(std::ostream& os, std::size_t node, std::size_t depth, int width) const
+	{
+		for (std::size_t child : nodes[node].children)
+		{
+			Node const& n (nodes[child]);
+			os << std::left << std::setw(width) << (std::string(2 * depth, ' ') + n.name)
+			   << std::right << std::setw(10) << n.calls
+			   << std::setw(8) << n.threads
+			   << std::setw(12) << n.wall_time
+			   << std::setw(12) << n.cpu_time
+			   << std::setw(12) << static_cast<double>(n.rss_delta) / (1024.0 * 1024.0)
+			   << "\n";
+			writeRows(os, child, depth + 1, width);
+		}
+	}
+
+	void writeJSON(std::ostream& os, std::size_t node, std::size_t depth) const
+	{
+		std::string const indent (2 * depth, ' ');
+		os << "[";
+		for (std::size_t i = 0; i < nodes[node].children.size(); i++)
+		{
+			Node const& n (nodes[nodes[node].children[i]]);
+			os << (i == 0 ? "\n" : ",\n") << indent << "  {\"name\": ";
+			writeJSONString(os, n.name);
+			os << ", \"calls\": " << n.calls
+			   << ", \"threads\": " << n.threads
+			   << ", \"wall_time\": " << n.wall_time
+			   << ", \"cpu_time\": " << n.cpu_time
+			   << ", \"rss_delta\": " << n.rss_delta
+			   << ", \"children\": ";
+			writeJSON(os, nodes[node].children[i], depth + 1);
+			os << "}";
+		}
+		if (!nodes[node].children.empty())
+			os << "\n" << indent;
+		os << "]";
+	}
+
+	std::vector<Node> nodes;
+};
+
+Profiler& Profiler::instance()
+{
+	static Profiler profiler;
+	return profiler;
+}
+
+Profiler::Profiler()
+	: _generation(1), _enabled(false),
+	  _memory_tracking(std::getenv("OGS_PROFILE_MEMORY") != nullptr)
+{
+	char const* const report (std::getenv("OGS_PROFILE_REPORT"));
+	if (report != nullptr)
+		_report.reset(new std::string(report));
+	_enabled = _report != nullptr;
+}
+
+Profiler::~Profiler()
+{
+	// logog is already shut down at this point, hence std streams are used
+	if (!_report)
+		return;
+
+	writeSummary(std::cout);
+	if (_report->empty())
+		return;
+	std::ofstream out(_report->c_str());
+	if (out)
+		writeJSON(out);
+	else
+		std::cerr << "Profiler: Could not write report to file " << *_report << "\n";
+}
+
+Profiler::ThreadData& Profiler::getThreadData()
+{
+	static thread_local ThreadData* data = nullptr;
+	static thread_local unsigned generation = 0;
+
+	if (data == nullptr || generation != _generation)
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_thread_data.emplace_back(new ThreadData);
+		data = _thread_data.back().get();
+		generation = _generation;
+	}
+	return *data;
+}
+
+bool Profiler::enter(char const* name)
+{
+	if (!_enabled)
+		return false;
+
+	ThreadData& data (getThreadData());
+	std::size_t const parent (data.active.empty() ? 0 : data.active.back().region);
+	std::size_t const region (data.getChild(parent, name));
+
+	data.active.push_back(ThreadData::ActiveRegion());
+	ThreadData::ActiveRegion& active (data.active.back());
+	active.region = region;
+	active.track_memory = _memory_tracking;
+	active.rss_start = active.track_memory ? data.getResMemUsage() : 0;
+	active.cpu_start = getThreadCPUTime();
+	active.run_time.start();
+	return true;
+}
+
+void Profiler::leave()
+{
+	ThreadData& data (getThreadData());
+	// the data might have been reset while the region was active
+	if (data.active.empty())
+		return;
+
+	ThreadData::ActiveRegion& active (data.active.back());
+	active.run_time.stop();
+	double const cpu_end (getThreadCPUTime());
+
+	ThreadData::Region& region (data.regions[active.region]);
+	region.calls++;
+	region.wall_time += active.run_time.elapsed();
+	region.cpu_time += cpu_end - active.cpu_start;
+	if (active.track_memory)
+		region.rss_delta += data.getResMemUsage() - active.rss_start;
+	data.active.pop_back();
+}
+
+void Profiler::reset()
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	_thread_data.clear();
+	_generation++;
+}
+
+void Profiler::summarize(Summary& summary) const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	for (auto const& data : _thread_data)
+		summary.merge(*data, 0, 0);
+}
+
+void Profiler::writeSummary(std::ostream& os) const
+{
+	Summary summary;
+	summarize(summary);
+
+	int const width (static_cast<int>(std::max<std::size_t>(summary.getNameWidth(0, 0), 6) + 2));
+	std::ostringstream table;
+	table << std::fixed << std::setprecision(4);
+	table << std::left << std::setw(width) << "Region"
+	      << std::right << std::setw(10) << "Calls"
+	      << std::setw(8) << "Threads"
+	      << std::setw(12) << "Wall [s]"
+	      << std::setw(12) << "CPU [s]"
+	      << std::setw(12) << "RSS [MiB]" << "\n";
+	table << std::string(width + 54, '-') << "\n";
+	summary.writeRows(table, 0, 0, width);
+	os << table.str();
+}
+
+void Profiler::writeJSON(std::ostream& os) const
+{
+	Summary summary;
+	summarize(summary);
+
+	std::ostringstream json;
+	json << std::setprecision(9);
+	json << "{\"regions\": ";
+	summary.writeJSON(json, 0, 0);
+	json << "}\n";
+	os << json.str();
+}
+
+} // end namespace BaseLib
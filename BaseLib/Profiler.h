@@ -0,0 +1,141 @@
+/**
+ * \file
+ * \brief  Definition of the Profiler and ProfileScope classes.
+ *
+ * \copyright
+ * Copyright (c) 2013, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#ifndef PROFILER_H_
+#define PROFILER_H_
+
+#include <atomic>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace BaseLib
+{
+
+/**
+ * Registry of hierarchical, named regions of code. For each region the number
+ * of calls, the elapsed wall time (measured with BaseLib::RunTime), the CPU
+ * time of the executing thread and the change of the resident set size
+ * (measured with BaseLib::MemWatch, not available on Windows) are accumulated.
+ *
+ * Regions are nested according to the order in which they are entered, i.e.
+ * the same region called from different places shows up in different places
+ * of the region tree. Every thread accumulates into its own tree, hence
+ * entering and leaving a region does not require any synchronisation. The
+ * trees of all threads are merged by the path of the regions when writing
+ * the report.
+ *
+ * Regions are usually marked with the BASELIB_PROFILE_SCOPE macro. Recording
+ * is enabled only if the environment variable \c OGS_PROFILE_REPORT is set
+ * when the profiler is created; otherwise entering a region only checks a
+ * flag. If enabled, a summary table is written to std::cout at program exit.
+ * If the value of the variable is not empty, it is used as the name of a file
+ * the JSON report is written to. The resident set size is only measured if
+ * additionally \c OGS_PROFILE_MEMORY is set.
+ */
+class Profiler
+{
+public:
+	/// The process wide instance.
+	static Profiler& instance();
+
+	~Profiler();
+
+	Profiler(Profiler const&) = delete;
+	Profiler& operator=(Profiler const&) = delete;
+
+	/// Enters the region with the given name, which has to be a string
+	/// that stays valid until the report is written (e.g. a literal).
+	/// @return false if the profiler is disabled and nothing was recorded.
+	bool enter(char const* name);
+
+	/// Leaves the region entered last by the calling thread.
+	void leave();
+
+	/// Enables or disables the recording of regions, default is enabled if
+	/// \c OGS_PROFILE_REPORT is set.
+	void setEnabled(bool enabled) { _enabled = enabled; }
+	bool isEnabled() const { return _enabled; }
+
+	/// Enables or disables the measurement of the resident set size, which
+	/// requires reading from /proc on every enter and leave. Default is enabled
+	/// if \c OGS_PROFILE_MEMORY is set.
+	void setMemoryTracking(bool tracking) { _memory_tracking = tracking; }
+
+	/// Removes all recorded data. Must not be called while any region is active.
+	void reset();
+
+	/// Writes the merged region tree as a table.
+	void writeSummary(std::ostream& os) const;
+
+	/// Writes the merged region tree in JSON format.
+	void writeJSON(std::ostream& os) const;
+
+private:
+	struct ThreadData;
+	struct Summary;
+
+	Profiler();
+
+	/// Returns the data of the calling thread, creating it if necessary.
+	ThreadData& getThreadData();
+
+	/// Merges the trees of all threads.
+	void summarize(Summary& summary) const;
+
+	mutable std::mutex _mutex;
+	std::vector<std::unique_ptr<ThreadData>> _thread_data;
+	std::atomic<unsigned> _generation;
+	std::atomic<bool> _enabled;
+	std::atomic<bool> _memory_tracking;
+	/// Value of OGS_PROFILE_REPORT at construction, null if not set.
+	std::unique_ptr<std::string> _report;
+};
+
+/// Enters the given region of the BaseLib::Profiler on construction and
+/// leaves it on destruction.
+class ProfileScope
+{
+public:
+	explicit ProfileScope(char const* name)
+		: _active(Profiler::instance().enter(name))
+	{}
+
+	~ProfileScope()
+	{
+		if (_active)
+			Profiler::instance().leave();
+	}
+
+	ProfileScope(ProfileScope const&) = delete;
+	ProfileScope& operator=(ProfileScope const&) = delete;
+
+private:
+	bool const _active;
+};
+
+} // end namespace BaseLib
+
+#define BASELIB_PROFILE_CONCAT_IMPL(a, b) a##b
+#define BASELIB_PROFILE_CONCAT(a, b) BASELIB_PROFILE_CONCAT_IMPL(a, b)
+
+/// Profiles the enclosing scope under the given name.
+#ifndef OGS_DISABLE_PROFILING
+#define BASELIB_PROFILE_SCOPE(name) \
+	BaseLib::ProfileScope const BASELIB_PROFILE_CONCAT(baselib_profile_scope_, __LINE__) (name)
+#else
+#define BASELIB_PROFILE_SCOPE(name)
+#endif
+
+#endif /* PROFILER_H_ */
@@ -0,0 +1,614 @@
+/**
+ * \file
+ * \brief  Implementation of the BinaryMeshIO class.
+ *
+ * \copyright
+ * Copyright (c) 2013, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#include "BinaryMeshIO.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+// ThirdParty/logog
+#include "logog/include/logog.hpp"
+
+// BaseLib
+#include "Endianness.h"
+#include "MemoryMappedFile.h"
+#include "Profiler.h"
+
+// MeshLib
+#include "CompactMesh.h"
+#include "Mesh.h"
+#include "Node.h"
+#include "Elements/Element.h"
+#include "Elements/createElement.h"
+
+namespace FileIO
+{
+
+namespace
+{
+char const magic[8] = {'O', 'G', 'S', 'B', 'M', 'S', 'H', '\0'};
+std::uint32_t const format_version (1);
+std::uint32_t const topology_flag (1);
+std::size_t const alignment (8);
+unsigned const no_neighbor (std::numeric_limits<unsigned>::max());
+
+/// Header of a binary mesh file, the fields are stored one after another.
+struct FileHeader
+{
+	std::uint32_t version;
+	std::uint32_t flags;
+	std::uint64_t n_nodes;
+	std::uint64_t n_elements;
+	std::uint64_t n_element_nodes;
+	std::uint64_t n_node_elements;
+	std::uint64_t n_neighbors;
+	std::uint64_t name_length;
+	double edge_length[2];
+};
+
+/// The content of a binary mesh file.
+struct MeshData
+{
+	FileHeader header;
+	std::string name;
+	std::vector<double> coords;
+	std::vector<CellType> cell_types;
+	std::vector<unsigned> values;
+	std::vector<std::size_t> element_offsets;
+	std::vector<unsigned> element_node_ids;
+	std::vector<std::size_t> node_element_offsets;
+	std::vector<unsigned> node_element_ids;
+	std::vector<unsigned> neighbor_ids;
+};
+
+/// Writes values in little-endian byte order.
+class BlockWriter
+{
+public:
+	explicit BlockWriter(std::ostream& os)
+		: _os(os), _n_bytes(0), _swap_bytes(!BaseLib::isLittleEndian())
+	{}
+
+	template <typename T>
+	void writeValue(T value)
+	{
+		writeBlock<T>(1, [value](std::size_t) { return value; });
+	}
+
+	/// Writes n values of type T, value i is get(i).
+	template <typename T, typename GET>
+	void writeBlock(std::size_t n, GET const& get)
+	{
+		const std::size_t buffer_size (1024);
+		T buffer[buffer_size];
+		for (std::size_t i = 0; i < n; i += buffer_size)
+		{
+			std::size_t const m (std::min(buffer_size, n - i));
+			for (std::size_t k = 0; k < m; k++)
+			{
+				buffer[k] = static_cast<T>(get(i + k));
+				if (_swap_bytes)
+					BaseLib::swapBytes(buffer[k]);
+			}
+			_os.write(reinterpret_cast<char const*>(buffer), m * sizeof(T));
+		}
+		_n_bytes += n * sizeof(T);
+	}
+
+	void writeBytes(char const* data, std::size_t n)
+	{
+		_os.write(data, n);
+		_n_bytes += n;
+	}
+
+	/// Fills up to the next aligned position.
+	void pad()
+	{
+		for (; _n_bytes % alignment != 0; _n_bytes++)
+			_os.put('\0');
+	}
+
+private:
+	std::ostream& _os;
+	std::size_t _n_bytes;
+	bool const _swap_bytes;
+};
+
+/// Reads little-endian values from the mapped file.
+class BlockReader
+{
+public:
+	BlockReader(char const* begin, char const* end)
+		: _begin(begin), _pos(begin), _end(end), _swap_bytes(!BaseLib::isLittleEndian())
+	{}
+
+	template <typename T>
+	bool readValue(T& value)
+	{
+		if (static_cast<std::size_t>(_end - _pos) < sizeof(T))
+			return false;
+		std::memcpy(&value, _pos, sizeof(T));
+		if (_swap_bytes)
+			BaseLib::swapBytes(value);
+		_pos += sizeof(T);
+		return true;
+	}
+
+	/// Reads a block of n values stored as FILE_T into the vector and skips
+	/// the padding.
+	template <typename FILE_T, typename T>
+	bool readBlock(std::size_t n, std::vector<T> &values)
+	{
+		if (n > static_cast<std::size_t>(_end - _pos) / sizeof(FILE_T))
+			return false;
+		values.resize(n);
+		if (n > 0 && std::is_same<FILE_T, T>::value && !_swap_bytes)
+			std::memcpy(values.data(), _pos, n * sizeof(T));
+		else
+		{
+			for (std::size_t i = 0; i < n; i++)
+			{
+				FILE_T v;
+				std::memcpy(&v, _pos + i * sizeof(FILE_T), sizeof(FILE_T));
+				if (_swap_bytes)
+					BaseLib::swapBytes(v);
+				values[i] = static_cast<T>(v);
+			}
+		}
+		_pos += n * sizeof(FILE_T);
+		skipPadding();
+		return true;
+	}
+
+	bool readString(std::size_t n, std::string &str)
+	{
+		if (n > static_cast<std::size_t>(_end - _pos))
+			return false;
+		str.assign(_pos, n);
+		_pos += n;
+		skipPadding();
+		return true;
+	}
+
+private:
+	void skipPadding()
+	{
+		std::size_t const offset (_pos - _begin);
+		std::size_t const padded ((offset + alignment - 1) / alignment * alignment);
+		_pos = _begin + std::min(padded, static_cast<std::size_t>(_end - _begin));
+	}
+
+	char const* const _begin;
+	char const* _pos;
+	char const* const _end;
+	bool const _swap_bytes;
+};
+
+// Uniform access to the data of MeshLib::Mesh and MeshLib::CompactMesh.
+double getNodeCoord(MeshLib::Mesh const& mesh, std::size_t i, unsigned k)
+{
+	return (*mesh.getNode(i))[k];
+}
+
+double getNodeCoord(MeshLib::CompactMesh const& mesh, std::size_t i, unsigned k)
+{
+	return mesh.getNode(i)[k];
+}
+
+CellType getCellType(MeshLib::Mesh const& mesh, std::size_t i)
+{
+	return mesh.getElement(i)->getCellType();
+}
+
+CellType getCellType(MeshLib::CompactMesh const& mesh, std::size_t i)
+{
+	return mesh.getCellType(i);
+}
+
+unsigned getElementValue(MeshLib::Mesh const& mesh, std::size_t i)
+{
+	return mesh.getElement(i)->getValue();
+}
+
+unsigned getElementValue(MeshLib::CompactMesh const& mesh, std::size_t i)
+{
+	return mesh.getElementValue(i);
+}
+
+unsigned getNElementNodes(MeshLib::Mesh const& mesh, std::size_t i)
+{
+	return mesh.getElement(i)->getNNodes(true);
+}
+
+unsigned getNElementNodes(MeshLib::CompactMesh const& mesh, std::size_t i)
+{
+	return mesh.getNElementNodes(i, true);
+}
+
+unsigned getElementNodeID(MeshLib::Mesh const& mesh, std::size_t i, unsigned j)
+{
+	return mesh.getElement(i)->getNode(j)->getID();
+}
+
+unsigned getElementNodeID(MeshLib::CompactMesh const& mesh, std::size_t i, unsigned j)
+{
+	return mesh.getElementNodeIDs(i)[j];
+}
+
+void getEdgeLengthRange(MeshLib::Mesh const& mesh, double edge_length[2])
+{
+	edge_length[0] = mesh.getMinEdgeLength();
+	edge_length[1] = mesh.getMaxEdgeLength();
+}
+
+void getEdgeLengthRange(MeshLib::CompactMesh const&, double edge_length[2])
+{
+	edge_length[0] = edge_length[1] = 0;
+}
+
+// The topology tables exist for MeshLib::Mesh only.
+void getTopologySizes(MeshLib::Mesh const& mesh, FileHeader &header)
+{
+	header.n_node_elements = 0;
+	for (MeshLib::Node const* node : mesh.getNodes())
+		header.n_node_elements += node->getNElements();
+	header.n_neighbors = 0;
+	for (MeshLib::Element const* element : mesh.getElements())
+		header.n_neighbors += element->getNNeighbors();
+}
+
+void getTopologySizes(MeshLib::CompactMesh const&, FileHeader &header)
+{
+	header.n_node_elements = 0;
+	header.n_neighbors = 0;
+}
+
+void writeTopology(MeshLib::Mesh const& mesh, BlockWriter &writer)
+{
+	std::vector<MeshLib::Node*> const& nodes (mesh.getNodes());
+	std::uint64_t offset (0);
+	writer.writeValue<std::uint64_t>(offset);
+	writer.writeBlock<std::uint64_t>(nodes.size(), [&](std::size_t i) {
+		return offset += nodes[i]->getNElements();
+	});
+	writer.pad();
+
+	for (MeshLib::Node const* node : nodes)
+	{
+		std::vector<MeshLib::Element*> const& elements (node->getElements());
+		writer.writeBlock<std::uint32_t>(elements.size(), [&elements](std::size_t k) {
+			return elements[k]->getID();
+		});
+	}
+	writer.pad();
+
+	for (MeshLib::Element const* element : mesh.getElements())
+		writer.writeBlock<std::uint32_t>(element->getNNeighbors(), [element](std::size_t k) {
+			MeshLib::Element const* const neighbor (element->getNeighbor(k));
+			return neighbor ? neighbor->getID() : no_neighbor;
+		});
+	writer.pad();
+}
+
+void writeTopology(MeshLib::CompactMesh const&, BlockWriter &)
+{}
+
+/// Checks if the offsets start at 0, are increasing and end at n.
+bool isValidOffsets(std::vector<std::size_t> const& offsets, std::size_t n)
+{
+	return offsets.front() == 0 && offsets.back() == n &&
+	       std::is_sorted(offsets.begin(), offsets.end());
+}
+
+bool isValidIDs(std::vector<unsigned> const& ids, std::size_t n)
+{
+	return std::none_of(ids.begin(), ids.end(), [n](unsigned id) { return id >= n; });
+}
+
+bool readMeshData(std::string const& file_name, bool read_topology, MeshData &data)
+{
+	BaseLib::MemoryMappedFile const file (file_name);
+	if (!file.isOpen())
+	{
+		ERR("BinaryMeshIO: Could not open file %s.", file_name.c_str());
+		return false;
+	}
+
+	BlockReader reader(file.begin(), file.end());
+	std::vector<char> file_magic;
+	FileHeader &header (data.header);
+	if (!reader.readBlock<char>(sizeof(magic), file_magic) ||
+	    !std::equal(file_magic.begin(), file_magic.end(), magic))
+	{
+		ERR("BinaryMeshIO: %s is not a binary mesh file.", file_name.c_str());
+		return false;
+	}
+	if (!reader.readValue(header.version) || header.version != format_version)
+	{
+		ERR("BinaryMeshIO: Unsupported format version %d.", header.version);
+		return false;
+	}
+
+	if (!reader.readValue(header.flags) || !reader.readValue(header.n_nodes) ||
+	    !reader.readValue(header.n_elements) || !reader.readValue(header.n_element_nodes) ||
+	    !reader.readValue(header.n_node_elements) || !reader.readValue(header.n_neighbors) ||
+	    !reader.readValue(header.name_length) || !reader.readValue(header.edge_length[0]) ||
+	    !reader.readValue(header.edge_length[1]) ||
+	    !reader.readString(header.name_length, data.name))
+	{
+		ERR("BinaryMeshIO: Incomplete header.");
+		return false;
+	}
+
+	std::size_t const n_nodes (header.n_nodes);
+	std::size_t const n_elements (header.n_elements);
+	std::vector<std::uint8_t> cell_types;
+	if (!reader.readBlock<double>(3 * n_nodes, data.coords) ||
+	    !reader.readBlock<std::uint8_t>(n_elements, cell_types) ||
+	    !reader.readBlock<std::uint32_t>(n_elements, data.values) ||
+	    !reader.readBlock<std::uint64_t>(n_elements + 1, data.element_offsets) ||
+	    !reader.readBlock<std::uint32_t>(header.n_element_nodes, data.element_node_ids))
+	{
+		ERR("BinaryMeshIO: Unexpected end of file.");
+		return false;
+	}
+
+	if (!(header.flags & topology_flag))
+		read_topology = false;
+	if (read_topology &&
+	    (!reader.readBlock<std::uint64_t>(n_nodes + 1, data.node_element_offsets) ||
+	     !reader.readBlock<std::uint32_t>(header.n_node_elements, data.node_element_ids) ||
+	     !reader.readBlock<std::uint32_t>(header.n_neighbors, data.neighbor_ids)))
+	{
+		ERR("BinaryMeshIO: Unexpected end of file.");
+		return false;
+	}
+
+	data.cell_types.resize(n_elements);
+	for (std::size_t i = 0; i < n_elements; i++)
+	{
+		data.cell_types[i] = static_cast<CellType>(cell_types[i]);
+		if (cell_types[i] > static_cast<std::uint8_t>(CellType::PYRAMID5) ||
+		    getNCellTypeNodes(data.cell_types[i]) == 0)
+		{
+			ERR("BinaryMeshIO: Invalid cell type %d of element %d.", cell_types[i], i);
+			return false;
+		}
+	}
+
+	bool valid (isValidOffsets(data.element_offsets, data.element_node_ids.size()) &&
+	            isValidIDs(data.element_node_ids, n_nodes));
+	for (std::size_t i = 0; valid && i < n_elements; i++)
+		valid = data.element_offsets[i + 1] - data.element_offsets[i] ==
+		        getNCellTypeNodes(data.cell_types[i]);
+	if (read_topology)
+	{
+		valid = valid && isValidOffsets(data.node_element_offsets, data.node_element_ids.size()) &&
+		        isValidIDs(data.node_element_ids, n_elements) &&
+		        std::none_of(data.neighbor_ids.begin(), data.neighbor_ids.end(),
+		                     [n_elements](unsigned id) { return id != no_neighbor && id >= n_elements; });
+	}
+	if (!valid)
+	{
+		ERR("BinaryMeshIO: Inconsistent element data.");
+		return false;
+	}
+	return true;
+}
+} // end anonymous namespace
+
+BinaryMeshIO::BinaryMeshIO()
+	: _mesh(nullptr), _compact_mesh(nullptr), _write_topology(true)
+{}
+
+void BinaryMeshIO::setMesh(const MeshLib::Mesh* mesh)
+{
+	_mesh = mesh;
+	_compact_mesh = nullptr;
+}
+
+void BinaryMeshIO::setMesh(const MeshLib::CompactMesh* mesh)
+{
+	_mesh = nullptr;
+	_compact_mesh = mesh;
+}
+
+MeshLib::Mesh* BinaryMeshIO::loadMeshFromFile(std::string const& file_name) const
+{
+	BASELIB_PROFILE_SCOPE("BinaryMeshIO::loadMeshFromFile");
+	INFO("Reading binary mesh ... ");
+
+	MeshData data;
+	if (!readMeshData(file_name, true, data))
+		return nullptr;
+
+	std::size_t const n_nodes (data.header.n_nodes);
+	std::size_t const n_elements (data.header.n_elements);
+	std::vector<MeshLib::Node*> nodes(n_nodes);
+	std::vector<MeshLib::Element*> elements(n_elements);
+
+#ifdef _OPENMP
+	#pragma omp parallel
+#endif
+	{
+#ifdef _OPENMP
+		#pragma omp for schedule(static)
+#endif
+		for (long i = 0; i < static_cast<long>(n_nodes); i++)
+			nodes[i] = new MeshLib::Node(&data.coords[3 * i], i);
+
+#ifdef _OPENMP
+		#pragma omp for schedule(static)
+#endif
+		for (long i = 0; i < static_cast<long>(n_elements); i++)
+		{
+			std::size_t const offset (data.element_offsets[i]);
+			std::size_t const n_element_nodes (data.element_offsets[i + 1] - offset);
+			MeshLib::Node** element_nodes = new MeshLib::Node*[n_element_nodes];
+			for (std::size_t k = 0; k < n_element_nodes; k++)
+				element_nodes[k] = nodes[data.element_node_ids[offset + k]];
+			elements[i] = MeshLib::createElement(data.cell_types[i], element_nodes, data.values[i]);
+			if (!elements[i])
+				delete [] element_nodes;
+		}
+	}
+
+	bool valid (std::find(elements.begin(), elements.end(), nullptr) == elements.end());
+	if (!valid)
+		ERR("BinaryMeshIO: Mesh contains elements not supported by MeshLib::Mesh.");
+
+	bool const has_topology (!data.node_element_offsets.empty());
+	if (valid && has_topology)
+	{
+		std::size_t n_neighbors (0);
+		for (MeshLib::Element const* element : elements)
+			n_neighbors += element->getNNeighbors();
+		valid = n_neighbors == data.neighbor_ids.size();
+		if (!valid)
+			ERR("BinaryMeshIO: Inconsistent element neighbors.");
+	}
+
+	if (!valid)
+	{
+		for (MeshLib::Element* element : elements)
+			delete element;
+		for (MeshLib::Node* node : nodes)
+			delete node;
+		return nullptr;
+	}
+
+	MeshLib::Mesh* mesh (has_topology ?
+		new MeshLib::Mesh(data.name, nodes, elements, data.node_element_offsets,
+		                  data.node_element_ids, data.neighbor_ids, data.header.edge_length) :
+		new MeshLib::Mesh(data.name, nodes, elements));
+
+	INFO("\t... finished.");
+	INFO("Nr. Nodes: %d.", nodes.size());
+	INFO("Nr. Elements: %d.", elements.size());
+	return mesh;
+}
+
+MeshLib::CompactMesh* BinaryMeshIO::loadCompactMeshFromFile(std::string const& file_name) const
+{
+	BASELIB_PROFILE_SCOPE("BinaryMeshIO::loadCompactMeshFromFile");
+	MeshData data;
+	if (!readMeshData(file_name, false, data))
+		return nullptr;
+
+	std::vector<MeshLib::CompactNode> nodes;
+	nodes.reserve(data.header.n_nodes);
+	for (std::size_t i = 0; i < data.coords.size(); i += 3)
+		nodes.emplace_back(&data.coords[i]);
+	std::vector<double>().swap(data.coords);
+
+	return new MeshLib::CompactMesh(data.name, std::move(nodes),
+	                                std::move(data.element_offsets),
+	                                std::move(data.element_node_ids), data.cell_types,
+	                                std::move(data.values));
+}
+
+bool BinaryMeshIO::writeToFile(std::string const& file_name) const
+{
+	if (!_mesh && !_compact_mesh)
+	{
+		ERR("BinaryMeshIO::writeToFile(): No mesh specified.");
+		return false;
+	}
+
+	std::ofstream os(file_name.c_str(), std::ios::binary);
+	if (!os)
+	{
+		ERR("BinaryMeshIO::writeToFile(): Could not open file %s.", file_name.c_str());
+		return false;
+	}
+
+	if (_compact_mesh)
+		return write(*_compact_mesh, false, os);
+	return write(*_mesh, _write_topology, os);
+}
+
+template <typename MESH>
+bool BinaryMeshIO::write(MESH const& mesh, bool write_topology, std::ostream& os) const
+{
+	std::size_t const n_nodes (mesh.getNNodes());
+	std::size_t const n_elements (mesh.getNElements());
+	std::vector<std::uint64_t> element_offsets(n_elements + 1, 0);
+	for (std::size_t i = 0; i < n_elements; i++)
+		element_offsets[i + 1] = element_offsets[i] + getNElementNodes(mesh, i);
+
+	FileHeader header;
+	header.version = format_version;
+	header.flags = write_topology ? topology_flag : 0;
+	header.n_nodes = n_nodes;
+	header.n_elements = n_elements;
+	header.n_element_nodes = element_offsets.back();
+	header.n_node_elements = 0;
+	header.n_neighbors = 0;
+	if (write_topology)
+		getTopologySizes(mesh, header);
+	std::string const name (mesh.getName());
+	header.name_length = name.size();
+	getEdgeLengthRange(mesh, header.edge_length);
+
+	BlockWriter writer(os);
+	writer.writeBytes(magic, sizeof(magic));
+	writer.writeValue(header.version);
+	writer.writeValue(header.flags);
+	writer.writeValue(header.n_nodes);
+	writer.writeValue(header.n_elements);
+	writer.writeValue(header.n_element_nodes);
+	writer.writeValue(header.n_node_elements);
+	writer.writeValue(header.n_neighbors);
+	writer.writeValue(header.name_length);
+	writer.writeValue(header.edge_length[0]);
+	writer.writeValue(header.edge_length[1]);
+	writer.writeBytes(name.data(), name.size());
+	writer.pad();
+
+	writer.writeBlock<double>(3 * n_nodes, [&mesh](std::size_t i) {
+		return getNodeCoord(mesh, i / 3, i % 3);
+	});
+	writer.pad();
+	writer.writeBlock<std::uint8_t>(n_elements, [&mesh](std::size_t i) {
+		return static_cast<std::uint8_t>(getCellType(mesh, i));
+	});
+	writer.pad();
+	writer.writeBlock<std::uint32_t>(n_elements, [&mesh](std::size_t i) {
+		return getElementValue(mesh, i);
+	});
+	writer.pad();
+	writer.writeBlock<std::uint64_t>(n_elements + 1, [&element_offsets](std::size_t i) {
+		return element_offsets[i];
+	});
+	writer.pad();
+	for (std::size_t i = 0; i < n_elements; i++)
+		writer.writeBlock<std::uint32_t>(element_offsets[i + 1] - element_offsets[i],
+			[&mesh, i](std::size_t k) { return getElementNodeID(mesh, i, k); });
+	writer.pad();
+
+	if (write_topology)
+		writeTopology(mesh, writer);
+
+	if (!os)
+	{
+		ERR("BinaryMeshIO::writeToFile(): Error writing the file.");
+		return false;
+	}
+	return true;
+}
+
+}
@@ -0,0 +1,78 @@
+/**
+ * \file
+ * \brief  Definition of the BinaryMeshIO class.
+ *
+ * \copyright
+ * Copyright (c) 2013, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#ifndef BINARYMESHIO_H_
+#define BINARYMESHIO_H_
+
+#include <iosfwd>
+#include <string>
+
+namespace MeshLib {
+	class Mesh;
+	class CompactMesh;
+}
+
+namespace FileIO
+{
+
+/**
+ * \brief Reads and writes meshes in the native binary format (*.bmsh files).
+ *
+ * The format is meant as a cache for meshes that are loaded repeatedly. After
+ * a versioned header the mesh name, the node coordinates, cell types, material
+ * ids, element offsets and the connectivity are stored as contiguous
+ * little-endian blocks, each aligned to 8 bytes. Optionally the elements
+ * connected to the nodes and the element neighbors of a MeshLib::Mesh are
+ * stored as well, such that they need not be computed again when loading.
+ *
+ * The file is mapped into memory for reading (see BaseLib::MemoryMappedFile).
+ */
+class BinaryMeshIO
+{
+public:
+	BinaryMeshIO();
+
+	/// Read mesh from file.
+	MeshLib::Mesh* loadMeshFromFile(std::string const& file_name) const;
+
+	/// Read mesh from file into a compact mesh, the topology tables are ignored.
+	MeshLib::CompactMesh* loadCompactMeshFromFile(std::string const& file_name) const;
+
+	/// Set mesh for writing.
+	void setMesh(const MeshLib::Mesh* mesh);
+
+	/// Set compact mesh for writing, compact meshes are written without the
+	/// topology tables.
+	void setMesh(const MeshLib::CompactMesh* mesh);
+
+	/// Decide if the node-element and element neighbor tables should be
+	/// written (default is true).
+	void setWriteTopology(bool flag = true) { _write_topology = flag; }
+
+	/// Writes the mesh to the given file.
+	/// @return true on success
+	bool writeToFile(std::string const& file_name) const;
+
+private:
+	/// Writes the complete file, the template parameter is MeshLib::Mesh or
+	/// MeshLib::CompactMesh.
+	template <typename MESH>
+	bool write(MESH const& mesh, bool write_topology, std::ostream& os) const;
+
+	MeshLib::Mesh const* _mesh;
+	MeshLib::CompactMesh const* _compact_mesh;
+	bool _write_topology;
+};
+
+}
+
+#endif /* BINARYMESHIO_H_ */
@@ -16,6 +16,9 @@
  * @author Karsten Rink
  */
 
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
 #include <iomanip>
 #include <sstream>
 
@@ -35,9 +38,12 @@
 #include "Elements/Tri.h"
 #include "MeshIO.h"
 #include "Node.h"
+#include "CompactMesh.h"
 
 // BaseLib
 #include "FileTools.h"
+#include "MemoryMappedFile.h"
+#include "Profiler.h"
 #include "StringTools.h"
 
 namespace FileIO
@@ -45,192 +51,298 @@ namespace FileIO
 namespace Legacy {
 
 MeshIO::MeshIO()
-	: _mesh(NULL)
+	: _mesh(NULL), _compact_mesh(NULL)
 {
 }
 
-MeshLib::Mesh* MeshIO::loadMeshFromFile(const std::string& file_name)
+namespace
 {
-	INFO("Reading OGS legacy mesh ... ");
-
-	std::ifstream in (file_name.c_str(),std::ios::in);
-	if (!in.is_open())
-	{
-		WARN("MeshIO::loadMeshFromFile() - Could not open file %s.", file_name.c_str());
-		return nullptr;
-	}
+/// Number of lines parsed by one task.
+const std::size_t chunk_size (4096);
 
-	std::string line_string ("");
-	getline(in, line_string);
+/// Returns the beginning of the next line.
+char const* nextLine(char const* p, char const* end)
+{
+	char const* const eol (static_cast<char const*>(std::memchr(p, '\n', end - p)));
+	return eol ? eol + 1 : end;
+}
 
-	std::vector<MeshLib::Node*> nodes;
-	std::vector<MeshLib::Element*> elements;
+bool lineContains(char const* begin, char const* end, char const* str)
+{
+	return std::search(begin, end, str, str + std::strlen(str)) != end;
+}
 
-	if(line_string.find("#FEM_MSH") != std::string::npos) // OGS mesh file
+/// Skips n_lines lines and stores the beginning of the first line of every
+/// chunk. Returns nullptr if the file has less lines.
+char const* splitIntoChunks(char const* p, char const* end, std::size_t n_lines,
+                            std::vector<char const*> &chunk_begins)
+{
+	chunk_begins.clear();
+	for (std::size_t i = 0; i < n_lines; ++i)
 	{
-		while (!in.eof())
-		{
-			getline(in, line_string);
-
-			// check keywords
-			if (line_string.find("#STOP") != std::string::npos)
-				break;
-			else if (line_string.find("$NODES") != std::string::npos)
-			{
-				double x, y, z, double_dummy;
-				unsigned idx;
-				getline(in, line_string);
-				BaseLib::trim(line_string);
-				unsigned nNodes = atoi(line_string.c_str());
-				std::string s;
-				for (unsigned i = 0; i < nNodes; ++i)
-				{
-					getline(in, line_string);
-					std::stringstream iss(line_string);
-					iss >> idx >> x >> y >> z;
-					MeshLib::Node* node(new MeshLib::Node(x, y, z, idx));
-					nodes.push_back(node);
-					iss >> s;
-					if (s.find("$AREA") != std::string::npos)
-						iss >> double_dummy;
-				}
-			}
-			else if (line_string.find("$ELEMENTS") != std::string::npos)
-			{
-				getline(in, line_string);
-				BaseLib::trim(line_string);
-				unsigned nElements = atoi(line_string.c_str());
-				for (unsigned i = 0; i < nElements; ++i)
-				{
-					getline(in, line_string);
-					elements.push_back(readElement(line_string, nodes));
-				}
-			}
-		}
-
-		if (elements.empty())
-		{
-			ERR ("MeshIO::loadMeshFromFile() - File did not contain element information.");
-			for (auto it = nodes.begin(); it!=nodes.end(); ++it)
-				delete *it;
+		if (p == end)
 			return nullptr;
-		}
+		if (i % chunk_size == 0)
+			chunk_begins.push_back(p);
+		p = nextLine(p, end);
+	}
+	return p;
+}
 
-		MeshLib::Mesh* mesh (new MeshLib::Mesh(BaseLib::extractBaseNameWithoutExtension(
-		                                               file_name), nodes, elements));
+bool isBlank(char c)
+{
+	return c == ' ' || c == '\t' || c == '\r';
+}
 
-		INFO("\t... finished.");
-		INFO("Nr. Nodes: %d.", nodes.size());
-		INFO("Nr. Elements: %d.", elements.size());
+bool parseUnsigned(char const* &p, char const* end, unsigned &value)
+{
+	while (p != end && isBlank(*p))
+		++p;
+	char const* const begin (p);
+	value = 0;
+	for (; p != end && *p >= '0' && *p <= '9'; ++p)
+		value = 10 * value + (*p - '0');
+	return p != begin && (p == end || isBlank(*p) || *p == '\n');
+}
 
-		in.close();
-		return mesh;
+bool parseDouble(char const* &p, char const* end, double &value)
+{
+	while (p != end && isBlank(*p))
+		++p;
+	char const* const begin (p);
+	while (p != end && !isBlank(*p) && *p != '\n')
+		++p;
+	std::size_t const n (p - begin);
+	if (n == 0)
+		return false;
+
+	// copy the token since the mapped file is not null-terminated, only
+	// unusually long tokens are copied into a string
+	char token[64];
+	std::string long_token;
+	char const* str (token);
+	if (n < sizeof(token))
+	{
+		std::copy(begin, p, token);
+		token[n] = '\0';
 	}
 	else
 	{
-		in.close();
-		return nullptr;
+		long_token.assign(begin, p);
+		str = long_token.c_str();
 	}
+	char* token_end;
+	value = std::strtod(str, &token_end);
+	return token_end == str + n;
 }
 
-MeshLib::Element* MeshIO::readElement(const std::string& line,
-                                      const std::vector<MeshLib::Node*> &nodes)
+/// Parses the node line starting at p.
+MeshLib::Node* parseNode(char const* p, char const* end)
 {
-	std::stringstream ss (line);
-	std::string elem_type_str("");
-	MeshElemType elem_type (MeshElemType::INVALID);
-	unsigned index, patch_index;
-	ss >> index >> patch_index;
+	unsigned id;
+	double x, y, z;
+	if (!parseUnsigned(p, end, id) || !parseDouble(p, end, x) || !parseDouble(p, end, y) ||
+	    !parseDouble(p, end, z))
+		return nullptr;
+	return new MeshLib::Node(x, y, z, id);
+}
 
-	do {
-		ss >> elem_type_str;
-		if (ss.fail())
-			return NULL;
-		elem_type = String2MeshElemType(elem_type_str);
-	} while (elem_type == MeshElemType::INVALID);
+/// Parses the element line starting at p.
+MeshLib::Element* parseElement(char const* p, char const* end,
+                               std::vector<MeshLib::Node*> const& nodes)
+{
+	unsigned index, patch_index;
+	if (!parseUnsigned(p, end, index) || !parseUnsigned(p, end, patch_index))
+		return nullptr;
 
-	unsigned* idx = new unsigned[8];
-	MeshLib::Element* elem;
+	// skip optional entries in front of the element type
+	MeshElemType elem_type (MeshElemType::INVALID);
+	while (elem_type == MeshElemType::INVALID)
+	{
+		while (p != end && isBlank(*p))
+			++p;
+		char const* const token (p);
+		while (p != end && !isBlank(*p) && *p != '\n')
+			++p;
+		if (p == token)
+			return nullptr;
+		elem_type = String2MeshElemType(token, p);
+	}
 
-	switch(elem_type)
+	unsigned n_nodes (0);
+	switch (elem_type)
 	{
-	case MeshElemType::LINE: {
-		for (int i = 0; i < 2; ++i)
-			ss >> idx[i];
-		// edge_nodes array will be deleted from Line object
-		MeshLib::Node** edge_nodes = new MeshLib::Node*[2];
-		for (unsigned k(0); k < 2; ++k)
-			edge_nodes[k] = nodes[idx[k]];
-		elem = new MeshLib::Line(edge_nodes, patch_index);
+	case MeshElemType::LINE:
+		n_nodes = 2;
 		break;
-	}
-	case MeshElemType::TRIANGLE: {
-		for (int i = 0; i < 3; ++i)
-			ss >> idx[i];
-		MeshLib::Node** tri_nodes = new MeshLib::Node*[3];
-		for (unsigned k(0); k < 3; ++k)
-			tri_nodes[k] = nodes[idx[k]];
-		elem = new MeshLib::Tri(tri_nodes, patch_index);
+	case MeshElemType::TRIANGLE:
+		n_nodes = 3;
 		break;
-	}
-	case MeshElemType::QUAD: {
-		for (int i = 0; i < 4; ++i)
-			ss >> idx[i];
-		MeshLib::Node** quad_nodes = new MeshLib::Node*[4];
-		for (unsigned k(0); k < 4; ++k)
-			quad_nodes[k] = nodes[idx[k]];
-		elem = new MeshLib::Quad(quad_nodes, patch_index);
+	case MeshElemType::QUAD:
+	case MeshElemType::TETRAHEDRON:
+		n_nodes = 4;
 		break;
-	}
-	case MeshElemType::TETRAHEDRON: {
-		for (int i = 0; i < 4; ++i)
-			ss >> idx[i];
-		MeshLib::Node** tet_nodes = new MeshLib::Node*[4];
-		for (unsigned k(0); k < 4; ++k)
-			tet_nodes[k] = nodes[idx[k]];
-		elem = new MeshLib::Tet(tet_nodes, patch_index);
+	case MeshElemType::PYRAMID:
+		n_nodes = 5;
 		break;
-	}
-	case MeshElemType::HEXAHEDRON: {
-		for (int i = 0; i < 8; ++i)
-			ss >> idx[i];
-		MeshLib::Node** hex_nodes = new MeshLib::Node*[8];
-		for (unsigned k(0); k < 8; ++k)
-			hex_nodes[k] = nodes[idx[k]];
-		elem = new MeshLib::Hex(hex_nodes, patch_index);
+	case MeshElemType::PRISM:
+		n_nodes = 6;
 		break;
-	}
-	case MeshElemType::PYRAMID: {
-		for (int i = 0; i < 5; ++i)
-			ss >> idx[i];
-		MeshLib::Node** pyramid_nodes = new MeshLib::Node*[5];
-		for (unsigned k(0); k < 5; ++k)
-			pyramid_nodes[k] = nodes[idx[k]];
-		elem = new MeshLib::Pyramid(pyramid_nodes, patch_index);
+	case MeshElemType::HEXAHEDRON:
+		n_nodes = 8;
 		break;
+	default:
+		return nullptr;
 	}
-	case MeshElemType::PRISM: {
-		for (int i = 0; i < 6; ++i)
-			ss >> idx[i];
-		MeshLib::Node** prism_nodes = new MeshLib::Node*[6];
-		for (unsigned k(0); k < 6; ++k)
-			prism_nodes[k] = nodes[idx[k]];
-		elem = new MeshLib::Prism(prism_nodes, patch_index);
-		break;
+
+	// the node array will be deleted by the element
+	MeshLib::Node** elem_nodes = new MeshLib::Node*[n_nodes];
+	for (unsigned k(0); k < n_nodes; ++k)
+	{
+		unsigned id;
+		if (!parseUnsigned(p, end, id) || id >= nodes.size())
+		{
+			delete [] elem_nodes;
+			return nullptr;
+		}
+		elem_nodes[k] = nodes[id];
 	}
+
+	switch (elem_type)
+	{
+	case MeshElemType::LINE:
+		return new MeshLib::Line(elem_nodes, patch_index);
+	case MeshElemType::TRIANGLE:
+		return new MeshLib::Tri(elem_nodes, patch_index);
+	case MeshElemType::QUAD:
+		return new MeshLib::Quad(elem_nodes, patch_index);
+	case MeshElemType::TETRAHEDRON:
+		return new MeshLib::Tet(elem_nodes, patch_index);
+	case MeshElemType::HEXAHEDRON:
+		return new MeshLib::Hex(elem_nodes, patch_index);
+	case MeshElemType::PYRAMID:
+		return new MeshLib::Pyramid(elem_nodes, patch_index);
 	default:
-		elem = NULL;
-		break;
+		return new MeshLib::Prism(elem_nodes, patch_index);
+	}
+}
+
+/// Parses the lines of a section in parallel, each chunk of lines is handled
+/// by one task. The parser returns nullptr on error.
+template <typename T, typename PARSER>
+bool parseLines(std::vector<char const*> const& chunk_begins, char const* end,
+                std::vector<T*> &objects, PARSER const& parser)
+{
+	long n_errors (0);
+#ifdef _OPENMP
+	#pragma omp parallel for schedule(dynamic) reduction(+:n_errors)
+#endif
+	for (long c = 0; c < static_cast<long>(chunk_begins.size()); ++c)
+	{
+		char const* p (chunk_begins[c]);
+		std::size_t const chunk_end (std::min((c + 1) * chunk_size, objects.size()));
+		for (std::size_t i = c * chunk_size; i < chunk_end; ++i)
+		{
+			char const* const line_end (nextLine(p, end));
+			objects[i] = parser(p, line_end);
+			if (!objects[i])
+				n_errors++;
+			p = line_end;
+		}
+	}
+	return n_errors == 0;
+}
+} // end anonymous namespace
+
+MeshLib::Mesh* MeshIO::loadMeshFromFile(const std::string& file_name)
+{
+	BASELIB_PROFILE_SCOPE("Legacy::MeshIO::loadMeshFromFile");
+	INFO("Reading OGS legacy mesh ... ");
+
+	BaseLib::MemoryMappedFile const file (file_name);
+	if (!file.isOpen())
+	{
+		WARN("MeshIO::loadMeshFromFile() - Could not open file %s.", file_name.c_str());
+		return nullptr;
 	}
 
-	delete [] idx;
+	char const* const end (file.end());
+	char const* p (nextLine(file.begin(), end));
+	if (!lineContains(file.begin(), p, "#FEM_MSH")) // OGS mesh file
+		return nullptr;
 
-	return elem;
+	std::vector<MeshLib::Node*> nodes;
+	std::vector<MeshLib::Element*> elements;
+	std::vector<char const*> chunk_begins;
+	bool success (true);
+
+	while (success && p != end)
+	{
+		char const* const line_end (nextLine(p, end));
+
+		// check keywords
+		if (lineContains(p, line_end, "#STOP"))
+			break;
+		else if (lineContains(p, line_end, "$NODES") || lineContains(p, line_end, "$ELEMENTS"))
+		{
+			bool const is_node_section (lineContains(p, line_end, "$NODES"));
+			p = line_end;
+			unsigned n (0);
+			char const* const section_begin (nextLine(p, end));
+			parseUnsigned(p, section_begin, n);
+			p = splitIntoChunks(section_begin, end, n, chunk_begins);
+			if (!p)
+			{
+				ERR("MeshIO::loadMeshFromFile() - Unexpected end of file.");
+				success = false;
+			}
+			else if (is_node_section)
+			{
+				nodes.resize(n);
+				success = parseLines(chunk_begins, end, nodes, parseNode);
+			}
+			else
+			{
+				elements.resize(n);
+				success = parseLines(chunk_begins, end, elements,
+					[&nodes](char const* b, char const* e) { return parseElement(b, e, nodes); });
+			}
+			if (!success)
+				ERR("MeshIO::loadMeshFromFile() - Invalid %s section.",
+				    is_node_section ? "$NODES" : "$ELEMENTS");
+		}
+		else
+			p = line_end;
+	}
+
+	if (success && elements.empty())
+	{
+		ERR ("MeshIO::loadMeshFromFile() - File did not contain element information.");
+		success = false;
+	}
+
+	if (!success)
+	{
+		for (auto it = elements.begin(); it!=elements.end(); ++it)
+			delete *it;
+		for (auto it = nodes.begin(); it!=nodes.end(); ++it)
+			delete *it;
+		return nullptr;
+	}
+
+	MeshLib::Mesh* mesh (new MeshLib::Mesh(BaseLib::extractBaseNameWithoutExtension(
+	                                               file_name), nodes, elements));
+
+	INFO("\t... finished.");
+	INFO("Nr. Nodes: %d.", nodes.size());
+	INFO("Nr. Elements: %d.", elements.size());
+
+	return mesh;
 }
 
 bool MeshIO::write()
 {
-	if(!_mesh) {
+	if(!_mesh && !_compact_mesh) {
 		WARN("MeshIO::write(): Cannot write: no mesh object specified.");
 		return false;
 	}
@@ -240,16 +352,28 @@ bool MeshIO::write()
 		<< "  NO_PCS\n"
 		<< "$NODES\n"
 		<< "  ";
-	const size_t n_nodes(_mesh->getNNodes());
-	_out << n_nodes << "\n";
-	for (size_t i(0); i < n_nodes; ++i) {
-		_out << i << " " << *(_mesh->getNode(i)) << "\n";
+	if (_compact_mesh) {
+		const size_t n_nodes(_compact_mesh->getNNodes());
+		_out << n_nodes << "\n";
+		for (size_t i(0); i < n_nodes; ++i) {
+			double const* const coords (_compact_mesh->getNode(i).getCoords());
+			_out << i << " " << coords[0] << " " << coords[1] << " " << coords[2] << " \n";
+		}
+	} else {
+		const size_t n_nodes(_mesh->getNNodes());
+		_out << n_nodes << "\n";
+		for (size_t i(0); i < n_nodes; ++i) {
+			_out << i << " " << *(_mesh->getNode(i)) << "\n";
+		}
 	}
 
 	_out << "$ELEMENTS\n"
 		<< "  ";
 
-	writeElements(_mesh->getElements(), _out);
+	if (_compact_mesh)
+		writeElements(*_compact_mesh, _out);
+	else
+		writeElements(_mesh->getElements(), _out);
 
 	_out << " $LAYER\n"
 		<< "  0\n"
@@ -261,6 +385,13 @@ bool MeshIO::write()
 void MeshIO::setMesh(const MeshLib::Mesh* mesh)
 {
 	_mesh = mesh;
+	_compact_mesh = NULL;
+}
+
+void MeshIO::setMesh(const MeshLib::CompactMesh* mesh)
+{
+	_mesh = NULL;
+	_compact_mesh = mesh;
 }
 
 void MeshIO::writeElements(std::vector<MeshLib::Element*> const& ele_vec,
@@ -278,6 +409,22 @@ void MeshIO::writeElements(std::vector<MeshLib::Element*> const& ele_vec,
 	}
 }
 
+void MeshIO::writeElements(MeshLib::CompactMesh const& mesh,
+                                      std::ostream &out) const
+{
+	const size_t n_elements (mesh.getNElements());
+
+	out << n_elements << "\n";
+	for (size_t i(0); i < n_elements; ++i) {
+		out << i << " " << mesh.getElementValue(i) << " " << this->ElemType2StringOutput(mesh.getElementType(i)) << " ";
+		MeshLib::CompactMesh::NodeIDs const node_ids (mesh.getElementNodeIDs(i));
+		unsigned nElemNodes (mesh.getNElementNodes(i));
+		for(size_t j = 0; j < nElemNodes; ++j)
+			out << node_ids[j] << " ";
+		out << "\n";
+	}
+}
+
 std::string MeshIO::ElemType2StringOutput(const MeshElemType t) const
 {
 	if (t == MeshElemType::LINE)
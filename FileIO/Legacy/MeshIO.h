@@ -27,6 +27,7 @@
 namespace MeshLib
 {
 	class Mesh;
+	class CompactMesh;
 	class Node;
 	class Element;
 }
@@ -45,23 +46,28 @@ public:
 
 	virtual ~MeshIO() {};
 
-	/// Read mesh from file.
+	/// Read mesh from file. The file is mapped into memory, the node and
+	/// element sections are parsed in parallel in chunks of lines.
 	MeshLib::Mesh* loadMeshFromFile(const std::string& fileName);
 
 	/// Set mesh for writing.
 	void setMesh(const MeshLib::Mesh*  mesh);
 
+	/// Set compact mesh for writing.
+	void setMesh(const MeshLib::CompactMesh* mesh);
+
 protected:
 	/// Write mesh to stream.
 	bool write();
 
 private:
 	void writeElements(std::vector<MeshLib::Element*> const& ele_vec, std::ostream &out) const;
-	MeshLib::Element* readElement(const std::string& line, const std::vector<MeshLib::Node*> &nodes);
+	void writeElements(MeshLib::CompactMesh const& mesh, std::ostream &out) const;
 	std::string ElemType2StringOutput(const MeshElemType t) const;
 
 	double* _edge_length[2];
 	const MeshLib::Mesh* _mesh;
+	const MeshLib::CompactMesh* _compact_mesh;
 
 };  /* class */
 
@@ -18,6 +18,7 @@
 
 #include "BoostVtuInterface.h"
 #include "zLibDataCompressor.h"
+#include "XmlIO/VtuMappedReader.h"
 #include <fstream>
 
 #include <boost/foreach.hpp>
@@ -27,6 +28,7 @@
 #include "logog/include/logog.hpp"
 
 #include "FileTools.h"
+#include "Profiler.h"
 #include "StringTools.h"
 
 // MSH
@@ -38,14 +40,68 @@
 #include "Elements/Tet.h"
 #include "Elements/Tri.h"
 #include "Mesh.h"
+#include "CompactMesh.h"
 #include "Node.h"
 
 namespace FileIO
 {
 using namespace boost;
 
+namespace
+{
+// Uniform access to the data of MeshLib::Mesh and MeshLib::CompactMesh used
+// by BoostVtuInterface::buildPropertyTree().
+double const* getNodeCoords(MeshLib::Mesh const& mesh, std::size_t i)
+{
+	return mesh.getNode(i)->getCoords();
+}
+
+double const* getNodeCoords(MeshLib::CompactMesh const& mesh, std::size_t i)
+{
+	return mesh.getNode(i).getCoords();
+}
+
+unsigned getElementValue(MeshLib::Mesh const& mesh, std::size_t i)
+{
+	return mesh.getElement(i)->getValue();
+}
+
+unsigned getElementValue(MeshLib::CompactMesh const& mesh, std::size_t i)
+{
+	return mesh.getElementValue(i);
+}
+
+MeshElemType getElementType(MeshLib::Mesh const& mesh, std::size_t i)
+{
+	return mesh.getElement(i)->getGeomType();
+}
+
+MeshElemType getElementType(MeshLib::CompactMesh const& mesh, std::size_t i)
+{
+	return mesh.getElementType(i);
+}
+
+void writeElementNodeIDs(MeshLib::Mesh const& mesh, std::size_t i,
+	std::ostream &os, unsigned &n_elem_nodes)
+{
+	MeshLib::Element const& element (*mesh.getElement(i));
+	n_elem_nodes = element.getNNodes();
+	for (unsigned j = 0; j < n_elem_nodes; j++)
+		os << element.getNode(j)->getID() << " ";
+}
+
+void writeElementNodeIDs(MeshLib::CompactMesh const& mesh, std::size_t i,
+	std::ostream &os, unsigned &n_elem_nodes)
+{
+	MeshLib::CompactMesh::NodeIDs const node_ids (mesh.getElementNodeIDs(i));
+	n_elem_nodes = mesh.getNElementNodes(i);
+	for (unsigned j = 0; j < n_elem_nodes; j++)
+		os << node_ids[j] << " ";
+}
+}
+
 BoostVtuInterface::BoostVtuInterface() :
-	_mesh(nullptr), _use_compressor(false), _doc()
+	_mesh(nullptr), _compact_mesh(nullptr), _use_compressor(false), _doc()
 {
 }
 
@@ -54,6 +110,7 @@ BoostVtuInterface::~BoostVtuInterface()
 
 MeshLib::Mesh* BoostVtuInterface::readVTUFile(const std::string &file_name)
 {
+	BASELIB_PROFILE_SCOPE("BoostVtuInterface::readVTUFile");
 	std::ifstream in(file_name.c_str());
 	if (in.fail())
 	{
@@ -79,9 +136,9 @@ MeshLib::Mesh* BoostVtuInterface::readVTUFile(const std::string &file_name)
 				return nullptr;
 			}
 
-			// TODO: remove this once compressed data can be handled!!
-			INFO("Handling of compressed meshes not yet implemented.");
-			return nullptr;
+			// the compressed arrays are decoded without the DOM
+			in.close();
+			return VtuMappedReader::readVTUFile(file_name);
 		}
 
 		//skip to <Piece>-tag and start parsing content
@@ -404,9 +461,22 @@ void BoostVtuInterface::setMesh(const MeshLib::Mesh* mesh)
 		return;
 	}
 	this->_mesh = const_cast<MeshLib::Mesh*>(mesh);
-	buildPropertyTree();
+	this->_compact_mesh = nullptr;
+	buildPropertyTree(*_mesh);
 };
 
+void BoostVtuInterface::setMesh(const MeshLib::CompactMesh* mesh)
+{
+	if (!mesh)
+	{
+		ERR("BoostVtuInterface::write(): No mesh specified.");
+		return;
+	}
+	this->_mesh = nullptr;
+	this->_compact_mesh = mesh;
+	buildPropertyTree(*_compact_mesh);
+}
+
 void BoostVtuInterface::addScalarPointProperty(std::string const& name,
 	std::vector<double> const& prop_vals)
 {
@@ -415,8 +485,9 @@ void BoostVtuInterface::addScalarPointProperty(std::string const& name,
 		return;
 	}
 
-	if (_mesh->getNNodes() != prop_vals.size()) {
-		WARN("BoostVtuInterface::addPointProperty(): number of values for propertry %s (%d) does not match the number of nodes (%d)", name.c_str(), prop_vals.size(), _mesh->getNNodes());
+	const std::size_t nNodes (_mesh ? _mesh->getNNodes() : _compact_mesh->getNNodes());
+	if (nNodes != prop_vals.size()) {
+		WARN("BoostVtuInterface::addPointProperty(): number of values for propertry %s (%d) does not match the number of nodes (%d)", name.c_str(), prop_vals.size(), nNodes);
 		return;
 	}
 
@@ -439,13 +510,12 @@ void BoostVtuInterface::addScalarPointProperty(std::string const& name,
 	oss.str(std::string());
 }
 
-void BoostVtuInterface::buildPropertyTree()
+template <typename MESH>
+void BoostVtuInterface::buildPropertyTree(MESH const& mesh)
 {
 	_doc.clear();
-	const std::size_t nNodes (_mesh->getNNodes());
-	const std::size_t nElems (_mesh->getNElements());
-	const std::vector<MeshLib::Node*> &nodes (_mesh->getNodes());
-	const std::vector<MeshLib::Element*> &elements (_mesh->getElements());
+	const std::size_t nNodes (mesh.getNNodes());
+	const std::size_t nElems (mesh.getNElements());
 
 	const std::string data_array_close("\t\t\t\t");
 	const std::string data_array_indent("\t\t\t\t  ");
@@ -476,7 +546,7 @@ void BoostVtuInterface::buildPropertyTree()
 	oss.precision(_out.precision());
 	oss << std::endl << data_array_indent;
 	for (unsigned i = 0; i < nElems; i++)
-		oss << elements[i]->getValue() << " ";
+		oss << getElementValue(mesh, i) << " ";
 	oss << std::endl << data_array_close;
 	this->addDataArray(celldata_node, "MaterialIDs", "Int32", oss.str());
 	oss.str(std::string());
@@ -486,8 +556,11 @@ void BoostVtuInterface::buildPropertyTree()
 	ptree &points_node = piece_node.add("Points", "");
 	oss << std::endl;
 	for (unsigned i = 0; i < nNodes; i++)
-		oss << data_array_indent << (*nodes[i])[0] << " " << (*nodes[i])[1] << " " <<
-		(*nodes[i])[2] << std::endl;
+	{
+		double const* const coords (getNodeCoords(mesh, i));
+		oss << data_array_indent << coords[0] << " " << coords[1] << " " <<
+		coords[2] << std::endl;
+	}
 	oss << data_array_close;
 	this->addDataArray(points_node, "Points", "Float64", oss.str(), 3);
 	oss.str(std::string());
@@ -504,15 +577,13 @@ void BoostVtuInterface::buildPropertyTree()
 	unsigned offset_count(0);
 	for (unsigned i = 0; i < nElems; i++)
 	{
-		MeshLib::Element* element (elements[i]);
-		const unsigned nElemNodes (element->getNNodes());
+		unsigned nElemNodes (0);
 		oss << data_array_indent;
-		for (unsigned j = 0; j < nElemNodes; j++)
-			oss << element->getNode(j)->getID() << " ";
+		writeElementNodeIDs(mesh, i, oss, nElemNodes);
 		oss << std::endl;
 		offset_count += nElemNodes;
 		offstream << offset_count << " ";
-		typestream << this->getVTKElementID(element->getGeomType()) << " ";
+		typestream << this->getVTKElementID(getElementType(mesh, i)) << " ";
 	}
 	oss << data_array_close;
 	offstream << std::endl << data_array_close;
@@ -526,16 +597,17 @@ void BoostVtuInterface::buildPropertyTree()
 
 bool BoostVtuInterface::write()
 {
+	BASELIB_PROFILE_SCOPE("BoostVtuInterface::write");
 	if (_doc.empty()) {
 		ERR("BoostVtuInterface::write(): No mesh specified.");
 		return false;
 	}
-	property_tree::xml_writer_settings<char> settings('\t', 1);
+	auto settings = property_tree::xml_writer_make_settings<std::string>('\t', 1);
 	write_xml(_out, _doc, settings);
 	return true;
 }
 
-unsigned BoostVtuInterface::getVTKElementID(MeshElemType type) const
+unsigned BoostVtuInterface::getVTKElementID(MeshElemType type)
 {
 	switch (type)
 	{
@@ -29,6 +29,7 @@ typedef boost::optional<const boost::property_tree::ptree&> OptionalPtree;
 
 namespace MeshLib {
 	class Mesh;
+	class CompactMesh;
 	class Node;
 	class Element;
 }
@@ -56,22 +57,26 @@ public:
 	/// Set mesh for writing.
 	void setMesh(const MeshLib::Mesh* mesh);
 
+	/// Set compact mesh for writing.
+	void setMesh(const MeshLib::CompactMesh* mesh);
+
 	void addScalarPointProperty(std::string const& name, std::vector<double> const& prop_vals);
 
+	/// Returns the ID used by VTK for a given cell type (e.g. "5" for a triangle, etc.)
+	static unsigned getVTKElementID(MeshElemType type);
+
 private:
 	/** Method builds a tree structure storing the mesh data. This method is called from
-	 * setMesh().
+	 * setMesh(). The template parameter is MeshLib::Mesh or MeshLib::CompactMesh.
 	 */
-	void buildPropertyTree();
+	template <typename MESH>
+	void buildPropertyTree(MESH const& mesh);
 
 	/// Adds a VTK-DataArray of the given name and datatype to the DOM tree and inserts the data-string at that node
 	void addDataArray(boost::property_tree::ptree &parent_node, const std::string &name, const std::string &data_type, const std::string &data, unsigned nComponents = 1);
 
 	bool write();
 
-	/// Returns the ID used by VTK for a given cell type (e.g. "5" for a triangle, etc.)
-	unsigned getVTKElementID(MeshElemType type) const;
-
 	/// Check if the root node really specifies an XML file
 	static bool isVTKFile(const boost::property_tree::ptree &vtk_root);
 
@@ -90,6 +95,7 @@ private:
 	static const OptionalPtree findDataArray(std::string const& array_name, boost::property_tree::ptree const& tree);
 
 	MeshLib::Mesh* _mesh;
+	const MeshLib::CompactMesh* _compact_mesh;
 	bool _use_compressor;
 	boost::property_tree::ptree _doc;
 };
@@ -43,6 +43,11 @@ unsigned long zLibDataCompressor::CompressBuffer(const unsigned char* uncompress
 	return compressedSize;
 }
 
+unsigned long zLibDataCompressor::CompressionSpace(unsigned long uncompressedSize)
+{
+	return compressBound(uncompressedSize);
+}
+
 unsigned long zLibDataCompressor::UncompressBuffer(const unsigned char* compressedData,
                                                    unsigned long compressedSize,
                                                    unsigned char* uncompressedData,
@@ -26,6 +26,10 @@ public:
 	                                    unsigned char* compressedData,
 	                                    unsigned long compressionSpace);
 
+	// Upper bound of the size of the compressed data, i.e. the size of the
+	// buffer passed to CompressBuffer().
+	static unsigned long CompressionSpace(unsigned long uncompressedSize);
+
 	// Decompression method required by vtkDataCompressor.
 	static unsigned long UncompressBuffer(const unsigned char* compressedData,
 	                                      unsigned long compressedSize,
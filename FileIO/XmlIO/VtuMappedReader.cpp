@@ -0,0 +1,755 @@
+/**
+ * \file
+ * \brief  Implementation of the VtuMappedReader class.
+ *
+ * \copyright
+ * Copyright (c) 2013, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#include "VtuMappedReader.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+// ThirdParty/logog
+#include "logog/include/logog.hpp"
+
+// BaseLib
+#include "FileTools.h"
+#include "Endianness.h"
+#include "MemoryMappedFile.h"
+#include "Profiler.h"
+
+#include "Boost/zLibDataCompressor.h"
+
+// MSH
+#include "CompactMesh.h"
+#include "Mesh.h"
+#include "Node.h"
+#include "Elements/Element.h"
+#include "Elements/createElement.h"
+
+namespace FileIO
+{
+
+namespace
+{
+/// A part of the mapped file.
+struct Range
+{
+	char const* begin;
+	char const* end;
+};
+
+/// Attributes of a DataArray tag and the position of its content.
+struct DataArray
+{
+	DataArray() : found(false), n_components(1), offset(0) {}
+
+	bool found;
+	std::string name;
+	std::string type;
+	std::string format;
+	unsigned n_components;
+	std::size_t offset;
+	Range content;
+};
+
+/// The information of the XML header needed for decoding the data arrays.
+struct VtuHeader
+{
+	std::size_t n_points;
+	std::size_t n_cells;
+	unsigned header_size;
+	bool compressed;
+	bool swap_bytes;
+	bool appended_base64;
+	Range appended_data;
+	DataArray points;
+	DataArray connectivity;
+	DataArray offsets;
+	DataArray types;
+	DataArray material_ids;
+};
+
+/// The geometry and topology read from the file.
+struct VtuMeshData
+{
+	std::vector<double> coords;
+	std::vector<std::size_t> offsets;
+	std::vector<unsigned> node_ids;
+	std::vector<CellType> cell_types;
+	std::vector<unsigned> material_ids;
+};
+
+char const* findString(char const* begin, char const* end, char const* str)
+{
+	return std::search(begin, end, str, str + std::strlen(str));
+}
+
+/// Gets the value of an attribute within the text of a tag.
+bool getAttribute(Range const& tag, char const* name, std::string &value)
+{
+	std::size_t const length (std::strlen(name));
+	for (char const* p (findString(tag.begin, tag.end, name)); p != tag.end;
+	     p = findString(p + length, tag.end, name))
+	{
+		if (p == tag.begin || !std::isspace(static_cast<unsigned char>(p[-1])))
+			continue;
+		char const* q (p + length);
+		while (q != tag.end && std::isspace(static_cast<unsigned char>(*q)))
+			++q;
+		if (q == tag.end || *q != '=')
+			continue;
+		do
+			++q;
+		while (q != tag.end && std::isspace(static_cast<unsigned char>(*q)));
+		if (q == tag.end || (*q != '"' && *q != '\''))
+			return false;
+		char const* const value_end (std::find(q + 1, tag.end, *q));
+		value.assign(q + 1, value_end);
+		return true;
+	}
+	return false;
+}
+
+bool getAttribute(Range const& tag, char const* name, std::size_t &value)
+{
+	std::string str;
+	if (!getAttribute(tag, name, str))
+		return false;
+	value = std::strtoul(str.c_str(), nullptr, 10);
+	return true;
+}
+
+/// Scans the XML part of the file, i.e. everything in front of the appended
+/// data.
+bool parseHeader(BaseLib::MemoryMappedFile const& file, VtuHeader &header)
+{
+	header.n_points = 0;
+	header.n_cells = 0;
+	header.header_size = 4;
+	header.compressed = false;
+	header.swap_bytes = false;
+	header.appended_base64 = false;
+	header.appended_data.begin = nullptr;
+	header.appended_data.end = nullptr;
+
+	char const* const header_end (findString(file.begin(), file.end(), "<AppendedData"));
+	if (header_end != file.end())
+	{
+		char const* const tag_end (std::find(header_end, file.end(), '>'));
+		Range const tag = {header_end, tag_end};
+		std::string encoding;
+		if (getAttribute(tag, "encoding", encoding))
+			header.appended_base64 = encoding == "base64";
+		char const* const data_begin (std::find(tag_end, file.end(), '_'));
+		if (data_begin == file.end())
+		{
+			ERR("VtuMappedReader: Missing '_' in front of the appended data.");
+			return false;
+		}
+		header.appended_data.begin = data_begin + 1;
+		header.appended_data.end = file.end();
+	}
+
+	bool is_vtu (false);
+	unsigned n_pieces (0);
+	std::string section;
+	std::string value;
+	for (char const* p (std::find(file.begin(), header_end, '<')); p != header_end;
+	     p = std::find(p, header_end, '<'))
+	{
+		char const* const tag_end (std::find(p, header_end, '>'));
+		if (tag_end == header_end)
+			break;
+		Range const tag = {p + 1, tag_end};
+		p = tag_end + 1;
+
+		bool const is_closing (*tag.begin == '/');
+		std::string const name (tag.begin + is_closing, std::find_if(tag.begin + is_closing, tag.end,
+			[](char c) { return std::isspace(static_cast<unsigned char>(c)) || c == '/'; }));
+		if (is_closing)
+		{
+			if (name == section)
+				section.clear();
+			continue;
+		}
+
+		if (name == "VTKFile")
+		{
+			is_vtu = getAttribute(tag, "type", value) && value == "UnstructuredGrid";
+			if (getAttribute(tag, "byte_order", value))
+				header.swap_bytes = (value == "BigEndian") == BaseLib::isLittleEndian();
+			if (getAttribute(tag, "header_type", value))
+			{
+				if (value == "UInt64")
+					header.header_size = 8;
+				else if (value != "UInt32")
+				{
+					ERR("VtuMappedReader: Unsupported header type %s.", value.c_str());
+					return false;
+				}
+			}
+			if (getAttribute(tag, "compressor", value))
+			{
+				if (value != "vtkZLibDataCompressor")
+				{
+					ERR("VtuMappedReader: Unknown compression method %s.", value.c_str());
+					return false;
+				}
+				header.compressed = true;
+			}
+		}
+		else if (name == "Piece")
+		{
+			if (++n_pieces > 1)
+			{
+				ERR("VtuMappedReader: Only files with one piece are supported.");
+				return false;
+			}
+			getAttribute(tag, "NumberOfPoints", header.n_points);
+			getAttribute(tag, "NumberOfCells", header.n_cells);
+		}
+		else if (name == "Points" || name == "Cells" || name == "CellData" || name == "PointData")
+		{
+			if (tag.end[-1] != '/')
+				section = name;
+		}
+		else if (name == "DataArray")
+		{
+			DataArray array;
+			array.found = true;
+			getAttribute(tag, "Name", array.name);
+			getAttribute(tag, "type", array.type);
+			if (!getAttribute(tag, "format", array.format))
+				array.format = "ascii";
+			std::size_t n_components (1);
+			getAttribute(tag, "NumberOfComponents", n_components);
+			array.n_components = static_cast<unsigned>(n_components);
+			getAttribute(tag, "offset", array.offset);
+			array.content.begin = p;
+			array.content.end = (tag.end[-1] == '/') ? p : std::find(p, header_end, '<');
+
+			if (section == "Points" && !header.points.found)
+				header.points = array;
+			else if (section == "Cells" && array.name == "connectivity")
+				header.connectivity = array;
+			else if (section == "Cells" && array.name == "offsets")
+				header.offsets = array;
+			else if (section == "Cells" && array.name == "types")
+				header.types = array;
+			else if (section == "CellData" && array.name == "MaterialIDs")
+				header.material_ids = array;
+		}
+	}
+
+	if (!is_vtu)
+	{
+		ERR("VtuMappedReader: Not a VTK unstructured grid file.");
+		return false;
+	}
+	return true;
+}
+
+/// Sequential access to the binary data of an array, either raw or base64
+/// encoded.
+class BinaryReader
+{
+public:
+	BinaryReader(char const* begin, char const* end, bool base64)
+		: _pos(begin), _end(end), _base64(base64), _n_remaining(0)
+	{}
+
+	/// Returns a pointer to the next n bytes or nullptr if there are not
+	/// enough data. Raw data are not copied, base64 encoded data are decoded
+	/// into a buffer that is valid until the next call.
+	unsigned char const* get(std::size_t n)
+	{
+		if (!_base64)
+		{
+			if (static_cast<std::size_t>(_end - _pos) < n)
+				return nullptr;
+			unsigned char const* const data (reinterpret_cast<unsigned char const*>(_pos));
+			_pos += n;
+			return data;
+		}
+
+		_buffer.resize(n);
+		return decode(_buffer.data(), n) ? _buffer.data() : nullptr;
+	}
+
+private:
+	/// Decodes n bytes. Segments that are encoded separately, i.e. have their
+	/// own padding, are decoded as one contiguous stream.
+	bool decode(unsigned char* out, std::size_t n)
+	{
+		for (; n > 0 && _n_remaining > 0; --n, --_n_remaining)
+			*out++ = _remaining[3 - _n_remaining];
+
+		while (n >= 3)
+		{
+			unsigned const k (decodeQuad(out));
+			if (k == 0)
+				return false;
+			out += k;
+			n -= k;
+		}
+
+		if (n > 0)
+		{
+			unsigned const k (decodeQuad(_remaining));
+			if (k < n)
+				return false;
+			std::copy(_remaining, _remaining + n, out);
+			// keep the unused bytes at the end of _remaining
+			std::copy_backward(_remaining + n, _remaining + k, _remaining + 3);
+			_n_remaining = k - n;
+		}
+		return true;
+	}
+
+	/// Decodes the next four characters, returns the number of bytes or 0 on
+	/// error.
+	unsigned decodeQuad(unsigned char* out)
+	{
+		static signed char const* const table (getDecodingTable());
+
+		unsigned values[4];
+		unsigned n_padding (0);
+		for (unsigned i = 0; i < 4; ++i)
+		{
+			while (_pos != _end && std::isspace(static_cast<unsigned char>(*_pos)))
+				++_pos;
+			if (_pos == _end)
+				return 0;
+			char const c (*_pos++);
+			if (c == '=')
+			{
+				values[i] = 0;
+				n_padding++;
+				continue;
+			}
+			signed char const v (table[static_cast<unsigned char>(c)]);
+			if (v < 0 || n_padding > 0)
+				return 0;
+			values[i] = v;
+		}
+		if (n_padding > 2)
+			return 0;
+
+		unsigned const bits ((values[0] << 18) | (values[1] << 12) | (values[2] << 6) | values[3]);
+		out[0] = static_cast<unsigned char>(bits >> 16);
+		out[1] = static_cast<unsigned char>(bits >> 8);
+		out[2] = static_cast<unsigned char>(bits);
+		return 3 - n_padding;
+	}
+
+	static signed char const* getDecodingTable()
+	{
+		static signed char table[256];
+		std::fill(table, table + 256, -1);
+		char const* const chars ("ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/");
+		for (unsigned i = 0; i < 64; ++i)
+			table[static_cast<unsigned char>(chars[i])] = static_cast<signed char>(i);
+		return table;
+	}
+
+	char const* _pos;
+	char const* const _end;
+	bool const _base64;
+	unsigned char _remaining[3];
+	unsigned _n_remaining;
+	std::vector<unsigned char> _buffer;
+};
+
+bool readHeaderWord(BinaryReader &reader, VtuHeader const& header, std::uint64_t &value)
+{
+	unsigned char const* const data (reader.get(header.header_size));
+	if (!data)
+		return false;
+	if (header.header_size == 4)
+	{
+		std::uint32_t v;
+		std::memcpy(&v, data, sizeof(v));
+		if (header.swap_bytes)
+			BaseLib::swapBytes(v);
+		value = v;
+	}
+	else
+	{
+		std::memcpy(&value, data, sizeof(value));
+		if (header.swap_bytes)
+			BaseLib::swapBytes(value);
+	}
+	return true;
+}
+
+/// Reads the header and the (possibly compressed) data of a binary array of
+/// n_bytes bytes. Returns a pointer to the uncompressed data, which is either
+/// located in the mapped file or in the given buffer, or nullptr on error.
+unsigned char const* readBinaryData(BinaryReader &reader, VtuHeader const& header,
+                                    std::size_t n_bytes, std::vector<unsigned char> &buffer)
+{
+	if (!header.compressed)
+	{
+		std::uint64_t size;
+		if (!readHeaderWord(reader, header, size))
+			return nullptr;
+		if (size != n_bytes)
+		{
+			ERR("VtuMappedReader: Array has %d bytes, expected %d.", size, n_bytes);
+			return nullptr;
+		}
+		return reader.get(n_bytes);
+	}
+
+	std::uint64_t n_blocks, block_size, last_block_size;
+	if (!readHeaderWord(reader, header, n_blocks) ||
+	    !readHeaderWord(reader, header, block_size) ||
+	    !readHeaderWord(reader, header, last_block_size))
+		return nullptr;
+	std::uint64_t const size ((n_blocks == 0) ? 0 :
+		(n_blocks - 1) * block_size + (last_block_size ? last_block_size : block_size));
+	if (size != n_bytes || (n_blocks > 0 && block_size == 0) || last_block_size > block_size)
+	{
+		ERR("VtuMappedReader: Array has %d bytes, expected %d.", size, n_bytes);
+		return nullptr;
+	}
+
+	// positions of the compressed blocks
+	std::vector<std::size_t> block_offsets(n_blocks + 1, 0);
+	for (std::size_t i = 0; i < n_blocks; i++)
+	{
+		std::uint64_t compressed_size;
+		if (!readHeaderWord(reader, header, compressed_size))
+			return nullptr;
+		block_offsets[i + 1] = block_offsets[i] + compressed_size;
+	}
+	unsigned char const* const compressed_data (reader.get(block_offsets.back()));
+	if (!compressed_data)
+		return nullptr;
+
+	buffer.resize(n_bytes);
+	long n_errors (0);
+#ifdef _OPENMP
+	#pragma omp parallel for schedule(dynamic) reduction(+:n_errors)
+#endif
+	for (long i = 0; i < static_cast<long>(n_blocks); i++)
+	{
+		unsigned long const uncompressed_size (
+			(static_cast<std::uint64_t>(i + 1) == n_blocks && last_block_size) ? last_block_size : block_size);
+		if (zLibDataCompressor::UncompressBuffer(compressed_data + block_offsets[i],
+		                                         block_offsets[i + 1] - block_offsets[i],
+		                                         buffer.data() + i * block_size,
+		                                         uncompressed_size) != uncompressed_size)
+			n_errors++;
+	}
+	if (n_errors > 0)
+	{
+		ERR("VtuMappedReader: Uncompressing %d blocks failed.", n_errors);
+		return nullptr;
+	}
+	return buffer.data();
+}
+
+template <typename SOURCE, typename T>
+void convertValues(unsigned char const* data, std::size_t n, bool swap_bytes, T* values)
+{
+	for (std::size_t i = 0; i < n; i++)
+	{
+		SOURCE v;
+		std::memcpy(&v, data + i * sizeof(SOURCE), sizeof(SOURCE));
+		if (swap_bytes)
+			BaseLib::swapBytes(v);
+		values[i] = static_cast<T>(v);
+	}
+}
+
+/// Size of a value of the given VTK data type in bytes, 0 for unknown types.
+std::size_t getTypeSize(std::string const& type)
+{
+	if (type == "Int8" || type == "UInt8")
+		return 1;
+	if (type == "Int16" || type == "UInt16")
+		return 2;
+	if (type == "Int32" || type == "UInt32" || type == "Float32")
+		return 4;
+	if (type == "Int64" || type == "UInt64" || type == "Float64")
+		return 8;
+	return 0;
+}
+
+template <typename T>
+void convertData(std::string const& type, unsigned char const* data, std::size_t n,
+                 bool swap_bytes, T* values)
+{
+	if (type == "Float64")
+		convertValues<double>(data, n, swap_bytes, values);
+	else if (type == "Float32")
+		convertValues<float>(data, n, swap_bytes, values);
+	else if (type == "Int8")
+		convertValues<std::int8_t>(data, n, swap_bytes, values);
+	else if (type == "UInt8")
+		convertValues<std::uint8_t>(data, n, swap_bytes, values);
+	else if (type == "Int16")
+		convertValues<std::int16_t>(data, n, swap_bytes, values);
+	else if (type == "UInt16")
+		convertValues<std::uint16_t>(data, n, swap_bytes, values);
+	else if (type == "Int32")
+		convertValues<std::int32_t>(data, n, swap_bytes, values);
+	else if (type == "UInt32")
+		convertValues<std::uint32_t>(data, n, swap_bytes, values);
+	else if (type == "Int64")
+		convertValues<std::int64_t>(data, n, swap_bytes, values);
+	else if (type == "UInt64")
+		convertValues<std::uint64_t>(data, n, swap_bytes, values);
+}
+
+template <typename T>
+bool readAsciiData(Range const& content, std::size_t n, T* values)
+{
+	// the content is followed by the closing tag, i.e. strtod() stops there
+	char const* p (content.begin);
+	for (std::size_t i = 0; i < n; i++)
+	{
+		char* next;
+		double const v (std::strtod(p, &next));
+		if (next == p || next > content.end)
+			return false;
+		values[i] = static_cast<T>(v);
+		p = next;
+	}
+	return true;
+}
+
+/// Reads n values of the data array into the given array.
+template <typename T>
+bool readDataArray(VtuHeader const& header, DataArray const& array, std::size_t n, T* values)
+{
+	if (array.format == "ascii")
+		return readAsciiData(array.content, n, values);
+
+	std::size_t const type_size (getTypeSize(array.type));
+	if (type_size == 0)
+	{
+		ERR("VtuMappedReader: Unsupported data type %s.", array.type.c_str());
+		return false;
+	}
+
+	Range data_range (array.content);
+	bool base64 (true);
+	if (array.format == "appended")
+	{
+		if (!header.appended_data.begin ||
+		    array.offset > static_cast<std::size_t>(header.appended_data.end - header.appended_data.begin))
+			return false;
+		data_range.begin = header.appended_data.begin + array.offset;
+		data_range.end = header.appended_data.end;
+		base64 = header.appended_base64;
+	}
+	else if (array.format != "binary")
+	{
+		ERR("VtuMappedReader: Unknown format %s.", array.format.c_str());
+		return false;
+	}
+
+	BinaryReader reader(data_range.begin, data_range.end, base64);
+	std::vector<unsigned char> buffer;
+	unsigned char const* const data (readBinaryData(reader, header, n * type_size, buffer));
+	if (!data)
+		return false;
+	convertData(array.type, data, n, header.swap_bytes, values);
+	return true;
+}
+
+/// Converts a VTK cell type, returns CellType::INVALID for unsupported types.
+CellType getCellType(unsigned vtk_type)
+{
+	switch (vtk_type)
+	{
+	case 3:
+		return CellType::LINE2;
+	case 5:
+		return CellType::TRI3;
+	case 8: // pixel
+	case 9:
+		return CellType::QUAD4;
+	case 10:
+		return CellType::TET4;
+	case 11: // voxel
+	case 12:
+		return CellType::HEX8;
+	case 13:
+		return CellType::PRISM6;
+	case 14:
+		return CellType::PYRAMID5;
+	case 23:
+		return CellType::QUAD8;
+	case 28:
+		return CellType::QUAD9;
+	default:
+		return CellType::INVALID;
+	}
+}
+
+bool readMeshData(std::string const& file_name, VtuMeshData &data)
+{
+	BaseLib::MemoryMappedFile const file(file_name);
+	if (!file.isOpen())
+	{
+		ERR("VtuMappedReader: Can't open file %s.", file_name.c_str());
+		return false;
+	}
+
+	VtuHeader header;
+	if (!parseHeader(file, header))
+		return false;
+
+	std::size_t const n_points (header.n_points);
+	std::size_t const n_cells (header.n_cells);
+	if (n_points == 0 || n_cells == 0)
+	{
+		ERR("VtuMappedReader: Number of nodes is %d, number of elements is %d.", n_points, n_cells);
+		return false;
+	}
+	if (!header.points.found || !header.connectivity.found || !header.offsets.found ||
+	    !header.types.found)
+	{
+		ERR("VtuMappedReader: Points, connectivity, offsets or types array not found.");
+		return false;
+	}
+	if (header.points.n_components != 3)
+	{
+		ERR("VtuMappedReader: Points array has %d components.", header.points.n_components);
+		return false;
+	}
+
+	data.coords.resize(3 * n_points);
+	if (!readDataArray(header, header.points, data.coords.size(), data.coords.data()))
+	{
+		ERR("VtuMappedReader: Could not read the points.");
+		return false;
+	}
+
+	data.offsets.assign(n_cells + 1, 0);
+	if (!readDataArray(header, header.offsets, n_cells, data.offsets.data() + 1) ||
+	    !std::is_sorted(data.offsets.begin(), data.offsets.end()))
+	{
+		ERR("VtuMappedReader: Could not read the offsets.");
+		return false;
+	}
+
+	data.node_ids.resize(data.offsets.back());
+	if (!readDataArray(header, header.connectivity, data.node_ids.size(), data.node_ids.data()))
+	{
+		ERR("VtuMappedReader: Could not read the connectivity.");
+		return false;
+	}
+
+	std::vector<unsigned> vtk_types(n_cells);
+	if (!readDataArray(header, header.types, n_cells, vtk_types.data()))
+	{
+		ERR("VtuMappedReader: Could not read the cell types.");
+		return false;
+	}
+
+	data.material_ids.assign(n_cells, 0);
+	if (!header.material_ids.found)
+	{
+		WARN("VtuMappedReader: MaterialIDs not found, setting every cell to 0.");
+	}
+	else if (!readDataArray(header, header.material_ids, n_cells, data.material_ids.data()))
+	{
+		ERR("VtuMappedReader: Could not read the material ids.");
+		return false;
+	}
+
+	if (std::any_of(data.node_ids.begin(), data.node_ids.end(),
+	                [n_points](unsigned id) { return id >= n_points; }))
+	{
+		ERR("VtuMappedReader: Connectivity contains invalid node ids.");
+		return false;
+	}
+
+	data.cell_types.resize(n_cells);
+	for (std::size_t i = 0; i < n_cells; i++)
+	{
+		data.cell_types[i] = getCellType(vtk_types[i]);
+		unsigned const n_nodes (getNCellTypeNodes(data.cell_types[i]));
+		if (n_nodes == 0 || data.offsets[i + 1] - data.offsets[i] != n_nodes)
+		{
+			ERR("VtuMappedReader: Unsupported cell type %d or wrong number of nodes in cell %d.",
+			    vtk_types[i], i);
+			return false;
+		}
+
+		// pixels and voxels have a different node order than quads and hexahedra
+		unsigned* const ids (data.node_ids.data() + data.offsets[i]);
+		if (vtk_types[i] == 8 || vtk_types[i] == 11)
+			std::swap(ids[2], ids[3]);
+		if (vtk_types[i] == 11)
+			std::swap(ids[6], ids[7]);
+	}
+	return true;
+}
+} // end anonymous namespace
+
+MeshLib::Mesh* VtuMappedReader::readVTUFile(std::string const& file_name)
+{
+	BASELIB_PROFILE_SCOPE("VtuMappedReader::readVTUFile");
+	VtuMeshData data;
+	if (!readMeshData(file_name, data))
+		return nullptr;
+
+	std::size_t const n_nodes (data.coords.size() / 3);
+	std::vector<MeshLib::Node*> nodes(n_nodes);
+	for (std::size_t i = 0; i < n_nodes; i++)
+		nodes[i] = new MeshLib::Node(&data.coords[3 * i], i);
+
+	std::size_t const n_elements (data.cell_types.size());
+	std::vector<MeshLib::Element*> elements(n_elements);
+	for (std::size_t i = 0; i < n_elements; i++)
+	{
+		std::size_t const n_element_nodes (data.offsets[i + 1] - data.offsets[i]);
+		MeshLib::Node** element_nodes = new MeshLib::Node*[n_element_nodes];
+		for (std::size_t k = 0; k < n_element_nodes; k++)
+			element_nodes[k] = nodes[data.node_ids[data.offsets[i] + k]];
+		elements[i] = MeshLib::createElement(data.cell_types[i], element_nodes, data.material_ids[i]);
+	}
+
+	INFO("Reading OGS mesh finished.");
+	INFO("Nr. Nodes: %d", nodes.size());
+	INFO("Nr. Elements: %d", elements.size());
+	return new MeshLib::Mesh(BaseLib::extractBaseNameWithoutExtension(file_name), nodes,
+	                         elements);
+}
+
+MeshLib::CompactMesh* VtuMappedReader::readCompactMesh(std::string const& file_name)
+{
+	BASELIB_PROFILE_SCOPE("VtuMappedReader::readCompactMesh");
+	VtuMeshData data;
+	if (!readMeshData(file_name, data))
+		return nullptr;
+
+	std::vector<MeshLib::CompactNode> nodes;
+	nodes.reserve(data.coords.size() / 3);
+	for (std::size_t i = 0; i < data.coords.size(); i += 3)
+		nodes.emplace_back(&data.coords[i]);
+	std::vector<double>().swap(data.coords);
+
+	return new MeshLib::CompactMesh(BaseLib::extractBaseNameWithoutExtension(file_name),
+	                                std::move(nodes), std::move(data.offsets),
+	                                std::move(data.node_ids), data.cell_types,
+	                                std::move(data.material_ids));
+}
+
+}
@@ -0,0 +1,53 @@
+/**
+ * \file
+ * \brief  Definition of the VtuMappedReader class.
+ *
+ * \copyright
+ * Copyright (c) 2013, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#ifndef VTUMAPPEDREADER_H_
+#define VTUMAPPEDREADER_H_
+
+#include <string>
+
+namespace MeshLib {
+	class Mesh;
+	class CompactMesh;
+}
+
+namespace FileIO
+{
+
+/**
+ * \brief Reads VtkXMLUnstructuredGrid-files (vtu) without building a document.
+ *
+ * The file is mapped into memory (see BaseLib::MemoryMappedFile), only the XML
+ * header is scanned for the tags and attributes needed. The data arrays are
+ * decoded directly from the mapped file into the coordinate and connectivity
+ * arrays. Supported are the formats "ascii", "binary" (base64 encoded) and
+ * "appended" (raw or base64 encoded), with UInt32 or UInt64 headers, both
+ * byte orders and optional compression with vtkZLibDataCompressor. The blocks
+ * of compressed arrays are uncompressed in parallel.
+ *
+ * Besides the geometry and topology only the cell data array "MaterialIDs" is
+ * read; if it is not present all material ids are set to 0.
+ */
+class VtuMappedReader
+{
+public:
+	/// Reads the file into a MeshLib::Mesh. Returns nullptr on error.
+	static MeshLib::Mesh* readVTUFile(std::string const& file_name);
+
+	/// Reads the file into a MeshLib::CompactMesh, i.e. no node and element
+	/// objects are created. Returns nullptr on error.
+	static MeshLib::CompactMesh* readCompactMesh(std::string const& file_name);
+};
+
+}
+
+#endif /* VTUMAPPEDREADER_H_ */
@@ -0,0 +1,420 @@
+/**
+ * \file
+ * \brief  Implementation of the VtuStreamWriter class.
+ *
+ * \copyright
+ * Copyright (c) 2013, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#include "VtuStreamWriter.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+
+// ThirdParty/logog
+#include "logog/include/logog.hpp"
+
+// BaseLib
+#include "Endianness.h"
+#include "Profiler.h"
+
+#include "Boost/BoostVtuInterface.h"
+#include "Boost/zLibDataCompressor.h"
+
+// MSH
+#include "Elements/Element.h"
+#include "CompactMesh.h"
+#include "Mesh.h"
+#include "Node.h"
+
+namespace FileIO
+{
+
+namespace
+{
+// Uniform access to the data of MeshLib::Mesh and MeshLib::CompactMesh.
+double const* getNodeCoords(MeshLib::Mesh const& mesh, std::size_t i)
+{
+	return mesh.getNode(i)->getCoords();
+}
+
+double const* getNodeCoords(MeshLib::CompactMesh const& mesh, std::size_t i)
+{
+	return mesh.getNode(i).getCoords();
+}
+
+unsigned getElementValue(MeshLib::Mesh const& mesh, std::size_t i)
+{
+	return mesh.getElement(i)->getValue();
+}
+
+unsigned getElementValue(MeshLib::CompactMesh const& mesh, std::size_t i)
+{
+	return mesh.getElementValue(i);
+}
+
+MeshElemType getElementType(MeshLib::Mesh const& mesh, std::size_t i)
+{
+	return mesh.getElement(i)->getGeomType();
+}
+
+MeshElemType getElementType(MeshLib::CompactMesh const& mesh, std::size_t i)
+{
+	return mesh.getElementType(i);
+}
+
+unsigned getNElementNodes(MeshLib::Mesh const& mesh, std::size_t i)
+{
+	return mesh.getElement(i)->getNNodes();
+}
+
+unsigned getNElementNodes(MeshLib::CompactMesh const& mesh, std::size_t i)
+{
+	return mesh.getNElementNodes(i);
+}
+
+std::size_t getElementNodeID(MeshLib::Mesh const& mesh, std::size_t i, unsigned j)
+{
+	return mesh.getElement(i)->getNode(j)->getID();
+}
+
+std::size_t getElementNodeID(MeshLib::CompactMesh const& mesh, std::size_t i, unsigned j)
+{
+	return mesh.getElementNodeIDs(i)[j];
+}
+
+/// Number of characters reserved for the offset attributes of the data arrays.
+const std::size_t offset_width (20);
+
+/**
+ * Writes one data array of the appended section, i.e. the header and the
+ * data. Uncompressed data is written as one block preceded by its size.
+ * Compressed data is written in blocks of the given size, the header
+ * containing the number of blocks and their sizes is written at the
+ * beginning and is updated by finish().
+ */
+class AppendedArrayWriter
+{
+public:
+	AppendedArrayWriter(std::ostream& os, bool compress, std::size_t block_size,
+	                    std::uint64_t n_bytes)
+		: _os(os), _compress(compress), _block_size(block_size),
+		  _n_bytes(n_bytes), _header_pos(os.tellp()), _error(false)
+	{
+		if (!_compress)
+		{
+			writeHeaderValue(_n_bytes);
+			_buffer.reserve(std::min<std::uint64_t>(_block_size, _n_bytes) + sizeof(double));
+			return;
+		}
+
+		_n_blocks = _n_bytes / _block_size + (_n_bytes % _block_size ? 1 : 0);
+		for (std::uint64_t i = 0; i < _n_blocks + 3; i++)
+			writeHeaderValue(0);
+		_compressed_sizes.reserve(_n_blocks);
+		_buffer.reserve(_block_size + sizeof(double));
+		_compressed.resize(zLibDataCompressor::CompressionSpace(_block_size));
+	}
+
+	template <typename T>
+	void put(T const value)
+	{
+		char const* const bytes (reinterpret_cast<char const*>(&value));
+		_buffer.insert(_buffer.end(), bytes, bytes + sizeof(T));
+		if (_buffer.size() >= _block_size)
+			flush();
+	}
+
+	/// Writes the remaining data and the header of compressed data.
+	/// @return false if an error occurred
+	bool finish()
+	{
+		if (!_buffer.empty())
+			writeBlock(_buffer.size());
+
+		if (_compress)
+		{
+			if (_compressed_sizes.size() != _n_blocks)
+				_error = true;
+			std::streampos const end_pos (_os.tellp());
+			_os.seekp(_header_pos);
+			writeHeaderValue(_n_blocks);
+			writeHeaderValue(_block_size);
+			writeHeaderValue(_n_bytes % _block_size);
+			for (std::uint64_t size : _compressed_sizes)
+				writeHeaderValue(size);
+			_os.seekp(end_pos);
+		}
+		return !_error && _os.good();
+	}
+
+private:
+	void writeHeaderValue(std::uint64_t value)
+	{
+		_os.write(reinterpret_cast<char const*>(&value), sizeof(value));
+	}
+
+	/// Writes all complete blocks and keeps the remaining bytes.
+	void flush()
+	{
+		std::size_t n_written (0);
+		while (_buffer.size() - n_written >= _block_size)
+		{
+			writeBlock(n_written, _block_size);
+			n_written += _block_size;
+		}
+		_buffer.erase(_buffer.begin(), _buffer.begin() + n_written);
+	}
+
+	void writeBlock(std::size_t size)
+	{
+		writeBlock(0, size);
+		_buffer.clear();
+	}
+
+	void writeBlock(std::size_t begin, std::size_t size)
+	{
+		if (!_compress)
+		{
+			_os.write(_buffer.data() + begin, size);
+			return;
+		}
+
+		unsigned long const compressed_size (zLibDataCompressor::CompressBuffer(
+			reinterpret_cast<unsigned char const*>(_buffer.data() + begin), size,
+			_compressed.data(), _compressed.size()));
+		if (compressed_size == 0)
+			_error = true;
+		_os.write(reinterpret_cast<char const*>(_compressed.data()), compressed_size);
+		_compressed_sizes.push_back(compressed_size);
+	}
+
+	std::ostream& _os;
+	bool const _compress;
+	std::size_t const _block_size;
+	std::uint64_t const _n_bytes;
+	std::uint64_t _n_blocks;
+	std::streampos const _header_pos;
+	bool _error;
+	std::vector<char> _buffer;
+	std::vector<unsigned char> _compressed;
+	std::vector<std::uint64_t> _compressed_sizes;
+};
+}
+
+VtuStreamWriter::VtuStreamWriter(bool compress, std::size_t block_size) :
+	_mesh(nullptr), _compact_mesh(nullptr), _compress(compress),
+	_block_size(std::max<std::size_t>(block_size, sizeof(double)))
+{}
+
+void VtuStreamWriter::setMesh(const MeshLib::Mesh* mesh)
+{
+	_mesh = mesh;
+	_compact_mesh = nullptr;
+}
+
+void VtuStreamWriter::setMesh(const MeshLib::CompactMesh* mesh)
+{
+	_mesh = nullptr;
+	_compact_mesh = mesh;
+}
+
+void VtuStreamWriter::addPointProperty(std::string const& name,
+	std::vector<double> const& values, unsigned n_components)
+{
+	_point_properties.push_back(Property{name, &values, n_components});
+}
+
+void VtuStreamWriter::addCellProperty(std::string const& name,
+	std::vector<double> const& values, unsigned n_components)
+{
+	_cell_properties.push_back(Property{name, &values, n_components});
+}
+
+bool VtuStreamWriter::writeToFile(std::string const& file_name) const
+{
+	BASELIB_PROFILE_SCOPE("VtuStreamWriter::writeToFile");
+	if (!_mesh && !_compact_mesh)
+	{
+		ERR("VtuStreamWriter::writeToFile(): No mesh specified.");
+		return false;
+	}
+
+	std::ofstream os(file_name.c_str(), std::ios::binary);
+	if (!os)
+	{
+		ERR("VtuStreamWriter::writeToFile(): Could not open file %s.", file_name.c_str());
+		return false;
+	}
+
+	if (_mesh)
+		return write(*_mesh, os);
+	return write(*_compact_mesh, os);
+}
+
+template <typename MESH>
+bool VtuStreamWriter::write(MESH const& mesh, std::ostream& os) const
+{
+	const std::size_t nNodes (mesh.getNNodes());
+	const std::size_t nElems (mesh.getNElements());
+
+	for (Property const& p : _point_properties)
+		if (p.values->size() != nNodes * p.n_components)
+		{
+			ERR("VtuStreamWriter::write(): number of values for property %s (%d) does not match the number of nodes (%d).",
+			    p.name.c_str(), p.values->size(), nNodes);
+			return false;
+		}
+	for (Property const& p : _cell_properties)
+		if (p.values->size() != nElems * p.n_components)
+		{
+			ERR("VtuStreamWriter::write(): number of values for property %s (%d) does not match the number of elements (%d).",
+			    p.name.c_str(), p.values->size(), nElems);
+			return false;
+		}
+
+	std::uint64_t nConnectivity (0);
+	for (std::size_t i = 0; i < nElems; i++)
+		nConnectivity += getNElementNodes(mesh, i);
+
+	// XML header, the offsets of the data arrays are set after writing the data
+	std::vector<std::streampos> offset_positions;
+	auto const writeDataArrayTag = [&os, &offset_positions](std::string const& type,
+		std::string const& name, unsigned n_components)
+	{
+		os << "\t\t\t\t<DataArray type=\"" << type << "\" Name=\"" << name << "\"";
+		if (n_components > 1)
+			os << " NumberOfComponents=\"" << n_components << "\"";
+		os << " format=\"appended\" offset=\"";
+		offset_positions.push_back(os.tellp());
+		os << std::string(offset_width, ' ') << "\"/>\n";
+	};
+
+	os << "<?xml version=\"1.0\"?>\n";
+	os << "<VTKFile type=\"UnstructuredGrid\" version=\"1.0\" byte_order=\""
+	   << (BaseLib::isLittleEndian() ? "LittleEndian" : "BigEndian") << "\" header_type=\"UInt64\"";
+	if (_compress)
+		os << " compressor=\"vtkZLibDataCompressor\"";
+	os << ">\n";
+	os << "\t<UnstructuredGrid>\n";
+	os << "\t\t<Piece NumberOfPoints=\"" << nNodes << "\" NumberOfCells=\"" << nElems << "\">\n";
+	os << "\t\t\t<PointData>\n";
+	for (Property const& p : _point_properties)
+		writeDataArrayTag("Float64", p.name, p.n_components);
+	os << "\t\t\t</PointData>\n";
+	os << "\t\t\t<CellData Scalars=\"MaterialIDs\">\n";
+	writeDataArrayTag("Int32", "MaterialIDs", 1);
+	for (Property const& p : _cell_properties)
+		writeDataArrayTag("Float64", p.name, p.n_components);
+	os << "\t\t\t</CellData>\n";
+	os << "\t\t\t<Points>\n";
+	writeDataArrayTag("Float64", "Points", 3);
+	os << "\t\t\t</Points>\n";
+	os << "\t\t\t<Cells>\n";
+	writeDataArrayTag("Int64", "connectivity", 1);
+	writeDataArrayTag("Int64", "offsets", 1);
+	writeDataArrayTag("UInt8", "types", 1);
+	os << "\t\t\t</Cells>\n";
+	os << "\t\t</Piece>\n";
+	os << "\t</UnstructuredGrid>\n";
+	os << "\t<AppendedData encoding=\"raw\">\n\t\t_";
+
+	// appended data in the same order as the data array tags
+	std::streampos const data_begin (os.tellp());
+	std::vector<std::uint64_t> offsets;
+	bool success (true);
+
+	auto const writeProperty = [&](Property const& p)
+	{
+		offsets.push_back(os.tellp() - data_begin);
+		AppendedArrayWriter array(os, _compress, _block_size, p.values->size() * sizeof(double));
+		for (double v : *p.values)
+			array.put(v);
+		success = array.finish() && success;
+	};
+
+	for (Property const& p : _point_properties)
+		writeProperty(p);
+
+	{
+		offsets.push_back(os.tellp() - data_begin);
+		AppendedArrayWriter array(os, _compress, _block_size, nElems * sizeof(std::int32_t));
+		for (std::size_t i = 0; i < nElems; i++)
+			array.put(static_cast<std::int32_t>(getElementValue(mesh, i)));
+		success = array.finish() && success;
+	}
+
+	for (Property const& p : _cell_properties)
+		writeProperty(p);
+
+	{
+		offsets.push_back(os.tellp() - data_begin);
+		AppendedArrayWriter array(os, _compress, _block_size, 3 * nNodes * sizeof(double));
+		for (std::size_t i = 0; i < nNodes; i++)
+		{
+			double const* const coords (getNodeCoords(mesh, i));
+			array.put(coords[0]);
+			array.put(coords[1]);
+			array.put(coords[2]);
+		}
+		success = array.finish() && success;
+	}
+
+	{
+		offsets.push_back(os.tellp() - data_begin);
+		AppendedArrayWriter array(os, _compress, _block_size, nConnectivity * sizeof(std::int64_t));
+		for (std::size_t i = 0; i < nElems; i++)
+		{
+			const unsigned nElemNodes (getNElementNodes(mesh, i));
+			for (unsigned j = 0; j < nElemNodes; j++)
+				array.put(static_cast<std::int64_t>(getElementNodeID(mesh, i, j)));
+		}
+		success = array.finish() && success;
+	}
+
+	{
+		offsets.push_back(os.tellp() - data_begin);
+		AppendedArrayWriter array(os, _compress, _block_size, nElems * sizeof(std::int64_t));
+		std::int64_t offset_count (0);
+		for (std::size_t i = 0; i < nElems; i++)
+		{
+			offset_count += getNElementNodes(mesh, i);
+			array.put(offset_count);
+		}
+		success = array.finish() && success;
+	}
+
+	{
+		offsets.push_back(os.tellp() - data_begin);
+		AppendedArrayWriter array(os, _compress, _block_size, nElems * sizeof(std::uint8_t));
+		for (std::size_t i = 0; i < nElems; i++)
+			array.put(static_cast<std::uint8_t>(
+				BoostVtuInterface::getVTKElementID(getElementType(mesh, i))));
+		success = array.finish() && success;
+	}
+
+	os << "\n\t</AppendedData>\n";
+	os << "</VTKFile>\n";
+
+	// set the offsets in the header
+	for (std::size_t i = 0; i < offsets.size(); i++)
+	{
+		os.seekp(offset_positions[i]);
+		os << std::setw(offset_width) << offsets[i];
+	}
+
+	if (!success || !os.good())
+	{
+		ERR("VtuStreamWriter::write(): Error while writing the data arrays.");
+		return false;
+	}
+	return true;
+}
+
+} // end namespace FileIO
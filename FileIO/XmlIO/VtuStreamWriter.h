@@ -0,0 +1,93 @@
+/**
+ * \file
+ * \brief  Definition of the VtuStreamWriter class.
+ *
+ * \copyright
+ * Copyright (c) 2013, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#ifndef VTUSTREAMWRITER_H_
+#define VTUSTREAMWRITER_H_
+
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace MeshLib {
+	class Mesh;
+	class CompactMesh;
+}
+
+namespace FileIO
+{
+
+/**
+ * \brief Writes VtkXMLUnstructuredGrid-files (vtu) with the data arrays in
+ * the appended section in raw binary format.
+ *
+ * In contrast to BoostVtuInterface no document is built in memory: the XML
+ * header is written first with placeholders for the offsets of the data
+ * arrays, afterwards the arrays are streamed block wise into the file and the
+ * offsets are set at the end. Hence, the memory needed in addition to the
+ * mesh is one block. Optionally the blocks are compressed with
+ * zLibDataCompressor (vtkZLibDataCompressor format).
+ *
+ * The property arrays are not copied, the vectors have to be valid until the
+ * file is written.
+ */
+class VtuStreamWriter
+{
+public:
+	/**
+	 * @param compress   compress the data arrays block wise with zlib
+	 * @param block_size size of the (uncompressed) blocks in bytes
+	 */
+	explicit VtuStreamWriter(bool compress = false, std::size_t block_size = 1 << 16);
+
+	/// Set mesh for writing.
+	void setMesh(const MeshLib::Mesh* mesh);
+
+	/// Set compact mesh for writing.
+	void setMesh(const MeshLib::CompactMesh* mesh);
+
+	/// Adds a point data array with n_components values per mesh node.
+	void addPointProperty(std::string const& name, std::vector<double> const& values,
+	                      unsigned n_components = 1);
+
+	/// Adds a cell data array with n_components values per mesh element.
+	void addCellProperty(std::string const& name, std::vector<double> const& values,
+	                     unsigned n_components = 1);
+
+	/// Writes the mesh and the properties to the given file.
+	/// @return true on success
+	bool writeToFile(std::string const& file_name) const;
+
+private:
+	struct Property
+	{
+		std::string name;
+		std::vector<double> const* values;
+		unsigned n_components;
+	};
+
+	/// Writes the complete file, the template parameter is MeshLib::Mesh or
+	/// MeshLib::CompactMesh.
+	template <typename MESH>
+	bool write(MESH const& mesh, std::ostream& os) const;
+
+	MeshLib::Mesh const* _mesh;
+	MeshLib::CompactMesh const* _compact_mesh;
+	bool const _compress;
+	std::size_t const _block_size;
+	std::vector<Property> _point_properties;
+	std::vector<Property> _cell_properties;
+};
+
+}
+
+#endif /* VTUSTREAMWRITER_H_ */
@@ -20,28 +20,37 @@
 
 // BaseLib
 #include "FileTools.h"
+#include "Profiler.h"
 #include "StringTools.h"
 
 // MeshLib
 #include "Mesh.h"
 
 // FileIO
+#include "BinaryMeshIO.h"
 #include "Legacy/MeshIO.h"
-#include "XmlIO/Boost/BoostVtuInterface.h"
+#include "XmlIO/VtuMappedReader.h"
 #include "readMeshFromFile.h"
 
 namespace FileIO
 {
 MeshLib::Mesh* readMeshFromFile(const std::string &file_name)
 {
+	BASELIB_PROFILE_SCOPE("readMeshFromFile");
 	if (BaseLib::hasFileExtension("msh", file_name))
 	{
 		Legacy::MeshIO meshIO;
 		return meshIO.loadMeshFromFile(file_name);
 	}
 
+	if (BaseLib::hasFileExtension("bmsh", file_name))
+	{
+		BinaryMeshIO meshIO;
+		return meshIO.loadMeshFromFile(file_name);
+	}
+
 	if (BaseLib::hasFileExtension("vtu", file_name))
-		return BoostVtuInterface::readVTUFile(file_name);
+		return VtuMappedReader::readVTUFile(file_name);
 
 	ERR("readMeshFromFile(): Unknown mesh file format in file %s.", file_name.c_str());
 	return nullptr;
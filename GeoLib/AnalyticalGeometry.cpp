@@ -218,24 +218,26 @@ double getOrientedTriArea(GeoLib::Point const& a, GeoLib::Point const& b, GeoLib
 	return 0.5 * sqrt(MathLib::scalarProduct(w, w));
 }
 
+/// Returns six times the signed volume of the tetrahedron a, b, c, d, i.e. the
+/// determinant of the matrix (b-a, c-a, d-a).
+static
+double getOrientedTetVolume6(GeoLib::Point const& a, GeoLib::Point const& b,
+                             GeoLib::Point const& c, GeoLib::Point const& d)
+{
+	const double u[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+	const double v[3] = { c[0] - a[0], c[1] - a[1], c[2] - a[2] };
+	const double w[3] = { d[0] - a[0], d[1] - a[1], d[2] - a[2] };
+	return u[0] * (v[1] * w[2] - v[2] * w[1])
+	       - u[1] * (v[0] * w[2] - v[2] * w[0])
+	       + u[2] * (v[0] * w[1] - v[1] * w[0]);
+}
+
 bool isPointInTriangle(GeoLib::Point const& p, GeoLib::Point const& a, GeoLib::Point const& b,
                        GeoLib::Point const& c, double eps)
 {
-	const unsigned dim(3);
-	MathLib::DenseMatrix<double> m(dim, dim);
-	for (unsigned i(0); i < dim; i++)
-		m(i, 0) = b[i] - a[i];
-	for (unsigned i(0); i < dim; i++)
-		m(i, 1) = c[i] - a[i];
-	for (unsigned i(0); i < dim; i++)
-		m(i, 2) = p[i] - a[i];
-
 	// point p is in the same plane as the triangle if and only if
-	// the following determinate of the 3x3 matrix equals zero (up to an eps)
-	double det3x3(m(0, 0) * (m(1, 1) * m(2, 2) - m(2, 1) * m(1, 2))
-	              - m(1, 0) * (m(2, 1) * m(0, 2) - m(0, 1) * m(2, 2))
-	              + m(2, 0) * (m(0, 1) * m(1, 2) - m(1, 1) * m(0, 2)));
-	if (fabs(det3x3) > eps)
+	// the determinate of the 3x3 matrix (b-a, c-a, p-a) equals zero (up to an eps)
+	if (fabs(getOrientedTetVolume6(a, b, c, p)) > eps)
 		return false;
 
 	double total_area(getOrientedTriArea(a, b, c));
@@ -248,6 +250,23 @@ bool isPointInTriangle(GeoLib::Point const& p, GeoLib::Point const& a, GeoLib::P
 	return false;
 }
 
+bool isPointInTetrahedron(GeoLib::Point const& p, GeoLib::Point const& a, GeoLib::Point const& b,
+                          GeoLib::Point const& c, GeoLib::Point const& d, double eps)
+{
+	const double vol(getOrientedTetVolume6(a, b, c, d));
+	if (fabs(vol) < std::numeric_limits<double>::min())
+		return false;
+
+	// barycentric coordinates of p
+	const double lambda[4] = {
+		getOrientedTetVolume6(p, b, c, d) / vol,
+		getOrientedTetVolume6(a, p, c, d) / vol,
+		getOrientedTetVolume6(a, b, p, d) / vol,
+		getOrientedTetVolume6(a, b, c, p) / vol
+	};
+	return std::all_of(lambda, lambda + 4, [eps](double l) { return l >= -eps; });
+}
+
 // NewellPlane from book Real-Time Collision detection p. 494
 void getNewellPlane(const std::vector<GeoLib::Point*>& pnts, MathLib::Vector3 &plane_normal, double& d)
 {
@@ -105,6 +105,16 @@ bool isPointInTriangle(GeoLib::Point const& p,
 				GeoLib::Point const& a, GeoLib::Point const& b, GeoLib::Point const& c,
 				double eps = std::numeric_limits<double>::epsilon());
 
+/**
+ * Tests if the point p is located in the tetrahedron given by the points
+ * a, b, c and d. The point is inside if all barycentric coordinates of the point
+ * are greater or equal than -eps.
+ * @return false for degenerated tetrahedra
+ */
+bool isPointInTetrahedron(GeoLib::Point const& p,
+				GeoLib::Point const& a, GeoLib::Point const& b, GeoLib::Point const& c,
+				GeoLib::Point const& d, double eps = std::numeric_limits<double>::epsilon());
+
 /**
  * test for intersections of the line segments of the Polyline
  * @param ply the polyline
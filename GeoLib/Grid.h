@@ -15,6 +15,9 @@
 #ifndef GRID_H_
 #define GRID_H_
 
+#include <algorithm>
+#include <limits>
+#include <utility>
 #include <vector>
 
 // ThirdParty/logog
@@ -256,25 +259,59 @@ public:
 
 		double len (sqrt(MathLib::sqrDist(pnt.getCoords(), nearest_pnt->getCoords())));
 		// search all other grid cells within the cube with the edge nodes
-		std::vector<std::vector<POINT*> const*> vecs_of_pnts;
-		getPntVecsOfGridCellsIntersectingCube(pnt, len, vecs_of_pnts);
-
-		const std::size_t n_vecs(vecs_of_pnts.size());
-		for (std::size_t j(0); j<n_vecs; j++) {
-			std::vector<POINT*> const& pnts(*(vecs_of_pnts[j]));
-			const std::size_t n_pnts(pnts.size());
-			for (std::size_t k(0); k<n_pnts; k++) {
-				const double sqr_dist (MathLib::sqrDist(pnt.getCoords(), pnts[k]->getCoords()));
+		double const* const c(pnt.getCoords());
+		double const min_pnt[3] = { c[0] - len, c[1] - len, c[2] - len };
+		double const max_pnt[3] = { c[0] + len, c[1] + len, c[2] + len };
+		forEachPointInCuboid(min_pnt, max_pnt, [&](POINT* p)
+			{
+				const double sqr_dist (MathLib::sqrDist(c, p->getCoords()));
 				if (sqr_dist < sqr_min_dist) {
 					sqr_min_dist = sqr_dist;
-					nearest_pnt = pnts[k];
+					nearest_pnt = p;
 				}
-			}
-		}
+			});
 
 		return nearest_pnt;
 	}
 
+	/**
+	 * Batch version of getNearestPoint(). The queries are sorted by the grid
+	 * cells containing the query points, such that consecutive queries access
+	 * the same grid cells, and are processed in parallel if OpenMP is enabled.
+	 * @param coords coordinates of the query points, x, y, z of the i-th point
+	 * at positions 3i, 3i+1, 3i+2
+	 * @param n_pnts number of query points
+	 * @param nearest_pnts (output) the nearest point for each query point
+	 */
+	void getNearestPoints(double const* coords, std::size_t n_pnts,
+	                      std::vector<POINT*> &nearest_pnts) const;
+
+	/**
+	 * Searches the k points with the smallest distances to the given point.
+	 * The grid cells are visited in layers around the cell of the point until
+	 * no unvisited cell can contain a point nearer than the k-th nearest
+	 * point found so far.
+	 * @param pnt the query point
+	 * @param k the number of points searched for
+	 * @param nearest_pnts (output) the min(k, number of points) nearest points
+	 * sorted by increasing distance; the vector is reused, i.e. if it has
+	 * enough capacity no memory is allocated
+	 */
+	void getKNearestPoints(POINT const& pnt, std::size_t k,
+	                       std::vector<POINT*> &nearest_pnts) const;
+
+	/**
+	 * Searches all points with a distance to the given point not greater than
+	 * the given radius.
+	 * @param pnt the query point
+	 * @param radius the search radius
+	 * @param pnts (output) the points within the radius in no particular order;
+	 * the vector is reused, i.e. if it has enough capacity no memory is
+	 * allocated
+	 */
+	void getPointsInRadius(POINT const& pnt, double radius,
+	                       std::vector<POINT*> &pnts) const;
+
 	/**
 	 * Method fetches the vectors of all grid cells intersecting the axis aligned cuboid
 	 * defined by two points. The first point with minimal coordinates in all directions.
@@ -307,7 +344,16 @@ private:
 	 * @param pnt (input) the coordinates of the point
 	 * @param coords (output) the coordinates of the grid cell
 	 */
-	inline void getGridCoords(POINT const& pnt, std::size_t* coords) const;
+	template <typename P>
+	inline void getGridCoords(P const& pnt, std::size_t* coords) const;
+
+	/**
+	 * Calls f(p) for every point p within the grid cells intersecting the
+	 * axis aligned cuboid given by the coordinates of the minimal and maximal
+	 * corner points.
+	 */
+	template <typename F>
+	void forEachPointInCuboid(double const* min_pnt, double const* max_pnt, F const& f) const;
 
 	/**
 	 *
@@ -427,6 +473,150 @@ void Grid<POINT>::getPntVecsOfGridCellsIntersectingCuboid(POINT const& min_pnt,
 	}
 }
 
+template <typename POINT>
+template <typename F>
+void Grid<POINT>::forEachPointInCuboid(double const* min_pnt, double const* max_pnt,
+                                       F const& f) const
+{
+	std::size_t min_coords[3];
+	getGridCoords(min_pnt, min_coords);
+	std::size_t max_coords[3];
+	getGridCoords(max_pnt, max_coords);
+
+	const std::size_t steps0_x_steps1(_n_steps[0] * _n_steps[1]);
+	for (std::size_t k(min_coords[2]); k < max_coords[2] + 1; k++) {
+		for (std::size_t j(min_coords[1]); j < max_coords[1] + 1; j++) {
+			const std::size_t offset(j * _n_steps[0] + k * steps0_x_steps1);
+			for (std::size_t i(min_coords[0]); i < max_coords[0] + 1; i++) {
+				std::vector<POINT*> const& pnts(_grid_cell_nodes_map[offset + i]);
+				for (std::size_t l(0); l < pnts.size(); l++)
+					f(pnts[l]);
+			}
+		}
+	}
+}
+
+template <typename POINT>
+void Grid<POINT>::getNearestPoints(double const* coords, std::size_t n_pnts,
+                                   std::vector<POINT*> &nearest_pnts) const
+{
+	nearest_pnts.resize(n_pnts);
+
+	// sort the queries by grid cell index
+	std::vector<std::pair<std::size_t, std::size_t>> cell_queries(n_pnts);
+	const std::size_t steps0_x_steps1(_n_steps[0] * _n_steps[1]);
+	for (std::size_t i(0); i < n_pnts; i++) {
+		std::size_t cell_coords[3];
+		getGridCoords(coords + 3*i, cell_coords);
+		cell_queries[i].first = cell_coords[0] + cell_coords[1] * _n_steps[0]
+		                        + cell_coords[2] * steps0_x_steps1;
+		cell_queries[i].second = i;
+	}
+	std::sort(cell_queries.begin(), cell_queries.end());
+
+	const long n_queries(n_pnts);
+#ifdef _OPENMP
+	#pragma omp parallel for schedule(static)
+#endif
+	for (long i = 0; i < n_queries; i++) {
+		std::size_t const query(cell_queries[i].second);
+		nearest_pnts[query] = getNearestPoint(POINT(coords + 3*query));
+	}
+}
+
+template <typename POINT>
+void Grid<POINT>::getKNearestPoints(POINT const& pnt, std::size_t k,
+                                    std::vector<POINT*> &nearest_pnts) const
+{
+	nearest_pnts.clear();
+	if (k == 0)
+		return;
+
+	double const* const c(pnt.getCoords());
+	// max-heap with respect to the distance to the query point
+	auto const is_nearer = [c](POINT const* a, POINT const* b)
+		{
+			return MathLib::sqrDist(a->getCoords(), c) < MathLib::sqrDist(b->getCoords(), c);
+		};
+
+	std::size_t center[3];
+	getGridCoords(pnt, center);
+
+	for (std::size_t layer(0); ; layer++) {
+		// index range of the cube of cells with the given layer around center
+		std::size_t min_coords[3], max_coords[3];
+		bool covers_grid(true);
+		for (std::size_t d(0); d < 3; d++) {
+			min_coords[d] = (center[d] < layer) ? 0 : center[d] - layer;
+			max_coords[d] = std::min(center[d] + layer, _n_steps[d] - 1);
+			if (min_coords[d] > 0 || max_coords[d] < _n_steps[d] - 1)
+				covers_grid = false;
+		}
+
+		// visit the cells of the outermost layer of the cube
+		for (std::size_t kk(min_coords[2]); kk <= max_coords[2]; kk++) {
+			for (std::size_t j(min_coords[1]); j <= max_coords[1]; j++) {
+				for (std::size_t i(min_coords[0]); i <= max_coords[0]; i++) {
+					if (std::max(std::max(center[0] > i ? center[0] - i : i - center[0],
+					                      center[1] > j ? center[1] - j : j - center[1]),
+					             center[2] > kk ? center[2] - kk : kk - center[2]) != layer)
+						continue;
+					std::vector<POINT*> const& pnts(
+						_grid_cell_nodes_map[i + j * _n_steps[0] + kk * _n_steps[0] * _n_steps[1]]);
+					for (std::size_t l(0); l < pnts.size(); l++) {
+						if (nearest_pnts.size() < k) {
+							nearest_pnts.push_back(pnts[l]);
+							std::push_heap(nearest_pnts.begin(), nearest_pnts.end(), is_nearer);
+						} else if (is_nearer(pnts[l], nearest_pnts.front())) {
+							std::pop_heap(nearest_pnts.begin(), nearest_pnts.end(), is_nearer);
+							nearest_pnts.back() = pnts[l];
+							std::push_heap(nearest_pnts.begin(), nearest_pnts.end(), is_nearer);
+						}
+					}
+				}
+			}
+		}
+
+		if (covers_grid)
+			break;
+
+		if (nearest_pnts.size() == k) {
+			// distance of the query point to the border of the visited cube,
+			// borders at the boundary of the grid are not taken into account
+			double border_dist(std::numeric_limits<double>::max());
+			for (std::size_t d(0); d < 3; d++) {
+				if (min_coords[d] > 0)
+					border_dist = std::min(border_dist,
+						c[d] - (this->_min_pnt[d] + min_coords[d] * _step_sizes[d]));
+				if (max_coords[d] < _n_steps[d] - 1)
+					border_dist = std::min(border_dist,
+						this->_min_pnt[d] + (max_coords[d] + 1) * _step_sizes[d] - c[d]);
+			}
+			if (border_dist >= 0 &&
+			    MathLib::sqrDist(nearest_pnts.front()->getCoords(), c) <= border_dist * border_dist)
+				break;
+		}
+	}
+
+	std::sort_heap(nearest_pnts.begin(), nearest_pnts.end(), is_nearer);
+}
+
+template <typename POINT>
+void Grid<POINT>::getPointsInRadius(POINT const& pnt, double radius,
+                                    std::vector<POINT*> &pnts) const
+{
+	pnts.clear();
+	double const* const c(pnt.getCoords());
+	double const min_pnt[3] = { c[0] - radius, c[1] - radius, c[2] - radius };
+	double const max_pnt[3] = { c[0] + radius, c[1] + radius, c[2] + radius };
+	double const sqr_radius(radius * radius);
+	forEachPointInCuboid(min_pnt, max_pnt, [&](POINT* p)
+		{
+			if (MathLib::sqrDist(c, p->getCoords()) <= sqr_radius)
+				pnts.push_back(p);
+		});
+}
+
 #ifndef NDEBUG
 template <typename POINT>
 void Grid<POINT>::createGridGeometry(GeoLib::GEOObjects* geo_obj) const
@@ -510,7 +700,8 @@ void Grid<POINT>::createGridGeometry(GeoLib::GEOObjects* geo_obj) const
 #endif
 
 template <typename POINT>
-void Grid<POINT>::getGridCoords(POINT const& pnt, std::size_t* coords) const
+template <typename P>
+void Grid<POINT>::getGridCoords(P const& pnt, std::size_t* coords) const
 {
 	for (std::size_t k(0); k<3; k++) {
 		if (pnt[k] < this->_min_pnt[k]) {
@@ -530,14 +721,14 @@ void Grid<POINT>::getPointCellBorderDistances(POINT const& pnt,
                                               double dists[6],
                                               std::size_t const* const coords) const
 {
-	dists[0] = fabs(pnt[2] - this->_min_pnt[2] + coords[2] * _step_sizes[2]); // bottom
-	dists[5] = fabs(pnt[2] - this->_min_pnt[2] + (coords[2] + 1) * _step_sizes[2]); // top
+	dists[0] = fabs(pnt[2] - (this->_min_pnt[2] + coords[2] * _step_sizes[2])); // bottom
+	dists[5] = fabs(pnt[2] - (this->_min_pnt[2] + (coords[2] + 1) * _step_sizes[2])); // top
 
-	dists[1] = fabs(pnt[1] - this->_min_pnt[1] + coords[1] * _step_sizes[1]); // front
-	dists[3] = fabs(pnt[1] - this->_min_pnt[1] + (coords[1] + 1) * _step_sizes[1]); // back
+	dists[1] = fabs(pnt[1] - (this->_min_pnt[1] + coords[1] * _step_sizes[1])); // front
+	dists[3] = fabs(pnt[1] - (this->_min_pnt[1] + (coords[1] + 1) * _step_sizes[1])); // back
 
-	dists[4] = fabs(pnt[0] - this->_min_pnt[0] + coords[0] * _step_sizes[0]); // left
-	dists[2] = fabs(pnt[0] - this->_min_pnt[0] + (coords[0] + 1) * _step_sizes[0]); // right
+	dists[4] = fabs(pnt[0] - (this->_min_pnt[0] + coords[0] * _step_sizes[0])); // left
+	dists[2] = fabs(pnt[0] - (this->_min_pnt[0] + (coords[0] + 1) * _step_sizes[0])); // right
 }
 } // end namespace GeoLib
 
@@ -12,27 +12,79 @@
  *
  */
 
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 // ThirdParty/logog
 #include "logog/include/logog.hpp"
 
 // GeoLib
-#include "BruteForceClosestPair.h"
 #include "PointVec.h"
 #include "PointWithID.h"
 
-// BaseLib
-#include "quicksort.h"
-
 // MathLib
 #include "MathTools.h"
 
 namespace GeoLib
 {
+namespace
+{
+const std::size_t no_pnt (std::numeric_limits<std::size_t>::max());
+
+/// Sorts the vector in parallel: the threads sort chunks of the vector which
+/// are merged pairwise afterwards.
+template <typename T, typename Compare>
+void parallelSort(std::vector<T>& v, Compare cmp)
+{
+	std::size_t const n (v.size());
+	if (n == 0)
+		return;
+#ifdef _OPENMP
+	std::size_t const n_chunks (omp_get_max_threads());
+#else
+	std::size_t const n_chunks (1);
+#endif
+	std::size_t const chunk_size ((n + n_chunks - 1) / n_chunks);
+
+#ifdef _OPENMP
+	#pragma omp parallel for schedule(static)
+#endif
+	for (long c = 0; c < static_cast<long>(n_chunks); c++)
+	{
+		std::size_t const beg (std::min(n, c * chunk_size));
+		std::size_t const end (std::min(n, beg + chunk_size));
+		std::sort(v.begin() + beg, v.begin() + end, cmp);
+	}
+
+	for (std::size_t width (chunk_size); width < n; width *= 2)
+	{
+		long const n_merges ((n + 2 * width - 1) / (2 * width));
+#ifdef _OPENMP
+		#pragma omp parallel for schedule(static)
+#endif
+		for (long m = 0; m < n_merges; m++)
+		{
+			std::size_t const beg (m * 2 * width);
+			std::size_t const mid (std::min(n, beg + width));
+			std::size_t const end (std::min(n, beg + 2 * width));
+			std::inplace_merge(v.begin() + beg, v.begin() + mid, v.begin() + end, cmp);
+		}
+	}
+}
+}
+
 PointVec::PointVec (const std::string& name, std::vector<Point*>* points,
                     std::map<std::string, std::size_t>* name_id_map, PointType type, double rel_eps) :
 	TemplateVec<Point> (name, points, name_id_map),
 	_type(type), _sqr_shortest_dist (std::numeric_limits<double>::max()),
-	_aabb(points->begin(), points->end())
+	_aabb(points->begin(), points->end()),
+	_hash_cell_size (std::numeric_limits<double>::max())
 {
 	assert (_data_vec);
 	std::size_t number_of_all_input_pnts (_data_vec->size());
@@ -45,6 +97,8 @@ PointVec::PointVec (const std::string& name, std::vector<Point*>* points,
 		     number_of_all_input_pnts - _data_vec->size());
 
 	correctNameIDMapping();
+
+	buildPointHash();
 }
 
 PointVec::~PointVec ()
@@ -76,18 +130,12 @@ void PointVec::push_back (Point* pnt, std::string const*const name)
 
 std::size_t PointVec::uniqueInsert (Point* pnt)
 {
-	const double eps (std::numeric_limits<double>::epsilon());
-	auto const it = std::find_if(_data_vec->begin(), _data_vec->end(),
-		[&eps, &pnt](Point* const p)
-		{
-			return MathLib::maxNormDist(p, pnt) <= eps;
-		});
-
-	if (it != _data_vec->end())
+	double sqr_dist (std::numeric_limits<double>::max());
+	std::size_t const id (searchPointHash(*pnt, sqr_dist));
+	if (id != no_pnt)
 	{
 		delete pnt;
-		pnt = NULL;
-		return std::distance(_data_vec->begin(), it);
+		return id;
 	}
 
 	_data_vec->push_back(pnt);
@@ -95,17 +143,103 @@ std::size_t PointVec::uniqueInsert (Point* pnt)
 	// update bounding box
 	_aabb.update (*(_data_vec->back()));
 
-	// update shortest distance
-	std::for_each(_data_vec->begin(), _data_vec->end(),
-			[this](Point* const p)
-			{
-				_sqr_shortest_dist = std::min(_sqr_shortest_dist,
-						MathLib::sqrDist(*p, *(_data_vec->back())));
-			});
+	// update spatial hash and shortest distance
+	_hash_next.push_back(no_pnt);
+	insertIntoPointHash(_data_vec->size()-1, sqr_dist);
 
 	return _data_vec->size()-1;
 }
 
+PointVec::HashKey PointVec::getHashKey (Point const& pnt, double cell_size)
+{
+	// clamp the cell coordinates in order to avoid an overflow for very
+	// small cells, the neighbourhood of a cell is still correct
+	double const max_coord (std::ldexp(1.0, 62));
+	HashKey key;
+	for (std::size_t k(0); k < 3; k++)
+		key[k] = static_cast<long long>(
+			std::max(-max_coord, std::min(max_coord, std::floor(pnt[k] / cell_size))));
+	return key;
+}
+
+void PointVec::buildPointHash ()
+{
+	std::size_t const n_pnts (_data_vec->size());
+	_hash_cells.clear();
+	_hash_cells.reserve(n_pnts);
+	_hash_next.assign(n_pnts, no_pnt);
+	_hash_cell_size = std::numeric_limits<double>::max();
+	_sqr_shortest_dist = std::numeric_limits<double>::max();
+
+	// In a random insertion order the shortest distance, and therefore the
+	// cell size, changes only a few times.
+	std::vector<std::size_t> ids (n_pnts);
+	std::iota(ids.begin(), ids.end(), 0);
+	std::shuffle(ids.begin(), ids.end(), std::mt19937(n_pnts));
+
+	for (std::size_t id : ids)
+	{
+		double sqr_dist (std::numeric_limits<double>::max());
+		searchPointHash(*(*_data_vec)[id], sqr_dist);
+		insertIntoPointHash(id, sqr_dist);
+	}
+}
+
+std::size_t PointVec::searchPointHash (Point const& pnt, double &sqr_dist) const
+{
+	const double eps (std::numeric_limits<double>::epsilon());
+	HashKey const key (getHashKey(pnt, _hash_cell_size));
+	std::size_t identical_id (no_pnt);
+	HashKey neighbour;
+	for (neighbour[0] = key[0] - 1; neighbour[0] <= key[0] + 1; neighbour[0]++)
+		for (neighbour[1] = key[1] - 1; neighbour[1] <= key[1] + 1; neighbour[1]++)
+			for (neighbour[2] = key[2] - 1; neighbour[2] <= key[2] + 1; neighbour[2]++)
+			{
+				auto const cell (_hash_cells.find(neighbour));
+				if (cell == _hash_cells.end())
+					continue;
+				for (std::size_t id (cell->second); id != no_pnt; id = _hash_next[id])
+				{
+					Point const& p (*(*_data_vec)[id]);
+					if (MathLib::maxNormDist(&p, &pnt) <= eps)
+						identical_id = std::min(identical_id, id);
+					sqr_dist = std::min(sqr_dist, MathLib::sqrDist(p, pnt));
+				}
+			}
+	return identical_id;
+}
+
+void PointVec::insertIntoPointHash (std::size_t id, double sqr_dist)
+{
+	_sqr_shortest_dist = std::min(_sqr_shortest_dist, sqr_dist);
+
+	// The cell size must not be smaller than the shortest distance, such that
+	// the nearest point is found in the neighbouring cells, and not smaller
+	// than the tolerance of the test for identical points.
+	double const cell_size (std::max(std::sqrt(_sqr_shortest_dist),
+		std::numeric_limits<double>::epsilon()));
+	if (cell_size < 0.5 * _hash_cell_size)
+	{
+		std::vector<std::size_t> ids;
+		for (auto const& cell : _hash_cells)
+			for (std::size_t k (cell.second); k != no_pnt; k = _hash_next[k])
+				ids.push_back(k);
+
+		_hash_cells.clear();
+		_hash_cell_size = cell_size;
+		for (std::size_t k : ids)
+		{
+			std::size_t& last (_hash_cells.emplace(getHashKey(*(*_data_vec)[k], _hash_cell_size), no_pnt).first->second);
+			_hash_next[k] = last;
+			last = k;
+		}
+	}
+
+	std::size_t& last (_hash_cells.emplace(getHashKey(*(*_data_vec)[id], _hash_cell_size), no_pnt).first->second);
+	_hash_next[id] = last;
+	last = id;
+}
+
 std::vector<Point*>* PointVec::filterStations(const std::vector<PropertyBounds> &bounds) const
 {
 	std::vector<Point*>* tmpStations (new std::vector<Point*>);
@@ -124,65 +258,52 @@ double PointVec::getShortestPointDistance () const
 void PointVec::makePntsUnique (std::vector<GeoLib::Point*>* pnt_vec,
                                std::vector<std::size_t> &pnt_id_map, double eps)
 {
-	std::size_t n_pnts_in_file(pnt_vec->size());
-	std::vector<std::size_t> perm;
-	pnt_id_map.reserve(n_pnts_in_file);
-	for (std::size_t k(0); k < n_pnts_in_file; k++) {
-		perm.push_back(k);
-		pnt_id_map.push_back(k);
-	}
+	std::size_t const n_pnts_in_file(pnt_vec->size());
+	std::vector<std::size_t> perm(n_pnts_in_file);
+	std::iota(perm.begin(), perm.end(), 0);
+	pnt_id_map.resize(n_pnts_in_file);
 
-	// sort the points
-	BaseLib::Quicksort<GeoLib::Point*>(*pnt_vec, 0, n_pnts_in_file, perm);
-
-	// unfortunately quicksort is not stable -
-	// sort identical points by id - to make sorting stable
-	// determine intervals with identical points to resort for stability of sorting
-	std::vector<std::size_t> identical_pnts_interval;
-	bool identical(false);
-	for (std::size_t k = 0; k < n_pnts_in_file - 1; k++)
-	{
-		if (MathLib::maxNormDist((*pnt_vec)[k + 1], (*pnt_vec)[k]) <= eps)
+	// sort the points lexicographically, identical points by id
+	parallelSort(perm, [pnt_vec](std::size_t i, std::size_t j)
 		{
-			// points are identical, sort by id
-			if (!identical)
-				identical_pnts_interval.push_back(k);
-			identical = true;
-		} else {
-			if (identical)
-				identical_pnts_interval.push_back(k + 1);
-			identical = false;
-		}
-	}
-	if (identical)
-		identical_pnts_interval.push_back(n_pnts_in_file);
-
-	for (std::size_t i(0); i < identical_pnts_interval.size() / 2; i++) {
-		// bubble sort by id
-		std::size_t beg(identical_pnts_interval[2 * i]);
-		std::size_t end(identical_pnts_interval[2 * i + 1]);
-		for (std::size_t j(beg); j < end; j++)
-			for (std::size_t k(beg); k < end - 1; k++)
-				if (perm[k] > perm[k + 1])
-					std::swap(perm[k], perm[k + 1]);
+			GeoLib::Point const& p (*(*pnt_vec)[i]);
+			GeoLib::Point const& q (*(*pnt_vec)[j]);
+			for (std::size_t k(0); k < 3; k++) {
+				if (p[k] < q[k])
+					return true;
+				if (q[k] < p[k])
+					return false;
+			}
+			return i < j;
+		});
 
+	// mark the points that are identical to their predecessor
+	long const n_pnts (n_pnts_in_file);
+	std::vector<char> identical_to_prev(n_pnts_in_file, 0);
+#ifdef _OPENMP
+	#pragma omp parallel for schedule(static)
+#endif
+	for (long k = 1; k < n_pnts; k++)
+		identical_to_prev[k] =
+			MathLib::maxNormDist((*pnt_vec)[perm[k]], (*pnt_vec)[perm[k-1]]) <= eps;
+
+	// map all points of an interval of identical points to the point with the
+	// smallest id within the interval
+	for (std::size_t beg(0); beg < n_pnts_in_file; ) {
+		std::size_t end(beg + 1);
+		while (end < n_pnts_in_file && identical_to_prev[end])
+			end++;
+		std::size_t const min_id (*std::min_element(perm.begin() + beg, perm.begin() + end));
+		for (std::size_t k(beg); k < end; k++)
+			pnt_id_map[perm[k]] = min_id;
+		beg = end;
 	}
 
-	// check if there are identical points
-	for (std::size_t k = 0; k < n_pnts_in_file - 1; k++)
-		if (MathLib::maxNormDist((*pnt_vec)[k + 1], (*pnt_vec)[k]) <= eps)
-			pnt_id_map[perm[k + 1]] = pnt_id_map[perm[k]];
-
-	// reverse permutation
-	BaseLib::Quicksort<std::size_t, GeoLib::Point*>(perm, 0, n_pnts_in_file, *pnt_vec);
-
 	// remove the second, third, ... occurrence from vector
-	std::size_t cnt(0); // counts the points that are deleted
 	for (std::size_t k(0); k < n_pnts_in_file; k++) {
 		if (pnt_id_map[k] < k) {
 			delete (*pnt_vec)[k];
 			(*pnt_vec)[k] = nullptr;
-			cnt++;
 		}
 	}
 
@@ -190,7 +311,7 @@ void PointVec::makePntsUnique (std::vector<GeoLib::Point*>* pnt_vec,
 	pnt_vec->erase(pnt_vec_end, pnt_vec->end());
 
 	// renumber id-mapping
-	cnt = 0;
+	std::size_t cnt(0);
 	for (std::size_t k(0); k < n_pnts_in_file; k++) {
 		if (pnt_id_map[k] == k) { // point not removed, if necessary: id change
 			pnt_id_map[k] = cnt;
@@ -235,13 +356,6 @@ void PointVec::correctNameIDMapping()
 	}
 }
 
-void PointVec::calculateShortestDistance ()
-{
-	std::size_t i, j;
-	BruteForceClosestPair (*_data_vec, i, j);
-	_sqr_shortest_dist = MathLib::sqrDist (*(*_data_vec)[i], *(*_data_vec)[j]);
-}
-
 std::vector<GeoLib::Point*>* PointVec::getSubset(const std::vector<std::size_t> &subset)
 {
 	std::vector<GeoLib::Point*> *new_points (new std::vector<GeoLib::Point*>(subset.size()));
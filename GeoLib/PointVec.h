@@ -17,8 +17,11 @@
 #include "Point.h"
 #include "Station.h"
 
+#include <array>
+#include <limits>
 #include <map>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #ifndef POINTVEC_H_
@@ -38,6 +41,14 @@ class PointWithID;
  * It also handles the deleting of points. Additionally, each vector of points is identified by
  * a unique name from class GEOObject. For this reason PointVec should have
  * a name.
+ *
+ * The points are additionally stored in a spatial hash, i.e. in the cells of
+ * a regular grid that are addressed by their integer coordinates. The
+ * size of the cells is adapted to the shortest distance between the points,
+ * such that the test for an identical point in push_back() and the update of
+ * the shortest distance only have to look at the points of a few cells.
+ * \attention The coordinates of the points must not be changed after
+ * inserting them into the PointVec, otherwise the spatial hash is invalid.
  * */
 class PointVec : public TemplateVec<Point>
 {
@@ -112,6 +123,8 @@ private:
 	/**
 	 * Removes points out of the given point set that have the (nearly) same coordinates, i.e.
 	 * the distance of two points is smaller than eps measured in the maximum norm.
+	 * The points are sorted lexicographically in parallel, successive points in
+	 * this order are compared.
 	 * @param pnt_vec the given set of points stored in a vector
 	 * @param pnt_id_map the id mapping
 	 * @param eps if the distance (measured in maximum norm) between points \f$p_i\f$ and \f$p_j\f$
@@ -137,6 +150,50 @@ private:
 
 	std::size_t uniqueInsert (Point* pnt);
 
+	/// Integer coordinates of a cell of the spatial hash.
+	typedef std::array<long long, 3> HashKey;
+
+	struct HashKeyHash
+	{
+		std::size_t operator() (HashKey const& key) const
+		{
+			return static_cast<std::size_t>(key[0]) * 73856093u
+				^ static_cast<std::size_t>(key[1]) * 19349663u
+				^ static_cast<std::size_t>(key[2]) * 83492791u;
+		}
+	};
+
+	typedef std::unordered_map<HashKey, std::size_t, HashKeyHash> HashCells;
+
+	/// Returns the key of the hash cell with the given size containing the point.
+	static HashKey getHashKey (Point const& pnt, double cell_size);
+
+	/**
+	 * Inserts all points of _data_vec into the spatial hash and computes the
+	 * shortest distance between the points.
+	 */
+	void buildPointHash ();
+
+	/**
+	 * Searches the hash cells around the given point.
+	 * @param pnt the point
+	 * @param sqr_dist squared distance to the nearest hashed point, if the
+	 * distance is smaller than the cell size
+	 * @return the smallest id of the points that are identical to pnt (measured
+	 * in maximum norm with tolerance std::numeric_limits<double>::epsilon())
+	 * or std::numeric_limits<std::size_t>::max() if there is no such point
+	 */
+	std::size_t searchPointHash (Point const& pnt, double &sqr_dist) const;
+
+	/**
+	 * Adds the point with the given id to the spatial hash. If the shortest
+	 * distance becomes smaller than half of the cell size the hash is
+	 * rebuilt with a cell size equal to the shortest distance.
+	 * @param id the id of the point in _data_vec
+	 * @param sqr_dist result of searchPointHash() for this point
+	 */
+	void insertIntoPointHash (std::size_t id, double sqr_dist);
+
 	/** the type of the point (\sa enum PointType) */
 	PointType _type;
 
@@ -147,15 +204,18 @@ private:
 	std::vector<std::size_t> _pnt_id_map;
 
 	/**
-	 * method calculates the shortest distance of points inside the _pnt_vec
-	 */
-	void calculateShortestDistance ();
-	/**
-	 * squared shortest distance - calculated by calculateShortestAndLargestDistance, possible update by uniqueInsert
+	 * squared shortest distance - calculated by buildPointHash, updated by uniqueInsert
 	 */
 	double _sqr_shortest_dist;
 
 	AABB<GeoLib::Point> _aabb;
+
+	/// size of the cells of the spatial hash
+	double _hash_cell_size;
+	/// id of the last inserted point of each non-empty hash cell
+	HashCells _hash_cells;
+	/// id of the next point in the same hash cell for each point
+	std::vector<std::size_t> _hash_next;
 };
 } // end namespace
 
@@ -11,7 +11,14 @@
  *              http://www.opengeosys.org/project/license
  */
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <fstream>
+#include <limits>
+#include <vector>
 
 // ThirdParty/logog
 #include "logog/include/logog.hpp"
@@ -19,10 +26,44 @@
 #include "Raster.h"
 
 // BaseLib
+#include "Endianness.h"
+#include "FileTools.h"
+#include "MemoryMappedFile.h"
 #include "StringTools.h"
 
 namespace GeoLib {
 
+namespace
+{
+char const binary_magic[8] = {'O', 'G', 'S', 'B', 'R', 'A', 'S', '\0'};
+std::uint32_t const binary_format_version (1);
+std::size_t const binary_header_size (64);
+
+/// Reads a little-endian value and advances the position.
+template <typename T>
+T readValue(char const*& pos)
+{
+	T value;
+	std::memcpy(&value, pos, sizeof(T));
+	pos += sizeof(T);
+	return BaseLib::toLittleEndian(value);
+}
+
+template <typename T>
+void writeValue(std::ostream &os, T value)
+{
+	value = BaseLib::toLittleEndian(value);
+	os.write(reinterpret_cast<char const*>(&value), sizeof(T));
+}
+} // end anonymous namespace
+
+Raster::Raster(std::size_t n_cols, std::size_t n_rows, double xllcorner, double yllcorner,
+               double cell_size, double no_data_val, BaseLib::MemoryMappedFile* mapped_file,
+               double const* data) :
+	_n_cols(n_cols), _n_rows(n_rows), _ll_pnt(xllcorner, yllcorner, 0.0), _cell_size(cell_size),
+	_no_data_val(no_data_val), _raster_data(NULL), _data(data), _mapped_file(mapped_file)
+{}
+
 void Raster::refineRaster(std::size_t scaling)
 {
 	double *new_raster_data(new double[_n_rows*_n_cols*scaling*scaling]);
@@ -33,24 +74,28 @@ void Raster::refineRaster(std::size_t scaling)
 			for (std::size_t new_row(row*scaling); new_row<(row+1)*scaling; new_row++) {
 				const size_t idx0(new_row*_n_cols*scaling);
 				for (std::size_t new_col(col*scaling); new_col<(col+1)*scaling; new_col++) {
-					new_raster_data[idx0+new_col] = _raster_data[idx];
+					new_raster_data[idx0+new_col] = _data[idx];
 				}
 			}
 		}
 	}
 
 	std::swap(_raster_data, new_raster_data);
+	_data = _raster_data;
 	_cell_size /= scaling;
 	_n_cols *= scaling;
 	_n_rows *= scaling;
 
 	delete [] new_raster_data;
+	delete _mapped_file;
+	_mapped_file = NULL;
 }
 
 Raster::~Raster()
 {
 	if (_raster_data != NULL)
 		delete [] _raster_data;
+	delete _mapped_file;
 }
 
 void Raster::setCellSize(double cell_size)
@@ -68,6 +113,45 @@ GeoLib::Point const& Raster::getOrigin() const
 	return _ll_pnt;
 }
 
+double Raster::interpolateValueAtPoint(double x, double y) const
+{
+	// position in pixel units
+	const double xPos ((x - _ll_pnt[0]) / _cell_size);
+	const double yPos ((y - _ll_pnt[1]) / _cell_size);
+	if (xPos < 0 || yPos < 0 || xPos > _n_cols || yPos > _n_rows)
+		return _no_data_val;
+
+	// lower left of the four pixel centres around the point
+	const double x_floor (std::floor(xPos - 0.5));
+	const double y_floor (std::floor(yPos - 0.5));
+	const double xShift (xPos - 0.5 - x_floor);
+	const double yShift (yPos - 0.5 - y_floor);
+	const long xIdx (static_cast<long>(x_floor));
+	const long yIdx (static_cast<long>(y_floor));
+	const long max_col (static_cast<long>(_n_cols) - 1);
+	const long max_row (static_cast<long>(_n_rows) - 1);
+	const std::size_t col0 (std::min(std::max(xIdx, 0l), max_col));
+	const std::size_t col1 (std::min(std::max(xIdx + 1, 0l), max_col));
+	const std::size_t row0 (std::min(std::max(yIdx, 0l), max_row));
+	const std::size_t row1 (std::min(std::max(yIdx + 1, 0l), max_row));
+
+	const std::array<double,4> weight = {{ (1-xShift)*(1-yShift), xShift*(1-yShift), xShift*yShift, (1-xShift)*yShift }};
+	const std::array<double,4> pix_val = {{ _data[row0*_n_cols + col0], _data[row0*_n_cols + col1],
+		_data[row1*_n_cols + col1], _data[row1*_n_cols + col0] }};
+
+	double value (0.0);
+	double weight_sum (0.0);
+	for (std::size_t j(0); j < 4; ++j) {
+		if (std::fabs(pix_val[j] - _no_data_val) < std::numeric_limits<double>::epsilon())
+			continue;
+		value += weight[j] * pix_val[j];
+		weight_sum += weight[j];
+	}
+	if (weight_sum <= 0.0)
+		return _no_data_val;
+	return value / weight_sum;
+}
+
 Raster* Raster::getRasterFromSurface(Surface const& sfc, double cell_size, double no_data_val)
 {
 	Point const& ll (sfc.getAABB().getMinPoint());
@@ -118,12 +202,104 @@ void Raster::writeRasterAsASC(std::ostream &os) const
 	// write data
 	for (unsigned row(0); row<_n_rows; row++) {
 		for (unsigned col(0); col<_n_cols; col++) {
-			os << _raster_data[(_n_rows-row-1)*_n_cols+col] << " ";
+			os << _data[(_n_rows-row-1)*_n_cols+col] << " ";
 		}
 		os << "\n";
 	}
 }
 
+bool Raster::writeRasterAsBinary(std::ostream &os) const
+{
+	os.write(binary_magic, sizeof(binary_magic));
+	writeValue<std::uint32_t>(os, binary_format_version);
+	writeValue<std::uint32_t>(os, 0); // reserved
+	writeValue<std::uint64_t>(os, _n_cols);
+	writeValue<std::uint64_t>(os, _n_rows);
+	writeValue<double>(os, _ll_pnt[0]);
+	writeValue<double>(os, _ll_pnt[1]);
+	writeValue<double>(os, _cell_size);
+	writeValue<double>(os, _no_data_val);
+
+	std::size_t const n (_n_rows*_n_cols);
+	if (BaseLib::isLittleEndian()) {
+		os.write(reinterpret_cast<char const*>(_data), n*sizeof(double));
+	} else {
+		for (std::size_t i(0); i < n; i++)
+			writeValue<double>(os, _data[i]);
+	}
+	return static_cast<bool>(os);
+}
+
+Raster* Raster::getRasterFromBinaryFile(std::string const& fname)
+{
+	BaseLib::MemoryMappedFile* file (new BaseLib::MemoryMappedFile(fname,
+		BaseLib::MemoryMappedFile::AccessPattern::RANDOM));
+	if (!file->isOpen()) {
+		WARN("Raster::getRasterFromBinaryFile(): Could not open file %s.", fname.c_str());
+		delete file;
+		return NULL;
+	}
+	if (file->size() < binary_header_size
+		|| std::memcmp(file->begin(), binary_magic, sizeof(binary_magic)) != 0) {
+		WARN("Raster::getRasterFromBinaryFile(): %s is not a binary raster file.", fname.c_str());
+		delete file;
+		return NULL;
+	}
+
+	char const* pos (file->begin() + sizeof(binary_magic));
+	std::uint32_t const version (readValue<std::uint32_t>(pos));
+	readValue<std::uint32_t>(pos); // reserved
+	std::uint64_t const n_cols (readValue<std::uint64_t>(pos));
+	std::uint64_t const n_rows (readValue<std::uint64_t>(pos));
+	double const xllcorner (readValue<double>(pos));
+	double const yllcorner (readValue<double>(pos));
+	double const cell_size (readValue<double>(pos));
+	double const no_data_val (readValue<double>(pos));
+	if (version != binary_format_version) {
+		WARN("Raster::getRasterFromBinaryFile(): Unsupported version %d of file %s.", version, fname.c_str());
+		delete file;
+		return NULL;
+	}
+	if (n_cols == 0 || n_rows == 0 || !(cell_size > 0.0) || !std::isfinite(cell_size)
+		|| !std::isfinite(xllcorner) || !std::isfinite(yllcorner)) {
+		WARN("Raster::getRasterFromBinaryFile(): Invalid header in file %s.", fname.c_str());
+		delete file;
+		return NULL;
+	}
+	// n_cols * n_rows is compared without computing the product, which may
+	// overflow for corrupted headers
+	std::uint64_t const n_stored_values ((file->size() - binary_header_size) / sizeof(double));
+	if (n_cols > n_stored_values / n_rows) {
+		WARN("Raster::getRasterFromBinaryFile(): File %s is truncated.", fname.c_str());
+		delete file;
+		return NULL;
+	}
+
+	char const* const data (file->begin() + binary_header_size);
+	if (!BaseLib::isLittleEndian()) {
+		std::vector<double> values(n_cols*n_rows);
+		pos = data;
+		for (std::size_t i(0); i < values.size(); i++)
+			values[i] = readValue<double>(pos);
+		delete file;
+		return new Raster(n_cols, n_rows, xllcorner, yllcorner, cell_size,
+		                  values.begin(), values.end(), no_data_val);
+	}
+	// the mapping is page aligned and the header size is a multiple of 8,
+	// i.e. the values are properly aligned
+	return new Raster(n_cols, n_rows, xllcorner, yllcorner, cell_size, no_data_val,
+	                  file, reinterpret_cast<double const*>(data));
+}
+
+Raster* Raster::getRasterFromFile(std::string const& fname)
+{
+	if (BaseLib::hasFileExtension("bras", fname))
+		return getRasterFromBinaryFile(fname);
+	if (BaseLib::hasFileExtension("grd", fname))
+		return getRasterFromSurferFile(fname);
+	return getRasterFromASCFile(fname);
+}
+
 Raster* Raster::getRasterFromASCFile(std::string const& fname)
 {
 	std::ifstream in(fname.c_str());
@@ -16,6 +16,10 @@
 
 #include "Surface.h"
 
+namespace BaseLib {
+class MemoryMappedFile;
+}
+
 namespace GeoLib {
 
 /**
@@ -25,6 +29,10 @@ namespace GeoLib {
  * left point, the size of a raster pixel and a value for invalid data pixels.
  * Additional the object needs the raster data itself. The raster data will be
  * copied from the constructor. The destructor will release the memory.
+ *
+ * Rasters read from the binary raster format (*.bras files, see
+ * writeRasterAsBinary()) are not copied, the data are accessed directly in the
+ * memory-mapped file. Only the parts of the raster actually used are read.
  */
 class Raster {
 public:
@@ -49,7 +57,8 @@ public:
 	Raster(std::size_t n_cols, std::size_t n_rows, double xllcorner, double yllcorner,
 					double cell_size, InputIterator begin, InputIterator end, double no_data_val = -9999) :
 		_n_cols(n_cols), _n_rows(n_rows), _ll_pnt(xllcorner, yllcorner, 0.0), _cell_size(cell_size),
-		_no_data_val(no_data_val), _raster_data(new double[n_cols*n_rows])
+		_no_data_val(no_data_val), _raster_data(new double[n_cols*n_rows]),
+		_data(_raster_data), _mapped_file(nullptr)
 	{
 		iterator raster_it(_raster_data);
 		for (InputIterator it(begin); it != end; ++it) {
@@ -85,16 +94,26 @@ public:
 
 	double getNoDataValue() const { return _no_data_val; }
 
+	/**
+	 * Bilinear interpolation of the raster values at the point (x, y). The
+	 * values are located at the centres of the pixels, at the border of the
+	 * raster the values of the nearest pixels are used. Pixels without data
+	 * are ignored and the weights of the others are scaled accordingly.
+	 * @return the interpolated value or the no data value if the point is
+	 * outside of the raster or there is no data around the point
+	 */
+	double interpolateValueAtPoint(double x, double y) const;
+
 	/**
 	 * Constant iterator that is pointing to the first raster pixel value.
 	 * @return constant iterator
 	 */
-	const_iterator begin() const { return _raster_data; }
+	const_iterator begin() const { return _data; }
 	/**
 	 * Constant iterator that is pointing to the last raster pixel value.
 	 * @return constant iterator
 	 */
-	const_iterator end() const { return _raster_data + _n_rows*_n_cols; }
+	const_iterator end() const { return _data + _n_rows*_n_cols; }
 
 	~Raster();
 
@@ -104,10 +123,36 @@ public:
 	 */
 	void writeRasterAsASC(std::ostream &os) const;
 
+	/**
+	 * Write the raster in the binary raster format into the output stream. After a
+	 * header of 64 bytes (magic "OGSBRAS", version, number of columns and rows,
+	 * lower left point, cell size and no data value) the raster values follow
+	 * row by row starting with the lowest row, all values are stored little-endian.
+	 * @param os the output stream, it has to be opened in binary mode
+	 * @return true on success
+	 */
+	bool writeRasterAsBinary(std::ostream &os) const;
+
 	static Raster* getRasterFromSurface(Surface const& sfc, double cell_size, double no_data_val = -9999);
 	static Raster* getRasterFromASCFile(std::string const& fname);
 	static Raster* getRasterFromSurferFile(std::string const& fname);
+	/**
+	 * Maps a raster in the binary raster format into memory. The data are read on
+	 * demand by the operating system while the raster is accessed.
+	 */
+	static Raster* getRasterFromBinaryFile(std::string const& fname);
+	/**
+	 * Reads a raster choosing the format by the file extension: asc (ESRI ASCII
+	 * grid), grd (Surfer grid) or bras (binary raster).
+	 */
+	static Raster* getRasterFromFile(std::string const& fname);
 private:
+	/// Constructor for a raster using the data in a memory-mapped file, the
+	/// raster takes the ownership of the file.
+	Raster(std::size_t n_cols, std::size_t n_rows, double xllcorner, double yllcorner,
+	       double cell_size, double no_data_val, BaseLib::MemoryMappedFile* mapped_file,
+	       double const* data);
+
 	static bool readASCHeader(std::ifstream &in, std::size_t &n_cols, std::size_t &n_rows,
 						double &xllcorner, double &yllcorner, double &cell_size, double &no_data_val);
 	/**
@@ -143,9 +188,17 @@ private:
 	 */
 	double _no_data_val;
 	/**
-	 * raw raster data
+	 * raw raster data owned by the raster, NULL for memory-mapped rasters
 	 */
 	double* _raster_data;
+	/**
+	 * raster data, either _raster_data or the data in the mapped file
+	 */
+	double const* _data;
+	/**
+	 * the memory-mapped file the data are read from
+	 */
+	BaseLib::MemoryMappedFile* _mapped_file;
 };
 
 }
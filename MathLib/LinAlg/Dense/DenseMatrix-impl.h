@@ -90,6 +90,12 @@ DenseMatrix<FP_TYPE, IDX_TYPE>::operator=(DenseMatrix && rhs)
 	return *this;
 }
 
+template<typename FP_TYPE, typename IDX_TYPE>
+void DenseMatrix<FP_TYPE, IDX_TYPE>::setZero()
+{
+	std::fill(_data, _data + _n_rows * _n_cols, static_cast<FP_TYPE>(0));
+}
+
 template<typename FP_TYPE, typename IDX_TYPE>
 void DenseMatrix<FP_TYPE, IDX_TYPE>::axpy(FP_TYPE alpha, const FP_TYPE* x, FP_TYPE beta,
 		FP_TYPE* y) const
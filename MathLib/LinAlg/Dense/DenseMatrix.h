@@ -15,6 +15,7 @@
 #ifndef MATRIX_H
 #define MATRIX_H
 
+#include <algorithm>
 #include <new>
 #include <exception>
 #include <stdexcept>
@@ -73,6 +74,11 @@ public:
     */
    DenseMatrix& operator=(DenseMatrix && rhs);
 
+   /**
+    * Sets all entries of the matrix to zero.
+    */
+   void setZero();
+
    /**
     * \f$ y = \alpha \cdot A x + \beta y\f$
     */
@@ -20,6 +20,8 @@
 #include <fstream>
 #include <iterator>
 
+#include "MathLib/LinAlg/RowColumnIndices.h"
+
 namespace MathLib
 {
 
@@ -61,13 +63,17 @@ public:
 	/// add a value to entry
 	void add(std::size_t i, double v) { (*this)[i] += v; }
 
+	/// set all entries to zero
+	void setZero() { std::valarray<T>::operator=(static_cast<T>(0)); }
+
 	/**
 	 * add a sub vector
 	 * @param pos       positions of each sub-vector entry in this vector
 	 * @param sub_vec   sub-vector
 	 */
 	template<class T_SUBVEC>
-	void add(const std::vector<std::size_t> &pos, const T_SUBVEC &sub_vec)
+	void add(RowColumnIndices<std::size_t>::LineIndex const& pos,
+	         const T_SUBVEC &sub_vec)
 	{
 		for (std::size_t i=0; i<pos.size(); ++i) {
 			this->add(pos[i], sub_vec[i]);
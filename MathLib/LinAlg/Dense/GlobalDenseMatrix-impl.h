@@ -66,7 +66,9 @@ GlobalDenseMatrix<FP_TYPE, IDX_TYPE>::add(IDX_TYPE row, IDX_TYPE col, FP_TYPE va
 template<typename FP_TYPE, typename IDX_TYPE>
 template<class T_DENSE_MATRIX>
 void
-GlobalDenseMatrix<FP_TYPE, IDX_TYPE>::add(std::vector<IDX_TYPE> const& row_pos, std::vector<IDX_TYPE> const& col_pos,
+GlobalDenseMatrix<FP_TYPE, IDX_TYPE>::add(
+		typename RowColumnIndices<IDX_TYPE>::LineIndex const& row_pos,
+		typename RowColumnIndices<IDX_TYPE>::LineIndex const& col_pos,
 		const T_DENSE_MATRIX &sub_matrix, FP_TYPE fkt)
 {
 	if (row_pos.size() != sub_matrix.getNRows() || col_pos.size() != sub_matrix.getNCols())
@@ -73,7 +73,7 @@ public:
 	/// Add sub-matrix at positions \c row_pos and same column positions as the
 	/// given row positions.
 	template<class T_DENSE_MATRIX>
-	void add(std::vector<IDX_TYPE> const& row_pos,
+	void add(typename RowColumnIndices<IDX_TYPE>::LineIndex const& row_pos,
 			const T_DENSE_MATRIX &sub_matrix,
 			FP_TYPE fkt = static_cast<FP_TYPE>(1.0))
 	{
@@ -89,8 +89,9 @@ public:
 	}
 
 	template<class T_DENSE_MATRIX>
-	void add(std::vector<IDX_TYPE> const& row_pos,
-			std::vector<IDX_TYPE> const& col_pos, const T_DENSE_MATRIX &sub_matrix,
+	void add(typename RowColumnIndices<IDX_TYPE>::LineIndex const& row_pos,
+			typename RowColumnIndices<IDX_TYPE>::LineIndex const& col_pos,
+			const T_DENSE_MATRIX &sub_matrix,
 			FP_TYPE fkt = static_cast<FP_TYPE>(1.0));
 
         /// y = mat * x
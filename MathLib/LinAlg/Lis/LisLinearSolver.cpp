@@ -21,6 +21,8 @@
 #endif
 #include "logog/include/logog.hpp"
 
+#include "BaseLib/Profiler.h"
+
 #include "LisCheck.h"
 
 namespace MathLib
@@ -29,12 +31,28 @@ namespace MathLib
 using boost::property_tree::ptree;
 
 LisLinearSolver::LisLinearSolver(LisMatrix &A, ptree const*const option)
-: _A(A)
+: _A(A), _has_solver(false), _has_precon(false), _precon_outdated(true),
+  _precon_matrix_structure(0), _precon_matrix_revision(0), _precon_n_solves(0),
+  _precon_iterations(0), _last_iterations(0)
 {
     if (option)
         setOption(*option);
 }
 
+LisLinearSolver::~LisLinearSolver()
+{
+    destroyPreconditioner();
+    destroySolver();
+}
+
+void LisLinearSolver::setOption(const LisOption &option)
+{
+    _option = option;
+    // The solver object stores the parsed options.
+    destroyPreconditioner();
+    destroySolver();
+}
+
 void LisLinearSolver::setOption(const ptree &option)
 {
     boost::optional<ptree> ptSolver = option.get_child("LinearSolver");
@@ -61,19 +79,29 @@ void LisLinearSolver::setOption(const ptree &option)
     if (max_iteration_step) {
         _option.max_iterations = *max_iteration_step;
     }
+    boost::optional<bool> precon_reuse = ptSolver->get_optional<bool>("precon_reuse");
+    if (precon_reuse) {
+        _option.precon_reuse.enabled = *precon_reuse;
+    }
+    boost::optional<unsigned> precon_max_solves = ptSolver->get_optional<unsigned>("precon_rebuild_interval");
+    if (precon_max_solves) {
+        _option.precon_reuse.max_solves = *precon_max_solves;
+    }
+    boost::optional<double> precon_iteration_growth = ptSolver->get_optional<double>("precon_rebuild_iteration_growth");
+    if (precon_iteration_growth) {
+        _option.precon_reuse.max_iteration_growth = *precon_iteration_growth;
+    }
+    boost::optional<bool> precon_rebuild_on_change = ptSolver->get_optional<bool>("precon_rebuild_on_change");
+    if (precon_rebuild_on_change) {
+        _option.precon_reuse.rebuild_on_change = *precon_rebuild_on_change;
+    }
+
+    destroyPreconditioner();
+    destroySolver();
 }
 
-void LisLinearSolver::solve(LisVector &b, LisVector &x)
+void LisLinearSolver::createSolver()
 {
-    finalizeMatrixAssembly(_A);
-
-    INFO("------------------------------------------------------------------");
-    INFO("*** LIS solver computation");
-#ifdef _OPENMP
-    INFO("-> max number of threads = %d", omp_get_num_procs());
-    INFO("-> number of threads = %d", omp_get_max_threads());
-#endif
-
     // configure option
     std::string solver_options;
     if (_option.solver_precon_arg.empty()) {
@@ -100,33 +128,122 @@ void LisLinearSolver::solve(LisVector &b, LisVector &x)
     }
 
     // Create solver
-    LIS_SOLVER solver;
-    int ierr = lis_solver_create(&solver);
+    int ierr = lis_solver_create(&_solver);
+    checkLisError(ierr);
+    _has_solver = true;
+    ierr = lis_solver_set_option(const_cast<char*>(solver_options.c_str()), _solver);
     checkLisError(ierr);
-    ierr = lis_solver_set_option(const_cast<char*>(solver_options.c_str()), solver);
+    ierr = lis_solver_set_option(const_cast<char*>(tol_option.c_str()), _solver);
     checkLisError(ierr);
-    ierr = lis_solver_set_option(const_cast<char*>(tol_option.c_str()), solver);
+    ierr = lis_solver_set_option(const_cast<char*>("-print mem"), _solver);
     checkLisError(ierr);
-    ierr = lis_solver_set_option(const_cast<char*>("-print mem"), solver);
+
+#ifndef LIS_HAS_SOLVE_KERNEL
+    if (_option.precon_reuse.enabled)
+        WARN("LisLinearSolver: preconditioner reuse is not supported by this Lis version, the preconditioner is rebuilt for each solve.");
+#endif
+}
+
+void LisLinearSolver::destroySolver()
+{
+    if (!_has_solver)
+        return;
+    int ierr = lis_solver_destroy(_solver);
     checkLisError(ierr);
+    _has_solver = false;
+}
+
+void LisLinearSolver::destroyPreconditioner()
+{
+    if (_has_precon) {
+        int ierr = lis_precon_destroy(_precon);
+        checkLisError(ierr);
+        _has_precon = false;
+    }
+    _precon_outdated = true;
+}
+
+bool LisLinearSolver::isPreconditionerOutdated() const
+{
+    if (!_has_precon || _precon_outdated || !_option.precon_reuse.enabled)
+        return true;
+
+    LisOption::PreconReuse const& policy = _option.precon_reuse;
+    // The matrix object is recreated by LisMatrix::setZero() unless the
+    // matrix is preallocated. The address of the new object may be the same.
+    if (_precon_matrix_structure != _A.getStructureRevision())
+        return true;
+    if (policy.rebuild_on_change && _precon_matrix_revision != _A.getRevision())
+        return true;
+    if (policy.max_solves > 0 && _precon_n_solves >= policy.max_solves)
+        return true;
+    if (policy.max_iteration_growth > 0 && _precon_n_solves > 0
+        && _last_iterations > policy.max_iteration_growth * _precon_iterations)
+        return true;
+    return false;
+}
+
+void LisLinearSolver::solve(LisVector &b, LisVector &x)
+{
+    BASELIB_PROFILE_SCOPE("LisLinearSolver::solve");
+    finalizeMatrixAssembly(_A);
 
-    // solve
-    INFO("-> solve");
-    ierr = lis_solve(_A.getRawMatrix(), b.getRawVector(), x.getRawVector(), solver);
+    INFO("------------------------------------------------------------------");
+    INFO("*** LIS solver computation");
+#ifdef _OPENMP
+    INFO("-> max number of threads = %d", omp_get_num_procs());
+    INFO("-> number of threads = %d", omp_get_max_threads());
+#endif
+
+    if (!_has_solver)
+        createSolver();
+
+    LIS_MATRIX &A = _A.getRawMatrix();
+    int ierr = 0;
+#ifdef LIS_HAS_SOLVE_KERNEL
+    if (_option.precon_reuse.enabled) {
+        if (isPreconditionerOutdated()) {
+            BASELIB_PROFILE_SCOPE("LisLinearSolver::setupPreconditioner");
+            INFO("-> setup preconditioner");
+            destroyPreconditioner();
+            // The preconditioner is built from the matrix and vectors
+            // registered in the solver, which lis_solve() would do internally.
+            _solver->A = A;
+            _solver->b = b.getRawVector();
+            _solver->x = x.getRawVector();
+            ierr = lis_precon_create(_solver, &_precon);
+            checkLisError(ierr);
+            _has_precon = true;
+            _precon_outdated = false;
+            _precon_matrix_structure = _A.getStructureRevision();
+            _precon_matrix_revision = _A.getRevision();
+            _precon_n_solves = 0;
+        }
+
+        INFO("-> solve");
+        ierr = lis_solve_kernel(A, b.getRawVector(), x.getRawVector(), _solver, _precon);
+    } else
+#endif
+    {
+        // lis_solve() sets up a new preconditioner for each solve.
+        INFO("-> solve");
+        ierr = lis_solve(A, b.getRawVector(), x.getRawVector(), _solver);
+    }
     checkLisError(ierr);
 
     int iter = 0;
     double resid = 0.0;
-    ierr = lis_solver_get_iters(solver, &iter);
+    ierr = lis_solver_get_iters(_solver, &iter);
     checkLisError(ierr);
-    ierr = lis_solver_get_residualnorm(solver, &resid);
+    ierr = lis_solver_get_residualnorm(_solver, &resid);
     checkLisError(ierr);
     INFO("\t iteration: %d/%ld\n", iter, _option.max_iterations);
     INFO("\t residual: %e\n", resid);
 
-    // Clear solver
-    ierr = lis_solver_destroy(solver);
-    checkLisError(ierr);
+    if (_precon_n_solves == 0)
+        _precon_iterations = iter;
+    _precon_n_solves++;
+    _last_iterations = iter;
     INFO("------------------------------------------------------------------");
 }
 
@@ -30,6 +30,12 @@ namespace MathLib
 /**
  * \brief Linear solver using Lis (http://www.ssisc.org/lis/)
  *
+ * The Lis solver object is created on the first solve and kept until the
+ * options are changed. Depending on LisOption::precon_reuse the
+ * preconditioner is also kept and reused by subsequent solves, which avoids
+ * the repeated setup of expensive preconditioners like ILU or SAAMG. The
+ * reuse relies on Lis internals and is only compiled if the configure check
+ * for lis_solve_kernel() succeeded, otherwise lis_solve() is used.
  */
 class LisLinearSolver
 {
@@ -43,7 +49,7 @@ public:
      */
     LisLinearSolver(LisMatrix &A, boost::property_tree::ptree const*const option = nullptr);
 
-    virtual ~LisLinearSolver() {};
+    virtual ~LisLinearSolver();
 
     /**
      * configure linear solvers
@@ -55,7 +61,7 @@ public:
      * configure linear solvers
      * @param option
      */
-    void setOption(const LisOption &option) { _option = option; }
+    void setOption(const LisOption &option);
 
     /**
      * get linear solver options
@@ -71,10 +77,37 @@ public:
      */
     void solve(LisVector &b, LisVector &x);
 
+    /// Forces the setup of a new preconditioner in the next solve.
+    void resetPreconditioner() { _precon_outdated = true; }
+
+private:
+    /// Creates the Lis solver object from the current options.
+    void createSolver();
+    void destroySolver();
+    void destroyPreconditioner();
+
+    /// Checks the reuse policy if the preconditioner has to be rebuilt.
+    bool isPreconditionerOutdated() const;
 
 private:
     LisMatrix& _A;
     LisOption _option;
+
+    LIS_SOLVER _solver;
+    LIS_PRECON _precon;
+    bool _has_solver;
+    bool _has_precon;
+    bool _precon_outdated;
+
+    /// State of the matrix when the preconditioner was built.
+    unsigned long _precon_matrix_structure;
+    unsigned long _precon_matrix_revision;
+    /// Number of solves with the current preconditioner.
+    unsigned _precon_n_solves;
+    /// Iterations of the first solve with the current preconditioner.
+    int _precon_iterations;
+    /// Iterations of the last solve.
+    int _last_iterations;
 };
 
 } // MathLib
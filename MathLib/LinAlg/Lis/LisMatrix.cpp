@@ -14,6 +14,7 @@
 
 #include "LisMatrix.h"
 
+#include <algorithm>
 #include <stdexcept>
 
 #include "LisVector.h"
@@ -23,7 +24,9 @@ namespace MathLib
 {
 
 LisMatrix::LisMatrix(std::size_t n_rows, LisOption::MatrixType mat_type)
-    : _n_rows(n_rows), _mat_type(mat_type), _is_assembled(false)
+    : _n_rows(n_rows), _mat_type(mat_type), _is_assembled(false),
+      _row_ptr(nullptr), _col_idx(nullptr), _values(nullptr), _revision(0),
+      _structure_revision(0)
 {
     int ierr = lis_matrix_create(0, &_AA);
     checkLisError(ierr);
@@ -34,6 +37,46 @@ LisMatrix::LisMatrix(std::size_t n_rows, LisOption::MatrixType mat_type)
     checkLisError(ierr);
 }
 
+LisMatrix::LisMatrix(std::size_t n_rows,
+        CRSSparsityPattern const& sparsity_pattern)
+    : _n_rows(n_rows), _mat_type(LisOption::MatrixType::CRS),
+      _is_assembled(false),
+      _row_ptr(nullptr), _col_idx(nullptr), _values(nullptr), _revision(0),
+      _structure_revision(0)
+{
+    if (sparsity_pattern.getNRows() != n_rows)
+        throw std::invalid_argument(
+            "LisMatrix: sparsity pattern does not match the number of rows.");
+
+    int ierr = lis_matrix_create(0, &_AA);
+    checkLisError(ierr);
+    ierr = lis_matrix_set_size(_AA, 0, n_rows);
+    checkLisError(ierr);
+    lis_matrix_get_range(_AA, &_is, &_ie);
+    ierr = lis_vector_duplicate(_AA, &_diag);
+    checkLisError(ierr);
+
+    // Allocate the CRS arrays and copy the pattern; the values are zero.
+    LIS_INT const nnz = sparsity_pattern.getNEntries();
+    ierr = lis_matrix_malloc_csr(n_rows, nnz, &_row_ptr, &_col_idx, &_values);
+    checkLisError(ierr);
+    std::copy(sparsity_pattern.getRowPointers().begin(),
+              sparsity_pattern.getRowPointers().end(), _row_ptr);
+    std::copy(sparsity_pattern.getColumnIndices().begin(),
+              sparsity_pattern.getColumnIndices().end(), _col_idx);
+    std::fill_n(_values, nnz, 0.0);
+
+    // The matrix takes ownership of the arrays.
+    ierr = lis_matrix_set_csr(nnz, _row_ptr, _col_idx, _values, _AA);
+    checkLisError(ierr);
+    ierr = lis_matrix_assemble(_AA);
+    checkLisError(ierr);
+    _row_ptr = _AA->ptr;
+    _col_idx = _AA->index;
+    _values = _AA->value;
+    _is_assembled = true;
+}
+
 LisMatrix::~LisMatrix()
 {
     int ierr = lis_matrix_destroy(_AA);
@@ -44,12 +87,23 @@ LisMatrix::~LisMatrix()
 
 void LisMatrix::setZero()
 {
+    _revision++;
+    if (isPreallocated())
+    {
+        // Keep the structure, only reset the values.
+        std::fill_n(_values, _row_ptr[_n_rows], 0.0);
+        int ierr = lis_vector_set_all(0.0, _diag);
+        checkLisError(ierr);
+        return;
+    }
+
     // A matrix has to be destroyed and created again because Lis doesn't provide a
     // function to set matrix entries to zero
     int ierr = lis_matrix_destroy(_AA);
     checkLisError(ierr);
     ierr = lis_matrix_create(0, &_AA);
     checkLisError(ierr);
+    _structure_revision++;
     ierr = lis_matrix_set_size(_AA, 0, _n_rows);
     checkLisError(ierr);
     ierr = lis_vector_set_all(0.0, _diag);
@@ -60,6 +114,15 @@ void LisMatrix::setZero()
 
 int LisMatrix::setValue(std::size_t rowId, std::size_t colId, double v)
 {
+    _revision++;
+    if (isPreallocated())
+    {
+        _values[findEntry(rowId, colId)] = v;
+        if (rowId==colId)
+            lis_vector_set_value(LIS_INS_VALUE, rowId, v, _diag);
+        return 0;
+    }
+
     lis_matrix_set_value(LIS_INS_VALUE, rowId, colId, v, _AA);
     if (rowId==colId)
         lis_vector_set_value(LIS_INS_VALUE, rowId, v, _diag);
@@ -69,6 +132,15 @@ int LisMatrix::setValue(std::size_t rowId, std::size_t colId, double v)
 
 int LisMatrix::add(std::size_t rowId, std::size_t colId, double v)
 {
+    _revision++;
+    if (isPreallocated())
+    {
+        _values[findEntry(rowId, colId)] += v;
+        if (rowId==colId)
+            lis_vector_set_value(LIS_ADD_VALUE, rowId, v, _diag);
+        return 0;
+    }
+
     lis_matrix_set_value(LIS_ADD_VALUE, rowId, colId, v, _AA);
     if (rowId==colId)
         lis_vector_set_value(LIS_ADD_VALUE, rowId, v, _diag);
@@ -76,6 +148,18 @@ int LisMatrix::add(std::size_t rowId, std::size_t colId, double v)
     return 0;
 }
 
+LIS_INT LisMatrix::findEntry(std::size_t rowId, std::size_t colId) const
+{
+    LIS_INT const* const first = _col_idx + _row_ptr[rowId];
+    LIS_INT const* const last = _col_idx + _row_ptr[rowId + 1];
+    LIS_INT const* const it = std::lower_bound(first, last,
+        static_cast<LIS_INT>(colId));
+    if (it == last || *it != static_cast<LIS_INT>(colId))
+        throw std::out_of_range(
+            "LisMatrix: entry is not contained in the sparsity pattern.");
+    return it - _col_idx;
+}
+
 void LisMatrix::write(const std::string &filename) const
 {
     if (!_is_assembled)
@@ -113,7 +197,11 @@ bool finalizeMatrixAssembly(LisMatrix &mat)
 {
     LIS_MATRIX &A = mat.getRawMatrix();
 
-    if (!mat.isAssembled()) {
+    // The structure of a preallocated matrix is assembled on construction
+    // and the values are modified in place.
+    if (mat.isPreallocated()) {
+        mat._is_assembled = true;
+    } else if (!mat.isAssembled()) {
         int ierr = lis_matrix_set_type(A, static_cast<int>(mat.getMatrixType()));
         checkLisError(ierr);
         ierr = lis_matrix_assemble(A);
@@ -20,6 +20,7 @@
 #include <vector>
 
 #include "MathLib/LinAlg/RowColumnIndices.h"
+#include "MathLib/LinAlg/Sparse/CRSSparsityPattern.h"
 
 #include "lis.h"
 
@@ -46,6 +47,19 @@ public:
      */
     LisMatrix(std::size_t n_rows, LisOption::MatrixType mat_type = LisOption::MatrixType::CRS);
 
+    /**
+     * constructor of a CRS matrix with preallocated entries
+     *
+     * The structure of the matrix is fixed by the given sparsity pattern and
+     * assembled immediately. Subsequent additions are written directly into
+     * the preallocated storage; adding entries not contained in the pattern
+     * is an error. setZero() only resets the values.
+     *
+     * @param n_rows the number of rows (that is equal to the number of columns)
+     * @param sparsity_pattern the matrix entries, with n_rows rows
+     */
+    LisMatrix(std::size_t n_rows, CRSSparsityPattern const& sparsity_pattern);
+
     /**
      *
      */
@@ -87,7 +101,7 @@ public:
     /// Add sub-matrix at positions \c row_pos and same column positions as the
     /// given row positions.
     template<class T_DENSE_MATRIX>
-    void add(std::vector<std::size_t> const& row_pos,
+    void add(RowColumnIndices<std::size_t>::LineIndex const& row_pos,
             const T_DENSE_MATRIX &sub_matrix,
             double fkt = 1.0)
     {
@@ -105,8 +119,9 @@ public:
 
     ///
     template <class T_DENSE_MATRIX>
-    void add(std::vector<std::size_t> const& row_pos,
-            std::vector<std::size_t> const& col_pos, const T_DENSE_MATRIX &sub_matrix,
+    void add(RowColumnIndices<std::size_t>::LineIndex const& row_pos,
+            RowColumnIndices<std::size_t>::LineIndex const& col_pos,
+            const T_DENSE_MATRIX &sub_matrix,
             double fkt = 1.0);
 
     /// get this matrix type
@@ -115,6 +130,22 @@ public:
     /// return if this matrix is already assembled or not
     bool isAssembled() const { return _is_assembled; }
 
+    /// return a counter which is incremented on every modification of the
+    /// matrix entries
+    unsigned long getRevision() const { return _revision; }
+
+    /// return a counter which is incremented whenever the raw Lis matrix is
+    /// destroyed and created again, i.e. objects built from the raw matrix,
+    /// like a preconditioner, are invalid if the counter has changed
+    unsigned long getStructureRevision() const { return _structure_revision; }
+
+    /// return if the matrix structure was preallocated from a sparsity pattern
+    bool isPreallocated() const { return _values != nullptr; }
+
+private:
+    /// Position of entry (rowId, colId) in the preallocated value array.
+    LIS_INT findEntry(std::size_t rowId, std::size_t colId) const;
+
 private:
     std::size_t const _n_rows;
     LisOption::MatrixType const _mat_type;
@@ -123,6 +154,12 @@ private:
     bool _is_assembled;
     LIS_INT _is;	///< location where the partial matrix _AA starts in global matrix.
     LIS_INT _ie;	///< location where the partial matrix _AA ends in global matrix.
+    /// CRS arrays of a preallocated matrix, owned by _AA. Null otherwise.
+    LIS_INT* _row_ptr;
+    LIS_INT* _col_idx;
+    LIS_SCALAR* _values;
+    unsigned long _revision;
+    unsigned long _structure_revision;
 
     // friend function
     friend bool finalizeMatrixAssembly(LisMatrix &mat);
@@ -130,7 +167,8 @@ private:
 
 template<class T_DENSE_MATRIX>
 void
-LisMatrix::add(std::vector<std::size_t> const& row_pos, std::vector<std::size_t> const& col_pos,
+LisMatrix::add(RowColumnIndices<std::size_t>::LineIndex const& row_pos,
+        RowColumnIndices<std::size_t>::LineIndex const& col_pos,
         const T_DENSE_MATRIX &sub_matrix, double fkt)
 {
     if (row_pos.size() != sub_matrix.getNRows() || col_pos.size() != sub_matrix.getNCols())
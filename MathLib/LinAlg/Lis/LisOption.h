@@ -100,6 +100,36 @@ struct LisOption
     /// to other variables.
     std::string solver_precon_arg;
 
+    /// Policy for keeping the preconditioner between subsequent solves of
+    /// the same matrix, e.g. in a transient simulation. If reuse is enabled
+    /// the preconditioner is rebuilt only if one of the criteria holds.
+    /// Reuse needs lis_solve_kernel(), which is not part of the public Lis
+    /// API and is detected at configure time (LIS_HAS_SOLVE_KERNEL). Without
+    /// it the policy is ignored.
+    struct PreconReuse
+    {
+        /// Keep the preconditioner between solves. Default false, i.e. the
+        /// preconditioner is rebuilt for every solve.
+        bool enabled;
+        /// Rebuild after this number of solves, zero for no limit.
+        unsigned max_solves;
+        /// Rebuild if the number of iterations exceeds the number of
+        /// iterations of the first solve with the current preconditioner by
+        /// this factor. Zero disables the criterion.
+        double max_iteration_growth;
+        /// Rebuild whenever the matrix entries were modified since the last
+        /// rebuild.
+        bool rebuild_on_change;
+
+        PreconReuse()
+            : enabled(false), max_solves(0), max_iteration_growth(0),
+              rebuild_on_change(false)
+        {}
+    };
+
+    /// Preconditioner reuse policy.
+    PreconReuse precon_reuse;
+
     /**
      * Constructor
      *
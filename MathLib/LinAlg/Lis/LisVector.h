@@ -18,6 +18,8 @@
 #include <iostream>
 #include <vector>
 
+#include "MathLib/LinAlg/RowColumnIndices.h"
+
 #include "lis.h"
 
 namespace MathLib
@@ -95,7 +97,8 @@ public:
 
     ///
     template<class T_SUBVEC>
-    void add(const std::vector<std::size_t> &pos, const T_SUBVEC &sub_vec)
+    void add(RowColumnIndices<std::size_t>::LineIndex const& pos,
+            const T_SUBVEC &sub_vec)
     {
         for (std::size_t i=0; i<pos.size(); ++i) {
             this->add(pos[i], sub_vec[i]);
@@ -51,6 +51,25 @@ PETScMatrix::PETScMatrix (const PetscInt nrows, const PetscInt ncols, const PETS
     create(mat_opt.d_nz, mat_opt.o_nz);
 }
 
+PETScMatrix::PETScMatrix (const PetscInt nrows, CRSSparsityPattern const& sparsity_pattern,
+                          const PETScMatrixOption &mat_opt)
+    :_nrows(nrows), _ncols(nrows), _n_loc_rows(PETSC_DECIDE),
+     _n_loc_cols(mat_opt.n_local_cols)
+{
+    if(!mat_opt.is_global_size)
+    {
+        _nrows = PETSC_DECIDE;
+        _ncols = PETSC_DECIDE;
+        _n_loc_rows = nrows;
+
+        // Make the matrix be square.
+        MPI_Allreduce(&_n_loc_rows, &_nrows, 1, MPI_INT, MPI_SUM, PETSC_COMM_WORLD);
+        _ncols = _nrows;
+    }
+
+    create(sparsity_pattern);
+}
+
 void PETScMatrix::setRowsColumnsZero(std::vector<PetscInt> const& row_pos)
 {
     // Each rank (compute core) processes only the rows that belong to the rank itself.
@@ -99,6 +118,57 @@ void PETScMatrix::create(const PetscInt d_nz, const PetscInt o_nz)
     MatGetLocalSize(_A, &_n_loc_rows, &_n_loc_cols);
 }
 
+void PETScMatrix::create(CRSSparsityPattern const& sparsity_pattern)
+{
+    MatCreate(PETSC_COMM_WORLD, &_A);
+    MatSetSizes(_A, _n_loc_rows, _n_loc_cols, _nrows, _ncols);
+
+    MatSetFromOptions(_A);
+
+    // Determine the local row and column ranges in the same way as PETSc does
+    // for the layout of the matrix.
+    PetscInt n_loc_rows = _n_loc_rows;
+    PetscInt n_rows = _nrows;
+    PetscSplitOwnership(PETSC_COMM_WORLD, &n_loc_rows, &n_rows);
+    PetscInt n_loc_cols = _n_loc_cols;
+    PetscInt n_cols = _ncols;
+    PetscSplitOwnership(PETSC_COMM_WORLD, &n_loc_cols, &n_cols);
+
+    PetscInt row_end = 0;
+    MPI_Scan(&n_loc_rows, &row_end, 1, MPIU_INT, MPI_SUM, PETSC_COMM_WORLD);
+    PetscInt col_end = 0;
+    MPI_Scan(&n_loc_cols, &col_end, 1, MPIU_INT, MPI_SUM, PETSC_COMM_WORLD);
+    const PetscInt row_begin = row_end - n_loc_rows;
+    const PetscInt col_begin = col_end - n_loc_cols;
+
+    // Count the nonzeros of the local rows in the diagonal and off-diagonal
+    // portions.
+    std::vector<PetscInt> d_nnz(n_loc_rows, 0);
+    std::vector<PetscInt> o_nnz(n_loc_rows, 0);
+    for (PetscInt i = 0; i < n_loc_rows; i++)
+    {
+        const std::size_t row = row_begin + i;
+        for (auto it = sparsity_pattern.getRowBeginIterator(row);
+             it != sparsity_pattern.getRowEndIterator(row); ++it)
+        {
+            const PetscInt col = static_cast<PetscInt>(*it);
+            if (col_begin <= col && col < col_end)
+                d_nnz[i]++;
+            else
+                o_nnz[i]++;
+        }
+    }
+
+    // Only the call matching the actual matrix type takes effect.
+    MatSeqAIJSetPreallocation(_A, 0, d_nnz.data());
+    MatMPIAIJSetPreallocation(_A, 0, d_nnz.data(), 0, o_nnz.data());
+    MatSetOption(_A, MAT_NEW_NONZERO_ALLOCATION_ERR, PETSC_TRUE);
+
+    MatGetOwnershipRange(_A, &_start_rank, &_end_rank);
+    MatGetSize(_A, &_nrows,  &_ncols);
+    MatGetLocalSize(_A, &_n_loc_rows, &_n_loc_cols);
+}
+
 bool finalizeMatrixAssembly(PETScMatrix &mat, const MatAssemblyType asm_type)
 {
     mat.finalizeAssembly(asm_type);
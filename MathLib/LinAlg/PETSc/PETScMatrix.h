@@ -18,6 +18,8 @@
 #include <string>
 #include <vector>
 
+#include "MathLib/LinAlg/Sparse/CRSSparsityPattern.h"
+
 #include "PETScMatrixOption.h"
 #include "PETScVector.h"
 
@@ -48,6 +50,19 @@ class PETScMatrix
         PETScMatrix(const PetscInt nrows, const PetscInt ncols,
                     const PETScMatrixOption &mat_op = PETScMatrixOption() );
 
+        /*!
+          \brief        Constructor for a square matrix preallocated from a sparsity pattern.
+                        The number of nonzeros of each local row is taken from the
+                        pattern instead of the d_nz and o_nz options. Inserting
+                        entries outside of the pattern is an error.
+          \param nrows  The number of rows of the matrix or the local matrix.
+          \param sparsity_pattern The global sparsity pattern with global row and
+                        column indices.
+          \param mat_op The configuration information for creating a matrix.
+        */
+        PETScMatrix(const PetscInt nrows, CRSSparsityPattern const& sparsity_pattern,
+                    const PETScMatrixOption &mat_op = PETScMatrixOption() );
+
         ~PETScMatrix()
         {
             MatDestroy(&_A);
@@ -222,6 +237,12 @@ class PETScMatrix
         */
         void create(const PetscInt d_nz, const PetscInt o_nz);
 
+        /*!
+          \brief Create the matrix with the number of nonzeros of each local row
+                 given by the sparsity pattern and set the related member data.
+        */
+        void create(CRSSparsityPattern const& sparsity_pattern);
+
         friend bool finalizeMatrixAssembly(PETScMatrix &mat, const MatAssemblyType asm_type);
 };
 
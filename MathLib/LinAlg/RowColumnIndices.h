@@ -10,21 +10,54 @@
 #ifndef ROWCOLUMNINDICES_H_
 #define ROWCOLUMNINDICES_H_
 
+#include <cstddef>
 #include <vector>
 
 namespace MathLib
 {
 
+/// Non-owning view on a contiguous sequence of indices, e.g. a whole
+/// std::vector or a part of a larger index array.
+template <typename IDX_TYPE>
+class IndexView
+{
+public:
+	typedef IDX_TYPE const* const_iterator;
+
+	IndexView(IDX_TYPE const* first, IDX_TYPE const* last)
+		: _first(first), _last(last)
+	{ }
+
+	/// Views the whole vector. The view is invalidated if the vector is
+	/// changed.
+	IndexView(std::vector<IDX_TYPE> const& indices)
+		: _first(indices.data()), _last(indices.data() + indices.size())
+	{ }
+
+	std::size_t size() const { return _last - _first; }
+	bool empty() const { return _first == _last; }
+
+	IDX_TYPE const& operator[](std::size_t i) const { return _first[i]; }
+
+	IDX_TYPE const* data() const { return _first; }
+	const_iterator begin() const { return _first; }
+	const_iterator end() const { return _last; }
+
+private:
+	IDX_TYPE const* _first;
+	IDX_TYPE const* _last;
+};
+
 template <typename IDX_TYPE>
 struct RowColumnIndices
 {
-	typedef typename std::vector<IDX_TYPE> LineIndex;
+	typedef IndexView<IDX_TYPE> LineIndex;
 	RowColumnIndices(LineIndex const& rows_, LineIndex const& columns_)
 		: rows(rows_), columns(columns_)
 	{ }
 
-	LineIndex const& rows;
-	LineIndex const& columns;
+	LineIndex const rows;
+	LineIndex const columns;
 };
 
 } // MathLib
@@ -16,14 +16,25 @@
 
 #include "MathTools.h"
 #include "blas.h"
+#include "DeterministicReduction.h"
+#include "SolverWorkspace.h"
 
 namespace MathLib {
 
+// All vector updates of an iteration are fused with the subsequent scalar
+// products, such that an iteration needs five passes over the vectors in
+// addition to the two matrix vector products and preconditioner applications.
+// The scalar products are deterministic reductions, i.e. the iterates do not
+// depend on the number of threads.
 unsigned BiCGStab(CRSMatrix<double, unsigned> const& A, double* const b, double* const x,
-		double& eps, unsigned& nsteps)
+		double& eps, unsigned& nsteps, SolverWorkspace* workspace)
 {
 	const unsigned N(A.getNRows());
-	double *v (new double[8* N]);
+	const long n(static_cast<long>(N));
+	SolverWorkspace local_workspace;
+	if (!workspace)
+		workspace = &local_workspace;
+	double *v (workspace->getVectors(8, N));
 	double *p (v + N);
 	double *phat (p + N);
 	double *s (phat + N);
@@ -31,67 +42,84 @@ unsigned BiCGStab(CRSMatrix<double, unsigned> const& A, double* const b, double*
 	double *t (shat + N);
 	double *r (t + N);
 	double *r0 (r + N);
+	double *partial (workspace->getReductionBuffer(2 * getNReductionBlocks(N)));
+	double sums[2];
 	double resid;
 
 	// normb = |b|
 	double nrmb = blas::nrm2(N, b);
 	if (nrmb < D_PREC) nrmb = D_ONE;
 
-	// r = r0 = b - A x0
-	blas::copy(N, b, r0);
-	A.amux(D_MONE, x, r0);
-	blas::copy(N, r0, r);
+	// r = r0 = b - A x0, rho1 = r0 * r
+	A.amux(D_ONE, x, r0);
+	reduceDeterministic<1>(N, partial, sums,
+		[=](std::size_t begin, std::size_t end, double* sum)
+		{
+			double rr (D_ZERO);
+			for (std::size_t k = begin; k < end; k++) {
+				r0[k] = b[k] - r0[k];
+				r[k] = r0[k];
+				rr += r0[k] * r0[k];
+			}
+			sum[0] += rr;
+		});
+	double rho1 (sums[0]);
 
-	resid = blas::nrm2(N, r) / nrmb;
+	resid = sqrt(rho1) / nrmb;
 
 	if (resid < eps) {
 		eps = resid;
 		nsteps = 0;
-		delete[] v;
 		return 0;
 	}
 
 	double alpha = D_ZERO, omega = D_ZERO, rho2 = D_ZERO;
 
 	for (unsigned l = 1; l <= nsteps; ++l) {
-		// rho1 = r0 * r
-		const double rho1 = blas::scpr(N, r0, r);
 		if (fabs(rho1) < D_PREC) {
-			eps = blas::nrm2(N, r) / nrmb;
-			delete[] v;
+			eps = resid;
 			return 2;
 		}
 
-		if (l == 1)
-			blas::copy(N, r, p); // p = r
-		else {
-//			blas::axpy(N, -omega, v, p); // p = (p-omega v)*beta+r
-			const double beta = rho1 * alpha / (rho2 * omega);
-//			blas::scal(N, beta, p);
-//			blas::axpy(N, D_ONE, r, p);
-			// p = (p-omega v)*beta+r
-			for (unsigned k(0); k<N; k++) {
-				p[k] = (p[k] - omega * v[k]) * beta + r[k];
-			}
+		// p = (p-omega v)*beta+r, p^ = p
+		const double beta = (l == 1) ? D_ZERO : rho1 * alpha / (rho2 * omega);
+#ifdef _OPENMP
+		#pragma omp parallel for
+#endif
+		for (long k = 0; k < n; k++) {
+			p[k] = (l == 1) ? r[k] : (p[k] - omega * v[k]) * beta + r[k];
+			phat[k] = p[k];
 		}
 
 		// p^ = C p
-		blas::copy(N, p, phat);
 		A.precondApply(phat);
 		// v = A p^
-		blas::setzero(N, v);
 		A.amux(D_ONE, phat, v);
 
-		alpha = rho1 / blas::scpr(N, r0, v);
-
-		// s = r - alpha v
-//		blas::copy(N, r, s);
-//		blas::axpy(N, -alpha, v, s);
-		for (unsigned k(0); k<N; k++) {
-			s[k] = r[k] - alpha * v[k];
-		}
-
-		resid = blas::nrm2(N, s) / nrmb;
+		reduceDeterministic<1>(N, partial, sums,
+			[=](std::size_t begin, std::size_t end, double* sum)
+			{
+				double r0v (D_ZERO);
+				for (std::size_t k = begin; k < end; k++)
+					r0v += r0[k] * v[k];
+				sum[0] += r0v;
+			});
+		alpha = rho1 / sums[0];
+
+		// s = r - alpha v, s^ = s
+		reduceDeterministic<1>(N, partial, sums,
+			[=](std::size_t begin, std::size_t end, double* sum)
+			{
+				double ss (D_ZERO);
+				for (std::size_t k = begin; k < end; k++) {
+					s[k] = r[k] - alpha * v[k];
+					shat[k] = s[k];
+					ss += s[k] * s[k];
+				}
+				sum[0] += ss;
+			});
+
+		resid = sqrt(sums[0]) / nrmb;
 #ifndef NDEBUG
 		std::cout << "Step " << l << ", resid=" << resid << std::endl;
 #endif
@@ -100,49 +128,60 @@ unsigned BiCGStab(CRSMatrix<double, unsigned> const& A, double* const b, double*
 			blas::axpy(N, alpha, phat, x);
 			eps = resid;
 			nsteps = l;
-			delete[] v;
 			return 0;
 		}
 
 		// s^ = C s
-		blas::copy(N, s, shat);
 		A.precondApply(shat);
-
 		// t = A s^
-		blas::setzero(N, t);
 		A.amux(D_ONE, shat, t);
 
 		// omega = t*s / t*t
-		omega = blas::scpr(N, t, s) / blas::scpr(N, t, t);
-
-		// x += alpha p^ + omega s^
-		blas::axpy(N, alpha, phat, x);
-		blas::axpy(N, omega, shat, x);
-
-		// r = s - omega t
-		blas::copy(N, s, r);
-		blas::axpy(N, -omega, t, r);
-
+		reduceDeterministic<2>(N, partial, sums,
+			[=](std::size_t begin, std::size_t end, double* sum)
+			{
+				double ts (D_ZERO), tt (D_ZERO);
+				for (std::size_t k = begin; k < end; k++) {
+					ts += t[k] * s[k];
+					tt += t[k] * t[k];
+				}
+				sum[0] += ts;
+				sum[1] += tt;
+			});
+		omega = sums[0] / sums[1];
+
+		// x += alpha p^ + omega s^, r = s - omega t, rho1 = r0 * r
 		rho2 = rho1;
-
-		resid = blas::nrm2(N, r) / nrmb;
+		reduceDeterministic<2>(N, partial, sums,
+			[=](std::size_t begin, std::size_t end, double* sum)
+			{
+				double r0r (D_ZERO), rr (D_ZERO);
+				for (std::size_t k = begin; k < end; k++) {
+					x[k] += alpha * phat[k] + omega * shat[k];
+					r[k] = s[k] - omega * t[k];
+					r0r += r0[k] * r[k];
+					rr += r[k] * r[k];
+				}
+				sum[0] += r0r;
+				sum[1] += rr;
+			});
+		rho1 = sums[0];
+
+		resid = sqrt(sums[1]) / nrmb;
 
 		if (resid < eps) {
 			eps = resid;
 			nsteps = l;
-			delete[] v;
 			return 0;
 		}
 
 		if (fabs(omega) < D_PREC) {
 			eps = resid;
-			delete[] v;
 			return 3;
 		}
 	}
 
 	eps = resid;
-	delete[] v;
 	return 1;
 }
 
@@ -21,8 +21,14 @@
 
 namespace MathLib {
 
+class SolverWorkspace;
+
+/**
+ * Preconditioned BiCGStab method. If a workspace is given, the work vectors
+ * are taken from it, otherwise they are allocated for the call.
+ */
 unsigned BiCGStab(CRSMatrix<double, unsigned> const& A, double* const b, double* const x,
-                  double& eps, unsigned& nsteps);
+                  double& eps, unsigned& nsteps, SolverWorkspace* workspace = nullptr);
 
 } // end namespace MathLib
 
@@ -16,6 +16,7 @@
 
 #include "MathTools.h"
 #include "blas.h"
+#include "SolverWorkspace.h"
 #include "../Sparse/CRSMatrix.h"
 #include "../Sparse/CRSMatrixDiagPrecond.h"
 
@@ -36,12 +37,15 @@ namespace MathLib {
 
 extern
 unsigned CG(CRSMatrix<double,unsigned> const * mat, double const * const b,
-		double* const x, double& eps, unsigned& nsteps)
+		double* const x, double& eps, unsigned& nsteps, SolverWorkspace* workspace)
 {
 	unsigned N = mat->getNRows();
 	double *p, *q, *r, *rhat, rho, rho1 = 0.0;
 
-	p = new double[4* N];
+	SolverWorkspace local_workspace;
+	if (!workspace)
+		workspace = &local_workspace;
+	p = workspace->getVectors(4, N);
 	q = p + N;
 	r = q + N;
 	rhat = r + N;
@@ -51,12 +55,11 @@ unsigned CG(CRSMatrix<double,unsigned> const * mat, double const * const b,
 		blas::setzero(N, x);
 		eps = 0.0;
 		nsteps = 0;
-		delete[] p;
 		return 0;
 	}
 
 	// r0 = b - Ax0
-	mat->amux(D_MONE, x, r);
+	mat->amux(D_ONE, x, r);
 	for (unsigned k(0); k < N; k++) {
 		r[k] = b[k] - r[k];
 	}
@@ -65,7 +68,6 @@ unsigned CG(CRSMatrix<double,unsigned> const * mat, double const * const b,
 	if (resid <= eps * nrmb) {
 		eps = resid / nrmb;
 		nsteps = 0;
-		delete[] p;
 		return 0;
 	}
 
@@ -107,14 +109,12 @@ unsigned CG(CRSMatrix<double,unsigned> const * mat, double const * const b,
 		if (resid <= eps * nrmb) {
 			eps = resid / nrmb;
 			nsteps = l;
-			delete[] p;
 			return 0;
 		}
 
 		rho1 = rho;
 	}
 	eps = resid / nrmb;
-	delete[] p;
 	return 1;
 }
 
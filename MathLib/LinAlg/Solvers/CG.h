@@ -19,15 +19,39 @@ namespace MathLib {
 
 // forward declaration
 template <typename PF_TYPE, typename IDX_TYPE> class CRSMatrix;
+class SolverWorkspace;
 
+/**
+ * Preconditioned conjugate gradient method. If a workspace is given, the work
+ * vectors are taken from it, otherwise they are allocated for the call.
+ */
 unsigned CG(CRSMatrix<double,unsigned> const * mat, double const * const b,
-		double* const x, double& eps, unsigned& nsteps);
+		double* const x, double& eps, unsigned& nsteps,
+		SolverWorkspace* workspace = nullptr);
 
 #ifdef _OPENMP
 unsigned CGParallel(CRSMatrix<double,unsigned> const * mat, double const * const b,
-		double* const x, double& eps, unsigned& nsteps);
+		double* const x, double& eps, unsigned& nsteps,
+		SolverWorkspace* workspace = nullptr);
 #endif
 
+/**
+ * Pipelined preconditioned conjugate gradient method (P. Ghysels,
+ * W. Vanroose: Hiding global synchronization latency in the preconditioned
+ * conjugate gradient method, Parallel Computing 40, 2014). Additional
+ * recurrences for A p, A C r and C A p make the matrix vector product of an
+ * iteration independent of its scalar products. Hence all vector updates and
+ * all scalar products of an iteration are done in a single pass over the
+ * vectors. The residual norm is computed from the recurrence for the
+ * residual, which may deviate from the true residual at the order of the
+ * machine precision times the condition number.
+ *
+ * The arguments are the same as for CG().
+ */
+unsigned PipelinedCG(CRSMatrix<double,unsigned> const * mat, double const * const b,
+		double* const x, double& eps, unsigned& nsteps,
+		SolverWorkspace* workspace = nullptr);
+
 } // end namespace MathLib
 
 #endif /* SOLVER_H_ */
@@ -20,6 +20,7 @@
 
 #include "MathTools.h"
 #include "blas.h"
+#include "SolverWorkspace.h"
 #include "../Sparse/CRSMatrix.h"
 #include "../Sparse/CRSMatrixDiagPrecond.h"
 
@@ -40,17 +41,20 @@ namespace MathLib {
 
 #ifdef _OPENMP
 unsigned CGParallel(CRSMatrix<double,unsigned> const * mat, double const * const b,
-		double* const x, double& eps, unsigned& nsteps)
+		double* const x, double& eps, unsigned& nsteps, SolverWorkspace* workspace)
 {
 #ifdef WIN32
 #pragma warning ( push )
 #pragma warning ( disable: 4018 )
 #endif
 	const unsigned N(mat->getNRows());
-	double * __restrict__ p(new double[N]);
-	double * __restrict__ q(new double[N]);
-	double * __restrict__ r(new double[N]);
-	double * __restrict__ rhat(new double[N]);
+	SolverWorkspace local_workspace;
+	if (!workspace)
+		workspace = &local_workspace;
+	double * __restrict__ p(workspace->getVectors(4, N));
+	double * __restrict__ q(p + N);
+	double * __restrict__ r(q + N);
+	double * __restrict__ rhat(r + N);
 	double rho, rho1 = 0.0;
 
 	double nrmb = sqrt(scalarProduct(b, b, N));
@@ -59,12 +63,11 @@ unsigned CGParallel(CRSMatrix<double,unsigned> const * mat, double const * const
 		blas::setzero(N, x);
 		eps = 0.0;
 		nsteps = 0;
-		delete[] p;
 		return 0;
 	}
 
 	// r0 = b - Ax0
-	mat->amux(D_MONE, x, r);
+	mat->amux(D_ONE, x, r);
 	for (unsigned k(0); k < N; k++) {
 		r[k] = b[k] - r[k];
 	}
@@ -73,10 +76,6 @@ unsigned CGParallel(CRSMatrix<double,unsigned> const * mat, double const * const
 	if (resid <= eps * nrmb) {
 		eps = resid / nrmb;
 		nsteps = 0;
-		delete[] p;
-		delete[] q;
-		delete[] r;
-		delete[] rhat;
 		return 0;
 	}
 
@@ -141,20 +140,12 @@ unsigned CGParallel(CRSMatrix<double,unsigned> const * mat, double const * const
 		if (resid <= eps * nrmb) {
 			eps = resid / nrmb;
 			nsteps = l;
-			delete[] p;
-			delete[] q;
-			delete[] r;
-			delete[] rhat;
 			return 0;
 		}
 
 		rho1 = rho;
 	}
 	eps = resid / nrmb;
-	delete[] p;
-	delete[] q;
-	delete[] r;
-	delete[] rhat;
 	return 1;
 #ifdef WIN32
 #pragma warning ( pop )
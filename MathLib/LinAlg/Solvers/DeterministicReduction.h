@@ -0,0 +1,67 @@
+/**
+ * \file
+ * \brief  Definition of the reduceDeterministic function.
+ *
+ * \copyright
+ * Copyright (c) 2013, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#ifndef DETERMINISTICREDUCTION_H_
+#define DETERMINISTICREDUCTION_H_
+
+#include <algorithm>
+#include <cstddef>
+
+namespace MathLib {
+
+/// Length of the blocks the index range of a deterministic reduction is split into.
+const std::size_t reduction_block_size = 2048;
+
+/// Number of blocks of a deterministic reduction over n indices.
+inline std::size_t getNReductionBlocks(std::size_t n)
+{
+	return (n + reduction_block_size - 1) / reduction_block_size;
+}
+
+/**
+ * Computes N_SUMS sums over the index range [0, n) in parallel. The range is
+ * split into blocks of the fixed length reduction_block_size, the function
+ * f(begin, end, partial) has to process the indices [begin, end) and add the
+ * contributions to partial[0], ..., partial[N_SUMS-1]. The partial sums of the
+ * blocks are added in the order of the blocks, i.e. in contrast to an OpenMP
+ * reduction the result does not depend on the number of threads.
+ *
+ * @param n         length of the index range
+ * @param buffer    memory for N_SUMS * getNReductionBlocks(n) partial sums
+ * @param sums      the N_SUMS resulting sums
+ * @param f         function processing a block
+ */
+template <std::size_t N_SUMS, typename F>
+void reduceDeterministic(std::size_t n, double* buffer, double* sums, F const& f)
+{
+	const long n_blocks (static_cast<long>(getNReductionBlocks(n)));
+#ifdef _OPENMP
+	#pragma omp parallel for schedule(static)
+#endif
+	for (long blk = 0; blk < n_blocks; blk++) {
+		double* const partial (buffer + blk * N_SUMS);
+		for (std::size_t j = 0; j < N_SUMS; j++)
+			partial[j] = 0.0;
+		const std::size_t begin (blk * reduction_block_size);
+		f(begin, std::min(n, begin + reduction_block_size), partial);
+	}
+
+	for (std::size_t j = 0; j < N_SUMS; j++)
+		sums[j] = 0.0;
+	for (long blk = 0; blk < n_blocks; blk++)
+		for (std::size_t j = 0; j < N_SUMS; j++)
+			sums[j] += buffer[blk * N_SUMS + j];
+}
+
+} // end namespace MathLib
+
+#endif /* DETERMINISTICREDUCTION_H_ */
@@ -93,8 +93,9 @@ unsigned GMRes(const CRSMatrix<double,unsigned>& A, double* const b, double* con
 	}
 
 	// r = b - Ax
-	blas::copy(n, b, r);
-	A.amux(D_MONE, x, r);
+	A.amux(D_ONE, x, r);
+	for (std::size_t k(0); k < n; k++)
+		r[k] = b[k] - r[k];
 
 	double beta = blas::nrm2(n, r);
 
@@ -154,8 +155,9 @@ unsigned GMRes(const CRSMatrix<double,unsigned>& A, double* const b, double* con
 		update(A, m, H, m + 1, s, V, x);
 
 		// r = b - A x;
-		blas::copy(n, b, r);
-		A.amux(D_MONE, x, r);
+		A.amux(D_ONE, x, r);
+		for (std::size_t k(0); k < n; k++)
+			r[k] = b[k] - r[k];
 		beta = blas::nrm2(n, r);
 
 		if ((resid = beta / normb) < eps) {
@@ -0,0 +1,163 @@
+/**
+ * \file
+ * \brief  Implementation of the pipelined CG method.
+ *
+ * \copyright
+ * Copyright (c) 2013, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#include <cmath>
+#include <iostream>
+#include <limits>
+
+#include "blas.h"
+#include "CG.h"
+#include "DeterministicReduction.h"
+#include "SolverWorkspace.h"
+#include "../Sparse/CRSMatrix.h"
+
+namespace MathLib {
+
+unsigned PipelinedCG(CRSMatrix<double,unsigned> const * mat, double const * const b,
+		double* const x, double& eps, unsigned& nsteps, SolverWorkspace* workspace)
+{
+	const unsigned N(mat->getNRows());
+	const long n(static_cast<long>(N));
+	SolverWorkspace local_workspace;
+	if (!workspace)
+		workspace = &local_workspace;
+	// the notation follows the paper of Ghysels and Vanroose:
+	// u = C r, w = A u, m = C w, nn = A m, s = A p, q = C s, z = A q
+	double *r (workspace->getVectors(9, N));
+	double *u (r + N);
+	double *w (u + N);
+	double *m (w + N);
+	double *nn (m + N);
+	double *z (nn + N);
+	double *q (z + N);
+	double *s (q + N);
+	double *p (s + N);
+	// the scalar products are deterministic reductions, i.e. the iterates do
+	// not depend on the number of threads
+	double *partial (workspace->getReductionBuffer(3 * getNReductionBlocks(N)));
+	double sums[3];
+
+	reduceDeterministic<1>(N, partial, sums,
+		[=](std::size_t begin, std::size_t end, double* sum)
+		{
+			double bb (D_ZERO);
+			for (std::size_t k = begin; k < end; k++)
+				bb += b[k] * b[k];
+			sum[0] += bb;
+		});
+	const double nrmb (std::sqrt(sums[0]));
+	if (nrmb < std::numeric_limits<double>::epsilon()) {
+		blas::setzero(N, x);
+		eps = 0.0;
+		nsteps = 0;
+		return 0;
+	}
+
+	// r0 = b - A x0, u0 = C r0, w0 = A u0
+	mat->amux(D_ONE, x, r);
+#ifdef _OPENMP
+	#pragma omp parallel for
+#endif
+	for (long k = 0; k < n; k++) {
+		r[k] = b[k] - r[k];
+		u[k] = r[k];
+	}
+	mat->precondApply(u);
+	mat->amux(D_ONE, u, w);
+
+	reduceDeterministic<3>(N, partial, sums,
+		[=](std::size_t begin, std::size_t end, double* sum)
+		{
+			double ru (D_ZERO), wu (D_ZERO), rr (D_ZERO);
+			for (std::size_t k = begin; k < end; k++) {
+				ru += r[k] * u[k];
+				wu += w[k] * u[k];
+				rr += r[k] * r[k];
+				m[k] = w[k];
+			}
+			sum[0] += ru;
+			sum[1] += wu;
+			sum[2] += rr;
+		});
+	double gamma (sums[0]), delta (sums[1]);
+
+	double resid (std::sqrt(sums[2]));
+	if (resid <= eps * nrmb) {
+		eps = resid / nrmb;
+		nsteps = 0;
+		return 0;
+	}
+
+	double alpha (D_ZERO), gamma_old (D_ZERO);
+	for (unsigned l = 1; l <= nsteps; ++l) {
+#ifndef NDEBUG
+		std::cout << "Step " << l << ", resid=" << resid / nrmb << std::endl;
+#endif
+		// m = C w, nn = A m
+		mat->precondApply(m);
+		mat->amux(D_ONE, m, nn);
+
+		double beta (D_ZERO);
+		if (l > 1) {
+			beta = gamma / gamma_old;
+			alpha = gamma / (delta - beta * gamma / alpha);
+		} else {
+			alpha = gamma / delta;
+		}
+		gamma_old = gamma;
+
+		// update all recurrences and compute the scalar products of the
+		// next iteration in a single pass
+		reduceDeterministic<3>(N, partial, sums,
+			[=](std::size_t begin, std::size_t end, double* sum)
+			{
+				double ru (D_ZERO), wu (D_ZERO), rr (D_ZERO);
+				for (std::size_t k = begin; k < end; k++) {
+					if (l > 1) {
+						z[k] = nn[k] + beta * z[k];
+						q[k] = m[k] + beta * q[k];
+						s[k] = w[k] + beta * s[k];
+						p[k] = u[k] + beta * p[k];
+					} else {
+						z[k] = nn[k];
+						q[k] = m[k];
+						s[k] = w[k];
+						p[k] = u[k];
+					}
+					x[k] += alpha * p[k];
+					r[k] -= alpha * s[k];
+					u[k] -= alpha * q[k];
+					w[k] -= alpha * z[k];
+					ru += r[k] * u[k];
+					wu += w[k] * u[k];
+					rr += r[k] * r[k];
+					m[k] = w[k];
+				}
+				sum[0] += ru;
+				sum[1] += wu;
+				sum[2] += rr;
+			});
+		gamma = sums[0];
+		delta = sums[1];
+
+		resid = std::sqrt(sums[2]);
+		if (resid <= eps * nrmb) {
+			eps = resid / nrmb;
+			nsteps = l;
+			return 0;
+		}
+	}
+	eps = resid / nrmb;
+	return 1;
+}
+
+} // end namespace MathLib
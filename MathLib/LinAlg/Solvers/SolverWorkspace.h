@@ -0,0 +1,65 @@
+/**
+ * \file
+ * \brief  Definition of the SolverWorkspace class.
+ *
+ * \copyright
+ * Copyright (c) 2013, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#ifndef SOLVERWORKSPACE_H_
+#define SOLVERWORKSPACE_H_
+
+#include <cstddef>
+#include <vector>
+
+namespace MathLib {
+
+/**
+ * Memory for the work vectors of the iterative solvers. A workspace passed to
+ * subsequent calls of the solvers is reused, i.e. the work vectors are
+ * allocated only once for a sequence of linear systems of the same size.
+ */
+class SolverWorkspace
+{
+public:
+	/**
+	 * Returns memory for n_vectors consecutive vectors of length n each. The
+	 * content of the memory is undefined.
+	 */
+	double* getVectors(std::size_t n_vectors, std::size_t n)
+	{
+		if (_buffer.size() < n_vectors * n)
+			_buffer.resize(n_vectors * n);
+		return _buffer.data();
+	}
+
+	/**
+	 * Returns memory for n partial sums of the deterministic reductions (see
+	 * reduceDeterministic()). The memory is separate from the work vectors.
+	 */
+	double* getReductionBuffer(std::size_t n)
+	{
+		if (_reduction_buffer.size() < n)
+			_reduction_buffer.resize(n);
+		return _reduction_buffer.data();
+	}
+
+	/// Releases the memory.
+	void clear()
+	{
+		std::vector<double>().swap(_buffer);
+		std::vector<double>().swap(_reduction_buffer);
+	}
+
+private:
+	std::vector<double> _buffer;
+	std::vector<double> _reduction_buffer;
+};
+
+} // end namespace MathLib
+
+#endif /* SOLVERWORKSPACE_H_ */
@@ -0,0 +1,153 @@
+/**
+ * \file
+ * \brief  Definition of the CRSMatrixBCSR class.
+ *
+ * \copyright
+ * Copyright (c) 2013, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#ifndef CRSMATRIXBCSR_H_
+#define CRSMATRIXBCSR_H_
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "CRSMatrix.h"
+#include "amuxSELL.h"
+
+namespace MathLib {
+
+/**
+ * Class CRSMatrixBCSR keeps a copy of the compressed row storage matrix in the
+ * block compressed row storage format with dense blocks of BLOCK_SIZE x
+ * BLOCK_SIZE entries that is used for the matrix vector multiplication. The
+ * format suits matrices of problems with BLOCK_SIZE components per node
+ * numbered by location, where only one column index is stored per block and
+ * the fixed size loops over the block entries are vectorised by the compiler.
+ *
+ * Because the class is derived from CRSMatrix, it can be used with the CG,
+ * BiCGStab and GMRes solvers. If entries are changed via the CRSMatrix
+ * interface after the construction, updateValues() has to be called. If the
+ * structure is changed via a reference to the CRSMatrix base class, e.g. by
+ * CRSMatrix::eraseEntries(), rebuild() has to be called.
+ */
+template<typename FP_TYPE, typename IDX_TYPE, unsigned BLOCK_SIZE>
+class CRSMatrixBCSR : public CRSMatrix<FP_TYPE, IDX_TYPE>
+{
+public:
+	CRSMatrixBCSR(std::string const &fname) :
+		CRSMatrix<FP_TYPE, IDX_TYPE>(fname)
+	{
+		convert();
+	}
+
+	CRSMatrixBCSR(IDX_TYPE n, IDX_TYPE *iA, IDX_TYPE *jA, FP_TYPE* A) :
+		CRSMatrix<FP_TYPE, IDX_TYPE>(n, iA, jA, A)
+	{
+		convert();
+	}
+
+	/// Converts a copy of the given matrix.
+	explicit CRSMatrixBCSR(CRSMatrix<FP_TYPE, IDX_TYPE> const& mat) :
+		CRSMatrix<FP_TYPE, IDX_TYPE>(mat)
+	{
+		convert();
+	}
+
+	virtual ~CRSMatrixBCSR()
+	{}
+
+	virtual void amux(FP_TYPE d, FP_TYPE const * const __restrict__ x, FP_TYPE * __restrict__ y) const
+	{
+		amuxBCSR<BLOCK_SIZE, FP_TYPE, IDX_TYPE>(d, this->_n_rows, this->_n_cols,
+			_block_row_ptr.data(), _block_col_idx.data(), _block_data.data(), x, y);
+	}
+
+	virtual void setZero()
+	{
+		CRSMatrix<FP_TYPE, IDX_TYPE>::setZero();
+		std::fill(_block_data.begin(), _block_data.end(), 0);
+	}
+
+	/// Removes the given rows and columns like CRSMatrix::eraseEntries() and
+	/// rebuilds the blocks.
+	void eraseEntries(IDX_TYPE n_rows_cols, IDX_TYPE const* const rows_cols)
+	{
+		CRSMatrix<FP_TYPE, IDX_TYPE>::eraseEntries(n_rows_cols, rows_cols);
+		rebuild();
+	}
+
+	/// Converts the compressed row storage into blocks again, which is
+	/// required after changes of the structure.
+	void rebuild()
+	{
+		convert();
+	}
+
+	/// Copies the entries of the compressed row storage into the blocks.
+	void updateValues()
+	{
+		std::fill(_block_data.begin(), _block_data.end(), 0);
+		IDX_TYPE const n (this->_n_rows);
+		for (IDX_TYPE row(0); row < n; row++) {
+			IDX_TYPE const block_row (row / BLOCK_SIZE);
+			typename std::vector<IDX_TYPE>::const_iterator const beg (
+				_block_col_idx.begin() + _block_row_ptr[block_row]);
+			typename std::vector<IDX_TYPE>::const_iterator const end (
+				_block_col_idx.begin() + _block_row_ptr[block_row+1]);
+			for (IDX_TYPE j(this->_row_ptr[row]); j < this->_row_ptr[row+1]; j++) {
+				IDX_TYPE const col (this->_col_idx[j]);
+				std::size_t const k (std::lower_bound(beg, end, col / BLOCK_SIZE) - _block_col_idx.begin());
+				_block_data[k * BLOCK_SIZE * BLOCK_SIZE + (row % BLOCK_SIZE) * BLOCK_SIZE
+					+ col % BLOCK_SIZE] = this->_data[j];
+			}
+		}
+	}
+
+	/// Number of non-zero blocks.
+	IDX_TYPE getNBlocks() const { return static_cast<IDX_TYPE>(_block_col_idx.size()); }
+
+private:
+	// The blocks are not updated by these, see eraseEntries().
+	using CRSMatrix<FP_TYPE, IDX_TYPE>::removeRows;
+	using CRSMatrix<FP_TYPE, IDX_TYPE>::transpose;
+
+	void convert()
+	{
+		IDX_TYPE const n (this->_n_rows);
+		IDX_TYPE const n_block_rows ((n + BLOCK_SIZE - 1) / BLOCK_SIZE);
+		_block_row_ptr.assign(n_block_rows + 1, 0);
+		_block_col_idx.clear();
+
+		std::vector<IDX_TYPE> block_cols;
+		for (IDX_TYPE block_row(0); block_row < n_block_rows; block_row++) {
+			block_cols.clear();
+			IDX_TYPE const end_row (std::min(n, (block_row + 1) * BLOCK_SIZE));
+			for (IDX_TYPE row(block_row * BLOCK_SIZE); row < end_row; row++)
+				for (IDX_TYPE j(this->_row_ptr[row]); j < this->_row_ptr[row+1]; j++)
+					block_cols.push_back(this->_col_idx[j] / BLOCK_SIZE);
+			std::sort(block_cols.begin(), block_cols.end());
+			block_cols.erase(std::unique(block_cols.begin(), block_cols.end()), block_cols.end());
+			_block_col_idx.insert(_block_col_idx.end(), block_cols.begin(), block_cols.end());
+			_block_row_ptr[block_row+1] = static_cast<IDX_TYPE>(_block_col_idx.size());
+		}
+
+		_block_data.resize(_block_col_idx.size() * BLOCK_SIZE * BLOCK_SIZE);
+		updateValues();
+	}
+
+	/// Offsets of the block rows in _block_col_idx.
+	std::vector<IDX_TYPE> _block_row_ptr;
+	std::vector<IDX_TYPE> _block_col_idx;
+	/// Entries of the blocks, each block is stored row-wise.
+	std::vector<FP_TYPE> _block_data;
+};
+
+} // end namespace MathLib
+
+#endif /* CRSMATRIXBCSR_H_ */
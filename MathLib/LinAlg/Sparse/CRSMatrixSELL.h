@@ -0,0 +1,181 @@
+/**
+ * \file
+ * \brief  Definition of the CRSMatrixSELL class.
+ *
+ * \copyright
+ * Copyright (c) 2013, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#ifndef CRSMATRIXSELL_H_
+#define CRSMATRIXSELL_H_
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "CRSMatrix.h"
+#include "amuxSELL.h"
+
+namespace MathLib {
+
+/**
+ * Class CRSMatrixSELL keeps a copy of the compressed row storage matrix in the
+ * sliced ELLPACK format SELL-C-sigma that is used for the matrix vector
+ * multiplication. The rows are grouped into chunks of C = 8 rows, the entries
+ * of a chunk are stored column by column, such that the multiplication is
+ * done for all rows of a chunk at once (with AVX2 or AVX-512 instructions if
+ * enabled for the compiler). To reduce the padding of the chunks, the rows are
+ * sorted by the number of entries within windows of sigma rows.
+ *
+ * Because the class is derived from CRSMatrix, it can be used with the CG,
+ * BiCGStab and GMRes solvers. If entries are changed via the CRSMatrix
+ * interface after the construction, updateValues() has to be called. If the
+ * structure is changed via a reference to the CRSMatrix base class, e.g. by
+ * CRSMatrix::eraseEntries(), rebuild() has to be called.
+ */
+template<typename FP_TYPE, typename IDX_TYPE>
+class CRSMatrixSELL : public CRSMatrix<FP_TYPE, IDX_TYPE>
+{
+public:
+	/// Number of rows of a chunk.
+	static const unsigned chunk_height = 8;
+
+	CRSMatrixSELL(std::string const &fname, IDX_TYPE sigma = 256) :
+		CRSMatrix<FP_TYPE, IDX_TYPE>(fname)
+	{
+		convert(sigma);
+	}
+
+	CRSMatrixSELL(IDX_TYPE n, IDX_TYPE *iA, IDX_TYPE *jA, FP_TYPE* A, IDX_TYPE sigma = 256) :
+		CRSMatrix<FP_TYPE, IDX_TYPE>(n, iA, jA, A)
+	{
+		convert(sigma);
+	}
+
+	/// Converts a copy of the given matrix.
+	explicit CRSMatrixSELL(CRSMatrix<FP_TYPE, IDX_TYPE> const& mat, IDX_TYPE sigma = 256) :
+		CRSMatrix<FP_TYPE, IDX_TYPE>(mat)
+	{
+		convert(sigma);
+	}
+
+	virtual ~CRSMatrixSELL()
+	{}
+
+	virtual void amux(FP_TYPE d, FP_TYPE const * const __restrict__ x, FP_TYPE * __restrict__ y) const
+	{
+		amuxSELL<chunk_height, FP_TYPE, IDX_TYPE>(d, this->_n_rows,
+			static_cast<IDX_TYPE>(_chunk_len.size()), _chunk_ptr.data(), _chunk_len.data(),
+			_perm.data(), _sell_col_idx.data(), _sell_data.data(), x, y);
+	}
+
+	virtual void setZero()
+	{
+		CRSMatrix<FP_TYPE, IDX_TYPE>::setZero();
+		std::fill(_sell_data.begin(), _sell_data.end(), 0);
+	}
+
+	/// Removes the given rows and columns like CRSMatrix::eraseEntries() and
+	/// rebuilds the SELL format.
+	void eraseEntries(IDX_TYPE n_rows_cols, IDX_TYPE const* const rows_cols)
+	{
+		CRSMatrix<FP_TYPE, IDX_TYPE>::eraseEntries(n_rows_cols, rows_cols);
+		rebuild();
+	}
+
+	/// Converts the compressed row storage into the SELL format again, which
+	/// is required after changes of the structure.
+	void rebuild()
+	{
+		convert(_sigma);
+	}
+
+	/// Copies the entries of the compressed row storage into the SELL format.
+	void updateValues()
+	{
+		IDX_TYPE const n (this->_n_rows);
+		for (IDX_TYPE p(0); p < n; p++) {
+			IDX_TYPE const row (_perm[p]);
+			IDX_TYPE const offset (_chunk_ptr[p / chunk_height] + p % chunk_height);
+			IDX_TYPE const beg (this->_row_ptr[row]);
+			IDX_TYPE const len (this->_row_ptr[row+1] - beg);
+			for (IDX_TYPE j(0); j < len; j++)
+				_sell_data[offset + j * chunk_height] = this->_data[beg + j];
+		}
+	}
+
+	/// Number of stored entries including the padding.
+	IDX_TYPE getNStoredEntries() const { return static_cast<IDX_TYPE>(_sell_data.size()); }
+
+private:
+	// The SELL format is not updated by these, see eraseEntries().
+	using CRSMatrix<FP_TYPE, IDX_TYPE>::removeRows;
+	using CRSMatrix<FP_TYPE, IDX_TYPE>::transpose;
+
+	void convert(IDX_TYPE sigma)
+	{
+		IDX_TYPE const n (this->_n_rows);
+		IDX_TYPE const* const row_ptr (this->_row_ptr);
+		IDX_TYPE const* const col_idx (this->_col_idx);
+		sigma = std::max(sigma, static_cast<IDX_TYPE>(1));
+		_sigma = sigma;
+
+		// sort the rows by decreasing length within windows of sigma rows
+		_perm.resize(n);
+		for (IDX_TYPE k(0); k < n; k++)
+			_perm[k] = k;
+		for (IDX_TYPE beg(0); beg < n; beg += sigma) {
+			IDX_TYPE const end (std::min(n, beg + sigma));
+			std::stable_sort(_perm.begin() + beg, _perm.begin() + end,
+				[row_ptr](IDX_TYPE a, IDX_TYPE b) {
+					return row_ptr[a+1] - row_ptr[a] > row_ptr[b+1] - row_ptr[b];
+				});
+		}
+
+		IDX_TYPE const n_chunks ((n + chunk_height - 1) / chunk_height);
+		_chunk_len.assign(n_chunks, 0);
+		_chunk_ptr.assign(n_chunks + 1, 0);
+		for (IDX_TYPE p(0); p < n; p++) {
+			IDX_TYPE const row (_perm[p]);
+			_chunk_len[p / chunk_height] = std::max(_chunk_len[p / chunk_height],
+				row_ptr[row+1] - row_ptr[row]);
+		}
+		for (IDX_TYPE c(0); c < n_chunks; c++)
+			_chunk_ptr[c+1] = _chunk_ptr[c] + _chunk_len[c] * chunk_height;
+
+		// The padding refers to the last column of the row (or column 0 for
+		// empty rows) to keep the accesses to x local.
+		_sell_col_idx.assign(_chunk_ptr[n_chunks], 0);
+		_sell_data.assign(_chunk_ptr[n_chunks], 0);
+		for (IDX_TYPE p(0); p < n; p++) {
+			IDX_TYPE const row (_perm[p]);
+			IDX_TYPE const c (p / chunk_height);
+			IDX_TYPE const offset (_chunk_ptr[c] + p % chunk_height);
+			IDX_TYPE const beg (row_ptr[row]);
+			IDX_TYPE const len (row_ptr[row+1] - beg);
+			IDX_TYPE const padding_col (len > 0 ? col_idx[beg + len - 1] : 0);
+			for (IDX_TYPE j(0); j < _chunk_len[c]; j++)
+				_sell_col_idx[offset + j * chunk_height] = (j < len) ? col_idx[beg + j] : padding_col;
+		}
+		updateValues();
+	}
+
+	/// Size of the windows the rows are sorted in.
+	IDX_TYPE _sigma;
+	/// Original row number of the rows in the permuted order.
+	std::vector<IDX_TYPE> _perm;
+	/// Offsets of the chunks in _sell_col_idx and _sell_data.
+	std::vector<IDX_TYPE> _chunk_ptr;
+	/// Length of the longest row of each chunk.
+	std::vector<IDX_TYPE> _chunk_len;
+	std::vector<IDX_TYPE> _sell_col_idx;
+	std::vector<FP_TYPE> _sell_data;
+};
+
+} // end namespace MathLib
+
+#endif /* CRSMATRIXSELL_H_ */
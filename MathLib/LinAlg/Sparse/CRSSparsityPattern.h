@@ -0,0 +1,92 @@
+/**
+ * @copyright
+ * Copyright (c) 2013, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/LICENSE.txt
+ */
+
+#ifndef CRSSPARSITYPATTERN_H_
+#define CRSSPARSITYPATTERN_H_
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+#include <vector>
+
+namespace MathLib
+{
+
+/// \brief Compact, immutable matrix sparsity pattern in compressed row storage.
+///
+/// \details In contrast to the MatrixSparsityPattern the entries can not be
+/// inserted one by one; the complete pattern is given at construction. The
+/// column indices of each row are sorted and unique. The pattern is meant to
+/// be computed once, e.g. from the mesh connectivity, and used for the
+/// preallocation of global sparse matrices.
+class CRSSparsityPattern
+{
+public:
+	/// Constant iterator over sorted entries of a row.
+	typedef std::size_t const* ConstRowIterator;
+
+	/// \param row_ptr  offsets of the rows in col_idx, n_rows+1 entries.
+	/// \param col_idx  sorted column indices of all rows.
+	CRSSparsityPattern(std::vector<std::size_t> row_ptr,
+	                   std::vector<std::size_t> col_idx)
+		: _row_ptr(std::move(row_ptr)), _col_idx(std::move(col_idx))
+	{
+		assert(!_row_ptr.empty());
+		assert(_row_ptr.back() == _col_idx.size());
+	}
+
+	/// Returns number of sparsity pattern rows.
+	std::size_t getNRows() const { return _row_ptr.size() - 1; }
+
+	/// Returns total number of entries.
+	std::size_t getNEntries() const { return _col_idx.size(); }
+
+	/// Returns number of entries in the given row.
+	std::size_t getNEntries(std::size_t const row) const
+	{
+		return _row_ptr[row + 1] - _row_ptr[row];
+	}
+
+	/// Constant iterator over sorted entries of a row.
+	ConstRowIterator getRowBeginIterator(std::size_t const row) const
+	{
+		return _col_idx.data() + _row_ptr[row];
+	}
+
+	/// Constant iterator over sorted entries of a row.
+	ConstRowIterator getRowEndIterator(std::size_t const row) const
+	{
+		return _col_idx.data() + _row_ptr[row + 1];
+	}
+
+	/// Offsets of the rows in the column index array.
+	std::vector<std::size_t> const& getRowPointers() const { return _row_ptr; }
+
+	/// Column indices of all rows.
+	std::vector<std::size_t> const& getColumnIndices() const { return _col_idx; }
+
+	/// Returns the position of the entry (row, col) in the column index array
+	/// or getNEntries() if the entry is not part of the pattern.
+	std::size_t find(std::size_t const row, std::size_t const col) const
+	{
+		ConstRowIterator const first = getRowBeginIterator(row);
+		ConstRowIterator const last = getRowEndIterator(row);
+		ConstRowIterator const it = std::lower_bound(first, last, col);
+		if (it == last || *it != col)
+			return getNEntries();
+		return it - _col_idx.data();
+	}
+
+private:
+	std::vector<std::size_t> _row_ptr;
+	std::vector<std::size_t> _col_idx;
+};
+
+} // end namespace MathLib
+
+#endif // CRSSPARSITYPATTERN_H_
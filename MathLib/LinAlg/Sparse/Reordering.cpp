@@ -0,0 +1,289 @@
+/**
+ * \file
+ * \brief  Implementation of bandwidth and fill reducing reorderings.
+ *
+ * \copyright
+ * Copyright (c) 2013, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#include "Reordering.h"
+
+#include <cstdint>
+#include <limits>
+#include <numeric>
+
+#ifdef USE_METIS
+#include <metis.h>
+#endif
+
+// ThirdParty/logog
+#include "logog/include/logog.hpp"
+
+namespace
+{
+
+/// Number of adjacent vertices without the vertex itself.
+std::size_t getDegree(std::size_t v, std::size_t const* row_ptr,
+	std::size_t const* col_idx)
+{
+	std::size_t degree (0);
+	for (std::size_t k(row_ptr[v]); k < row_ptr[v+1]; k++)
+		if (col_idx[k] != v)
+			degree++;
+	return degree;
+}
+
+/**
+ * Breadth first search in the component of the start vertex. The visited
+ * vertices are appended to order, the adjacent vertices of one vertex are
+ * visited in order of increasing degree. Returns the number of levels.
+ * level contains the level of the visited vertices and
+ * std::numeric_limits<std::size_t>::max() for all others.
+ */
+std::size_t breadthFirstSearch(std::size_t start, std::size_t const* row_ptr,
+	std::size_t const* col_idx, std::vector<std::size_t> const& degree,
+	std::vector<std::size_t> &level, std::vector<std::size_t> &order)
+{
+	std::size_t const unvisited (std::numeric_limits<std::size_t>::max());
+	std::size_t head (order.size());
+	order.push_back(start);
+	level[start] = 0;
+	std::size_t n_levels (1);
+	while (head < order.size()) {
+		std::size_t const v (order[head++]);
+		std::size_t const first_new (order.size());
+		for (std::size_t k(row_ptr[v]); k < row_ptr[v+1]; k++) {
+			std::size_t const w (col_idx[k]);
+			if (level[w] != unvisited)
+				continue;
+			level[w] = level[v] + 1;
+			n_levels = std::max(n_levels, level[w] + 1);
+			order.push_back(w);
+		}
+		std::stable_sort(order.begin() + first_new, order.end(),
+			[&degree](std::size_t a, std::size_t b)
+			{
+				return degree[a] < degree[b];
+			});
+	}
+	return n_levels;
+}
+
+/// Finds a pseudo-peripheral vertex in the component of the start vertex by
+/// the algorithm of George and Liu.
+std::size_t findPseudoPeripheralVertex(std::size_t start,
+	std::size_t const* row_ptr, std::size_t const* col_idx,
+	std::vector<std::size_t> const& degree, std::vector<std::size_t> &level,
+	std::vector<std::size_t> &order)
+{
+	std::size_t const unvisited (std::numeric_limits<std::size_t>::max());
+	std::size_t v (start);
+	std::size_t n_levels (0);
+	for (;;) {
+		std::size_t const offset (order.size());
+		std::size_t const new_n_levels (breadthFirstSearch(v, row_ptr, col_idx,
+			degree, level, order));
+		// vertex of minimal degree in the last level
+		std::size_t w (v);
+		for (std::size_t k(offset); k < order.size(); k++) {
+			std::size_t const u (order[k]);
+			if (level[u] + 1 == new_n_levels && (w == v || degree[u] < degree[w]))
+				w = u;
+		}
+		for (std::size_t k(offset); k < order.size(); k++)
+			level[order[k]] = unvisited;
+		order.resize(offset);
+		if (new_n_levels <= n_levels)
+			return v;
+		n_levels = new_n_levels;
+		v = w;
+	}
+}
+
+/// Transforms the coordinates into the transposed Hilbert index of the
+/// algorithm of J. Skilling, Programming the Hilbert curve, AIP Conf. Proc.
+/// 707 (2004).
+void axesToTranspose(std::uint32_t X[3], unsigned n_bits)
+{
+	std::uint32_t const M (1u << (n_bits - 1));
+	// inverse undo
+	for (std::uint32_t Q(M); Q > 1; Q >>= 1) {
+		std::uint32_t const P (Q - 1);
+		for (unsigned i(0); i < 3; i++) {
+			if (X[i] & Q) {
+				X[0] ^= P;
+			} else {
+				std::uint32_t const t ((X[0] ^ X[i]) & P);
+				X[0] ^= t;
+				X[i] ^= t;
+			}
+		}
+	}
+	// Gray encode
+	for (unsigned i(1); i < 3; i++)
+		X[i] ^= X[i-1];
+	std::uint32_t t (0);
+	for (std::uint32_t Q(M); Q > 1; Q >>= 1)
+		if (X[2] & Q)
+			t ^= Q - 1;
+	for (unsigned i(0); i < 3; i++)
+		X[i] ^= t;
+}
+
+} // end anonymous namespace
+
+namespace MathLib {
+
+std::vector<std::size_t> computeReverseCuthillMcKee(std::size_t n,
+	std::size_t const* row_ptr, std::size_t const* col_idx)
+{
+	std::size_t const unvisited (std::numeric_limits<std::size_t>::max());
+	std::vector<std::size_t> degree (n);
+	for (std::size_t v(0); v < n; v++)
+		degree[v] = getDegree(v, row_ptr, col_idx);
+
+	// start the components in order of increasing degree
+	std::vector<std::size_t> candidates (n);
+	std::iota(candidates.begin(), candidates.end(), 0);
+	std::stable_sort(candidates.begin(), candidates.end(),
+		[&degree](std::size_t a, std::size_t b)
+		{
+			return degree[a] < degree[b];
+		});
+
+	std::vector<std::size_t> level (n, unvisited);
+	std::vector<std::size_t> order;
+	order.reserve(n);
+	for (std::size_t const v : candidates) {
+		if (level[v] != unvisited)
+			continue;
+		std::size_t const start (findPseudoPeripheralVertex(v, row_ptr, col_idx,
+			degree, level, order));
+		breadthFirstSearch(start, row_ptr, col_idx, degree, level, order);
+	}
+
+	std::reverse(order.begin(), order.end());
+	return order;
+}
+
+std::vector<std::size_t> computeNestedDissection(std::size_t n,
+	std::size_t const* row_ptr, std::size_t const* col_idx)
+{
+#ifdef USE_METIS
+	// METIS requires the graph without self loops
+	std::vector<idx_t> xadj (n + 1);
+	std::vector<idx_t> adjncy;
+	adjncy.reserve(row_ptr[n]);
+	xadj[0] = 0;
+	for (std::size_t v(0); v < n; v++) {
+		for (std::size_t k(row_ptr[v]); k < row_ptr[v+1]; k++)
+			if (col_idx[k] != v)
+				adjncy.push_back(static_cast<idx_t>(col_idx[k]));
+		xadj[v+1] = static_cast<idx_t>(adjncy.size());
+	}
+
+	idx_t nvtxs (static_cast<idx_t>(n));
+	idx_t options[METIS_NOPTIONS];
+	METIS_SetDefaultOptions(options);
+	options[METIS_OPTION_NUMBERING] = 0;
+	std::vector<idx_t> perm (n), iperm (n);
+	if (n > 0 && METIS_NodeND(&nvtxs, xadj.data(), adjncy.data(), nullptr,
+			options, perm.data(), iperm.data()) == METIS_OK)
+		return std::vector<std::size_t>(perm.begin(), perm.end());
+	if (n > 0)
+		WARN("computeNestedDissection(): METIS_NodeND failed, using reverse Cuthill-McKee.");
+#endif
+	return computeReverseCuthillMcKee(n, row_ptr, col_idx);
+}
+
+std::vector<std::size_t> computeSpaceFillingCurveOrdering(std::size_t n,
+	double const* coords)
+{
+	std::vector<std::size_t> order (n);
+	std::iota(order.begin(), order.end(), 0);
+	if (n == 0)
+		return order;
+
+	// common scaling of all directions keeps the aspect ratio of the domain
+	double min[3], max[3];
+	for (unsigned d(0); d < 3; d++)
+		min[d] = max[d] = coords[d];
+	for (std::size_t i(1); i < n; i++) {
+		for (unsigned d(0); d < 3; d++) {
+			min[d] = std::min(min[d], coords[3*i+d]);
+			max[d] = std::max(max[d], coords[3*i+d]);
+		}
+	}
+	double extent (0.0);
+	for (unsigned d(0); d < 3; d++)
+		extent = std::max(extent, max[d] - min[d]);
+
+	// 21 bits per direction give a 63 bit key
+	unsigned const n_bits (21);
+	double const scale (extent > 0.0 ? ((1u << n_bits) - 1) / extent : 0.0);
+	std::vector<std::uint64_t> keys (n);
+	for (std::size_t i(0); i < n; i++) {
+		std::uint32_t X[3];
+		for (unsigned d(0); d < 3; d++)
+			X[d] = static_cast<std::uint32_t>((coords[3*i+d] - min[d]) * scale);
+		axesToTranspose(X, n_bits);
+		std::uint64_t key (0);
+		for (unsigned b(n_bits); b-- > 0; )
+			for (unsigned d(0); d < 3; d++)
+				key = (key << 1) | ((X[d] >> b) & 1u);
+		keys[i] = key;
+	}
+
+	std::stable_sort(order.begin(), order.end(),
+		[&keys](std::size_t a, std::size_t b)
+		{
+			return keys[a] < keys[b];
+		});
+	return order;
+}
+
+std::vector<std::size_t> computeOrdering(ReorderingMethod method,
+	std::size_t n, std::size_t const* row_ptr, std::size_t const* col_idx,
+	double const* coords)
+{
+	switch (method) {
+	case ReorderingMethod::REVERSE_CUTHILL_MCKEE:
+		return computeReverseCuthillMcKee(n, row_ptr, col_idx);
+	case ReorderingMethod::NESTED_DISSECTION:
+		return computeNestedDissection(n, row_ptr, col_idx);
+	case ReorderingMethod::SPACE_FILLING_CURVE:
+		return computeSpaceFillingCurveOrdering(n, coords);
+	case ReorderingMethod::NONE:
+		break;
+	}
+	std::vector<std::size_t> order (n);
+	std::iota(order.begin(), order.end(), 0);
+	return order;
+}
+
+std::vector<std::size_t> invertPermutation(std::vector<std::size_t> const& perm)
+{
+	std::vector<std::size_t> inverse (perm.size());
+	for (std::size_t i(0); i < perm.size(); i++)
+		inverse[perm[i]] = i;
+	return inverse;
+}
+
+std::size_t getBandwidth(std::size_t n, std::size_t const* row_ptr,
+	std::size_t const* col_idx)
+{
+	std::size_t bandwidth (0);
+	for (std::size_t i(0); i < n; i++) {
+		for (std::size_t k(row_ptr[i]); k < row_ptr[i+1]; k++) {
+			std::size_t const j (col_idx[k]);
+			bandwidth = std::max(bandwidth, i > j ? i - j : j - i);
+		}
+	}
+	return bandwidth;
+}
+
+} // end namespace MathLib
@@ -0,0 +1,181 @@
+/**
+ * \file
+ * \brief  Definition of bandwidth and fill reducing reorderings.
+ *
+ * \copyright
+ * Copyright (c) 2013, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#ifndef REORDERING_H_
+#define REORDERING_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "CRSMatrix.h"
+
+namespace MathLib {
+
+enum class ReorderingMethod
+{
+	NONE,                   ///< Identity permutation.
+	REVERSE_CUTHILL_MCKEE,  ///< Bandwidth reduction of the adjacency graph.
+	NESTED_DISSECTION,      ///< Fill reduction by METIS (RCM without METIS).
+	SPACE_FILLING_CURVE     ///< Hilbert curve ordering of the coordinates.
+};
+
+/**
+ * Orderings are returned as the permutation op_perm from new to original
+ * indices, i.e. the entity with the new index i has the original index
+ * op_perm[i]. The inverse permutation po_perm (original to new) is obtained
+ * by invertPermutation().
+ *
+ * The graphs are given in compressed row storage, the adjacency list of
+ * vertex i is col_idx[row_ptr[i]], ..., col_idx[row_ptr[i+1]-1]. The graphs
+ * have to be symmetric; entries on the diagonal are ignored.
+ */
+
+/// Reverse Cuthill-McKee ordering starting every connected component at a
+/// pseudo-peripheral vertex.
+std::vector<std::size_t> computeReverseCuthillMcKee(std::size_t n,
+	std::size_t const* row_ptr, std::size_t const* col_idx);
+
+/// Nested dissection ordering computed by METIS_NodeND. If OGS is built
+/// without METIS the reverse Cuthill-McKee ordering is returned.
+std::vector<std::size_t> computeNestedDissection(std::size_t n,
+	std::size_t const* row_ptr, std::size_t const* col_idx);
+
+/// Ordering of n points along a three dimensional Hilbert curve through the
+/// bounding box of the points. The coordinates are stored point-wise,
+/// i.e. coords has 3n entries.
+std::vector<std::size_t> computeSpaceFillingCurveOrdering(std::size_t n,
+	double const* coords);
+
+/// Computes the ordering by the given method. The coordinates are only used
+/// by the space filling curve, the graph is not used by it.
+std::vector<std::size_t> computeOrdering(ReorderingMethod method,
+	std::size_t n, std::size_t const* row_ptr, std::size_t const* col_idx,
+	double const* coords);
+
+/// Returns the inverse permutation.
+std::vector<std::size_t> invertPermutation(std::vector<std::size_t> const& perm);
+
+/// Maximal distance |i - j| of the adjacent vertices i and j in the graph.
+std::size_t getBandwidth(std::size_t n, std::size_t const* row_ptr,
+	std::size_t const* col_idx);
+
+/**
+ * Extracts the symmetrised adjacency graph of the sparsity pattern of the
+ * matrix, i.e. the pattern of A + A^T without the diagonal.
+ */
+template<typename FP_TYPE, typename IDX_TYPE>
+void getMatrixGraph(CRSMatrix<FP_TYPE, IDX_TYPE> const& mat,
+	std::vector<std::size_t> &row_ptr, std::vector<std::size_t> &col_idx)
+{
+	std::size_t const n (mat.getNRows());
+	IDX_TYPE const*const iA (mat.getRowPtrArray());
+	IDX_TYPE const*const jA (mat.getColIdxArray());
+
+	// count the entries of A and A^T per row
+	row_ptr.assign(n + 1, 0);
+	for (std::size_t i(0); i < n; i++) {
+		for (IDX_TYPE k(iA[i]); k < iA[i+1]; k++) {
+			std::size_t const j (jA[k]);
+			if (j == i)
+				continue;
+			row_ptr[i+1]++;
+			row_ptr[j+1]++;
+		}
+	}
+	for (std::size_t i(0); i < n; i++)
+		row_ptr[i+1] += row_ptr[i];
+
+	std::vector<std::size_t> pos (row_ptr.begin(), row_ptr.end() - 1);
+	col_idx.resize(row_ptr[n]);
+	for (std::size_t i(0); i < n; i++) {
+		for (IDX_TYPE k(iA[i]); k < iA[i+1]; k++) {
+			std::size_t const j (jA[k]);
+			if (j == i)
+				continue;
+			col_idx[pos[i]++] = j;
+			col_idx[pos[j]++] = i;
+		}
+	}
+
+	// remove the duplicates of symmetric entries
+	std::size_t k (0);
+	std::size_t beg (0);
+	for (std::size_t i(0); i < n; i++) {
+		std::size_t const end (row_ptr[i+1]);
+		std::sort(col_idx.begin() + beg, col_idx.begin() + end);
+		std::size_t const row_beg (k);
+		for (std::size_t j(beg); j < end; j++)
+			if (k == row_beg || col_idx[k-1] != col_idx[j])
+				col_idx[k++] = col_idx[j];
+		beg = end;
+		row_ptr[i+1] = k;
+	}
+	col_idx.resize(k);
+}
+
+/**
+ * Creates the matrix P A P^T for the permutation op_perm (new to original
+ * index), i.e. row and column i of the new matrix are row and column
+ * op_perm[i] of the given matrix.
+ */
+template<typename FP_TYPE, typename IDX_TYPE>
+CRSMatrix<FP_TYPE, IDX_TYPE>* createReorderedMatrix(
+	CRSMatrix<FP_TYPE, IDX_TYPE> const& mat, std::vector<std::size_t> const& op_perm)
+{
+	IDX_TYPE const n (mat.getNRows());
+	IDX_TYPE const*const iA (mat.getRowPtrArray());
+	IDX_TYPE const*const jA (mat.getColIdxArray());
+	FP_TYPE const*const A (mat.getEntryArray());
+	std::vector<std::size_t> const po_perm (invertPermutation(op_perm));
+
+	IDX_TYPE* iAn (new IDX_TYPE[n+1]);
+	IDX_TYPE* jAn (new IDX_TYPE[mat.getNNZ()]);
+	FP_TYPE* An (new FP_TYPE[mat.getNNZ()]);
+	iAn[0] = 0;
+	for (IDX_TYPE i(0); i < n; i++) {
+		std::size_t const row (op_perm[i]);
+		iAn[i+1] = iAn[i] + iA[row+1] - iA[row];
+	}
+
+	std::vector<std::pair<IDX_TYPE, FP_TYPE>> entries;
+	for (IDX_TYPE i(0); i < n; i++) {
+		std::size_t const row (op_perm[i]);
+		entries.clear();
+		for (IDX_TYPE k(iA[row]); k < iA[row+1]; k++)
+			entries.push_back(std::make_pair(static_cast<IDX_TYPE>(po_perm[jA[k]]), A[k]));
+		std::sort(entries.begin(), entries.end(),
+			[](std::pair<IDX_TYPE, FP_TYPE> const& a, std::pair<IDX_TYPE, FP_TYPE> const& b)
+			{
+				return a.first < b.first;
+			});
+		IDX_TYPE k (iAn[i]);
+		for (auto const& e : entries) {
+			jAn[k] = e.first;
+			An[k++] = e.second;
+		}
+	}
+	return new CRSMatrix<FP_TYPE, IDX_TYPE>(n, iAn, jAn, An);
+}
+
+/// Permutes the vector: x_new[i] = x[op_perm[i]].
+template<typename T>
+void permuteVector(std::vector<std::size_t> const& op_perm, T const* x, T* x_new)
+{
+	for (std::size_t i(0); i < op_perm.size(); i++)
+		x_new[i] = x[op_perm[i]];
+}
+
+} // end namespace MathLib
+
+#endif /* REORDERING_H_ */
@@ -0,0 +1,184 @@
+/**
+ * \file
+ * \brief  Matrix vector multiplication kernels for the sliced ELLPACK
+ * (SELL-C-sigma) and the block compressed row storage (BCSR) formats.
+ *
+ * \copyright
+ * Copyright (c) 2013, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#ifndef AMUXSELL_H_
+#define AMUXSELL_H_
+
+#include <cstddef>
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace MathLib {
+
+/**
+ * y = a * A * x for a matrix A in SELL-C-sigma format. The rows of the matrix
+ * are grouped into chunks of C (consecutive in the permuted order) rows. The
+ * entries of a chunk are stored column by column, i.e. the j-th entries of
+ * the C rows of the chunk are consecutive, shorter rows are padded with zeros.
+ *
+ * @param a scalar factor
+ * @param n number of rows
+ * @param n_chunks number of chunks, i.e. n/C rounded up
+ * @param chunk_ptr offsets of the chunks in col_idx and data (n_chunks+1 entries)
+ * @param chunk_len number of entries of the longest row of each chunk
+ * @param perm original row number for each row in the permuted order
+ * @param col_idx column indices
+ * @param data matrix entries
+ * @param x vector to multiply with
+ * @param y result vector
+ */
+template <unsigned C, typename FP_TYPE, typename IDX_TYPE>
+void amuxSELL(FP_TYPE a, IDX_TYPE n, IDX_TYPE n_chunks,
+	IDX_TYPE const* const __restrict__ chunk_ptr, IDX_TYPE const* const __restrict__ chunk_len,
+	IDX_TYPE const* const __restrict__ perm, IDX_TYPE const* const __restrict__ col_idx,
+	FP_TYPE const* const __restrict__ data, FP_TYPE const* const __restrict__ x,
+	FP_TYPE* __restrict__ y)
+{
+	long const n_c (static_cast<long>(n_chunks));
+#ifdef _OPENMP
+	#pragma omp parallel for schedule(static)
+#endif
+	for (long c = 0; c < n_c; c++) {
+		FP_TYPE t[C];
+		for (unsigned r(0); r < C; r++)
+			t[r] = 0;
+
+		IDX_TYPE const* const cols (col_idx + chunk_ptr[c]);
+		FP_TYPE const* const vals (data + chunk_ptr[c]);
+		IDX_TYPE const len (chunk_len[c]);
+		for (IDX_TYPE j(0); j < len; j++)
+			for (unsigned r(0); r < C; r++)
+				t[r] += vals[j*C+r] * x[cols[j*C+r]];
+
+		IDX_TYPE const first_row (static_cast<IDX_TYPE>(c) * C);
+		for (unsigned r(0); r < C && first_row + r < n; r++)
+			y[perm[first_row + r]] = a * t[r];
+	}
+}
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+/**
+ * Specialisation of the above kernel for double precision entries, 32 bit
+ * indices and chunks of eight rows, which are processed with gathers from
+ * x, i.e. one AVX-512 or two AVX2 registers per chunk.
+ */
+template <>
+inline
+void amuxSELL<8, double, unsigned>(double a, unsigned n, unsigned n_chunks,
+	unsigned const* const __restrict__ chunk_ptr, unsigned const* const __restrict__ chunk_len,
+	unsigned const* const __restrict__ perm, unsigned const* const __restrict__ col_idx,
+	double const* const __restrict__ data, double const* const __restrict__ x,
+	double* __restrict__ y)
+{
+	long const n_c (static_cast<long>(n_chunks));
+#ifdef _OPENMP
+	#pragma omp parallel for schedule(static)
+#endif
+	for (long c = 0; c < n_c; c++) {
+		unsigned const* const cols (col_idx + chunk_ptr[c]);
+		double const* const vals (data + chunk_ptr[c]);
+		unsigned const len (chunk_len[c]);
+		double t[8];
+#ifdef __AVX512F__
+		__m512d sum (_mm512_setzero_pd());
+		for (unsigned j(0); j < len; j++) {
+			__m256i const idx (_mm256_loadu_si256(reinterpret_cast<__m256i const*>(cols + 8*j)));
+			__m512d const xv (_mm512_i32gather_pd(idx, x, 8));
+			sum = _mm512_fmadd_pd(_mm512_loadu_pd(vals + 8*j), xv, sum);
+		}
+		_mm512_storeu_pd(t, _mm512_mul_pd(_mm512_set1_pd(a), sum));
+#else
+		__m256d sum0 (_mm256_setzero_pd());
+		__m256d sum1 (_mm256_setzero_pd());
+		for (unsigned j(0); j < len; j++) {
+			__m128i const idx0 (_mm_loadu_si128(reinterpret_cast<__m128i const*>(cols + 8*j)));
+			__m128i const idx1 (_mm_loadu_si128(reinterpret_cast<__m128i const*>(cols + 8*j + 4)));
+			__m256d const x0 (_mm256_i32gather_pd(x, idx0, 8));
+			__m256d const x1 (_mm256_i32gather_pd(x, idx1, 8));
+#ifdef __FMA__
+			sum0 = _mm256_fmadd_pd(_mm256_loadu_pd(vals + 8*j), x0, sum0);
+			sum1 = _mm256_fmadd_pd(_mm256_loadu_pd(vals + 8*j + 4), x1, sum1);
+#else
+			sum0 = _mm256_add_pd(sum0, _mm256_mul_pd(_mm256_loadu_pd(vals + 8*j), x0));
+			sum1 = _mm256_add_pd(sum1, _mm256_mul_pd(_mm256_loadu_pd(vals + 8*j + 4), x1));
+#endif
+		}
+		__m256d const av (_mm256_set1_pd(a));
+		_mm256_storeu_pd(t, _mm256_mul_pd(av, sum0));
+		_mm256_storeu_pd(t + 4, _mm256_mul_pd(av, sum1));
+#endif
+		unsigned const first_row (static_cast<unsigned>(c) * 8);
+		for (unsigned r(0); r < 8 && first_row + r < n; r++)
+			y[perm[first_row + r]] = t[r];
+	}
+}
+#endif
+
+/**
+ * y = a * A * x for a matrix A in block compressed row storage format with
+ * dense blocks of size B x B stored row-wise. If the number of rows or
+ * columns is not a multiple of B, the last block row or column is only
+ * partially used.
+ *
+ * @param a scalar factor
+ * @param n_rows number of rows
+ * @param n_cols number of columns
+ * @param block_row_ptr offsets of the block rows in block_col_idx
+ * @param block_col_idx block column indices
+ * @param data entries of the blocks
+ * @param x vector to multiply with
+ * @param y result vector
+ */
+template <unsigned B, typename FP_TYPE, typename IDX_TYPE>
+void amuxBCSR(FP_TYPE a, IDX_TYPE n_rows, IDX_TYPE n_cols,
+	IDX_TYPE const* const __restrict__ block_row_ptr,
+	IDX_TYPE const* const __restrict__ block_col_idx,
+	FP_TYPE const* const __restrict__ data, FP_TYPE const* const __restrict__ x,
+	FP_TYPE* __restrict__ y)
+{
+	long const n_block_rows (static_cast<long>((n_rows + B - 1) / B));
+#ifdef _OPENMP
+	#pragma omp parallel for schedule(static)
+#endif
+	for (long i = 0; i < n_block_rows; i++) {
+		FP_TYPE t[B];
+		for (unsigned r(0); r < B; r++)
+			t[r] = 0;
+
+		IDX_TYPE const end (block_row_ptr[i+1]);
+		for (IDX_TYPE k(block_row_ptr[i]); k < end; k++) {
+			FP_TYPE const* const block (data + static_cast<std::size_t>(k) * B * B);
+			IDX_TYPE const first_col (block_col_idx[k] * B);
+			if (first_col + B <= n_cols) {
+				FP_TYPE const* const xb (x + first_col);
+				for (unsigned r(0); r < B; r++)
+					for (unsigned s(0); s < B; s++)
+						t[r] += block[r*B+s] * xb[s];
+			} else {
+				for (unsigned r(0); r < B; r++)
+					for (unsigned s(0); first_col + s < n_cols; s++)
+						t[r] += block[r*B+s] * x[first_col + s];
+			}
+		}
+
+		IDX_TYPE const first_row (static_cast<IDX_TYPE>(i) * B);
+		for (unsigned r(0); r < B && first_row + r < n_rows; r++)
+			y[first_row + r] = a * t[r];
+	}
+}
+
+} // end namespace MathLib
+
+#endif /* AMUXSELL_H_ */
@@ -15,6 +15,9 @@
 
 #include "MeshGeoToolsLib/MeshNodeSearcher.h"
 
+#include <algorithm>
+#include <unordered_set>
+
 // MeshLib
 #include "Elements/Element.h"
 #include "Elements/Line.h"
@@ -27,13 +30,14 @@ namespace MeshGeoToolsLib
 {
 
 MeshNodeSearcher::MeshNodeSearcher(MeshLib::Mesh const& mesh) :
-		_mesh(mesh), _mesh_grid(_mesh.getNodes().cbegin(), _mesh.getNodes().cend()),
+		_mesh(&mesh), _compact_mesh(nullptr),
+		_mesh_grid(new GeoLib::Grid<MeshLib::Node>(mesh.getNodes().cbegin(), mesh.getNodes().cend())),
 		_search_length(0.0)
 {
 	double sum (0.0);
 	double sum_of_sqr (0.0);
 	std::size_t edge_cnt(0);
-	std::vector<MeshLib::Element*> const& elements(_mesh.getElements());
+	std::vector<MeshLib::Element*> const& elements(mesh.getElements());
 
 	for (std::vector<MeshLib::Element*>::const_iterator it(elements.cbegin());
 			it != elements.cend(); it++) {
@@ -52,6 +56,35 @@ MeshNodeSearcher::MeshNodeSearcher(MeshLib::Mesh const& mesh) :
 		edge_cnt += n_edges;
 	}
 
+	setSearchLength(sum, sum_of_sqr, edge_cnt, mesh.getName());
+}
+
+MeshNodeSearcher::MeshNodeSearcher(MeshLib::CompactMesh const& mesh) :
+		_mesh(nullptr), _compact_mesh(&mesh),
+		_compact_mesh_grid(new GeoLib::Grid<MeshLib::CompactNode>(mesh.getNodes().cbegin(), mesh.getNodes().cend())),
+		_search_length(0.0)
+{
+	double sum (0.0);
+	double sum_of_sqr (0.0);
+	std::size_t edge_cnt(0);
+
+	const std::size_t n_elements (mesh.getNElements());
+	for (std::size_t i(0); i<n_elements; i++) {
+		std::size_t const n_edges(mesh.getNElementEdges(i));
+		for (unsigned k(0); k<n_edges; k++) {
+			double const len(mesh.getElementEdgeLength(i, k));
+			sum += len;
+			sum_of_sqr += len*len;
+		}
+		edge_cnt += n_edges;
+	}
+
+	setSearchLength(sum, sum_of_sqr, edge_cnt, mesh.getName());
+}
+
+void MeshNodeSearcher::setSearchLength(double sum, double sum_of_sqr,
+		std::size_t edge_cnt, std::string const& mesh_name)
+{
 	const double mu (sum/edge_cnt);
 	const double s (sqrt(1.0/(edge_cnt-1) * (sum_of_sqr - (sum*sum)/edge_cnt) ));
 	// heuristic to prevent negative search lengths
@@ -64,7 +97,7 @@ MeshNodeSearcher::MeshNodeSearcher(MeshLib::Mesh const& mesh) :
 	_search_length = (mu - c * s)/2;
 
 	DBUG("[MeshNodeSearcher::MeshNodeSearcher] Calculated search length for mesh \"%s\" is %f.",
-			_mesh.getName().c_str(), _search_length);
+			mesh_name.c_str(), _search_length);
 }
 
 MeshNodeSearcher::~MeshNodeSearcher()
@@ -73,11 +106,40 @@ MeshNodeSearcher::~MeshNodeSearcher()
 	for (; it != _mesh_nodes_along_polylines.end(); it++) {
 		delete (*it);
 	}
+	for (auto* mesh_nodes : _mesh_nodes_along_surfaces)
+		delete mesh_nodes;
 }
 
 std::size_t MeshNodeSearcher::getMeshNodeIDForPoint(GeoLib::Point const& pnt) const
 {
-	return (_mesh_grid.getNearestPoint(pnt.getCoords()))->getID();
+	if (_compact_mesh) {
+		MeshLib::CompactNode const* const node(
+			_compact_mesh_grid->getNearestPoint(MeshLib::CompactNode(pnt.getCoords())));
+		return _compact_mesh->getNodeID(node);
+	}
+	return (_mesh_grid->getNearestPoint(pnt.getCoords()))->getID();
+}
+
+std::vector<std::size_t> MeshNodeSearcher::getMeshNodeIDsForPoints(
+		std::vector<GeoLib::Point*> const& pnts) const
+{
+	std::vector<double> coords(3 * pnts.size());
+	for (std::size_t i(0); i<pnts.size(); i++)
+		std::copy_n(pnts[i]->getCoords(), 3, coords.begin() + 3*i);
+
+	std::vector<std::size_t> ids(pnts.size());
+	if (_compact_mesh) {
+		std::vector<MeshLib::CompactNode*> nodes;
+		_compact_mesh_grid->getNearestPoints(coords.data(), pnts.size(), nodes);
+		for (std::size_t i(0); i<nodes.size(); i++)
+			ids[i] = _compact_mesh->getNodeID(nodes[i]);
+	} else {
+		std::vector<MeshLib::Node*> nodes;
+		_mesh_grid->getNearestPoints(coords.data(), pnts.size(), nodes);
+		for (std::size_t i(0); i<nodes.size(); i++)
+			ids[i] = nodes[i]->getID();
+	}
+	return ids;
 }
 
 std::vector<std::size_t> const& MeshNodeSearcher::getMeshNodeIDsAlongPolyline(
@@ -93,36 +155,110 @@ std::vector<std::size_t> const& MeshNodeSearcher::getMeshNodeIDsAlongSurface(Geo
 
 MeshNodesAlongPolyline& MeshNodeSearcher::getMeshNodesAlongPolyline(GeoLib::Polyline const& ply)
 {
-	std::vector<double> points;
-	std::vector<MeshNodesAlongPolyline*>::const_iterator it(_mesh_nodes_along_polylines.begin());
-	for (; it != _mesh_nodes_along_polylines.end(); it++) {
-		if (&(*it)->getPolyline() == &ply) {
-			// we calculated mesh nodes for this polyline already
-			return *(*it);
-		}
+	MeshNodesAlongPolyline* mesh_nodes (findMeshNodesAlongPolyline(ply));
+	if (mesh_nodes) {
+		// we calculated mesh nodes for this polyline already
+		return *mesh_nodes;
 	}
 
 	// compute nodes (and supporting points) along polyline
-	_mesh_nodes_along_polylines.push_back(
-			new MeshNodesAlongPolyline(_mesh.getNodes(), ply, _search_length));
+	_mesh_nodes_along_polylines.push_back(createMeshNodesAlongPolyline(ply));
 	return *_mesh_nodes_along_polylines.back();
 }
 
 MeshNodesAlongSurface& MeshNodeSearcher::getMeshNodesAlongSurface(GeoLib::Surface const& sfc)
 {
-	std::vector<double> points;
-	std::vector<MeshNodesAlongSurface*>::const_iterator it(_mesh_nodes_along_surfaces.begin());
-	for (; it != _mesh_nodes_along_surfaces.end(); it++) {
-		if (&(*it)->getSurface() == &sfc) {
-			// we calculated mesh nodes for this polyline already
-			return *(*it);
-		}
+	MeshNodesAlongSurface* mesh_nodes (findMeshNodesAlongSurface(sfc));
+	if (mesh_nodes) {
+		// we calculated mesh nodes for this surface already
+		return *mesh_nodes;
 	}
 
-	// compute nodes (and supporting points) along polyline
-	_mesh_nodes_along_surfaces.push_back(
-			new MeshNodesAlongSurface(_mesh.getNodes(), sfc));
+	// compute nodes along surface
+	_mesh_nodes_along_surfaces.push_back(createMeshNodesAlongSurface(sfc));
 	return *_mesh_nodes_along_surfaces.back();
 }
 
+void MeshNodeSearcher::searchMeshNodesAlongPolylines(
+		std::vector<GeoLib::Polyline*> const& plys)
+{
+	// polylines not searched before, each polyline only once
+	std::vector<GeoLib::Polyline const*> new_plys;
+	std::unordered_set<GeoLib::Polyline const*> new_plys_set;
+	for (auto const* ply : plys) {
+		if (!findMeshNodesAlongPolyline(*ply) && new_plys_set.insert(ply).second)
+			new_plys.push_back(ply);
+	}
+
+	std::vector<MeshNodesAlongPolyline*> mesh_nodes(new_plys.size());
+	const long n_plys (new_plys.size());
+#ifdef _OPENMP
+	#pragma omp parallel for schedule(dynamic, 1)
+#endif
+	for (long i = 0; i < n_plys; i++)
+		mesh_nodes[i] = createMeshNodesAlongPolyline(*new_plys[i]);
+
+	_mesh_nodes_along_polylines.insert(_mesh_nodes_along_polylines.end(),
+			mesh_nodes.cbegin(), mesh_nodes.cend());
+}
+
+void MeshNodeSearcher::searchMeshNodesAlongSurfaces(
+		std::vector<GeoLib::Surface*> const& sfcs)
+{
+	// surfaces not searched before, each surface only once
+	std::vector<GeoLib::Surface const*> new_sfcs;
+	std::unordered_set<GeoLib::Surface const*> new_sfcs_set;
+	for (auto const* sfc : sfcs) {
+		if (!findMeshNodesAlongSurface(*sfc) && new_sfcs_set.insert(sfc).second)
+			new_sfcs.push_back(sfc);
+	}
+
+	std::vector<MeshNodesAlongSurface*> mesh_nodes(new_sfcs.size());
+	const long n_sfcs (new_sfcs.size());
+#ifdef _OPENMP
+	#pragma omp parallel for schedule(dynamic, 1)
+#endif
+	for (long i = 0; i < n_sfcs; i++)
+		mesh_nodes[i] = createMeshNodesAlongSurface(*new_sfcs[i]);
+
+	_mesh_nodes_along_surfaces.insert(_mesh_nodes_along_surfaces.end(),
+			mesh_nodes.cbegin(), mesh_nodes.cend());
+}
+
+MeshNodesAlongPolyline* MeshNodeSearcher::findMeshNodesAlongPolyline(
+		GeoLib::Polyline const& ply) const
+{
+	for (auto* mesh_nodes : _mesh_nodes_along_polylines) {
+		if (&mesh_nodes->getPolyline() == &ply)
+			return mesh_nodes;
+	}
+	return nullptr;
+}
+
+MeshNodesAlongSurface* MeshNodeSearcher::findMeshNodesAlongSurface(
+		GeoLib::Surface const& sfc) const
+{
+	for (auto* mesh_nodes : _mesh_nodes_along_surfaces) {
+		if (&mesh_nodes->getSurface() == &sfc)
+			return mesh_nodes;
+	}
+	return nullptr;
+}
+
+MeshNodesAlongPolyline* MeshNodeSearcher::createMeshNodesAlongPolyline(
+		GeoLib::Polyline const& ply) const
+{
+	if (_compact_mesh)
+		return new MeshNodesAlongPolyline(*_compact_mesh, *_compact_mesh_grid, ply, _search_length);
+	return new MeshNodesAlongPolyline(*_mesh_grid, ply, _search_length);
+}
+
+MeshNodesAlongSurface* MeshNodeSearcher::createMeshNodesAlongSurface(
+		GeoLib::Surface const& sfc) const
+{
+	if (_compact_mesh)
+		return new MeshNodesAlongSurface(*_compact_mesh, *_compact_mesh_grid, sfc);
+	return new MeshNodesAlongSurface(*_mesh_grid, sfc);
+}
+
 } // end namespace MeshGeoTools
@@ -12,6 +12,7 @@
 #ifndef MESHNODESEARCHER_H_
 #define MESHNODESEARCHER_H_
 
+#include <memory>
 #include <vector>
 
 // GeoLib
@@ -22,6 +23,7 @@
 // MeshLib
 #include "Mesh.h"
 #include "Node.h"
+#include "CompactMesh.h"
 
 // forward declaration
 namespace MeshGeoToolsLib
@@ -47,6 +49,16 @@ public:
 	 * that the mesh does not change its geometry.
 	 */
 	explicit MeshNodeSearcher(MeshLib::Mesh const& mesh);
+
+	/**
+	 * Constructor for objects of class MeshNodeSearcher working on a
+	 * MeshLib::CompactMesh. The search is performed directly on the node
+	 * coordinate array of the mesh. The returned ids are the node ids of the
+	 * compact mesh.
+	 * @param mesh The mesh within the search will be performed. It is asumed
+	 * that the mesh does not change its geometry.
+	 */
+	explicit MeshNodeSearcher(MeshLib::CompactMesh const& mesh);
 	virtual ~MeshNodeSearcher();
 
 	/**
@@ -59,6 +71,14 @@ public:
 	 */
 	std::size_t getMeshNodeIDForPoint(GeoLib::Point const& pnt) const;
 
+	/**
+	 * Batch version of getMeshNodeIDForPoint(). The queries are processed in
+	 * parallel using GeoLib::Grid::getNearestPoints().
+	 * @param pnts the points the nearest mesh nodes are searched for
+	 * @return the ids of the nearest mesh nodes in the order of the points
+	 */
+	std::vector<std::size_t> getMeshNodeIDsForPoints(std::vector<GeoLib::Point*> const& pnts) const;
+
 	/**
 	 * Searches for the nearest mesh nodes along a GeoLib::Polyline.
 	 * The search for mesh nodes along a specific polyline will be performed
@@ -93,9 +113,48 @@ public:
 	 */
 	MeshNodesAlongSurface& getMeshNodesAlongSurface(GeoLib::Surface const& sfc);
 
+	/**
+	 * Searches the mesh nodes along all given polylines. The polylines not
+	 * processed before are searched in parallel. Afterwards the results are
+	 * available via getMeshNodesAlongPolyline() without further search.
+	 * @param plys the polylines the nearest mesh nodes are searched for
+	 */
+	void searchMeshNodesAlongPolylines(std::vector<GeoLib::Polyline*> const& plys);
+
+	/**
+	 * Searches the mesh nodes along all given surfaces. The surfaces not
+	 * processed before are searched in parallel. Afterwards the results are
+	 * available via getMeshNodesAlongSurface() without further search.
+	 * @param sfcs the surfaces the mesh nodes are searched for
+	 */
+	void searchMeshNodesAlongSurfaces(std::vector<GeoLib::Surface*> const& sfcs);
+
 private:
-	MeshLib::Mesh const& _mesh;
-	GeoLib::Grid<MeshLib::Node> _mesh_grid;
+	/// Returns the already computed search result for the polyline or nullptr.
+	MeshNodesAlongPolyline* findMeshNodesAlongPolyline(GeoLib::Polyline const& ply) const;
+
+	/// Returns the already computed search result for the surface or nullptr.
+	MeshNodesAlongSurface* findMeshNodesAlongSurface(GeoLib::Surface const& sfc) const;
+
+	/// Searches the mesh nodes along the polyline. The method does not modify
+	/// the searcher and can be called concurrently.
+	MeshNodesAlongPolyline* createMeshNodesAlongPolyline(GeoLib::Polyline const& ply) const;
+
+	/// Searches the mesh nodes along the surface. The method does not modify
+	/// the searcher and can be called concurrently.
+	MeshNodesAlongSurface* createMeshNodesAlongSurface(GeoLib::Surface const& sfc) const;
+
+	/// Sets the search length to a fraction of the mean edge length, where
+	/// the fraction is decreasing with the standard deviation of the edge
+	/// lengths.
+	void setSearchLength(double sum, double sum_of_sqr, std::size_t edge_cnt,
+			std::string const& mesh_name);
+
+	/// Exactly one of _mesh and _compact_mesh is set.
+	MeshLib::Mesh const* const _mesh;
+	MeshLib::CompactMesh const* const _compact_mesh;
+	std::unique_ptr<GeoLib::Grid<MeshLib::Node>> _mesh_grid;
+	std::unique_ptr<GeoLib::Grid<MeshLib::CompactNode>> _compact_mesh_grid;
 	double _search_length;
 	// with newer compiler we can omit to use a pointer here
 	std::vector<MeshNodesAlongPolyline*> _mesh_nodes_along_polylines;
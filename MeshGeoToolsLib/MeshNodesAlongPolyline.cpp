@@ -19,16 +19,43 @@
 #include "MathTools.h"
 
 #include <algorithm>
+#include <unordered_set>
+#include <utility>
 
 namespace MeshGeoToolsLib
 {
 MeshNodesAlongPolyline::MeshNodesAlongPolyline(
-		std::vector<MeshLib::Node*> const& mesh_nodes,
+		GeoLib::Grid<MeshLib::Node> const& mesh_grid,
 		GeoLib::Polyline const& ply,
 		double epsilon_radius) :
 	_ply(ply)
 {
-	const std::size_t n_nodes (mesh_nodes.size());
+	searchNodes(mesh_grid,
+		[](MeshLib::Node const* node) { return node->getID(); },
+		epsilon_radius);
+}
+
+MeshNodesAlongPolyline::MeshNodesAlongPolyline(
+		MeshLib::CompactMesh const& mesh,
+		GeoLib::Grid<MeshLib::CompactNode> const& mesh_grid,
+		GeoLib::Polyline const& ply,
+		double epsilon_radius) :
+	_ply(ply)
+{
+	searchNodes(mesh_grid,
+		[&mesh](MeshLib::CompactNode const* node) { return mesh.getNodeID(node); },
+		epsilon_radius);
+}
+
+template <typename POINT, typename GetID>
+void MeshNodesAlongPolyline::searchNodes(GeoLib::Grid<POINT> const& mesh_grid,
+		GetID const& get_id, double epsilon_radius)
+{
+	std::unordered_set<std::size_t> found_ids;
+	std::vector<std::vector<POINT*> const*> cells;
+	// ids and distances of the nodes found along the current line segment
+	std::vector<std::pair<std::size_t, double>> segment_nodes;
+
 	// loop over all line segments of the polyline
 	for (size_t k = 0; k < _ply.getNumberOfPoints() - 1; k++) {
 		double act_length_of_ply(_ply.getLength(k));
@@ -36,26 +63,47 @@ MeshNodesAlongPolyline::MeshNodesAlongPolyline(
 		double lower_lambda (- epsilon_radius / seg_length);
 		double upper_lambda (1 + epsilon_radius / seg_length);
 
-		// loop over all nodes
-		for (size_t j = 0; j < n_nodes; j++) {
-			double dist, lambda;
-
-			// is the orthogonal projection of the j-th node to the
-			// line g(lambda) = _ply->getPoint(k) + lambda * (_ply->getPoint(k+1) - _ply->getPoint(k))
-			// at the k-th line segment of the polyline, i.e. 0 <= lambda <= 1?
-			if (MathLib::calcProjPntToLineAndDists(mesh_nodes[j]->getCoords(),
-							(_ply.getPoint(k))->getCoords(), (_ply.getPoint(k + 1))->getCoords(),
-							lambda, dist) <= epsilon_radius) {
-				if (lower_lambda <= lambda && lambda <= upper_lambda) {
-					// check if node id is already in the vector
-					if (std::find(_msh_node_ids.begin(), _msh_node_ids.end(),
-									mesh_nodes[j]->getID()) == _msh_node_ids.end()) {
-						_msh_node_ids.push_back(mesh_nodes[j]->getID());
-						_dist_of_proj_node_from_ply_start.push_back(act_length_of_ply + dist);
-					}
-				} // end if lambda
+		// bounding box of the tube around the line segment, the projection
+		// of a node may lie up to epsilon_radius beyond the segment end points
+		GeoLib::Point const& a(*_ply.getPoint(k));
+		GeoLib::Point const& b(*_ply.getPoint(k + 1));
+		double min_coords[3], max_coords[3];
+		for (std::size_t d = 0; d < 3; d++) {
+			min_coords[d] = std::min(a[d], b[d]) - 2 * epsilon_radius;
+			max_coords[d] = std::max(a[d], b[d]) + 2 * epsilon_radius;
+		}
+		cells.clear();
+		mesh_grid.getPntVecsOfGridCellsIntersectingCuboid(
+			POINT(min_coords), POINT(max_coords), cells);
+
+		// loop over the nodes in the grid cells
+		segment_nodes.clear();
+		for (auto const* cell : cells) {
+			for (auto const* node : *cell) {
+				double dist, lambda;
+
+				// is the orthogonal projection of the node to the
+				// line g(lambda) = _ply->getPoint(k) + lambda * (_ply->getPoint(k+1) - _ply->getPoint(k))
+				// at the k-th line segment of the polyline, i.e. 0 <= lambda <= 1?
+				if (MathLib::calcProjPntToLineAndDists(node->getCoords(),
+								a.getCoords(), b.getCoords(),
+								lambda, dist) <= epsilon_radius) {
+					if (lower_lambda <= lambda && lambda <= upper_lambda) {
+						segment_nodes.push_back(std::make_pair(get_id(node), act_length_of_ply + dist));
+					} // end if lambda
+				}
+			} // end node loop
+		} // end cell loop
+
+		// keep the order of the node ids within one segment independent of
+		// the grid cell traversal
+		std::sort(segment_nodes.begin(), segment_nodes.end());
+		for (auto const& id_dist : segment_nodes) {
+			if (found_ids.insert(id_dist.first).second) {
+				_msh_node_ids.push_back(id_dist.first);
+				_dist_of_proj_node_from_ply_start.push_back(id_dist.second);
 			}
-		} // end node loop
+		}
 	} // end line segment loop
 
 	// sort the nodes along the polyline according to their distances
@@ -16,10 +16,12 @@
 #include <vector>
 
 // GeoLib
+#include "Grid.h"
 #include "Polyline.h"
 
 // MeshLib
 #include "Node.h"
+#include "CompactMesh.h"
 
 namespace MeshGeoToolsLib
 {
@@ -35,12 +37,24 @@ public:
 	/**
 	 * Constructor of object, that search mesh nodes along a
 	 * GeoLib::Polyline polyline within a given search radius. So the polyline
-	 * is something like a tube.
-	 * @param mesh_nodes Nodes the search will be performed on.
+	 * is something like a tube. For every line segment only the nodes in the
+	 * grid cells intersecting the bounding box of the tube segment are tested.
+	 * @param mesh_grid Grid of the nodes the search will be performed on.
 	 * @param ply Along the GeoLib::Polyline ply the mesh nodes are searched.
 	 * @param epsilon_radius Search / tube radius
 	 */
-	MeshNodesAlongPolyline(std::vector<MeshLib::Node*> const& mesh_nodes,
+	MeshNodesAlongPolyline(GeoLib::Grid<MeshLib::Node> const& mesh_grid,
+			GeoLib::Polyline const& ply, double epsilon_radius);
+	/**
+	 * Constructor of object, that search the nodes of a compact mesh along a
+	 * GeoLib::Polyline polyline within a given search radius.
+	 * @param mesh Mesh the search will be performed on.
+	 * @param mesh_grid Grid of the nodes of the compact mesh.
+	 * @param ply Along the GeoLib::Polyline ply the mesh nodes are searched.
+	 * @param epsilon_radius Search / tube radius
+	 */
+	MeshNodesAlongPolyline(MeshLib::CompactMesh const& mesh,
+			GeoLib::Grid<MeshLib::CompactNode> const& mesh_grid,
 			GeoLib::Polyline const& ply, double epsilon_radius);
 	/**
 	 * Access the vector of mesh node ids.
@@ -56,6 +70,17 @@ public:
 	std::vector<double> const & getDistOfProjNodeFromPlyStart() const;
 
 private:
+	/**
+	 * Searches the nodes within the tube around the polyline and sorts them
+	 * along the polyline.
+	 * @param mesh_grid grid of the mesh nodes
+	 * @param get_id get_id(p) returns the mesh node id of the node p
+	 * @param epsilon_radius Search / tube radius
+	 */
+	template <typename POINT, typename GetID>
+	void searchNodes(GeoLib::Grid<POINT> const& mesh_grid,
+			GetID const& get_id, double epsilon_radius);
+
 	GeoLib::Polyline const& _ply;
 	std::vector<std::size_t> _msh_node_ids;
 	std::vector<double> _dist_of_proj_node_from_ply_start;
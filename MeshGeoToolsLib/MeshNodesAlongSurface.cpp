@@ -13,6 +13,7 @@
 #include "MeshNodesAlongSurface.h"
 
 #include <algorithm>
+#include <unordered_set>
 
 #include "quicksort.h"
 #include "MathTools.h"
@@ -22,17 +23,72 @@ namespace MeshGeoToolsLib
 {
 
 MeshNodesAlongSurface::MeshNodesAlongSurface(
-		std::vector<MeshLib::Node*> const& mesh_nodes,
+		GeoLib::Grid<MeshLib::Node> const& mesh_grid,
 		GeoLib::Surface const& sfc) :
 	_sfc(sfc)
 {
-	for (auto* node : mesh_nodes) {
-		if (!sfc.isPntInBoundingVolume(node->getCoords()))
-			continue;
-		if (sfc.isPntInSfc(node->getCoords())) {
-			_msh_node_ids.push_back(node->getID());
+	searchNodes(mesh_grid,
+		[](MeshLib::Node const* node) { return node->getID(); });
+}
+
+MeshNodesAlongSurface::MeshNodesAlongSurface(
+		MeshLib::CompactMesh const& mesh,
+		GeoLib::Grid<MeshLib::CompactNode> const& mesh_grid,
+		GeoLib::Surface const& sfc) :
+	_sfc(sfc)
+{
+	searchNodes(mesh_grid,
+		[&mesh](MeshLib::CompactNode const* node) { return mesh.getNodeID(node); });
+}
+
+template <typename POINT, typename GetID>
+void MeshNodesAlongSurface::searchNodes(GeoLib::Grid<POINT> const& mesh_grid,
+		GetID const& get_id)
+{
+	std::unordered_set<std::size_t> found_ids;
+	std::vector<std::vector<POINT*> const*> cells;
+
+	const std::size_t n_triangles (_sfc.getNTriangles());
+	for (std::size_t t = 0; t < n_triangles; t++) {
+		GeoLib::Triangle const& tri (*_sfc[t]);
+
+		// The triangle test accepts points slightly outside of the triangle:
+		// the triangle is enlarged by one percent around its centroid and
+		// points off the triangle plane are accepted within 1e-3 (relative
+		// to the longest edge for triangles parallel to a coordinate plane).
+		double min_coords[3], max_coords[3];
+		for (std::size_t d = 0; d < 3; d++) {
+			min_coords[d] = std::min(std::min((*tri.getPoint(0))[d], (*tri.getPoint(1))[d]),
+				(*tri.getPoint(2))[d]);
+			max_coords[d] = std::max(std::max((*tri.getPoint(0))[d], (*tri.getPoint(1))[d]),
+				(*tri.getPoint(2))[d]);
+		}
+		double const diag (sqrt(MathLib::sqrDist(min_coords, max_coords)));
+		double const eps (0.02 * diag + 1e-3);
+		for (std::size_t d = 0; d < 3; d++) {
+			min_coords[d] -= eps;
+			max_coords[d] += eps;
+		}
+		cells.clear();
+		mesh_grid.getPntVecsOfGridCellsIntersectingCuboid(
+			POINT(min_coords), POINT(max_coords), cells);
+
+		for (auto const* cell : cells) {
+			for (auto const* node : *cell) {
+				std::size_t const id (get_id(node));
+				if (found_ids.count(id))
+					continue;
+				GeoLib::Point const pnt (node->getCoords());
+				if (!_sfc.isPntInBoundingVolume(pnt))
+					continue;
+				if (tri.containsPoint(pnt))
+					found_ids.insert(id);
+			}
 		}
 	}
+
+	_msh_node_ids.assign(found_ids.cbegin(), found_ids.cend());
+	std::sort(_msh_node_ids.begin(), _msh_node_ids.end());
 }
 
 std::vector<std::size_t> const& MeshNodesAlongSurface::getNodeIDs () const
@@ -16,10 +16,12 @@
 #include <vector>
 
 // GeoLib
+#include "Grid.h"
 #include "Surface.h"
 
 // MeshLib
 #include "Node.h"
+#include "CompactMesh.h"
 
 namespace MeshGeoToolsLib
 {
@@ -31,11 +33,23 @@ class MeshNodesAlongSurface
 public:
 	/**
 	 * Constructor of object, that search mesh nodes along a
-	 * GeoLib::Surface object within a given search radius.
-	 * @param mesh_nodes Nodes the search will be performed on.
+	 * GeoLib::Surface object within a given search radius. For every triangle
+	 * of the surface only the nodes in the grid cells intersecting the
+	 * bounding box of the triangle are tested.
+	 * @param mesh_grid Grid of the nodes the search will be performed on.
 	 * @param sfc Along the GeoLib::Surface sfc the mesh nodes are searched.
 	 */
-	MeshNodesAlongSurface(std::vector<MeshLib::Node*> const& mesh_nodes,
+	MeshNodesAlongSurface(GeoLib::Grid<MeshLib::Node> const& mesh_grid,
+			GeoLib::Surface const& sfc);
+	/**
+	 * Constructor of object, that search the nodes of a compact mesh along a
+	 * GeoLib::Surface object.
+	 * @param mesh Mesh the search will be performed on.
+	 * @param mesh_grid Grid of the nodes of the compact mesh.
+	 * @param sfc Along the GeoLib::Surface sfc the mesh nodes are searched.
+	 */
+	MeshNodesAlongSurface(MeshLib::CompactMesh const& mesh,
+			GeoLib::Grid<MeshLib::CompactNode> const& mesh_grid,
 			GeoLib::Surface const& sfc);
 	/**
 	 * Access the vector of mesh node ids.
@@ -50,6 +64,15 @@ public:
 	GeoLib::Surface const& getSurface () const;
 
 private:
+	/**
+	 * Searches the nodes located on the surface triangles. The node ids are
+	 * sorted ascending.
+	 * @param mesh_grid grid of the mesh nodes
+	 * @param get_id get_id(p) returns the mesh node id of the node p
+	 */
+	template <typename POINT, typename GetID>
+	void searchNodes(GeoLib::Grid<POINT> const& mesh_grid, GetID const& get_id);
+
 	GeoLib::Surface const& _sfc;
 	std::vector<std::size_t> _msh_node_ids;
 };
@@ -0,0 +1,147 @@
+/**
+ * \file
+ * \brief  Implementation of the CompactMesh class.
+ *
+ * \copyright
+ * Copyright (c) 2013, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#include "CompactMesh.h"
+
+#include <cmath>
+#include <utility>
+
+#include "MathTools.h"
+
+#include "Mesh.h"
+#include "Node.h"
+#include "Elements/Element.h"
+#include "Elements/Hex.h"
+#include "Elements/Line.h"
+#include "Elements/Prism.h"
+#include "Elements/Pyramid.h"
+#include "Elements/Quad.h"
+#include "Elements/Tet.h"
+#include "Elements/Tri.h"
+
+namespace MeshLib
+{
+
+namespace
+{
+typedef std::pair<unsigned const (*)[2], unsigned> EdgeTable;
+
+template <std::size_t N_EDGES>
+EdgeTable makeEdgeTable(unsigned const (&edge_nodes)[N_EDGES][2])
+{
+	return EdgeTable(edge_nodes, N_EDGES);
+}
+
+/// Returns the local edge node table of the element class and the number of
+/// edges for the given element type.
+EdgeTable getEdgeTable(MeshElemType t)
+{
+	switch (t)
+	{
+	case MeshElemType::LINE:
+		return makeEdgeTable(Line::getEdgeNodeTable());
+	case MeshElemType::TRIANGLE:
+		return makeEdgeTable(Tri::getEdgeNodeTable());
+	case MeshElemType::QUAD:
+		return makeEdgeTable(Quad::getEdgeNodeTable());
+	case MeshElemType::TETRAHEDRON:
+		return makeEdgeTable(Tet::getEdgeNodeTable());
+	case MeshElemType::HEXAHEDRON:
+		return makeEdgeTable(Hex::getEdgeNodeTable());
+	case MeshElemType::PRISM:
+		return makeEdgeTable(Prism::getEdgeNodeTable());
+	case MeshElemType::PYRAMID:
+		return makeEdgeTable(Pyramid::getEdgeNodeTable());
+	default:
+		return EdgeTable(nullptr, 0u);
+	}
+}
+}
+
+CompactMesh::CompactMesh(Mesh const& mesh)
+	: _name(mesh.getName()),
+	  _element_offsets(mesh.getNElements() + 1, 0),
+	  _cell_types(mesh.getNElements()),
+	  _values(mesh.getNElements())
+{
+	std::vector<Node*> const& nodes (mesh.getNodes());
+	_nodes.reserve(nodes.size());
+	for (std::size_t i=0; i<nodes.size(); ++i)
+		_nodes.emplace_back(nodes[i]->getCoords());
+
+	std::vector<Element*> const& elements (mesh.getElements());
+	const long nElements (elements.size());
+	for (long i=0; i<nElements; ++i)
+		_element_offsets[i+1] = _element_offsets[i] + elements[i]->getNNodes(true);
+	_element_node_ids.resize(_element_offsets.back());
+
+#ifdef _OPENMP
+	#pragma omp parallel for schedule(static)
+#endif
+	for (long i=0; i<nElements; ++i)
+	{
+		Element const& e (*elements[i]);
+		const unsigned nElemNodes (e.getNNodes(true));
+		for (unsigned k=0; k<nElemNodes; ++k)
+			_element_node_ids[_element_offsets[i] + k] = e.getNode(k)->getID();
+		_cell_types[i] = static_cast<unsigned char>(e.getCellType());
+		_values[i] = e.getValue();
+	}
+}
+
+CompactMesh::CompactMesh(std::string const& name,
+                         std::vector<CompactNode> nodes,
+                         std::vector<std::size_t> element_offsets,
+                         std::vector<unsigned> element_node_ids,
+                         std::vector<CellType> const& cell_types,
+                         std::vector<unsigned> values)
+	: _name(name), _nodes(std::move(nodes)),
+	  _element_offsets(std::move(element_offsets)),
+	  _element_node_ids(std::move(element_node_ids)),
+	  _cell_types(cell_types.size()),
+	  _values(std::move(values))
+{
+	assert(_element_offsets.size() == cell_types.size() + 1);
+	assert(_element_offsets.back() == _element_node_ids.size());
+	assert(_values.size() == cell_types.size());
+	for (std::size_t i=0; i<cell_types.size(); ++i)
+		_cell_types[i] = static_cast<unsigned char>(cell_types[i]);
+}
+
+unsigned CompactMesh::getNElementNodes(std::size_t element_id, bool all) const
+{
+	if (all)
+		return _element_offsets[element_id + 1] - _element_offsets[element_id];
+	return getNMeshElemTypeNodes(getElementType(element_id));
+}
+
+MeshElemType CompactMesh::getElementType(std::size_t element_id) const
+{
+	return CellType2MeshElemType(getCellType(element_id));
+}
+
+unsigned CompactMesh::getNElementEdges(std::size_t element_id) const
+{
+	return getEdgeTable(getElementType(element_id)).second;
+}
+
+double CompactMesh::getElementEdgeLength(std::size_t element_id, unsigned edge_id) const
+{
+	auto const edges (getEdgeTable(getElementType(element_id)));
+	assert(edge_id < edges.second);
+	NodeIDs const node_ids (getElementNodeIDs(element_id));
+	return std::sqrt(MathLib::sqrDist(
+		_nodes[node_ids[edges.first[edge_id][0]]].getCoords(),
+		_nodes[node_ids[edges.first[edge_id][1]]].getCoords()));
+}
+
+} /* namespace */
@@ -0,0 +1,211 @@
+/**
+ * \file
+ * \brief  Definition of the CompactMesh class.
+ *
+ * \copyright
+ * Copyright (c) 2013, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#ifndef COMPACTMESH_H_
+#define COMPACTMESH_H_
+
+#include <cassert>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "MathLib/LinAlg/RowColumnIndices.h"
+
+#include "MeshEnums.h"
+
+namespace MeshLib
+{
+class Mesh;
+
+/**
+ * Coordinates of a node of a CompactMesh. The class has no further members,
+ * i.e. a vector of CompactNode objects is one contiguous array of x, y, z
+ * triples. The id of a node is its position within the mesh node vector.
+ */
+class CompactNode
+{
+public:
+	typedef double FP_T;
+
+	CompactNode(double x, double y, double z)
+	{
+		_x[0] = x;
+		_x[1] = y;
+		_x[2] = z;
+	}
+
+	CompactNode(double const* coords)
+	{
+		_x[0] = coords[0];
+		_x[1] = coords[1];
+		_x[2] = coords[2];
+	}
+
+	double const* getCoords() const { return _x; }
+
+	double& operator[](std::size_t i) { return _x[i]; }
+	double const& operator[](std::size_t i) const { return _x[i]; }
+
+private:
+	double _x[3];
+};
+
+static_assert(sizeof(CompactNode) == 3 * sizeof(double),
+              "CompactNode objects have to be stored without padding.");
+
+/**
+ * Structure-of-arrays mesh representation.
+ *
+ * In contrast to the MeshLib::Mesh no node or element objects are created.
+ * The node coordinates are stored in one contiguous array, the element
+ * connectivity as offsets and node ids (like the row pointers and column
+ * indices of a CRS matrix), and the cell types and material ids of the
+ * elements in plain arrays. This needs a few bytes per node and element
+ * instead of several hundred, therefore large meshes can be held in memory
+ * for the geometric search, the coordinate mapping of elements (see
+ * CompactElement) and the output.
+ */
+class CompactMesh
+{
+public:
+	/// Node ids of one element.
+	typedef MathLib::IndexView<unsigned> NodeIDs;
+
+	/// Copies the geometry and topology of the given mesh.
+	explicit CompactMesh(Mesh const& mesh);
+
+	/**
+	 * Constructs the mesh directly from the arrays.
+	 * @param name             the mesh name
+	 * @param nodes            node coordinates
+	 * @param element_offsets  positions of the first node id of each element
+	 *                         in element_node_ids, n_elements+1 entries
+	 * @param element_node_ids ids of all (including non-linear) element nodes
+	 * @param cell_types       cell type of each element
+	 * @param values           material ids of the elements
+	 */
+	CompactMesh(std::string const& name,
+	            std::vector<CompactNode> nodes,
+	            std::vector<std::size_t> element_offsets,
+	            std::vector<unsigned> element_node_ids,
+	            std::vector<CellType> const& cell_types,
+	            std::vector<unsigned> values);
+
+	/// Get name of the mesh.
+	std::string const& getName() const { return _name; }
+
+	/// Get the number of nodes.
+	std::size_t getNNodes() const { return _nodes.size(); }
+
+	/// Get the number of elements.
+	std::size_t getNElements() const { return _cell_types.size(); }
+
+	/// Get the node with the given index.
+	CompactNode const& getNode(std::size_t idx) const { return _nodes[idx]; }
+
+	/// Get the nodes vector.
+	std::vector<CompactNode> const& getNodes() const { return _nodes; }
+
+	/// Coordinates of all nodes, x, y, z of node i are at positions 3i, 3i+1,
+	/// 3i+2.
+	double const* getCoordinates() const
+	{
+		return reinterpret_cast<double const*>(_nodes.data());
+	}
+
+	/// Returns the id of a node of this mesh.
+	std::size_t getNodeID(CompactNode const* node) const
+	{
+		assert(_nodes.data() <= node && node < _nodes.data() + _nodes.size());
+		return node - _nodes.data();
+	}
+
+	/// Ids of all nodes of the element including the non-linear nodes.
+	NodeIDs getElementNodeIDs(std::size_t element_id) const
+	{
+		return NodeIDs(_element_node_ids.data() + _element_offsets[element_id],
+		               _element_node_ids.data() + _element_offsets[element_id + 1]);
+	}
+
+	/// Get the number of nodes of the element, by default only the base nodes.
+	unsigned getNElementNodes(std::size_t element_id, bool all = false) const;
+
+	/// Get the cell type of the element.
+	CellType getCellType(std::size_t element_id) const
+	{
+		return static_cast<CellType>(_cell_types[element_id]);
+	}
+
+	/// Get the geometric type of the element.
+	MeshElemType getElementType(std::size_t element_id) const;
+
+	/// Get the material id of the element.
+	unsigned getElementValue(std::size_t element_id) const { return _values[element_id]; }
+
+	/// Get the number of edges of the element.
+	unsigned getNElementEdges(std::size_t element_id) const;
+
+	/// Get the length of the edge with the given local id of the element.
+	double getElementEdgeLength(std::size_t element_id, unsigned edge_id) const;
+
+private:
+	std::string _name;
+	std::vector<CompactNode> _nodes;
+	std::vector<std::size_t> _element_offsets;
+	std::vector<unsigned> _element_node_ids;
+	std::vector<unsigned char> _cell_types;
+	std::vector<unsigned> _values;
+};
+
+/**
+ * Light-weight view on an element of a CompactMesh with the interface
+ * required by NumLib::NaturalCoordinatesMapping. The template parameter is the
+ * corresponding MeshLib element type, e.g. MeshLib::Quad, which determines
+ * the dimension and number of nodes.
+ */
+template <typename MESH_ELEMENT>
+class CompactElement
+{
+public:
+	static const unsigned dimension;
+	static const unsigned n_all_nodes = MESH_ELEMENT::n_all_nodes;
+	static const unsigned n_base_nodes = MESH_ELEMENT::n_base_nodes;
+
+	CompactElement(CompactMesh const& mesh, std::size_t element_id)
+		: _mesh(mesh), _node_ids(mesh.getElementNodeIDs(element_id))
+	{
+		assert(_node_ids.size() == n_all_nodes);
+	}
+
+	CompactNode const* getNode(unsigned i) const
+	{
+		return &_mesh.getNode(_node_ids[i]);
+	}
+
+	unsigned getNNodes(bool all = false) const
+	{
+		if (all)
+			return n_all_nodes;
+		return n_base_nodes;
+	}
+
+private:
+	CompactMesh const& _mesh;
+	CompactMesh::NodeIDs const _node_ids;
+};
+
+template <typename MESH_ELEMENT>
+const unsigned CompactElement<MESH_ELEMENT>::dimension = MESH_ELEMENT::dimension;
+
+} /* namespace */
+
+#endif /* COMPACTMESH_H_ */
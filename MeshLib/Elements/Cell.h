@@ -41,6 +41,22 @@ public:
 	/// Returns true if the cell is somewhere on the mesh surface and false otherwise.
 	bool isOnSurface() const;
 
+	/**
+	 * Returns a node of a face without creating the face element like getFace() does.
+	 * @param face_id the id of the face, less than getNFaces()
+	 * @param node_id the id of the node within the face, less than getNFaceNodes(face_id)
+	 * @return a pointer to the internal Node
+	 */
+	virtual Node* getFaceNode(unsigned face_id, unsigned node_id) const = 0;
+
+	/**
+	 * Check if the 3d GeoLib::Point is inside of the element.
+	 * @param pnt the 3d GeoLib::Point object
+	 * @param eps tolerance for the barycentric coordinates of the point
+	 * @return true if the point is inside the element, false otherwise
+	 */
+	virtual bool isPntInside(GeoLib::Point const& pnt, double eps = std::numeric_limits<double>::epsilon()) const = 0;
+
 	/// Destructor
 	virtual ~Cell();
 
@@ -20,6 +20,8 @@
 
 #include "MathTools.h"
 
+#include "AnalyticalGeometry.h"
+
 namespace MeshLib {
 
 template <unsigned NNODES, CellType CELLHEXTYPE>
@@ -139,6 +141,18 @@ bool TemplateHex<NNODES,CELLHEXTYPE>::isEdge(unsigned idx1, unsigned idx2) const
 	return false;
 }
 
+template <unsigned NNODES, CellType CELLHEXTYPE>
+bool TemplateHex<NNODES,CELLHEXTYPE>::isPntInside(GeoLib::Point const& pnt, double eps) const
+{
+	// decomposition of the hexahedron into six tetrahedra around the diagonal 0-6
+	return (GeoLib::isPointInTetrahedron(pnt, *_nodes[0], *_nodes[1], *_nodes[2], *_nodes[6], eps) ||
+	        GeoLib::isPointInTetrahedron(pnt, *_nodes[0], *_nodes[2], *_nodes[3], *_nodes[6], eps) ||
+	        GeoLib::isPointInTetrahedron(pnt, *_nodes[0], *_nodes[3], *_nodes[7], *_nodes[6], eps) ||
+	        GeoLib::isPointInTetrahedron(pnt, *_nodes[0], *_nodes[7], *_nodes[4], *_nodes[6], eps) ||
+	        GeoLib::isPointInTetrahedron(pnt, *_nodes[0], *_nodes[4], *_nodes[5], *_nodes[6], eps) ||
+	        GeoLib::isPointInTetrahedron(pnt, *_nodes[0], *_nodes[5], *_nodes[1], *_nodes[6], eps));
+}
+
 template <unsigned NNODES, CellType CELLHEXTYPE>
 Element* TemplateHex<NNODES,CELLHEXTYPE>::clone() const
 {
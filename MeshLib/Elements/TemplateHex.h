@@ -74,9 +74,19 @@ public:
 	/// Get the number of edges for this element.
 	unsigned getNEdges() const { return 12; };
 
+	/// Local node ids of the edges of this element type, row i holds the
+	/// two nodes of edge i.
+	static unsigned const (&getEdgeNodeTable())[12][2] { return _edge_nodes; }
+
 	/// Get the number of nodes for face i.
 	unsigned getNFaceNodes(unsigned i) const { (void)i; return 4; };
 
+	/// Returns the node node_id of face face_id.
+	Node* getFaceNode(unsigned face_id, unsigned node_id) const
+	{
+		return _nodes[_face_nodes[face_id][node_id]];
+	}
+
 	/// Get the number of faces for this element.
 	unsigned getNFaces() const { return 6; };
 
@@ -104,6 +114,14 @@ public:
 	/// Returns true if these two indices form an edge and false otherwise
 	bool isEdge(unsigned i, unsigned j) const;
 
+	/**
+	 * Check if the 3d GeoLib::Point is inside of the element.
+	 * @param pnt the 3d GeoLib::Point object
+	 * @param eps tolerance for the barycentric coordinates of the point
+	 * @return true if the point is inside the element, false otherwise
+	 */
+	virtual bool isPntInside(GeoLib::Point const& pnt, double eps = std::numeric_limits<double>::epsilon()) const;
+
 	/**
 	 * Tests if the element is geometrically valid.
 	 * @param check_zero_volume indicates if volume == 0 should be checked
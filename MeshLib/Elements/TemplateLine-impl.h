@@ -14,6 +14,9 @@
 
 namespace MeshLib
 {
+template<unsigned NNODES, CellType CELLLINETYPE>
+const unsigned TemplateLine<NNODES,CELLLINETYPE>::_edge_nodes[1][2] = { {0, 1} };
+
 template<unsigned NNODES, CellType CELLLINETYPE>
 TemplateLine<NNODES,CELLLINETYPE>::TemplateLine(std::array<Node*, NNODES> const& nodes,
                                                 unsigned value, std::size_t id)
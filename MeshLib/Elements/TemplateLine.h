@@ -80,6 +80,10 @@ public:
 	/// 1D elements have no edges
 	unsigned getNEdges() const { return 1; };
 
+	/// Local node ids of the edges of this element type, row i holds the
+	/// two nodes of edge i.
+	static unsigned const (&getEdgeNodeTable())[1][2] { return _edge_nodes; }
+
 	/// Get the number of nodes for face i.
 	unsigned getNFaceNodes(unsigned /*i*/) const { return 0; };
 
@@ -143,6 +147,9 @@ protected:
 		return sqrt(MathLib::sqrDist(_nodes[0]->getCoords(), _nodes[1]->getCoords()));
 	}
 
+	/// Local node ids of the only edge.
+	static const unsigned _edge_nodes[1][2];
+
 	/// Returns the specified node.
 	Node* getEdgeNode(unsigned edge_id, unsigned node_id) const 
 	{ 
@@ -68,6 +68,10 @@ public:
 	/// Get the number of edges for this element.
 	unsigned getNEdges() const { return 3; };
 
+	/// Local node ids of the edges of this element type, row i holds the
+	/// two nodes of edge i.
+	static unsigned const (&getEdgeNodeTable())[3][2] { return _edge_nodes; }
+
 	/// Get the number of neighbors for this element.
 	unsigned getNNeighbors() const { return 3; };
 
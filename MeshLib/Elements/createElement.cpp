@@ -0,0 +1,53 @@
+/**
+ * \file
+ * \brief  Implementation of the createElement function.
+ *
+ * \copyright
+ * Copyright (c) 2013, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#include "createElement.h"
+
+#include "Hex.h"
+#include "Line.h"
+#include "Prism.h"
+#include "Pyramid.h"
+#include "Quad.h"
+#include "Tet.h"
+#include "Tri.h"
+
+namespace MeshLib
+{
+
+Element* createElement(CellType type, Node** nodes, unsigned value)
+{
+	switch (type)
+	{
+	case CellType::LINE2:
+		return new Line(nodes, value);
+	case CellType::TRI3:
+		return new Tri(nodes, value);
+	case CellType::QUAD4:
+		return new Quad(nodes, value);
+	case CellType::QUAD8:
+		return new Quad8(nodes, value);
+	case CellType::QUAD9:
+		return new Quad9(nodes, value);
+	case CellType::TET4:
+		return new Tet(nodes, value);
+	case CellType::HEX8:
+		return new Hex(nodes, value);
+	case CellType::PRISM6:
+		return new Prism(nodes, value);
+	case CellType::PYRAMID5:
+		return new Pyramid(nodes, value);
+	default:
+		return nullptr;
+	}
+}
+
+} // end namespace MeshLib
@@ -0,0 +1,32 @@
+/**
+ * \file
+ * \brief  Definition of the createElement function.
+ *
+ * \copyright
+ * Copyright (c) 2013, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#ifndef CREATEELEMENT_H_
+#define CREATEELEMENT_H_
+
+#include "MeshEnums.h"
+
+namespace MeshLib
+{
+class Element;
+class Node;
+
+/**
+ * Creates an element of the given cell type. The node array has to contain
+ * getNCellTypeNodes(type) nodes and is deleted by the element.
+ * @return the element or nullptr if the cell type is not supported
+ */
+Element* createElement(CellType type, Node** nodes, unsigned value = 0);
+
+} // end namespace MeshLib
+
+#endif /* CREATEELEMENT_H_ */
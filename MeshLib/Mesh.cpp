@@ -14,7 +14,13 @@
 
 #include "Mesh.h"
 
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
 #include "Node.h"
+#include "NodeAdjacency.h"
+#include "Elements/Cell.h"
 #include "Elements/Tri.h"
 #include "Elements/Quad.h"
 #include "Elements/Tet.h"
@@ -24,6 +30,7 @@
 
 #include "logog/include/logog.hpp"
 
+#include "Profiler.h"
 #include "RunTime.h"
 #include "uniqueInsert.h"
 
@@ -35,6 +42,7 @@ Mesh::Mesh(const std::string &name,
            const std::vector<Element*> &elements)
 	: _id(_counter_value), _mesh_dimension(0), _name(name), _nodes(nodes), _elements(elements)
 {
+	BASELIB_PROFILE_SCOPE("Mesh::Mesh");
 	this->resetNodeIDs();
 	this->resetElementIDs();
 	this->setDimension();
@@ -48,6 +56,26 @@ Mesh::Mesh(const std::string &name,
 	this->calcEdgeLengthRange();
 }
 
+Mesh::Mesh(const std::string &name,
+           const std::vector<Node*> &nodes,
+           const std::vector<Element*> &elements,
+           const std::vector<std::size_t> &node_element_offsets,
+           const std::vector<unsigned> &node_element_ids,
+           const std::vector<unsigned> &neighbor_ids,
+           const double edge_length[2])
+	: _id(_counter_value), _mesh_dimension(0), _name(name), _nodes(nodes), _elements(elements)
+{
+	BASELIB_PROFILE_SCOPE("Mesh::Mesh");
+	this->resetNodeIDs();
+	this->resetElementIDs();
+	this->setDimension();
+	this->setElementsConnectedToNodes(node_element_offsets, node_element_ids);
+	this->setElementNeighbors(neighbor_ids);
+
+	_edge_length[0] = edge_length[0];
+	_edge_length[1] = edge_length[1];
+}
+
 Mesh::Mesh(const Mesh &mesh)
 	: _id(_counter_value), _mesh_dimension(mesh.getDimension()),
 	  _name(mesh.getName()), _nodes(mesh.getNNodes()), _elements(mesh.getNElements())
@@ -73,7 +101,9 @@ Mesh::Mesh(const Mesh &mesh)
 	this->setElementsConnectedToNodes();
 	//this->setNodesConnectedByEdges();
 	//this->setNodesConnectedByElements();
-	this->setElementNeighbors();
+	this->copyElementNeighbors(mesh);
+	if (mesh._node_adjacency)
+		_node_adjacency.reset(new NodeAdjacency(*mesh._node_adjacency));
 }
 
 Mesh::~Mesh()
@@ -90,11 +120,13 @@ Mesh::~Mesh()
 void Mesh::addNode(Node* node)
 {
 	_nodes.push_back(node);
+	_node_adjacency.reset();
 }
 
 void Mesh::addElement(Element* elem)
 {
 	_elements.push_back(elem);
+	_node_adjacency.reset();
 
 	// add element information to nodes
 	unsigned nNodes (elem->getNNodes());
@@ -109,6 +141,17 @@ void Mesh::resetNodeIDs()
 		_nodes[i]->setID(i);
 }
 
+void Mesh::reorderNodes(std::vector<std::size_t> const& op_perm)
+{
+	assert(op_perm.size() == _nodes.size());
+	std::vector<Node*> nodes(_nodes.size());
+	for (std::size_t i=0; i<op_perm.size(); ++i)
+		nodes[i] = _nodes[op_perm[i]];
+	_nodes.swap(nodes);
+	this->resetNodeIDs();
+	_node_adjacency.reset();
+}
+
 void Mesh::resetElementIDs()
 {
 	const size_t nElements (this->_elements.size());
@@ -126,6 +169,7 @@ void Mesh::setDimension()
 
 void Mesh::setElementsConnectedToNodes()
 {
+	BASELIB_PROFILE_SCOPE("Mesh::setElementsConnectedToNodes");
 	const size_t nElements (_elements.size());
 	for (unsigned i=0; i<nElements; ++i)
 	{
@@ -136,12 +180,40 @@ void Mesh::setElementsConnectedToNodes()
 	}
 }
 
+void Mesh::setElementsConnectedToNodes(const std::vector<std::size_t> &node_element_offsets,
+                                       const std::vector<unsigned> &node_element_ids)
+{
+	BASELIB_PROFILE_SCOPE("Mesh::setElementsConnectedToNodes");
+	assert(node_element_offsets.size() == _nodes.size() + 1);
+	assert(node_element_offsets.back() == node_element_ids.size());
+	const long nNodes (_nodes.size());
+#ifdef _OPENMP
+	#pragma omp parallel for schedule(dynamic, 1024)
+#endif
+	for (long i=0; i<nNodes; ++i)
+	{
+		std::vector<Element*> &elements (_nodes[i]->_elements);
+		elements.clear();
+		elements.reserve(node_element_offsets[i+1] - node_element_offsets[i]);
+		for (std::size_t k=node_element_offsets[i]; k<node_element_offsets[i+1]; ++k)
+			elements.push_back(_elements[node_element_ids[k]]);
+	}
+}
+
 void Mesh::resetElementsConnectedToNodes()
 {
 	for (auto node = _nodes.begin(); node != _nodes.end(); ++node)
 		if (*node)
 			(*node)->_elements.clear();
 	this->setElementsConnectedToNodes();
+	_node_adjacency.reset();
+}
+
+NodeAdjacency const& Mesh::getNodeAdjacency() const
+{
+	if (!_node_adjacency)
+		_node_adjacency.reset(new NodeAdjacency(_nodes));
+	return *_node_adjacency;
 }
 
 void Mesh::calcEdgeLengthRange()
@@ -159,38 +231,123 @@ void Mesh::calcEdgeLengthRange()
 	this->_edge_length[1] = sqrt(this->_edge_length[1]);
 }
 
+unsigned Mesh::getSideNodes(const Element &element, unsigned i, const Node* side_nodes[4])
+{
+	switch (element.getDimension())
+	{
+	case 1:
+		side_nodes[0] = element.getNode(i);
+		return 1;
+	case 2:
+		side_nodes[0] = element.getEdgeNode(i, 0);
+		side_nodes[1] = element.getEdgeNode(i, 1);
+		return 2;
+	default:
+	{
+		const Cell &cell (static_cast<const Cell&>(element));
+		const unsigned nFaceNodes (cell.getNFaceNodes(i));
+		for (unsigned j=0; j<nFaceNodes; ++j)
+			side_nodes[j] = cell.getFaceNode(i, j);
+		return nFaceNodes;
+	}
+	}
+}
+
+namespace
+{
+/// Checks if all given nodes are base nodes of the element.
+bool containsNodes(const Element &element, const Node* const* nodes, unsigned nNodes)
+{
+	const unsigned nElemNodes (element.getNNodes());
+	Node* const* elem_nodes (element.getNodes());
+	for (unsigned i=0; i<nNodes; ++i)
+		if (std::find(elem_nodes, elem_nodes+nElemNodes, nodes[i]) == elem_nodes+nElemNodes)
+			return false;
+	return true;
+}
+}
+
 void Mesh::setElementNeighbors()
 {
-	const size_t nElements = _elements.size();
-	for (unsigned m(0); m<nElements; ++m)
+	BASELIB_PROFILE_SCOPE("Mesh::setElementNeighbors");
+	// Each element only writes its own neighbor entries, the neighbor relation is found from both sides.
+	const long nElements (_elements.size());
+#ifdef _OPENMP
+	#pragma omp parallel for schedule(dynamic, 1024)
+#endif
+	for (long m=0; m<nElements; ++m)
 	{
-		// create vector with all elements connected to current element (includes lots of doubles!)
-		std::vector<Element*> neighbors;
 		Element *const element (_elements[m]);
-
-		const size_t nNodes (element->getNNodes());
-		for (unsigned n(0); n<nNodes; ++n)
+		const unsigned dim (element->getDimension());
+		const unsigned nSides (element->getNNeighbors());
+		for (unsigned i=0; i<nSides; ++i)
 		{
-			std::vector<Element*> const& conn_elems ((element->getNode(n)->getElements()));
-			neighbors.insert(neighbors.end(), conn_elems.begin(), conn_elems.end());
-		}
+			const Node* side_nodes[4];
+			const unsigned nSideNodes (getSideNodes(*element, i, side_nodes));
 
-		const unsigned nNeighbors ( neighbors.size() );
+			// Any neighbor sharing the side is connected to the side node with the fewest elements.
+			const Node* min_node (side_nodes[0]);
+			for (unsigned j=1; j<nSideNodes; ++j)
+				if (side_nodes[j]->getNElements() < min_node->getNElements())
+					min_node = side_nodes[j];
 
-		for (unsigned i(0); i<nNeighbors; ++i)
-		{
-			if (element->addNeighbor(neighbors[i]))
+			Element* neighbor (nullptr);
+			std::vector<Element*> const& candidates (min_node->getElements());
+			for (std::size_t k=0; k<candidates.size(); ++k)
 			{
-				neighbors[i]->addNeighbor(element);
+				if (candidates[k] == element || candidates[k]->getDimension() != dim)
+					continue;
+				if (containsNodes(*candidates[k], side_nodes, nSideNodes))
+				{
+					neighbor = candidates[k];
+					break;
+				}
 			}
+			element->_neighbors[i] = neighbor;
+		}
+	}
+}
+
+void Mesh::setElementNeighbors(const std::vector<unsigned> &neighbor_ids)
+{
+	BASELIB_PROFILE_SCOPE("Mesh::setElementNeighbors");
+	std::size_t k (0);
+	const std::size_t nElements (_elements.size());
+	for (std::size_t m=0; m<nElements; ++m)
+	{
+		const unsigned nNeighbors (_elements[m]->getNNeighbors());
+		for (unsigned i=0; i<nNeighbors; ++i, ++k)
+		{
+			assert(k < neighbor_ids.size());
+			_elements[m]->_neighbors[i] = (neighbor_ids[k] == std::numeric_limits<unsigned>::max())
+				? nullptr : _elements[neighbor_ids[k]];
+		}
+	}
+	assert(k == neighbor_ids.size());
+}
+
+void Mesh::copyElementNeighbors(const Mesh &mesh)
+{
+	const std::size_t nElements (_elements.size());
+	for (std::size_t m=0; m<nElements; ++m)
+	{
+		const Element* const src (mesh.getElement(m));
+		const unsigned nNeighbors (src->getNNeighbors());
+		for (unsigned i=0; i<nNeighbors; ++i)
+		{
+			const Element* const neighbor (src->getNeighbor(i));
+			_elements[m]->_neighbors[i] = neighbor ? _elements[neighbor->getID()] : nullptr;
 		}
 	}
 }
 
 void Mesh::setNodesConnectedByEdges()
 {
-	const size_t nNodes (this->_nodes.size());
-	for (unsigned i=0; i<nNodes; ++i)
+	const long nNodes (this->_nodes.size());
+#ifdef _OPENMP
+	#pragma omp parallel for schedule(dynamic, 1024)
+#endif
+	for (long i=0; i<nNodes; ++i)
 	{
 		MeshLib::Node* node (_nodes[i]);
 		std::vector<MeshLib::Node*> conn_set;
@@ -201,47 +358,30 @@ void Mesh::setNodesConnectedByEdges()
 			const unsigned idx (conn_elems[j]->getNodeIDinElement(node));
 			const unsigned nElemNodes (conn_elems[j]->getNNodes());
 			for (unsigned k(0); k<nElemNodes; ++k)
-			{
-				bool is_in_vector (false);
-				const size_t nConnNodes (conn_set.size());
-				for (unsigned l(0); l<nConnNodes; ++l)
-					if (conn_elems[j]->getNode(k) == conn_set[l])
-						is_in_vector = true;
-				if (is_in_vector) continue;
 				if (conn_elems[j]->isEdge(idx, k))
 					conn_set.push_back(_nodes[conn_elems[j]->getNode(k)->getID()]);
-			}
 		}
+		std::sort(conn_set.begin(), conn_set.end(),
+			[](const MeshLib::Node* a, const MeshLib::Node* b) { return a->getID() < b->getID(); });
+		conn_set.erase(std::unique(conn_set.begin(), conn_set.end()), conn_set.end());
 		node->setConnectedNodes(conn_set);
 	}
 }
 
 void Mesh::setNodesConnectedByElements()
 {
-	const size_t nNodes (this->_nodes.size());
-	for (unsigned i=0; i<nNodes; ++i)
+	const NodeAdjacency &adjacency (this->getNodeAdjacency());
+	const long nNodes (this->_nodes.size());
+#ifdef _OPENMP
+	#pragma omp parallel for schedule(dynamic, 1024)
+#endif
+	for (long i=0; i<nNodes; ++i)
 	{
-		MeshLib::Node* node (_nodes[i]);
 		std::vector<MeshLib::Node*> conn_vec;
-		const std::vector<MeshLib::Element*> &conn_elems (node->getElements());
-		const size_t nConnElems (conn_elems.size());
-		for (unsigned j=0; j<nConnElems; ++j)
-		{
-			const unsigned nElemNodes (conn_elems[j]->getNNodes());
-			for (unsigned k(0); k<nElemNodes; ++k)
-			{
-				bool is_in_vector (false);
-				const MeshLib::Node* c_node (conn_elems[j]->getNode(k));
-				if (c_node == node) continue;
-				const size_t nConnNodes (conn_vec.size());
-				for (unsigned l(0); l<nConnNodes; ++l)
-					if (c_node == conn_vec[l])
-						is_in_vector = true;
-				if (!is_in_vector)
-					conn_vec.push_back(_nodes[c_node->getID()]);
-			}
-		}
-		node->setConnectedNodes(conn_vec);
+		conn_vec.reserve(adjacency.getNAdjacentNodes(i));
+		for (NodeAdjacency::ConstIterator it = adjacency.begin(i); it != adjacency.end(i); ++it)
+			conn_vec.push_back(_nodes[*it]);
+		_nodes[i]->setConnectedNodes(conn_vec);
 	}
 }
 
@@ -16,6 +16,7 @@
 #define MESH_H_
 
 #include <cstdlib>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -27,6 +28,7 @@ namespace MeshLib
 {
 	class Node;
 	class Element;
+	class NodeAdjacency;
 
 /**
  * A basic mesh.
@@ -42,6 +44,26 @@ public:
 	     const std::vector<Node*> &nodes,
 	     const std::vector<Element*> &elements);
 
+	/**
+	 * Constructor using precomputed topology information, e.g. read from a
+	 * mesh cache file, instead of computing it from the elements.
+	 * @param node_element_offsets positions of the first element connected to
+	 *                             each node in node_element_ids, nNodes+1 entries
+	 * @param node_element_ids     ids of the elements connected to the nodes
+	 * @param neighbor_ids         ids of the neighbors of all elements in the
+	 *                             order of the element sides,
+	 *                             std::numeric_limits<unsigned>::max() if there
+	 *                             is no neighbor
+	 * @param edge_length          minimum and maximum edge length of the mesh
+	 */
+	Mesh(const std::string &name,
+	     const std::vector<Node*> &nodes,
+	     const std::vector<Element*> &elements,
+	     const std::vector<std::size_t> &node_element_offsets,
+	     const std::vector<unsigned> &node_element_ids,
+	     const std::vector<unsigned> &neighbor_ids,
+	     const double edge_length[2]);
+
 	/// Copy constructor
 	Mesh(const Mesh &mesh);
 
@@ -90,12 +112,22 @@ public:
 	/// Resets the IDs of all mesh-nodes to their position in the node vector
 	void resetNodeIDs();
 
+	/// Reorders the node vector such that the node at position i is the node
+	/// formerly at position op_perm[i] and resets the node IDs. The elements
+	/// keep their nodes.
+	void reorderNodes(std::vector<std::size_t> const& op_perm);
+
 	/// Changes the name of the mesh.
 	void setName(const std::string &name) { this->_name = name; }
 
 	/// Get id of the mesh
 	std::size_t getID() const {return _id; }
 
+	/// Returns the node-to-node adjacency of the mesh. The adjacency is
+	/// computed on the first call and kept until nodes or elements are added.
+	/// The first call is not thread-safe.
+	NodeAdjacency const& getNodeAdjacency() const;
+
 protected:
 	/// Set the minimum and maximum length over the edges of the mesh.
 	void calcEdgeLengthRange();
@@ -115,8 +147,25 @@ protected:
 
 	/// Fills in the neighbor-information for elements.
 	/// Note: Using this implementation, an element e can only have neighbors that have the same dimensionality as e.
+	/// The neighbor of a face (edge in 2d, end point in 1d) is searched among the elements connected to one of
+	/// the face nodes only. The elements are processed in parallel if OpenMP is enabled.
 	void setElementNeighbors();
 
+	/// Sets the elements connected to the nodes from the given table (see constructor).
+	void setElementsConnectedToNodes(const std::vector<std::size_t> &node_element_offsets,
+	                                 const std::vector<unsigned> &node_element_ids);
+
+	/// Sets the neighbor-information for elements from the given neighbor ids (see constructor).
+	void setElementNeighbors(const std::vector<unsigned> &neighbor_ids);
+
+	/// Sets the neighbor-information for elements from the neighbors of the elements of the given mesh,
+	/// which must have the same structure as this mesh.
+	void copyElementNeighbors(const Mesh &mesh);
+
+	/// Collects the (base) nodes of side i of the element, i.e. of face i of a 3d element, of edge i of a
+	/// 2d element or of node i of a 1d element. The sides correspond to the neighbor indices of the element.
+	static unsigned getSideNodes(const Element &element, unsigned i, const Node* side_nodes[4]);
+
 	void setNodesConnectedByEdges();
 
 	void setNodesConnectedByElements();
@@ -127,6 +176,7 @@ protected:
 	std::string _name;
 	std::vector<Node*> _nodes;
 	std::vector<Element*> _elements;
+	mutable std::unique_ptr<NodeAdjacency> _node_adjacency;
 
 }; /* class */
 
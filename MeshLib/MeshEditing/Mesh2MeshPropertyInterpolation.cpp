@@ -12,28 +12,33 @@
  *
  */
 
+#include <algorithm>
+#include <limits>
 #include <vector>
-#include <fstream>
 
 #include "Mesh2MeshPropertyInterpolation.h"
 
 // BaseLib
 #include "logog/include/logog.hpp"
-#include "StringTools.h"
 
 // GeoLib
 #include "AABB.h"
 #include "Grid.h"
 
+// MathLib
+#include "MathTools.h"
+
 // MeshLib
 #include "Mesh.h"
 #include "Node.h"
+#include "Elements/Cell.h"
 #include "Elements/Face.h"
 
 namespace MeshLib {
 
-Mesh2MeshPropertyInterpolation::Mesh2MeshPropertyInterpolation(Mesh const*const src_mesh, std::vector<double> const*const src_properties) :
-	_src_mesh(src_mesh), _src_properties(src_properties)
+Mesh2MeshPropertyInterpolation::Mesh2MeshPropertyInterpolation(Mesh const*const src_mesh,
+	std::vector<double> const*const src_properties, Mode mode) :
+	_src_mesh(src_mesh), _src_properties(src_properties), _mode(mode)
 {}
 
 Mesh2MeshPropertyInterpolation::~Mesh2MeshPropertyInterpolation()
@@ -46,8 +51,8 @@ bool Mesh2MeshPropertyInterpolation::setPropertiesForMesh(Mesh *dest_mesh, std::
 		return false;
 	}
 
-	if (_src_mesh->getDimension() != 2) {
-		WARN ("MeshLib::Mesh2MeshPropertyInterpolation::setPropertiesForMesh() implemented only for 2D case at the moment.");
+	if (_src_mesh->getDimension() < 2) {
+		WARN ("MeshLib::Mesh2MeshPropertyInterpolation::setPropertiesForMesh() implemented only for 2D and 3D case at the moment.");
 		return false;
 	}
 
@@ -77,75 +82,108 @@ void Mesh2MeshPropertyInterpolation::interpolatePropertiesForMesh(Mesh *dest_mes
 
 	GeoLib::Grid<MeshLib::Node> src_grid(src_nodes.begin(), src_nodes.end(), 64);
 
+	// tolerances of the point in element tests, the tolerance for faces is
+	// an absolute value, for cells it is used for the barycentric coordinates
+	const double face_eps(30);
+	const double cell_eps(1e-10);
+
 	std::vector<MeshLib::Element*> const& dest_elements(dest_mesh->getElements());
-	const size_t n_dest_elements(dest_elements.size());
-	for (size_t k(0); k<n_dest_elements; k++) {
+	const long n_dest_elements(dest_elements.size());
+	std::size_t n_elements_without_nodes(0);
+
+#ifdef _OPENMP
+	#pragma omp parallel reduction(+:n_elements_without_nodes)
+#endif
+	{
+	// scratch data of the thread that is reused for all elements
+	std::vector<std::vector<MeshLib::Node*> const*> nodes;
+	MeshLib::Node min_pnt(0.0, 0.0, 0.0);
+	MeshLib::Node max_pnt(0.0, 0.0, 0.0);
+
+#ifdef _OPENMP
+	#pragma omp for schedule(dynamic, 256)
+#endif
+	for (long k = 0; k < n_dest_elements; k++) {
+		MeshLib::Element & dest_element(*dest_elements[k]);
+		const MeshLib::Node center(dest_element.getCenterOfGravity());
+		dest_element.setValue(k);
+
+		if (_mode == Mode::NEAREST) {
+			dest_properties[k] = interpolated_src_node_properties[
+				src_grid.getNearestPoint(center)->getID()];
+			continue;
+		}
+
 		// compute axis aligned bounding box around the current element
-		const GeoLib::AABB<MeshLib::Node> elem_aabb(dest_elements[k]->getNodes(), dest_elements[k]->getNodes()+dest_elements[k]->getNNodes());
+		const unsigned n_elem_nodes(dest_element.getNNodes());
+		for (unsigned d(0); d < 3; d++) {
+			min_pnt[d] = (*dest_element.getNode(0))[d];
+			max_pnt[d] = (*dest_element.getNode(0))[d];
+		}
+		for (unsigned i(1); i < n_elem_nodes; i++) {
+			MeshLib::Node const& node(*dest_element.getNode(i));
+			for (unsigned d(0); d < 3; d++) {
+				min_pnt[d] = std::min(min_pnt[d], node[d]);
+				max_pnt[d] = std::max(max_pnt[d], node[d]);
+			}
+		}
 
 		// request "interesting" nodes from grid
-		std::vector<std::vector<MeshLib::Node*> const*> nodes;
-		src_grid.getPntVecsOfGridCellsIntersectingCuboid(elem_aabb.getMinPoint(), elem_aabb.getMaxPoint(), nodes);
-
-		size_t cnt(0);
-		dest_properties[k] = 0.0;
-
-		for (size_t i(0); i<nodes.size(); ++i) {
-			std::vector<MeshLib::Node*> const* i_th_vec(nodes[i]);
-			const size_t n_nodes_in_vec(i_th_vec->size());
-			for (size_t j(0); j<n_nodes_in_vec; j++) {
-				MeshLib::Node const*const j_th_node((*i_th_vec)[j]);
-				if (elem_aabb.containsPoint(*j_th_node)) {
-					if (dynamic_cast<MeshLib::Face*>(dest_elements[k])->isPntInside(* dynamic_cast<GeoLib::Point const*>(j_th_node), 30)) {
-						dest_properties[k] += interpolated_src_node_properties[(*i_th_vec)[j]->getID()];
-						cnt++;
-					}
-				}
+		nodes.clear();
+		src_grid.getPntVecsOfGridCellsIntersectingCuboid(min_pnt, max_pnt, nodes);
+
+		MeshLib::Face const*const face(dest_element.getDimension() == 2
+			? static_cast<MeshLib::Face const*>(&dest_element) : nullptr);
+		MeshLib::Cell const*const cell(dest_element.getDimension() == 3
+			? static_cast<MeshLib::Cell const*>(&dest_element) : nullptr);
+
+		double sum(0.0);
+		double sum_of_weights(0.0);
+		for (std::size_t i(0); i<nodes.size(); ++i) {
+			for (MeshLib::Node const*const node : *nodes[i]) {
+				bool inside((*node)[0] >= min_pnt[0] && (*node)[0] <= max_pnt[0]
+					&& (*node)[1] >= min_pnt[1] && (*node)[1] <= max_pnt[1]
+					&& (*node)[2] >= min_pnt[2] && (*node)[2] <= max_pnt[2]);
+				if (inside && face)
+					inside = face->isPntInside(*node, face_eps);
+				if (inside && cell)
+					inside = cell->isPntInside(*node, cell_eps);
+				if (!inside)
+					continue;
+
+				double weight(1.0);
+				if (_mode == Mode::INVERSE_DISTANCE)
+					weight = 1.0 / std::max(MathLib::sqrDist(*node, center),
+						std::numeric_limits<double>::min());
+				sum += weight * interpolated_src_node_properties[node->getID()];
+				sum_of_weights += weight;
 			}
 		}
 
-		dest_properties[k] /= cnt;
-		dest_elements[k]->setValue(k);
-
-		if (cnt == 0) {
-			std::string base_name("DebugData/Element-");
-			base_name += BaseLib::number2str(k);
-
-			std::string aabb_fname(base_name + "-aabb.gli");
-			std::ofstream out_aabb(aabb_fname.c_str());
-			out_aabb << "#POINTS" << "\n";
-			out_aabb << "0 " << elem_aabb.getMinPoint() << "\n";
-			out_aabb << "1 " << elem_aabb.getMaxPoint() << "\n";
-			out_aabb << "#STOP" << "\n";
-			out_aabb.close();
-
-
-			std::string source_fname(base_name + "-SourceNodes.gli");
-			std::ofstream out_src(source_fname.c_str());
-			out_src << "#POINTS" << "\n";
-			size_t nodes_cnt(0);
-			for (size_t i(0); i<nodes.size(); ++i) {
-				std::vector<MeshLib::Node*> const* i_th_vec(nodes[i]);
-				const size_t n_nodes_in_vec(i_th_vec->size());
-				for (size_t j(0); j<n_nodes_in_vec; j++) {
-					MeshLib::Node const*const j_th_node((*i_th_vec)[j]);
-					out_src << nodes_cnt << " " << *(dynamic_cast<GeoLib::Point const*>(j_th_node)) << "\n";
-					nodes_cnt++;
-				}
-			}
-			out_src << "#STOP" << "\n";
-			out_src.close();
-			std::cerr << "no source nodes in dest element " << k << "\n";
+		if (sum_of_weights > 0.0) {
+			dest_properties[k] = sum / sum_of_weights;
+		} else {
+			dest_properties[k] = interpolated_src_node_properties[
+				src_grid.getNearestPoint(center)->getID()];
+			n_elements_without_nodes++;
 		}
 	}
+	}
+
+	if (n_elements_without_nodes > 0)
+		WARN("MeshLib::Mesh2MeshPropertyInterpolation::interpolatePropertiesForMesh(): %d destination elements do not contain source nodes, the values of the nearest source nodes are used.",
+			n_elements_without_nodes);
 }
 
 void Mesh2MeshPropertyInterpolation::interpolateElementPropertiesToNodeProperties(std::vector<double> &interpolated_node_properties) const
 {
 	std::vector<MeshLib::Node*> const& src_nodes(_src_mesh->getNodes());
-	const size_t n_src_nodes(src_nodes.size());
+	const long n_src_nodes(src_nodes.size());
 
-	for (size_t k(0); k<n_src_nodes; k++) {
+#ifdef _OPENMP
+	#pragma omp parallel for schedule(static)
+#endif
+	for (long k = 0; k<n_src_nodes; k++) {
 		const size_t n_con_elems (src_nodes[k]->getNElements());
 		interpolated_node_properties[k] = (*_src_properties)[(src_nodes[k]->getElement(0))->getValue()];
 		for (size_t j(1); j<n_con_elems; j++) {
@@ -15,6 +15,8 @@
 #ifndef MESH2MESHPROPERTYINTERPOLATION_H_
 #define MESH2MESHPROPERTYINTERPOLATION_H_
 
+#include <vector>
+
 namespace MeshLib {
 
 class Mesh;
@@ -22,10 +24,25 @@ class Mesh;
  * Class Mesh2MeshPropertyInterpolation transfers properties of
  * mesh elements of a (source) mesh to mesh elements of another
  * (destination) mesh deploying weighted interpolation. The two
- * meshes must have the same dimension.
+ * meshes must have the same dimension, 2d and 3d meshes are supported.
+ * The element properties of the source mesh are averaged at the source
+ * nodes first. The destination elements are processed in parallel if
+ * OpenMP is enabled.
  */
 class Mesh2MeshPropertyInterpolation {
 public:
+	/// Interpolation of the source node values to a destination element.
+	enum class Mode
+	{
+		/// mean of the values of the source nodes inside the element
+		ELEMENT_AVERAGE,
+		/// mean of the values of the source nodes inside the element weighted
+		/// with the inverse squared distance to the element center
+		INVERSE_DISTANCE,
+		/// value of the source node nearest to the element center
+		NEAREST
+	};
+
 	/**
 	 * Constructor taking the source or input mesh and properties.
 	 * @param source_mesh the mesh the given property information is
@@ -35,8 +52,13 @@ public:
 	 * must be at least the number of different properties stored in mesh.
 	 * For instance if mesh has \f$n\f$ (pairwise) different property
 	 * indices the vector of properties must have \f$\ge n\f$ entries.
+	 * @param mode the interpolation used for the destination elements. If no
+	 * source node is located inside a destination element the value of the
+	 * source node nearest to the element center is used in every mode.
 	 */
-	Mesh2MeshPropertyInterpolation(Mesh const*const source_mesh, std::vector<double> const*const source_properties);
+	Mesh2MeshPropertyInterpolation(Mesh const*const source_mesh,
+		std::vector<double> const*const source_properties,
+		Mode mode = Mode::ELEMENT_AVERAGE);
 	virtual ~Mesh2MeshPropertyInterpolation();
 
 	/**
@@ -52,9 +74,10 @@ public:
 
 private:
 	/**
-	 *
-	 * @param dest_mesh
-	 * @param dest_properties
+	 * Computes the property of each destination element from the source
+	 * node values and sets the index of the element as its value.
+	 * @param dest_mesh the destination mesh
+	 * @param dest_properties the computed properties, one entry per element
 	 */
 	void interpolatePropertiesForMesh(Mesh *dest_mesh, std::vector<double>& dest_properties) const;
 	/**
@@ -66,6 +89,7 @@ private:
 
 	Mesh const*const _src_mesh;
 	std::vector<double> const*const _src_properties;
+	Mode const _mode;
 };
 
 } // end namespace MeshLib
@@ -14,6 +14,10 @@
 
 #include "MeshEnums.h"
 
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
 const std::string MeshElemType2String(const MeshElemType t)
 {
 	if (t == MeshElemType::LINE)
@@ -35,20 +39,23 @@ const std::string MeshElemType2String(const MeshElemType t)
 
 MeshElemType String2MeshElemType(const std::string &s)
 {
-	if ((s.compare("line") == 0) || (s.compare("Line") == 0))
-		return MeshElemType::LINE;
-	if ((s.compare("quad") == 0) || (s.compare("Quadrilateral") == 0))
-		return MeshElemType::QUAD;
-	if ((s.compare("hex")  == 0) || (s.compare("Hexahedron") == 0))
-		return MeshElemType::HEXAHEDRON;
-	if ((s.compare("tri")  == 0) || (s.compare("Triangle") == 0))
-		return MeshElemType::TRIANGLE;
-	if ((s.compare("tet")  == 0) || (s.compare("Tetrahedron") == 0))
-		return MeshElemType::TETRAHEDRON;
-	if ((s.compare("pris") == 0) || (s.compare("Prism") == 0))
-		return MeshElemType::PRISM;
-	if ((s.compare("pyra") == 0) || (s.compare("Pyramid") == 0))
-		return MeshElemType::PYRAMID;
+	return String2MeshElemType(s.data(), s.data() + s.size());
+}
+
+MeshElemType String2MeshElemType(char const* begin, char const* end)
+{
+	static std::pair<char const*, MeshElemType> const names[] = {
+		{"line", MeshElemType::LINE}, {"Line", MeshElemType::LINE},
+		{"quad", MeshElemType::QUAD}, {"Quadrilateral", MeshElemType::QUAD},
+		{"hex", MeshElemType::HEXAHEDRON}, {"Hexahedron", MeshElemType::HEXAHEDRON},
+		{"tri", MeshElemType::TRIANGLE}, {"Triangle", MeshElemType::TRIANGLE},
+		{"tet", MeshElemType::TETRAHEDRON}, {"Tetrahedron", MeshElemType::TETRAHEDRON},
+		{"pris", MeshElemType::PRISM}, {"Prism", MeshElemType::PRISM},
+		{"pyra", MeshElemType::PYRAMID}, {"Pyramid", MeshElemType::PYRAMID}};
+	std::size_t const length (end - begin);
+	for (auto const& name : names)
+		if (std::strlen(name.first) == length && std::equal(begin, end, name.first))
+			return name.second;
 	return MeshElemType::INVALID;
 }
 
@@ -65,3 +72,93 @@ const std::string MeshQualityType2String(const MeshQualityType t)
 	return "none";
 }
 
+unsigned getNCellTypeNodes(const CellType t)
+{
+	switch (t)
+	{
+	case CellType::LINE2:
+		return 2;
+	case CellType::LINE3:
+	case CellType::TRI3:
+		return 3;
+	case CellType::QUAD4:
+	case CellType::TET4:
+		return 4;
+	case CellType::PYRAMID5:
+		return 5;
+	case CellType::TRI6:
+	case CellType::PRISM6:
+		return 6;
+	case CellType::QUAD8:
+	case CellType::HEX8:
+		return 8;
+	case CellType::QUAD9:
+		return 9;
+	case CellType::TET10:
+		return 10;
+	case CellType::PRISM15:
+		return 15;
+	case CellType::PRISM18:
+		return 18;
+	case CellType::HEX20:
+		return 20;
+	case CellType::HEX27:
+		return 27;
+	default:
+		return 0;
+	}
+}
+
+MeshElemType CellType2MeshElemType(const CellType t)
+{
+	switch (t)
+	{
+	case CellType::LINE2:
+	case CellType::LINE3:
+		return MeshElemType::LINE;
+	case CellType::TRI3:
+	case CellType::TRI6:
+		return MeshElemType::TRIANGLE;
+	case CellType::QUAD4:
+	case CellType::QUAD8:
+	case CellType::QUAD9:
+		return MeshElemType::QUAD;
+	case CellType::TET4:
+	case CellType::TET10:
+		return MeshElemType::TETRAHEDRON;
+	case CellType::HEX8:
+	case CellType::HEX20:
+	case CellType::HEX27:
+		return MeshElemType::HEXAHEDRON;
+	case CellType::PRISM6:
+	case CellType::PRISM15:
+	case CellType::PRISM18:
+		return MeshElemType::PRISM;
+	case CellType::PYRAMID5:
+		return MeshElemType::PYRAMID;
+	default:
+		return MeshElemType::INVALID;
+	}
+}
+
+unsigned getNMeshElemTypeNodes(const MeshElemType t)
+{
+	switch (t)
+	{
+	case MeshElemType::LINE:
+		return 2;
+	case MeshElemType::TRIANGLE:
+		return 3;
+	case MeshElemType::QUAD:
+	case MeshElemType::TETRAHEDRON:
+		return 4;
+	case MeshElemType::PYRAMID:
+		return 5;
+	case MeshElemType::PRISM:
+		return 6;
+	case MeshElemType::HEXAHEDRON:
+		return 8;
+	default:
+		return 0;
+	}
+}
@@ -74,6 +74,19 @@ const std::string MeshElemType2String(const MeshElemType t);
 /// Given a string of the shortened name of the element type, this returns the corresponding MeshElemType.
 MeshElemType String2MeshElemType(const std::string &s);
 
+/// Same as above for the name given by the character range [begin, end), e.g.
+/// a token in a file buffer, without constructing a string.
+MeshElemType String2MeshElemType(char const* begin, char const* end);
+
 const std::string MeshQualityType2String(const MeshQualityType t);
 
+/// Returns the number of nodes (including the non-linear nodes) of the given cell type.
+unsigned getNCellTypeNodes(const CellType t);
+
+/// Returns the element type of the given cell type, e.g. MeshElemType::QUAD for CellType::QUAD8.
+MeshElemType CellType2MeshElemType(const CellType t);
+
+/// Returns the number of corner nodes of the given element type.
+unsigned getNMeshElemTypeNodes(const MeshElemType t);
+
 #endif //MESHENUMS_H
@@ -14,6 +14,9 @@
 
 // stl
 #include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
 
 // ThirdParty/logog
 #include "logog/include/logog.hpp"
@@ -50,61 +53,67 @@ MeshLib::Mesh* MeshLayerMapper::CreateLayers(const MeshLib::Mesh &mesh, const st
 	}
 
 	const size_t nNodes = mesh.getNNodes();
-	// count number of 2d elements in the original mesh
-	const std::size_t nElems (std::count_if(mesh.getElements().begin(), mesh.getElements().end(),
-			[](MeshLib::Element const* elem) { return (elem->getDimension() == 2);}));
-
-	const std::size_t nOrgElems (mesh.getNElements());
 	const std::vector<MeshLib::Node*> &nodes = mesh.getNodes();
 	const std::vector<MeshLib::Element*> &elems = mesh.getElements();
-	std::vector<MeshLib::Node*> new_nodes;
-	new_nodes.reserve(nNodes + (nLayers * nNodes));
-	std::vector<MeshLib::Element*> new_elems;
-	new_elems.reserve(nElems * nLayers);
-	double z_offset (0.0);
 
-	for (unsigned layer_id = 0; layer_id <= nLayers; ++layer_id)
+	// collect the surface elements that are extruded
+	std::vector<const MeshLib::Element*> sfc_elems;
+	sfc_elems.reserve(elems.size());
+	for (std::size_t i = 0; i < elems.size(); ++i)
 	{
-		// add nodes for new layer
-		unsigned node_offset (nNodes * layer_id);
-		if (layer_id > 0) z_offset += thickness[layer_id-1];
-		for (unsigned i = 0; i < nNodes; ++i)
+		const MeshLib::Element* sfc_elem( elems[i] );
+		if (sfc_elem->getGeomType() == MeshElemType::TRIANGLE || sfc_elem->getGeomType() == MeshElemType::QUAD)
+			sfc_elems.push_back(sfc_elem);
+		else
 		{
-			const double* coords = nodes[i]->getCoords();
-			new_nodes.push_back (new MeshLib::Node(coords[0], coords[1], coords[2]-z_offset, node_offset+i));
+			WARN("MshLayerMapper::CreateLayers() - Method can only handle triangle and quad elements.");
+			WARN("Skipping Element %d of type \"%s\".", i, MeshElemType2String(sfc_elem->getGeomType()).c_str());
 		}
+	}
+	const std::size_t nElems (sfc_elems.size());
+
+	std::vector<double> z_offset(nLayers + 1, 0.0);
+	for (std::size_t layer_id = 1; layer_id <= nLayers; ++layer_id)
+		z_offset[layer_id] = z_offset[layer_id-1] + thickness[layer_id-1];
+
+	// the node and element vectors are allocated at once and filled in parallel
+	std::vector<MeshLib::Node*> new_nodes(nNodes * (nLayers + 1));
+	const long nNewNodes (new_nodes.size());
+#ifdef _OPENMP
+	#pragma omp parallel for schedule(static)
+#endif
+	for (long k = 0; k < nNewNodes; ++k)
+	{
+		const std::size_t layer_id (k / nNodes);
+		const double* coords = nodes[k % nNodes]->getCoords();
+		new_nodes[k] = new MeshLib::Node(coords[0], coords[1], coords[2]-z_offset[layer_id], k);
+	}
 
-		// starting with 2nd layer create prism or hex elements connecting the last layer with the current one
-		if (layer_id > 0)
+	// the elements of layer l connect the nodes of layer l-1 with the nodes of layer l
+	std::vector<MeshLib::Element*> new_elems(nElems * nLayers);
+	const long nNewElems (new_elems.size());
+#ifdef _OPENMP
+	#pragma omp parallel for schedule(static)
+#endif
+	for (long k = 0; k < nNewElems; ++k)
+	{
+		const std::size_t layer_id (k / nElems + 1);
+		const MeshLib::Element* sfc_elem( sfc_elems[k % nElems] );
+		const std::size_t node_offset (nNodes * (layer_id - 1));
+		const unsigned mat_id (nLayers - layer_id);
+
+		const unsigned nElemNodes(sfc_elem->getNNodes());
+		MeshLib::Node** e_nodes = new MeshLib::Node*[2*nElemNodes];
+		for (unsigned j=0; j<nElemNodes; ++j)
 		{
-			node_offset -= nNodes;
-			const unsigned mat_id (nLayers - layer_id);
-
-			for (unsigned i = 0; i < nOrgElems; ++i)
-			{
-				const MeshLib::Element* sfc_elem( elems[i] );
-				if (sfc_elem->getDimension() != 2)
-				{
-					WARN("MshLayerMapper::CreateLayers() - Method can only handle 2D mesh elements.");
-					WARN("Skipping Element %d of type \"%s\".", i, MeshElemType2String(sfc_elem->getGeomType()).c_str());
-					continue;
-				}
-				
-				const unsigned nElemNodes(sfc_elem->getNNodes());
-				MeshLib::Node** e_nodes = new MeshLib::Node*[2*nElemNodes];
-
-				for (unsigned j=0; j<nElemNodes; ++j)
-				{
-					const unsigned node_id = sfc_elem->getNode(j)->getID() + node_offset;
-					e_nodes[j] = new_nodes[node_id+nNodes];
-					e_nodes[j+nElemNodes] = new_nodes[node_id];
-				}
-				if (sfc_elem->getGeomType() == MeshElemType::TRIANGLE)	// extrude triangles to prism
-					new_elems.push_back (new MeshLib::Prism(e_nodes, mat_id));
-				else if (sfc_elem->getGeomType() == MeshElemType::QUAD)	// extrude quads to hexes
-					new_elems.push_back (new MeshLib::Hex(e_nodes, mat_id));
-			}
+			const std::size_t node_id = sfc_elem->getNode(j)->getID() + node_offset;
+			e_nodes[j] = new_nodes[node_id+nNodes];
+			e_nodes[j+nElemNodes] = new_nodes[node_id];
 		}
+		if (sfc_elem->getGeomType() == MeshElemType::TRIANGLE)	// extrude triangles to prism
+			new_elems[k] = new MeshLib::Prism(e_nodes, mat_id);
+		else	// extrude quads to hexes
+			new_elems[k] = new MeshLib::Hex(e_nodes, mat_id);
 	}
 	return new MeshLib::Mesh("SubsurfaceMesh", new_nodes, new_elems);
 }
@@ -118,18 +127,31 @@ int MeshLayerMapper::LayerMapping(MeshLib::Mesh &new_mesh, const std::string &ra
 		return 0;
 	}
 
-	const GeoLib::Raster *raster(GeoLib::Raster::getRasterFromASCFile(rasterfile));
+	const GeoLib::Raster *raster(GeoLib::Raster::getRasterFromFile(rasterfile));
 	if (! raster) {
 		ERR("MshLayerMapper::LayerMapping - could not read raster file %s", rasterfile.c_str());
 		return 0;
 	}
-	const double x0(raster->getOrigin()[0]);
-	const double y0(raster->getOrigin()[1]);
-	const double delta(raster->getRasterPixelDistance());
-	const double no_data(raster->getNoDataValue());
-	const std::size_t width(raster->getNCols());
-	const std::size_t height(raster->getNRows());
-	double const*const elevation(raster->begin());
+	const int result (LayerMapping(new_mesh, *raster, nLayers, layer_id, noDataReplacementValue));
+	delete raster;
+	return result;
+}
+
+int MeshLayerMapper::LayerMapping(MeshLib::Mesh &new_mesh, const GeoLib::Raster &raster,
+                                 const unsigned nLayers, const unsigned layer_id, double noDataReplacementValue)
+{
+	if (nLayers < layer_id)
+	{
+		ERR("MshLayerMapper::LayerMapping() - Mesh has only %d Layers, cannot assign layer %d.", nLayers, layer_id);
+		return 0;
+	}
+
+	const double x0(raster.getOrigin()[0]);
+	const double y0(raster.getOrigin()[1]);
+	const double delta(raster.getRasterPixelDistance());
+	const double no_data(raster.getNoDataValue());
+	const std::size_t width(raster.getNCols());
+	const std::size_t height(raster.getNRows());
 
 	const std::pair<double, double> xDim(x0, x0 + width * delta); // extension in x-dimension
 	const std::pair<double, double> yDim(y0, y0 + height * delta); // extension in y-dimension
@@ -139,69 +161,45 @@ int MeshLayerMapper::LayerMapping(MeshLib::Mesh &new_mesh, const std::string &ra
 
 	const size_t firstNode (layer_id * nNodesPerLayer);
 	const size_t lastNode  (firstNode + nNodesPerLayer);
-
-	const double half_delta = 0.5*delta;
 	const std::vector<MeshLib::Node*> &nodes = new_mesh.getNodes();
-	for (unsigned i = firstNode; i < lastNode; ++i)
-	{
-		const double* coords (nodes[i]->getCoords());
-
-		if (!isNodeOnRaster(*nodes[i], xDim, yDim))
-		{
-			// use either default value or elevation from layer above
-			nodes[i]->updateCoordinates(coords[0], coords[1], noDataReplacementValue);
-			continue;
-		}
 
-		// position in raster
-		const double xPos ((coords[0] - xDim.first) / delta);
-		const double yPos ((coords[1] - yDim.first) / delta);
-		// raster cell index
-		const size_t xIdx (static_cast<size_t>(floor(xPos)));
-		const size_t yIdx (static_cast<size_t>(floor(yPos)));
-
-		// weights for bilinear interpolation		
-		const double xShift = fabs(xPos-(xIdx+half_delta))/delta;
-		const double yShift = fabs(yPos-(yIdx+half_delta))/delta;
-		std::array<double,4> weight = { (1-xShift)*(1-xShift), xShift*(1-yShift), xShift*yShift, (1-xShift)*yShift };
-
-		// neightbors to include in interpolation
-		const int xShiftIdx = (xPos-xIdx-half_delta>=0) ? 1 : -1;
-		const int yShiftIdx = (yPos-yIdx-half_delta>=0) ? 1 : -1;
-		const std::array<int,4> x_nb = { 0, xShiftIdx, xShiftIdx, 0 };
-		const std::array<int,4> y_nb = { 0, 0, yShiftIdx, yShiftIdx };
-
-		// get pixel values
-		std::array<double,4>  pix_val;
-		unsigned no_data_count (0);
-		for (unsigned j=0; j<4; ++j)
+	// sort the nodes on the raster by the raster tile they are located in
+	const std::size_t n_tile_cols ((width + _raster_tile_size - 1) / _raster_tile_size);
+	const std::size_t max_tile (n_tile_cols * ((height + _raster_tile_size - 1) / _raster_tile_size));
+	std::vector<std::pair<std::size_t, std::size_t>> tile_node_ids;
+	tile_node_ids.reserve(nNodesPerLayer);
+	for (std::size_t i = firstNode; i < lastNode; ++i)
+	{
+		std::size_t tile (max_tile);
+		if (isNodeOnRaster(*nodes[i], xDim, yDim))
 		{
-			pix_val[j] = elevation[(yIdx + y_nb[j])*width + (xIdx + x_nb[j])];
-			if (fabs(pix_val[j] - no_data) < std::numeric_limits<double>::epsilon())
-			{
-				weight[j] = 0;
-				no_data_count++;
-			}
+			const std::size_t xIdx (std::min(static_cast<std::size_t>(((*nodes[i])[0] - x0) / delta), width - 1));
+			const std::size_t yIdx (std::min(static_cast<std::size_t>(((*nodes[i])[1] - y0) / delta), height - 1));
+			tile = (yIdx / _raster_tile_size) * n_tile_cols + xIdx / _raster_tile_size;
 		}
-
-		// adjust weights if necessary
-		if (no_data_count > 0)
+		tile_node_ids.push_back(std::make_pair(tile, i));
+	}
+	std::sort(tile_node_ids.begin(), tile_node_ids.end());
+
+	// interpolate the elevations, nodes outside of the raster or without data
+	// get the replacement value
+	const long nLayerNodes (tile_node_ids.size());
+#ifdef _OPENMP
+	#pragma omp parallel for schedule(static)
+#endif
+	for (long k = 0; k < nLayerNodes; ++k)
+	{
+		MeshLib::Node &node (*nodes[tile_node_ids[k].second]);
+		double z (noDataReplacementValue);
+		if (tile_node_ids[k].first != max_tile)
 		{
-			if (no_data_count == 4) // if there is absolutely no data just use the default value
-			{
-				nodes[i]->updateCoordinates(coords[0], coords[1], noDataReplacementValue);
-				continue;
-			}
-			const double norm = 4/(4-no_data_count);
-			std::for_each(weight.begin(), weight.end(), [&norm](double &val){val*=norm;});
+			const double value (raster.interpolateValueAtPoint(node[0], node[1]));
+			if (std::abs(value - no_data) >= std::numeric_limits<double>::epsilon())
+				z = value;
 		}
-
-		// new value
-		double z = MathLib::scalarProduct<double,4>(weight.data(), pix_val.data());
-		nodes[i]->updateCoordinates(coords[0], coords[1], z);
+		node[2] = z;
 	}
 
-	delete raster;
 	return 1;
 }
 
@@ -16,9 +16,14 @@
 #define MESHLAYERMAPPER_H
 
 #include <string>
+#include <vector>
 
 class QImage;
 
+namespace GeoLib {
+	class Raster;
+}
+
 namespace MeshLib {
 	class Mesh;
 	class Node;
@@ -44,11 +49,21 @@ public:
 
 	/**
 	 * Maps the z-values of nodes in the designated layer of the given mesh according to the given raster.
+	 * The raster format is chosen by the file extension (see GeoLib::Raster::getRasterFromFile()).
 	 * Note: This only results in a valid mesh if the layers don't intersect each other.
 	 */
 	static int LayerMapping(MeshLib::Mesh &mesh, const std::string &rasterfile,
                             const unsigned nLayers, const unsigned layer_id, double noDataReplacementValue);
 
+	/**
+	 * Maps the z-values of nodes in the designated layer of the given mesh according to the given raster.
+	 * The nodes are processed in parallel in the order of the raster tiles they are located in, such
+	 * that each thread only accesses a compact part of the raster data.
+	 * Note: This only results in a valid mesh if the layers don't intersect each other.
+	 */
+	static int LayerMapping(MeshLib::Mesh &mesh, const GeoLib::Raster &raster,
+                            const unsigned nLayers, const unsigned layer_id, double noDataReplacementValue);
+
 	/**
 	 * Blends a mesh with the surface given by dem_raster. Nodes and elements above the surface are either removed or adapted to fit the surface.
 	 * Note: It is unlikely but possible that the new nodes vector contains (very few) nodes that are not part of any element. This problem is
@@ -62,6 +77,9 @@ private:
 	static bool isNodeOnRaster(const MeshLib::Node &node,
 	                           const std::pair<double, double> &xDim,
 	                           const std::pair<double, double> &yDim);
+
+	/// Edge length in pixels of the square raster tiles used for ordering the nodes in LayerMapping().
+	static const std::size_t _raster_tile_size = 256;
 };
 
 #endif //MESHLAYERMAPPER_H
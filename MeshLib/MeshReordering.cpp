@@ -0,0 +1,53 @@
+/**
+ * \file
+ * \brief  Implementation of the reordering of mesh nodes.
+ *
+ * \copyright
+ * Copyright (c) 2013, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#include "MeshReordering.h"
+
+#include "Mesh.h"
+#include "Node.h"
+#include "NodeAdjacency.h"
+
+#include "Profiler.h"
+
+namespace MeshLib
+{
+
+std::vector<std::size_t> computeNodeOrdering(Mesh const& mesh,
+	MathLib::ReorderingMethod method)
+{
+	BASELIB_PROFILE_SCOPE("MeshLib::computeNodeOrdering");
+	std::size_t const n_nodes (mesh.getNNodes());
+	if (method == MathLib::ReorderingMethod::SPACE_FILLING_CURVE)
+	{
+		std::vector<Node*> const& nodes (mesh.getNodes());
+		std::vector<double> coords(3 * n_nodes);
+		for (std::size_t i=0; i<n_nodes; ++i)
+			for (unsigned d=0; d<3; ++d)
+				coords[3*i+d] = (*nodes[i])[d];
+		return MathLib::computeSpaceFillingCurveOrdering(n_nodes, coords.data());
+	}
+
+	NodeAdjacency const& adjacency (mesh.getNodeAdjacency());
+	return MathLib::computeOrdering(method, n_nodes,
+		adjacency.getOffsets().data(), adjacency.getAdjacentNodes().data(),
+		nullptr);
+}
+
+std::vector<std::size_t> reorderMeshNodes(Mesh &mesh,
+	MathLib::ReorderingMethod method)
+{
+	std::vector<std::size_t> const op_perm (computeNodeOrdering(mesh, method));
+	mesh.reorderNodes(op_perm);
+	return op_perm;
+}
+
+}
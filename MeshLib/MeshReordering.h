@@ -0,0 +1,45 @@
+/**
+ * \file
+ * \brief  Definition of the reordering of mesh nodes.
+ *
+ * \copyright
+ * Copyright (c) 2013, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#ifndef MESHREORDERING_H_
+#define MESHREORDERING_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "LinAlg/Sparse/Reordering.h"
+
+namespace MeshLib
+{
+class Mesh;
+
+/**
+ * Computes an ordering of the mesh nodes. The graph based methods use the
+ * node adjacency of the mesh, the space filling curve uses the node
+ * coordinates. The returned permutation maps new to original node ids.
+ */
+std::vector<std::size_t> computeNodeOrdering(Mesh const& mesh,
+	MathLib::ReorderingMethod method);
+
+/**
+ * Reorders the nodes of the mesh by the given method. Objects depending on
+ * the node ids, e.g. MeshSubsets and the AssemblerLib::MeshComponentMap,
+ * have to be created afterwards; the global indices and the sparsity pattern
+ * of the assembled matrices then follow the new node order. The permutation
+ * from new to original node ids is returned, e.g. to permute node data.
+ */
+std::vector<std::size_t> reorderMeshNodes(Mesh &mesh,
+	MathLib::ReorderingMethod method);
+
+}
+
+#endif /* MESHREORDERING_H_ */
@@ -0,0 +1,85 @@
+/**
+ * \copyright
+ * Copyright (c) 2013, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#include "NodeAdjacency.h"
+
+#include <algorithm>
+
+#include "Node.h"
+#include "Elements/Element.h"
+
+namespace MeshLib
+{
+
+namespace
+{
+/// Collects the sorted unique ids of the nodes adjacent to the given node
+/// into the buffer.
+void collectAdjacentNodes(Node const& node, std::vector<std::size_t> &buffer)
+{
+	buffer.clear();
+	std::vector<Element*> const& elements (node.getElements());
+	for (std::size_t j=0; j<elements.size(); ++j)
+	{
+		const unsigned nElemNodes (elements[j]->getNNodes());
+		for (unsigned k=0; k<nElemNodes; ++k)
+		{
+			const std::size_t id (elements[j]->getNode(k)->getID());
+			if (id != node.getID())
+				buffer.push_back(id);
+		}
+	}
+	std::sort(buffer.begin(), buffer.end());
+	buffer.erase(std::unique(buffer.begin(), buffer.end()), buffer.end());
+}
+}
+
+NodeAdjacency::NodeAdjacency(std::vector<Node*> const& nodes)
+	: _offsets(nodes.size() + 1, 0)
+{
+	const long nNodes (nodes.size());
+
+	// Count the adjacent nodes, then fill them in a second pass. Both passes
+	// reuse one buffer per thread instead of storing per-node vectors.
+#ifdef _OPENMP
+	#pragma omp parallel
+#endif
+	{
+		std::vector<std::size_t> buffer;
+#ifdef _OPENMP
+		#pragma omp for schedule(dynamic, 1024)
+#endif
+		for (long i=0; i<nNodes; ++i)
+		{
+			collectAdjacentNodes(*nodes[i], buffer);
+			_offsets[i+1] = buffer.size();
+		}
+	}
+
+	for (long i=0; i<nNodes; ++i)
+		_offsets[i+1] += _offsets[i];
+	_adjacent_nodes.resize(_offsets.back());
+
+#ifdef _OPENMP
+	#pragma omp parallel
+#endif
+	{
+		std::vector<std::size_t> buffer;
+#ifdef _OPENMP
+		#pragma omp for schedule(dynamic, 1024)
+#endif
+		for (long i=0; i<nNodes; ++i)
+		{
+			collectAdjacentNodes(*nodes[i], buffer);
+			std::copy(buffer.begin(), buffer.end(), _adjacent_nodes.begin() + _offsets[i]);
+		}
+	}
+}
+
+}
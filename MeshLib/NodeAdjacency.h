@@ -0,0 +1,70 @@
+/**
+ * \copyright
+ * Copyright (c) 2013, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#ifndef NODEADJACENCY_H_
+#define NODEADJACENCY_H_
+
+#include <cstddef>
+#include <vector>
+
+namespace MeshLib
+{
+class Node;
+
+/**
+ * Node-to-node adjacency of a mesh in compressed row storage. Two nodes are
+ * adjacent if they are (base) nodes of a common element. The ids of the
+ * adjacent nodes of node i are sorted and do not contain i itself.
+ */
+class NodeAdjacency
+{
+public:
+	typedef std::size_t const* ConstIterator;
+
+	/// Computes the adjacency from the elements connected to the nodes. The
+	/// node ids must be equal to the positions in the node vector. The nodes
+	/// are processed in parallel if OpenMP is enabled.
+	explicit NodeAdjacency(std::vector<Node*> const& nodes);
+
+	/// Number of nodes.
+	std::size_t size() const { return _offsets.size() - 1; }
+
+	/// Number of nodes adjacent to the node with the given id.
+	std::size_t getNAdjacentNodes(std::size_t node_id) const
+	{
+		return _offsets[node_id + 1] - _offsets[node_id];
+	}
+
+	/// First of the sorted ids of nodes adjacent to the given node.
+	ConstIterator begin(std::size_t node_id) const
+	{
+		return _adjacent_nodes.data() + _offsets[node_id];
+	}
+
+	/// End of the ids of nodes adjacent to the given node.
+	ConstIterator end(std::size_t node_id) const
+	{
+		return _adjacent_nodes.data() + _offsets[node_id + 1];
+	}
+
+	/// Positions of the adjacency lists of the nodes in getAdjacentNodes(),
+	/// size()+1 entries.
+	std::vector<std::size_t> const& getOffsets() const { return _offsets; }
+
+	/// Concatenated adjacency lists of all nodes.
+	std::vector<std::size_t> const& getAdjacentNodes() const { return _adjacent_nodes; }
+
+private:
+	std::vector<std::size_t> _offsets;
+	std::vector<std::size_t> _adjacent_nodes;
+};
+
+}
+
+#endif /* NODEADJACENCY_H_ */
@@ -0,0 +1,252 @@
+/**
+ * \file
+ * \brief  Definition of the BatchedNaturalCoordinatesMapping class.
+ *
+ * \copyright
+ * Copyright (c) 2013, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#ifndef BATCHEDNATURALCOORDINATESMAPPING_H_
+#define BATCHEDNATURALCOORDINATESMAPPING_H_
+
+#include <cassert>
+#include <cstddef>
+
+#include "logog/include/logog.hpp"
+
+namespace NumLib
+{
+
+namespace detail
+{
+
+/// Closed-form determinants and inverses of DIM x DIM matrices, evaluated
+/// for BLOCK_SIZE matrices at once. The matrices are stored lane-wise, i.e.
+/// entry (i,j) of matrix l is J[(i*DIM+j)*BLOCK_SIZE + l].
+template <std::size_t DIM, std::size_t BLOCK_SIZE> struct BatchedInverse;
+
+template <std::size_t BLOCK_SIZE>
+struct BatchedInverse<1, BLOCK_SIZE>
+{
+    static void compute(double const* J, double* detJ, double* invJ)
+    {
+        for (std::size_t l=0; l<BLOCK_SIZE; l++)
+        {
+            detJ[l] = J[l];
+            invJ[l] = 1.0 / J[l];
+        }
+    }
+};
+
+template <std::size_t BLOCK_SIZE>
+struct BatchedInverse<2, BLOCK_SIZE>
+{
+    static void compute(double const* J, double* detJ, double* invJ)
+    {
+        double const* const a = J;
+        double const* const b = J + BLOCK_SIZE;
+        double const* const c = J + 2*BLOCK_SIZE;
+        double const* const d = J + 3*BLOCK_SIZE;
+        for (std::size_t l=0; l<BLOCK_SIZE; l++)
+        {
+            double const det = a[l]*d[l] - b[l]*c[l];
+            double const inv_det = 1.0 / det;
+            detJ[l] = det;
+            invJ[l]              =  d[l] * inv_det;
+            invJ[BLOCK_SIZE+l]   = -b[l] * inv_det;
+            invJ[2*BLOCK_SIZE+l] = -c[l] * inv_det;
+            invJ[3*BLOCK_SIZE+l] =  a[l] * inv_det;
+        }
+    }
+};
+
+template <std::size_t BLOCK_SIZE>
+struct BatchedInverse<3, BLOCK_SIZE>
+{
+    static void compute(double const* J, double* detJ, double* invJ)
+    {
+        for (std::size_t l=0; l<BLOCK_SIZE; l++)
+        {
+            double const j00 = J[0*BLOCK_SIZE+l], j01 = J[1*BLOCK_SIZE+l], j02 = J[2*BLOCK_SIZE+l];
+            double const j10 = J[3*BLOCK_SIZE+l], j11 = J[4*BLOCK_SIZE+l], j12 = J[5*BLOCK_SIZE+l];
+            double const j20 = J[6*BLOCK_SIZE+l], j21 = J[7*BLOCK_SIZE+l], j22 = J[8*BLOCK_SIZE+l];
+            // cofactors
+            double const c00 = j11*j22 - j12*j21;
+            double const c01 = j12*j20 - j10*j22;
+            double const c02 = j10*j21 - j11*j20;
+            double const det = j00*c00 + j01*c01 + j02*c02;
+            double const inv_det = 1.0 / det;
+            detJ[l] = det;
+            invJ[0*BLOCK_SIZE+l] = c00 * inv_det;
+            invJ[1*BLOCK_SIZE+l] = (j02*j21 - j01*j22) * inv_det;
+            invJ[2*BLOCK_SIZE+l] = (j01*j12 - j02*j11) * inv_det;
+            invJ[3*BLOCK_SIZE+l] = c01 * inv_det;
+            invJ[4*BLOCK_SIZE+l] = (j00*j22 - j02*j20) * inv_det;
+            invJ[5*BLOCK_SIZE+l] = (j02*j10 - j00*j12) * inv_det;
+            invJ[6*BLOCK_SIZE+l] = c02 * inv_det;
+            invJ[7*BLOCK_SIZE+l] = (j01*j20 - j00*j21) * inv_det;
+            invJ[8*BLOCK_SIZE+l] = (j00*j11 - j01*j10) * inv_det;
+        }
+    }
+};
+
+} // detail
+
+/**
+ * \brief Coordinates mapping for a block of elements of the same type
+ *
+ * The node coordinates of up to BLOCK_SIZE elements are gathered once into
+ * arrays with the elements as the innermost (lane) index. The Jacobian, its
+ * determinant and closed-form inverse and dNdx are then computed for all
+ * elements of the block at once in loops of fixed length over the lanes,
+ * which the compiler vectorises. The shape function gradients in natural
+ * coordinates are shared by all elements, e.g. taken from a
+ * ShapeFunctionTable.
+ *
+ * \tparam T_MESH_ELEMENT   Mesh element type
+ * \tparam DIM              Dimension of the element and its natural coordinates
+ * \tparam BLOCK_SIZE       Number of elements processed at once
+ */
+template <class T_MESH_ELEMENT, std::size_t DIM, std::size_t BLOCK_SIZE = 8>
+class BatchedNaturalCoordinatesMapping
+{
+public:
+    static const std::size_t dim = DIM;
+    static const std::size_t n_nodes = T_MESH_ELEMENT::n_all_nodes;
+    static const std::size_t block_size = BLOCK_SIZE;
+
+    BatchedNaturalCoordinatesMapping() : _n_elements(0) {}
+
+    /**
+     * Gathers the node coordinates of the given elements. If less than
+     * block_size elements are given, the remaining lanes repeat the last
+     * element.
+     *
+     * @param elements      pointers to the elements
+     * @param n_elements    number of elements, 1 <= n_elements <= block_size
+     */
+    void setElements(T_MESH_ELEMENT const* const* elements, std::size_t n_elements)
+    {
+        assert(0 < n_elements && n_elements <= BLOCK_SIZE);
+        _n_elements = n_elements;
+        for (std::size_t l=0; l<BLOCK_SIZE; l++)
+        {
+            T_MESH_ELEMENT const& e = *elements[l < n_elements ? l : n_elements - 1];
+            for (std::size_t k=0; k<n_nodes; k++)
+            {
+                double const* const xyz = e.getNode(k)->getCoords();
+                for (std::size_t d=0; d<DIM; d++)
+                    _x[(k*DIM + d)*BLOCK_SIZE + l] = xyz[d];
+            }
+        }
+    }
+
+    /// return the number of elements set
+    std::size_t getNElements() const {return _n_elements;}
+
+    /**
+     * computes J, detJ, invJ and dNdx of all elements of the block
+     *
+     * @param dNdr  gradient of the shape functions in natural coordinates at
+     *              the evaluation point, dim x n_nodes entries row-wise
+     */
+    void computeShapeMatrices(double const* dNdr)
+    {
+        // J(i_r, j_x) = sum_k dNdr(i_r, k) x_k(j_x)
+        for (std::size_t i=0; i<DIM*DIM*BLOCK_SIZE; i++)
+            _J[i] = 0.0;
+        for (std::size_t k=0; k<n_nodes; k++)
+            for (std::size_t i_r=0; i_r<DIM; i_r++)
+            {
+                double const dN = dNdr[i_r*n_nodes + k];
+                for (std::size_t j_x=0; j_x<DIM; j_x++)
+                {
+                    double* const J = _J + (i_r*DIM + j_x)*BLOCK_SIZE;
+                    double const* const x = _x + (k*DIM + j_x)*BLOCK_SIZE;
+                    for (std::size_t l=0; l<BLOCK_SIZE; l++)
+                        J[l] += dN * x[l];
+                }
+            }
+
+        detail::BatchedInverse<DIM, BLOCK_SIZE>::compute(_J, _detJ, _invJ);
+#ifndef NDEBUG
+        for (std::size_t l=0; l<_n_elements; l++)
+            if (_detJ[l]<=.0)
+                ERR("***error: det|J|=%e is not positive.\n", _detJ[l]);
+#endif
+
+        // dNdx(i_x, k) = sum_j invJ(i_x, j_r) dNdr(j_r, k)
+        for (std::size_t i_x=0; i_x<DIM; i_x++)
+            for (std::size_t k=0; k<n_nodes; k++)
+            {
+                double* const dNdx = _dNdx + (i_x*n_nodes + k)*BLOCK_SIZE;
+                for (std::size_t l=0; l<BLOCK_SIZE; l++)
+                    dNdx[l] = 0.0;
+                for (std::size_t j_r=0; j_r<DIM; j_r++)
+                {
+                    double const dN = dNdr[j_r*n_nodes + k];
+                    double const* const invJ = _invJ + (i_x*DIM + j_r)*BLOCK_SIZE;
+                    for (std::size_t l=0; l<BLOCK_SIZE; l++)
+                        dNdx[l] += invJ[l] * dN;
+                }
+            }
+    }
+
+    /// determinant of the Jacobian of the element in the given lane
+    double getDetJ(std::size_t lane) const {return _detJ[lane];}
+
+    /// entry (i,j) of the Jacobian of the element in the given lane
+    double getJ(std::size_t lane, std::size_t i, std::size_t j) const
+    {
+        return _J[(i*DIM + j)*BLOCK_SIZE + lane];
+    }
+
+    /// entry (i,j) of the inverse Jacobian of the element in the given lane
+    double getInvJ(std::size_t lane, std::size_t i, std::size_t j) const
+    {
+        return _invJ[(i*DIM + j)*BLOCK_SIZE + lane];
+    }
+
+    /// derivative of the shape function of node k in direction i of the
+    /// element in the given lane
+    double getDNdx(std::size_t lane, std::size_t i, std::size_t k) const
+    {
+        return _dNdx[(i*n_nodes + k)*BLOCK_SIZE + lane];
+    }
+
+    /**
+     * copies J, detJ, invJ and dNdx of the element in the given lane into
+     * the shape matrices, N and dNdr are not touched
+     */
+    template <class T_SHAPE_MATRICES>
+    void getShapeMatrices(std::size_t lane, T_SHAPE_MATRICES &shapemat) const
+    {
+        shapemat.detJ = _detJ[lane];
+        for (std::size_t i=0; i<DIM; i++)
+        {
+            for (std::size_t j=0; j<DIM; j++)
+            {
+                shapemat.J(i,j) = getJ(lane, i, j);
+                shapemat.invJ(i,j) = getInvJ(lane, i, j);
+            }
+            for (std::size_t k=0; k<n_nodes; k++)
+                shapemat.dNdx(i,k) = getDNdx(lane, i, k);
+        }
+    }
+
+private:
+    std::size_t _n_elements;
+    double _x[n_nodes*DIM*BLOCK_SIZE];      ///< node coordinates, (node, dir, lane)
+    double _J[DIM*DIM*BLOCK_SIZE];          ///< Jacobians, (row, col, lane)
+    double _detJ[BLOCK_SIZE];               ///< determinants of the Jacobians
+    double _invJ[DIM*DIM*BLOCK_SIZE];       ///< inverse Jacobians, (row, col, lane)
+    double _dNdx[DIM*n_nodes*BLOCK_SIZE];   ///< gradients, (dir, node, lane)
+};
+
+} // NumLib
+
+#endif //BATCHEDNATURALCOORDINATESMAPPING_H_
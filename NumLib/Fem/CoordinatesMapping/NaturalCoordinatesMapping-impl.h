@@ -24,39 +24,87 @@ namespace detail
 
 template <ShapeMatrixType FIELD_TYPE> struct FieldType {};
 
-template <class T_MESH_ELEMENT, class T_SHAPE_FUNC, class T_SHAPE_MATRICES>
+/// Evaluates the shape functions at a point in natural coordinates.
+template <class T_SHAPE_FUNC>
+struct EvaluatedShapeFunction
+{
+    static const std::size_t dim = T_SHAPE_FUNC::DIM;
+    static const std::size_t n_nodes = T_SHAPE_FUNC::NPOINTS;
+
+    const double* natural_pt;
+
+    template <class T_N>
+    void getN(T_N &N) const
+    {
+        T_SHAPE_FUNC::computeShapeFunction(natural_pt, N);
+    }
+
+    void getDNdr(double* dNdr) const
+    {
+        T_SHAPE_FUNC::computeGradShapeFunction(natural_pt, dNdr);
+    }
+};
+
+/// Copies precomputed values of the shape functions.
+template <class T_SHAPE_FUNC>
+struct TabulatedShapeFunction
+{
+    static const std::size_t dim = T_SHAPE_FUNC::DIM;
+    static const std::size_t n_nodes = T_SHAPE_FUNC::NPOINTS;
+
+    const double* N;
+    const double* dNdr;
+
+    template <class T_N>
+    void getN(T_N &N_) const
+    {
+        for (std::size_t i=0; i<n_nodes; i++)
+            N_[i] = N[i];
+    }
+
+    void getDNdr(double* dNdr_) const
+    {
+        std::size_t const n = dim * n_nodes;
+        for (std::size_t i=0; i<n; i++)
+            dNdr_[i] = dNdr[i];
+    }
+};
+
+template <class T_MESH_ELEMENT, class T_SHAPE_SOURCE, class T_SHAPE_MATRICES>
 inline void computeMappingMatrices(
         const T_MESH_ELEMENT &/*ele*/,
-        const double* natural_pt,
+        const T_SHAPE_SOURCE &shape_source,
         T_SHAPE_MATRICES &shapemat,
         FieldType<ShapeMatrixType::N>)
 {
-    T_SHAPE_FUNC::computeShapeFunction(natural_pt, shapemat.N);
+    shape_source.getN(shapemat.N);
 };
 
-template <class T_MESH_ELEMENT, class T_SHAPE_FUNC, class T_SHAPE_MATRICES>
+template <class T_MESH_ELEMENT, class T_SHAPE_SOURCE, class T_SHAPE_MATRICES>
 inline void computeMappingMatrices(
         const T_MESH_ELEMENT &/*ele*/,
-        const double* natural_pt,
+        const T_SHAPE_SOURCE &shape_source,
         T_SHAPE_MATRICES &shapemat,
         FieldType<ShapeMatrixType::DNDR>)
 {
     double* const dNdr = shapemat.dNdr.data();
-    T_SHAPE_FUNC::computeGradShapeFunction(natural_pt, dNdr);
+    shape_source.getDNdr(dNdr);
 };
 
-template <class T_MESH_ELEMENT, class T_SHAPE_FUNC, class T_SHAPE_MATRICES>
+template <class T_MESH_ELEMENT, class T_SHAPE_SOURCE, class T_SHAPE_MATRICES>
 inline void computeMappingMatrices(
         const T_MESH_ELEMENT &ele,
-        const double* natural_pt,
+        const T_SHAPE_SOURCE &shape_source,
         T_SHAPE_MATRICES &shapemat,
         FieldType<ShapeMatrixType::DNDR_J>)
 {
-    computeMappingMatrices<T_MESH_ELEMENT, T_SHAPE_FUNC, T_SHAPE_MATRICES>
-        (ele, natural_pt, shapemat, FieldType<ShapeMatrixType::DNDR>());
+    computeMappingMatrices<T_MESH_ELEMENT, T_SHAPE_SOURCE, T_SHAPE_MATRICES>
+        (ele, shape_source, shapemat, FieldType<ShapeMatrixType::DNDR>());
 
-    const std::size_t dim = T_MESH_ELEMENT::dimension;
-    const std::size_t nnodes = T_MESH_ELEMENT::n_all_nodes;
+    // the sizes are compile-time constants of the shape function, such that
+    // the loops are unrolled for fixed-size matrices
+    const std::size_t dim = T_SHAPE_SOURCE::dim;
+    const std::size_t nnodes = T_SHAPE_SOURCE::n_nodes;
 
     //jacobian: J=[dx/dr dy/dr // dx/ds dy/ds]
     for (std::size_t k=0; k<nnodes; k++) {
@@ -76,28 +124,28 @@ inline void computeMappingMatrices(
 #endif
 };
 
-template <class T_MESH_ELEMENT, class T_SHAPE_FUNC, class T_SHAPE_MATRICES>
+template <class T_MESH_ELEMENT, class T_SHAPE_SOURCE, class T_SHAPE_MATRICES>
 inline void computeMappingMatrices(
         const T_MESH_ELEMENT &ele,
-        const double* natural_pt,
+        const T_SHAPE_SOURCE &shape_source,
         T_SHAPE_MATRICES &shapemat,
         FieldType<ShapeMatrixType::N_J>)
 {
-    computeMappingMatrices<T_MESH_ELEMENT, T_SHAPE_FUNC, T_SHAPE_MATRICES>
-        (ele, natural_pt, shapemat, FieldType<ShapeMatrixType::N>());
-    computeMappingMatrices<T_MESH_ELEMENT, T_SHAPE_FUNC, T_SHAPE_MATRICES>
-        (ele, natural_pt, shapemat, FieldType<ShapeMatrixType::DNDR_J>());
+    computeMappingMatrices<T_MESH_ELEMENT, T_SHAPE_SOURCE, T_SHAPE_MATRICES>
+        (ele, shape_source, shapemat, FieldType<ShapeMatrixType::N>());
+    computeMappingMatrices<T_MESH_ELEMENT, T_SHAPE_SOURCE, T_SHAPE_MATRICES>
+        (ele, shape_source, shapemat, FieldType<ShapeMatrixType::DNDR_J>());
 };
 
-template <class T_MESH_ELEMENT, class T_SHAPE_FUNC, class T_SHAPE_MATRICES>
+template <class T_MESH_ELEMENT, class T_SHAPE_SOURCE, class T_SHAPE_MATRICES>
 inline void computeMappingMatrices(
         const T_MESH_ELEMENT &ele,
-        const double* natural_pt,
+        const T_SHAPE_SOURCE &shape_source,
         T_SHAPE_MATRICES &shapemat,
         FieldType<ShapeMatrixType::DNDX>)
 {
-    computeMappingMatrices<T_MESH_ELEMENT, T_SHAPE_FUNC, T_SHAPE_MATRICES>
-        (ele, natural_pt, shapemat, FieldType<ShapeMatrixType::DNDR_J>());
+    computeMappingMatrices<T_MESH_ELEMENT, T_SHAPE_SOURCE, T_SHAPE_MATRICES>
+        (ele, shape_source, shapemat, FieldType<ShapeMatrixType::DNDR_J>());
 
     if (shapemat.detJ>.0) {
         //J^-1, dshape/dx
@@ -106,17 +154,17 @@ inline void computeMappingMatrices(
     }
 };
 
-template <class T_MESH_ELEMENT, class T_SHAPE_FUNC, class T_SHAPE_MATRICES>
+template <class T_MESH_ELEMENT, class T_SHAPE_SOURCE, class T_SHAPE_MATRICES>
 inline void computeMappingMatrices(
         const T_MESH_ELEMENT &ele,
-        const double* natural_pt,
+        const T_SHAPE_SOURCE &shape_source,
         T_SHAPE_MATRICES &shapemat,
         FieldType<ShapeMatrixType::ALL>)
 {
-    computeMappingMatrices<T_MESH_ELEMENT, T_SHAPE_FUNC, T_SHAPE_MATRICES>
-        (ele, natural_pt, shapemat, FieldType<ShapeMatrixType::N>());
-    computeMappingMatrices<T_MESH_ELEMENT, T_SHAPE_FUNC, T_SHAPE_MATRICES>
-        (ele, natural_pt, shapemat, FieldType<ShapeMatrixType::DNDX>());
+    computeMappingMatrices<T_MESH_ELEMENT, T_SHAPE_SOURCE, T_SHAPE_MATRICES>
+        (ele, shape_source, shapemat, FieldType<ShapeMatrixType::N>());
+    computeMappingMatrices<T_MESH_ELEMENT, T_SHAPE_SOURCE, T_SHAPE_MATRICES>
+        (ele, shape_source, shapemat, FieldType<ShapeMatrixType::DNDX>());
 };
 
 } // detail
@@ -131,12 +179,13 @@ inline void NaturalCoordinatesMapping<
         const double* natural_pt,
         T_SHAPE_MATRICES &shapemat)
 {
+    detail::EvaluatedShapeFunction<T_SHAPE_FUNC> const shape_source = {natural_pt};
     detail::computeMappingMatrices<
         T_MESH_ELEMENT,
-        T_SHAPE_FUNC,
+        detail::EvaluatedShapeFunction<T_SHAPE_FUNC>,
         T_SHAPE_MATRICES>
             (ele,
-             natural_pt,
+             shape_source,
              shapemat,
              detail::FieldType<ShapeMatrixType::ALL>());
 }
@@ -152,12 +201,51 @@ inline void NaturalCoordinatesMapping<
         const double* natural_pt,
         T_SHAPE_MATRICES &shapemat)
 {
+    detail::EvaluatedShapeFunction<T_SHAPE_FUNC> const shape_source = {natural_pt};
+    detail::computeMappingMatrices<
+        T_MESH_ELEMENT,
+        detail::EvaluatedShapeFunction<T_SHAPE_FUNC>,
+        T_SHAPE_MATRICES>
+            (ele,
+             shape_source,
+             shapemat,
+             detail::FieldType<T_SHAPE_MATRIX_TYPE>());
+}
+
+template <class T_MESH_ELEMENT, class T_SHAPE_FUNC, class T_SHAPE_MATRICES>
+inline void NaturalCoordinatesMapping<
+    T_MESH_ELEMENT,
+    T_SHAPE_FUNC,
+    T_SHAPE_MATRICES>
+::computeShapeMatrices(
+        const T_MESH_ELEMENT &ele,
+        const double* N,
+        const double* dNdr,
+        T_SHAPE_MATRICES &shapemat)
+{
+    computeShapeMatrices<ShapeMatrixType::ALL>(ele, N, dNdr, shapemat);
+}
+
+template <class T_MESH_ELEMENT, class T_SHAPE_FUNC, class T_SHAPE_MATRICES>
+template <ShapeMatrixType T_SHAPE_MATRIX_TYPE>
+inline void NaturalCoordinatesMapping<
+    T_MESH_ELEMENT,
+    T_SHAPE_FUNC,
+    T_SHAPE_MATRICES>
+::computeShapeMatrices(
+        const T_MESH_ELEMENT &ele,
+        const double* N,
+        const double* dNdr,
+        T_SHAPE_MATRICES &shapemat)
+{
+    typedef detail::TabulatedShapeFunction<T_SHAPE_FUNC> ShapeSource;
+    ShapeSource const shape_source = {N, dNdr};
     detail::computeMappingMatrices<
         T_MESH_ELEMENT,
-        T_SHAPE_FUNC,
+        ShapeSource,
         T_SHAPE_MATRICES>
             (ele,
-             natural_pt,
+             shape_source,
              shapemat,
              detail::FieldType<T_SHAPE_MATRIX_TYPE>());
 }
@@ -49,6 +49,29 @@ struct NaturalCoordinatesMapping
      */
     template <ShapeMatrixType T_SHAPE_MATRIX_TYPE>
     static void computeShapeMatrices(const T_MESH_ELEMENT &ele, const double* natural_pt, T_SHAPE_MATRICES &shapemat);
+
+    /**
+     * compute all mapping matrices from precomputed shape functions, e.g.
+     * taken from a ShapeFunctionTable
+     *
+     * @param ele               Mesh element object
+     * @param N                 Shape functions at the location
+     * @param dNdr              Gradient of the shape functions at the location, dim x nnodes row-wise
+     * @param shapemat          Shape matrix data where calculated shape functions are stored
+     */
+    static void computeShapeMatrices(const T_MESH_ELEMENT &ele, const double* N, const double* dNdr, T_SHAPE_MATRICES &shapemat);
+
+    /**
+     * compute specified mapping matrices from precomputed shape functions
+     *
+     * @tparam T_SHAPE_MATRIX_TYPE  Mapping matrix types to be calculated
+     * @param ele                   Mesh element object
+     * @param N                     Shape functions at the location
+     * @param dNdr                  Gradient of the shape functions at the location, dim x nnodes row-wise
+     * @param shapemat              Shape matrix data where calculated shape functions are stored
+     */
+    template <ShapeMatrixType T_SHAPE_MATRIX_TYPE>
+    static void computeShapeMatrices(const T_MESH_ELEMENT &ele, const double* N, const double* dNdr, T_SHAPE_MATRICES &shapemat);
 };
 
 } // NumLib
@@ -0,0 +1,126 @@
+/**
+ * \file
+ * \brief  Definition of the ShapeFunctionTable class.
+ *
+ * \copyright
+ * Copyright (c) 2013, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#ifndef SHAPEFUNCTIONTABLE_H_
+#define SHAPEFUNCTIONTABLE_H_
+
+#include <cassert>
+#include <vector>
+
+namespace NumLib
+{
+
+/**
+ * \brief Shape functions and their gradients in natural coordinates at the
+ * integration points of one element type
+ *
+ * The values do not depend on the element geometry and are computed once per
+ * integration order. They are stored contiguously point by point, i.e. N has
+ * n_nodes and dNdr has dim x n_nodes (row-wise) entries per point, where dim
+ * and n_nodes are the dimension and the number of nodes of the element.
+ *
+ * \tparam T_MESH_ELEMENT   Mesh element type
+ * \tparam T_SHAPE_FUNC     Shape function class
+ * \tparam T_INTEGRAL       Integration method
+ */
+template <class T_MESH_ELEMENT, class T_SHAPE_FUNC, class T_INTEGRAL>
+class ShapeFunctionTable
+{
+public:
+    /// Highest integration order for which a table is provided.
+    static const std::size_t max_integration_order = 4;
+
+    /**
+     * Returns the table for the given integration order. All tables of the
+     * element type are computed on the first call, which is thread-safe.
+     * The table of an order not supported by the integration method is empty.
+     */
+    static ShapeFunctionTable const& get(std::size_t integration_order)
+    {
+        static std::vector<ShapeFunctionTable> const tables(createTables());
+        assert(1 <= integration_order && integration_order <= max_integration_order);
+        return tables[integration_order - 1];
+    }
+
+    /// return the integration order of the table
+    std::size_t getIntegrationOrder() const {return _order;}
+
+    /// return the number of integration points
+    std::size_t getNPoints() const {return _weights.size();}
+
+    /// integration weight of the point igp
+    double getWeight(std::size_t igp) const {return _weights[igp];}
+
+    /// natural coordinates of the point igp
+    double const* getNaturalCoordinates(std::size_t igp) const
+    {
+        return _coords.data() + igp * _dim;
+    }
+
+    /// shape functions at the point igp
+    double const* getN(std::size_t igp) const
+    {
+        return _N.data() + igp * _n_nodes;
+    }
+
+    /// gradient of the shape functions at the point igp
+    double const* getDNdr(std::size_t igp) const
+    {
+        return _dNdr.data() + igp * _dim * _n_nodes;
+    }
+
+private:
+    explicit ShapeFunctionTable(std::size_t order)
+    : _order(order), _dim(T_MESH_ELEMENT::dimension),
+      _n_nodes(T_MESH_ELEMENT::n_all_nodes)
+    {
+        T_INTEGRAL const integration(order);
+        std::size_t const n_points = integration.getNPoints();
+        _weights.resize(n_points);
+        _coords.resize(n_points * _dim);
+        _N.resize(n_points * _n_nodes);
+        _dNdr.resize(n_points * _dim * _n_nodes);
+        for (std::size_t igp=0; igp<n_points; igp++)
+        {
+            auto const wp = T_INTEGRAL::getWeightedPoint(order, igp);
+            _weights[igp] = wp.getWeight();
+            double* const r = _coords.data() + igp * _dim;
+            for (std::size_t d=0; d<_dim; d++)
+                r[d] = wp[d];
+            double* const N = _N.data() + igp * _n_nodes;
+            T_SHAPE_FUNC::computeShapeFunction(r, N);
+            double* const dNdr = _dNdr.data() + igp * _dim * _n_nodes;
+            T_SHAPE_FUNC::computeGradShapeFunction(r, dNdr);
+        }
+    }
+
+    static std::vector<ShapeFunctionTable> createTables()
+    {
+        std::vector<ShapeFunctionTable> tables;
+        for (std::size_t order=1; order<=max_integration_order; order++)
+            tables.push_back(ShapeFunctionTable(order));
+        return tables;
+    }
+
+private:
+    std::size_t _order;
+    std::size_t _dim;
+    std::size_t _n_nodes;
+    std::vector<double> _weights;
+    std::vector<double> _coords;
+    std::vector<double> _N;
+    std::vector<double> _dNdr;
+};
+
+} // NumLib
+
+#endif //SHAPEFUNCTIONTABLE_H_
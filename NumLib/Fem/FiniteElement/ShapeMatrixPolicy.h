@@ -0,0 +1,76 @@
+/**
+ * \file
+ * \brief  Definition of matrix types for shape matrices and local matrices.
+ *
+ * \copyright
+ * Copyright (c) 2013, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#ifndef SHAPEMATRIXPOLICY_H_
+#define SHAPEMATRIXPOLICY_H_
+
+#ifdef OGS_USE_EIGEN
+#include <Eigen/Eigen>
+#endif
+
+#include "NumLib/Fem/CoordinatesMapping/ShapeMatrices.h"
+
+namespace NumLib
+{
+
+#ifdef OGS_USE_EIGEN
+/**
+ * \brief Eigen matrices with sizes fixed at compile time by the shape function
+ *
+ * The sizes are taken from T_SHAPE_FUNC::DIM and T_SHAPE_FUNC::NPOINTS. The
+ * matrices are stored on the stack, i.e. constructing shape matrices or local
+ * matrices does not allocate memory, and loops over the dimension and the
+ * nodes are unrolled by the compiler.
+ *
+ * \note Objects containing these matrices have to be allocated with
+ * Eigen::aligned_allocator if they are stored on the heap.
+ *
+ * \tparam T_SHAPE_FUNC     Shape function class
+ */
+template <class T_SHAPE_FUNC>
+struct EigenFixedShapeMatrixPolicy
+{
+    static const std::size_t dim = T_SHAPE_FUNC::DIM;
+    static const std::size_t n_nodes = T_SHAPE_FUNC::NPOINTS;
+
+    typedef Eigen::Matrix<double, n_nodes, n_nodes, Eigen::RowMajor> NodalMatrixType;
+    typedef Eigen::Matrix<double, n_nodes, 1> NodalVectorType;
+    typedef Eigen::Matrix<double, dim, n_nodes, Eigen::RowMajor> DimNodalMatrixType;
+    typedef Eigen::Matrix<double, dim, dim, Eigen::RowMajor> DimMatrixType;
+    typedef ShapeMatrices<NodalVectorType, DimNodalMatrixType, DimMatrixType> ShapeMatricesType;
+};
+
+/**
+ * \brief Eigen matrices with sizes set at run time
+ *
+ * The same interface as EigenFixedShapeMatrixPolicy, the matrices are
+ * allocated on the heap when they are constructed.
+ *
+ * \tparam T_SHAPE_FUNC     Shape function class
+ */
+template <class T_SHAPE_FUNC>
+struct EigenDynamicShapeMatrixPolicy
+{
+    static const std::size_t dim = T_SHAPE_FUNC::DIM;
+    static const std::size_t n_nodes = T_SHAPE_FUNC::NPOINTS;
+
+    typedef Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> NodalMatrixType;
+    typedef Eigen::VectorXd NodalVectorType;
+    typedef NodalMatrixType DimNodalMatrixType;
+    typedef NodalMatrixType DimMatrixType;
+    typedef ShapeMatrices<NodalVectorType, DimNodalMatrixType, DimMatrixType> ShapeMatricesType;
+};
+#endif // OGS_USE_EIGEN
+
+} // NumLib
+
+#endif //SHAPEMATRIXPOLICY_H_
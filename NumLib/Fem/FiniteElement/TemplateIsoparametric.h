@@ -19,6 +19,7 @@
 
 #include "../CoordinatesMapping/ShapeMatrices.h"
 #include "../CoordinatesMapping/NaturalCoordinatesMapping.h"
+#include "../CoordinatesMapping/ShapeFunctionTable.h"
 
 namespace NumLib
 {
@@ -52,6 +53,7 @@ public:
     typedef T_DIM_MATRIX DimMatrixType;
     typedef ShapeMatrices<NodalVectorType, DimNodalMatrixType, DimMatrixType> ShapeMatricesType;
     typedef NaturalCoordinatesMapping<MeshElementType, ShapeFunctionType, ShapeMatricesType> NaturalCoordsMappingType;
+    typedef ShapeFunctionTable<MeshElementType, ShapeFunctionType, IntegrationMethod> ShapeFunctionTableType;
 
     /**
      * Constructor without specifying a mesh element. setMeshElement() must be called afterwards.
@@ -106,6 +108,48 @@ public:
         NaturalCoordsMappingType::template computeShapeMatrices<T_SHAPE_MATRIX_TYPE>(*_ele, natural_pt, shape);
     }
 
+    /**
+     * return the precomputed shape functions at the integration points
+     *
+     * @param integration_order     integration order
+     */
+    static ShapeFunctionTableType const& getShapeFunctionTable(std::size_t integration_order)
+    {
+        return ShapeFunctionTableType::get(integration_order);
+    }
+
+    /**
+     * compute shape functions at an integration point using the precomputed
+     * values in natural coordinates, only the Jacobian, its inverse and
+     * dNdx are computed for the element
+     *
+     * @param integration_order     integration order
+     * @param igp                   integration point index
+     * @param shape                 evaluated shape function matrices
+     */
+    void computeShapeFunctionsAtIntegrationPoint(std::size_t integration_order, std::size_t igp, ShapeMatricesType &shape) const
+    {
+        computeShapeFunctionsAtIntegrationPoint<ShapeMatrixType::ALL>(integration_order, igp, shape);
+    }
+
+    /**
+     * compute shape functions at an integration point using the precomputed
+     * values in natural coordinates
+     *
+     * @tparam T_SHAPE_MATRIX_TYPE  shape matrix types to be calculated
+     * @param integration_order     integration order
+     * @param igp                   integration point index
+     * @param shape                 evaluated shape function matrices
+     */
+    template <ShapeMatrixType T_SHAPE_MATRIX_TYPE>
+    void computeShapeFunctionsAtIntegrationPoint(std::size_t integration_order, std::size_t igp, ShapeMatricesType &shape) const
+    {
+        ShapeFunctionTableType const& table = getShapeFunctionTable(integration_order);
+        assert(igp < table.getNPoints());
+        NaturalCoordsMappingType::template computeShapeMatrices<T_SHAPE_MATRIX_TYPE>(
+            *_ele, table.getN(igp), table.getDNdr(igp), shape);
+    }
+
 
 private:
     const MeshElementType* _ele;
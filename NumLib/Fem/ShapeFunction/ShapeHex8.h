@@ -10,6 +10,8 @@
 #ifndef SHAPEHEX8_H_
 #define SHAPEHEX8_H_
 
+#include <cstddef>
+
 namespace NumLib
 {
 
@@ -38,6 +40,9 @@ namespace NumLib
 class ShapeHex8
 {
 public:
+    static const std::size_t DIM = 3;
+    static const std::size_t NPOINTS = 8;
+
     /**
      * Evaluate the shape function at the given point
      *
@@ -10,6 +10,8 @@
 #ifndef SHAPELINE2_H_
 #define SHAPELINE2_H_
 
+#include <cstddef>
+
 namespace NumLib
 {
 
@@ -24,6 +26,9 @@ namespace NumLib
 class ShapeLine2
 {
 public:
+    static const std::size_t DIM = 1;
+    static const std::size_t NPOINTS = 2;
+
     /**
      * Evaluate the shape function at the given point
      *
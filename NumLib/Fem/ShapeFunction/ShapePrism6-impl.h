@@ -0,0 +1,63 @@
+/**
+ * \file
+ * \brief  Implementation of the ShapePrism6 class.
+ *
+ * \copyright
+ * Copyright (c) 2013, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+namespace NumLib
+{
+
+template <class T_X, class T_N>
+void ShapePrism6::computeShapeFunction(const T_X &r, T_N &N)
+{
+    const double L1 = 1.0 - r[0] - r[1];
+    const double L2 = r[0];
+    const double L3 = r[1];
+    const double t = r[2];
+
+    N[0] = 0.5 * L1 * (1.0 - t);
+    N[1] = 0.5 * L2 * (1.0 - t);
+    N[2] = 0.5 * L3 * (1.0 - t);
+    N[3] = 0.5 * L1 * (1.0 + t);
+    N[4] = 0.5 * L2 * (1.0 + t);
+    N[5] = 0.5 * L3 * (1.0 + t);
+}
+
+template <class T_X, class T_N>
+void ShapePrism6::computeGradShapeFunction(const T_X &r, T_N &dN)
+{
+    const double L1 = 1.0 - r[0] - r[1];
+    const double L2 = r[0];
+    const double L3 = r[1];
+    const double t = r[2];
+
+    //dN/dr
+    dN[0] = -0.5 * (1.0 - t);
+    dN[1] =  0.5 * (1.0 - t);
+    dN[2] =  0.0;
+    dN[3] = -0.5 * (1.0 + t);
+    dN[4] =  0.5 * (1.0 + t);
+    dN[5] =  0.0;
+    //dN/ds
+    dN[6] = -0.5 * (1.0 - t);
+    dN[7] =  0.0;
+    dN[8] =  0.5 * (1.0 - t);
+    dN[9] = -0.5 * (1.0 + t);
+    dN[10] = 0.0;
+    dN[11] = 0.5 * (1.0 + t);
+    //dN/dt
+    dN[12] = -0.5 * L1;
+    dN[13] = -0.5 * L2;
+    dN[14] = -0.5 * L3;
+    dN[15] =  0.5 * L1;
+    dN[16] =  0.5 * L2;
+    dN[17] =  0.5 * L3;
+}
+
+}
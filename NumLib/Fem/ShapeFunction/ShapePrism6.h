@@ -0,0 +1,60 @@
+/**
+ * \file
+ * \brief  Definition of the ShapePrism6 class.
+ *
+ * \copyright
+ * Copyright (c) 2013, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#ifndef SHAPEPRISM6_H_
+#define SHAPEPRISM6_H_
+
+#include <cstddef>
+
+namespace NumLib
+{
+
+/**
+ *  Shape function for a prism element of six nodes in natural coordinates.
+ *  The triangular faces are parametrised by r, s >= 0, r + s <= 1, the
+ *  direction between them by t in [-1, 1].
+ *
+ * \verbatim
+ *  bottom (t=-1): node 0 (0,0), node 1 (1,0), node 2 (0,1)
+ *  top    (t= 1): node 3 (0,0), node 4 (1,0), node 5 (0,1)
+ * \endverbatim
+ */
+class ShapePrism6
+{
+public:
+    static const std::size_t DIM = 3;
+    static const std::size_t NPOINTS = 6;
+
+    /**
+     * Evaluate the shape function at the given point
+     *
+     * @param [in]  r    point coordinates
+     * @param [out] N   a vector of calculated shape function.
+     */
+    template <class T_X, class T_N>
+    static void computeShapeFunction(const T_X &r, T_N &N);
+
+    /**
+     * Evaluate derivatives of the shape function at the given point
+     *
+     * @param [in]  r    point coordinates
+     * @param [out] dN  a matrix of the derivatives
+     */
+    template <class T_X, class T_N>
+    static void computeGradShapeFunction(const T_X &r, T_N &dN);
+};
+
+}
+
+#include "ShapePrism6-impl.h"
+
+#endif //SHAPEPRISM6_H_
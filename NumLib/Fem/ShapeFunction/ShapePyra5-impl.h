@@ -0,0 +1,49 @@
+/**
+ * \file
+ * \brief  Implementation of the ShapePyra5 class.
+ *
+ * \copyright
+ * Copyright (c) 2013, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+namespace NumLib
+{
+
+template <class T_X, class T_N>
+void ShapePyra5::computeShapeFunction(const T_X &r, T_N &N)
+{
+    N[0] = 0.125 * (1.0 - r[0]) * (1.0 - r[1]) * (1.0 - r[2]);
+    N[1] = 0.125 * (1.0 + r[0]) * (1.0 - r[1]) * (1.0 - r[2]);
+    N[2] = 0.125 * (1.0 + r[0]) * (1.0 + r[1]) * (1.0 - r[2]);
+    N[3] = 0.125 * (1.0 - r[0]) * (1.0 + r[1]) * (1.0 - r[2]);
+    N[4] = 0.5 * (1.0 + r[2]);
+}
+
+template <class T_X, class T_N>
+void ShapePyra5::computeGradShapeFunction(const T_X &r, T_N &dN)
+{
+    //dN/dr
+    dN[0] = -0.125 * (1.0 - r[1]) * (1.0 - r[2]);
+    dN[1] = -dN[0];
+    dN[2] =  0.125 * (1.0 + r[1]) * (1.0 - r[2]);
+    dN[3] = -dN[2];
+    dN[4] =  0.0;
+    //dN/ds
+    dN[5] = -0.125 * (1.0 - r[0]) * (1.0 - r[2]);
+    dN[6] = -0.125 * (1.0 + r[0]) * (1.0 - r[2]);
+    dN[7] = -dN[6];
+    dN[8] = -dN[5];
+    dN[9] =  0.0;
+    //dN/dt
+    dN[10] = -0.125 * (1.0 - r[0]) * (1.0 - r[1]);
+    dN[11] = -0.125 * (1.0 + r[0]) * (1.0 - r[1]);
+    dN[12] = -0.125 * (1.0 + r[0]) * (1.0 + r[1]);
+    dN[13] = -0.125 * (1.0 - r[0]) * (1.0 + r[1]);
+    dN[14] =  0.5;
+}
+
+}
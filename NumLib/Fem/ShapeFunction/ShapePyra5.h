@@ -0,0 +1,59 @@
+/**
+ * \file
+ * \brief  Definition of the ShapePyra5 class.
+ *
+ * \copyright
+ * Copyright (c) 2013, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#ifndef SHAPEPYRA5_H_
+#define SHAPEPYRA5_H_
+
+#include <cstddef>
+
+namespace NumLib
+{
+
+/**
+ *  Shape function for a pyramid element of five nodes in natural coordinates
+ *  r, s, t in [-1, 1]. The base is at t=-1, the apex at t=1.
+ *
+ * \verbatim
+ *  node 0 (-1,-1,-1), node 1 (1,-1,-1), node 2 (1,1,-1), node 3 (-1,1,-1)
+ *  node 4 (apex)
+ * \endverbatim
+ */
+class ShapePyra5
+{
+public:
+    static const std::size_t DIM = 3;
+    static const std::size_t NPOINTS = 5;
+
+    /**
+     * Evaluate the shape function at the given point
+     *
+     * @param [in]  r    point coordinates
+     * @param [out] N   a vector of calculated shape function.
+     */
+    template <class T_X, class T_N>
+    static void computeShapeFunction(const T_X &r, T_N &N);
+
+    /**
+     * Evaluate derivatives of the shape function at the given point
+     *
+     * @param [in]  r    point coordinates
+     * @param [out] dN  a matrix of the derivatives
+     */
+    template <class T_X, class T_N>
+    static void computeGradShapeFunction(const T_X &r, T_N &dN);
+};
+
+}
+
+#include "ShapePyra5-impl.h"
+
+#endif //SHAPEPYRA5_H_
@@ -13,6 +13,8 @@
 #ifndef SHAPEQUAD4_H_
 #define SHAPEQUAD4_H_
 
+#include <cstddef>
+
 namespace NumLib
 {
 
@@ -32,6 +34,9 @@ namespace NumLib
 class ShapeQuad4
 {
 public:
+    static const std::size_t DIM = 2;
+    static const std::size_t NPOINTS = 4;
+
     /**
      * Evaluate the shape function at the given point
      *
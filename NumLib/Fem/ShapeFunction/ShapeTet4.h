@@ -0,0 +1,58 @@
+/**
+ * \file
+ * \brief  Definition of the ShapeTet4 class.
+ *
+ * \copyright
+ * Copyright (c) 2013, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#ifndef SHAPETET4_H_
+#define SHAPETET4_H_
+
+#include <cstddef>
+
+namespace NumLib
+{
+
+/**
+ *  Shape function for a tetrahedron element of four nodes in natural
+ *  coordinates r, s, t >= 0, r + s + t <= 1
+ *
+ * \verbatim
+ *  node 0 (0,0,0), node 1 (1,0,0), node 2 (0,1,0), node 3 (0,0,1)
+ * \endverbatim
+ */
+class ShapeTet4
+{
+public:
+    static const std::size_t DIM = 3;
+    static const std::size_t NPOINTS = 4;
+
+    /**
+     * Evaluate the shape function at the given point
+     *
+     * @param [in]  r    point coordinates
+     * @param [out] N   a vector of calculated shape function.
+     */
+    template <class T_X, class T_N>
+    static void computeShapeFunction(const T_X &r, T_N &N);
+
+    /**
+     * Evaluate derivatives of the shape function at the given point
+     *
+     * @param [in]  r    point coordinates
+     * @param [out] dN  a matrix of the derivatives
+     */
+    template <class T_X, class T_N>
+    static void computeGradShapeFunction(const T_X &r, T_N &dN);
+};
+
+}
+
+#include "ShapeTet4-impl.h"
+
+#endif //SHAPETET4_H_
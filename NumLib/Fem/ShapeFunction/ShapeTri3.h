@@ -15,6 +15,8 @@
 #ifndef SHAPETRI3_H_
 #define SHAPETRI3_H_
 
+#include <cstddef>
+
 namespace NumLib
 {
 
@@ -32,6 +34,9 @@ namespace NumLib
 class ShapeTri3
 {
 public:
+    static const std::size_t DIM = 2;
+    static const std::size_t NPOINTS = 3;
+
     /**
      * Evaluate the shape function at the given point
      *
@@ -0,0 +1,135 @@
+/**
+ * \file
+ * \brief  Benchmark of the assembly of local matrices with dynamically and
+ * statically sized shape matrices.
+ *
+ * \copyright
+ * Copyright (c) 2013, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#include <string>
+
+// BaseLib
+#include "RunTime.h"
+#include "tclap/CmdLine.h"
+#include "LogogSimpleFormatter.h"
+
+// ThirdParty/logog
+#include "logog/include/logog.hpp"
+
+// MeshLib
+#include "Mesh.h"
+#include "MeshGenerators/MeshGenerator.h"
+
+// NumLib
+#include "NumLib/Fem/FiniteElement/C0IsoparametricElements.h"
+#include "NumLib/Fem/FiniteElement/ShapeMatrixPolicy.h"
+
+/**
+ * Computes the mass and the Laplace matrix of all elements of the mesh with
+ * the shape functions evaluated at the integration points. The shape matrices
+ * and the local matrices are constructed per element like in an assembler.
+ * Returns the sum of all entries of the local matrices.
+ */
+template <template <class, class, class> class T_FE, class T_POLICY, class T_ELEMENT>
+double assembleLocalMatrices(MeshLib::Mesh const& mesh, bool use_table)
+{
+	typedef typename T_POLICY::NodalMatrixType NodalMatrix;
+	typedef typename T_POLICY::ShapeMatricesType ShapeMatricesType;
+	typedef typename T_FE<typename T_POLICY::NodalVectorType,
+		typename T_POLICY::DimNodalMatrixType,
+		typename T_POLICY::DimMatrixType>::type FeType;
+
+	std::size_t const dim (T_POLICY::dim);
+	std::size_t const n_nodes (T_POLICY::n_nodes);
+	std::size_t const integration_order (2);
+	typename FeType::IntegrationMethod const integration_method(integration_order);
+	typename FeType::ShapeFunctionTableType const& table (
+		FeType::getShapeFunctionTable(integration_order));
+
+	double checksum (0.0);
+	FeType fe;
+	for (MeshLib::Element const* e : mesh.getElements()) {
+		fe.setMeshElement(*static_cast<T_ELEMENT const*>(e));
+		NodalMatrix M(n_nodes, n_nodes);
+		NodalMatrix K(n_nodes, n_nodes);
+		M.setZero();
+		K.setZero();
+		ShapeMatricesType shape(dim, n_nodes);
+		for (std::size_t ip(0); ip < integration_method.getNPoints(); ip++) {
+			shape.setZero();
+			double w;
+			if (use_table) {
+				fe.computeShapeFunctionsAtIntegrationPoint(integration_order, ip, shape);
+				w = table.getWeight(ip);
+			} else {
+				auto const wp = integration_method.getWeightedPoint(ip);
+				fe.computeShapeFunctions(wp.getCoords(), shape);
+				w = wp.getWeight();
+			}
+			M.noalias() += shape.N * shape.N.transpose() * shape.detJ * w;
+			K.noalias() += shape.dNdx.transpose() * shape.dNdx * shape.detJ * w;
+		}
+		checksum += M.sum() + K.sum();
+	}
+	return checksum;
+}
+
+template <template <class, class, class> class T_FE, class T_POLICY, class T_ELEMENT>
+void runBenchmark(std::string const& name, MeshLib::Mesh const& mesh,
+	unsigned n_repetitions, bool use_table)
+{
+	BaseLib::RunTime run_time;
+	run_time.start();
+	double checksum (0.0);
+	for (unsigned k(0); k < n_repetitions; k++)
+		checksum += assembleLocalMatrices<T_FE, T_POLICY, T_ELEMENT>(mesh, use_table);
+	run_time.stop();
+	INFO("%s: %f s (checksum %.12e)", name.c_str(), run_time.elapsed(), checksum);
+}
+
+int main(int argc, char *argv[])
+{
+	LOGOG_INITIALIZE();
+	BaseLib::LogogSimpleFormatter *custom_format (new BaseLib::LogogSimpleFormatter);
+	logog::Cout *logogCout(new logog::Cout);
+	logogCout->SetFormatter(*custom_format);
+
+	TCLAP::CmdLine cmd("Benchmark of dynamically and statically sized shape matrices", ' ', "0.1");
+	TCLAP::ValueArg<unsigned> n_arg("n", "n-cells", "number of cells in each direction", false, 40, "unsigned");
+	cmd.add(n_arg);
+	TCLAP::ValueArg<unsigned> rep_arg("r", "repetitions", "number of repetitions", false, 5, "unsigned");
+	cmd.add(rep_arg);
+	cmd.parse(argc, argv);
+
+	unsigned const n (n_arg.getValue());
+	unsigned const n_rep (rep_arg.getValue());
+
+	using namespace NumLib;
+	{
+		MeshLib::Mesh const*const mesh (MeshLib::MeshGenerator::generateRegularQuadMesh(1.0, 10 * n));
+		INFO("Quad4 mesh with %d elements", mesh->getNElements());
+		runBenchmark<FeQUAD4, EigenDynamicShapeMatrixPolicy<ShapeQuad4>, MeshLib::Quad>("dynamic", *mesh, n_rep, false);
+		runBenchmark<FeQUAD4, EigenFixedShapeMatrixPolicy<ShapeQuad4>, MeshLib::Quad>("fixed", *mesh, n_rep, false);
+		runBenchmark<FeQUAD4, EigenDynamicShapeMatrixPolicy<ShapeQuad4>, MeshLib::Quad>("dynamic, table", *mesh, n_rep, true);
+		runBenchmark<FeQUAD4, EigenFixedShapeMatrixPolicy<ShapeQuad4>, MeshLib::Quad>("fixed, table", *mesh, n_rep, true);
+		delete mesh;
+	}
+	{
+		MeshLib::Mesh const*const mesh (MeshLib::MeshGenerator::generateRegularHexMesh(1.0, n));
+		INFO("Hex8 mesh with %d elements", mesh->getNElements());
+		runBenchmark<FeHEX8, EigenDynamicShapeMatrixPolicy<ShapeHex8>, MeshLib::Hex>("dynamic", *mesh, n_rep, false);
+		runBenchmark<FeHEX8, EigenFixedShapeMatrixPolicy<ShapeHex8>, MeshLib::Hex>("fixed", *mesh, n_rep, false);
+		runBenchmark<FeHEX8, EigenDynamicShapeMatrixPolicy<ShapeHex8>, MeshLib::Hex>("dynamic, table", *mesh, n_rep, true);
+		runBenchmark<FeHEX8, EigenFixedShapeMatrixPolicy<ShapeHex8>, MeshLib::Hex>("fixed, table", *mesh, n_rep, true);
+		delete mesh;
+	}
+
+	delete logogCout;
+	delete custom_format;
+	LOGOG_SHUTDOWN();
+}
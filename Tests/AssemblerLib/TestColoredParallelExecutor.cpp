@@ -0,0 +1,139 @@
+/**
+ * \copyright
+ * Copyright (c) 2013, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "AssemblerLib/ColoredParallelExecutor.h"
+#include "AssemblerLib/ElementColoring.h"
+#include "AssemblerLib/GlobalSetup.h"
+#include "AssemblerLib/MeshComponentMap.h"
+#include "AssemblerLib/SerialDenseSetup.h"
+#include "AssemblerLib/VectorMatrixAssembler.h"
+
+#include "MeshLib/Elements/Element.h"
+#include "MeshLib/Location.h"
+#include "MeshLib/Mesh.h"
+#include "MeshLib/MeshGenerators/MeshGenerator.h"
+#include "MeshLib/MeshSubsets.h"
+#include "MeshLib/Node.h"
+
+#include "../TestTools.h"
+#include "SteadyDiffusion2DExample1.h"
+
+TEST(AssemblerLibElementColoring, NoSharedNodesWithinColor)
+{
+    std::unique_ptr<MeshLib::Mesh> mesh(
+        MeshLib::MeshGenerator::generateRegularHexMesh(1.0, 6));
+    auto const& elements = mesh->getElements();
+
+    AssemblerLib::ElementColoring const coloring(elements);
+
+    // Regular hex mesh is colorable with 8 colors; greedy coloring in the
+    // generator's order achieves it.
+    ASSERT_EQ(8u, coloring.size());
+
+    std::vector<bool> visited(elements.size(), false);
+    for (std::size_t color = 0; color < coloring.size(); color++)
+    {
+        std::vector<bool> node_used(mesh->getNNodes(), false);
+        for (std::size_t i : coloring[color])
+        {
+            ASSERT_FALSE(visited[i]);
+            visited[i] = true;
+            for (unsigned k = 0; k < elements[i]->getNNodes(); k++)
+            {
+                std::size_t const node_id = elements[i]->getNode(k)->getID();
+                ASSERT_FALSE(node_used[node_id]);
+                node_used[node_id] = true;
+            }
+        }
+    }
+    ASSERT_TRUE(std::all_of(visited.begin(), visited.end(),
+        [](bool v) { return v; }));
+}
+
+TEST(AssemblerLibColoredParallelExecutor, AssemblyEqualsSerialAssembly)
+{
+    SteadyDiffusion2DExample1 ex1;
+
+    typedef AssemblerLib::SerialDenseSetup SerialSetup;
+    typedef AssemblerLib::GlobalSetup<
+            AssemblerLib::SerialDenseVectorMatrixBuilder,
+            AssemblerLib::ColoredParallelExecutor>
+        ParallelSetup;
+    typedef SerialSetup::VectorType GlobalVector;
+    typedef SerialSetup::MatrixType GlobalMatrix;
+
+    MeshLib::MeshSubset const mesh_items_all_nodes(*ex1.msh,
+                                                   ex1.msh->getNodes());
+    std::vector<MeshLib::MeshSubsets*> vec_comp_dis;
+    vec_comp_dis.push_back(new MeshLib::MeshSubsets(&mesh_items_all_nodes));
+    AssemblerLib::MeshComponentMap vec1_composition(
+        vec_comp_dis, AssemblerLib::ComponentOrder::BY_COMPONENT);
+
+    auto const& all_eles = ex1.msh->getElements();
+    std::vector<std::vector<std::size_t> > map_ele_nodes2vec_entries;
+    map_ele_nodes2vec_entries.reserve(all_eles.size());
+    for (auto e = all_eles.cbegin(); e != all_eles.cend(); ++e)
+    {
+        std::vector<MeshLib::Location> vec_items;
+        for (std::size_t j = 0; j < (*e)->getNNodes(); j++)
+            vec_items.emplace_back(ex1.msh->getID(),
+                MeshLib::MeshItemType::Node, (*e)->getNode(j)->getID());
+        map_ele_nodes2vec_entries.push_back(
+            vec1_composition.getGlobalIndices
+                <AssemblerLib::ComponentOrder::BY_COMPONENT>(vec_items));
+    }
+    AssemblerLib::LocalToGlobalIndexMap const dof_map(
+        map_ele_nodes2vec_entries);
+
+    typedef SteadyDiffusion2DExample1::LocalAssembler LocalAssembler;
+    LocalAssembler local_assembler;
+    typedef AssemblerLib::VectorMatrixAssembler<
+            GlobalMatrix, GlobalVector,
+            MeshLib::Element, LocalAssembler,
+            MathLib::DenseMatrix<double>,
+            MathLib::DenseVector<double>
+        > GlobalAssembler;
+
+    // Serial assembly.
+    std::unique_ptr<GlobalMatrix> A_serial(
+        SerialSetup::createMatrix(vec1_composition));
+    A_serial->setZero();
+    std::unique_ptr<GlobalVector> rhs_serial(
+        SerialSetup::createVector(vec1_composition));
+    GlobalAssembler serial_assembler(*A_serial, *rhs_serial, local_assembler,
+        dof_map);
+    SerialSetup::execute(serial_assembler, all_eles);
+
+    // Parallel assembly.
+    std::unique_ptr<GlobalMatrix> A_parallel(
+        ParallelSetup::createMatrix(vec1_composition));
+    A_parallel->setZero();
+    std::unique_ptr<GlobalVector> rhs_parallel(
+        ParallelSetup::createVector(vec1_composition));
+    GlobalAssembler parallel_assembler(*A_parallel, *rhs_parallel,
+        local_assembler, dof_map);
+    AssemblerLib::ElementColoring const coloring(all_eles);
+    ParallelSetup::execute(parallel_assembler, all_eles, coloring);
+
+    ASSERT_EQ(A_serial->getNRows(), A_parallel->getNRows());
+    for (std::size_t i = 0; i < A_serial->getNRows(); i++)
+        for (std::size_t j = 0; j < A_serial->getNCols(); j++)
+            ASSERT_DOUBLE_EQ((*A_serial)(i, j), (*A_parallel)(i, j));
+    ASSERT_ARRAY_EQ(&(*rhs_serial)[0], &(*rhs_parallel)[0],
+        rhs_serial->size());
+
+    std::remove_if(vec_comp_dis.begin(), vec_comp_dis.end(),
+        [](MeshLib::MeshSubsets * p) { delete p; return true; });
+}
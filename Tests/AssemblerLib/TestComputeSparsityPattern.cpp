@@ -0,0 +1,65 @@
+/**
+ * \copyright
+ * Copyright (c) 2013, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <set>
+#include <vector>
+
+#include "AssemblerLib/ComputeSparsityPattern.h"
+#include "AssemblerLib/LocalToGlobalIndexMap.h"
+#include "AssemblerLib/MeshComponentMap.h"
+
+#include "MeshLib/Elements/Element.h"
+#include "MeshLib/Mesh.h"
+#include "MeshLib/MeshGenerators/MeshGenerator.h"
+#include "MeshLib/MeshSubsets.h"
+#include "MeshLib/Node.h"
+
+TEST(AssemblerLibComputeSparsityPattern, RegularQuadMesh)
+{
+    std::unique_ptr<MeshLib::Mesh> mesh(
+        MeshLib::MeshGenerator::generateRegularQuadMesh(1.0, 6));
+    MeshLib::MeshSubset const nodes_subset(*mesh, mesh->getNodes());
+    std::vector<MeshLib::MeshSubsets*> components;
+    components.push_back(new MeshLib::MeshSubsets(&nodes_subset));
+
+    AssemblerLib::MeshComponentMap const cmap(components,
+        AssemblerLib::ComponentOrder::BY_COMPONENT);
+    AssemblerLib::LocalToGlobalIndexMap const dof_map(mesh->getElements(),
+        mesh->getID(), cmap, AssemblerLib::ComponentOrder::BY_COMPONENT);
+
+    MathLib::CRSSparsityPattern const pattern =
+        AssemblerLib::computeSparsityPattern(dof_map, cmap.size());
+
+    // With one component the global indices are the node ids and each row
+    // contains the node itself and all nodes sharing an element with it.
+    ASSERT_EQ(mesh->getNNodes(), pattern.getNRows());
+    std::size_t n_entries = 0;
+    for (std::size_t i = 0; i < mesh->getNNodes(); i++)
+    {
+        std::set<std::size_t> expected;
+        for (auto e : mesh->getNode(i)->getElements())
+            for (unsigned j = 0; j < e->getNNodes(); j++)
+                expected.insert(e->getNode(j)->getID());
+
+        ASSERT_EQ(expected.size(), pattern.getNEntries(i));
+        ASSERT_TRUE(std::equal(expected.begin(), expected.end(),
+                               pattern.getRowBeginIterator(i)));
+        ASSERT_NE(pattern.getNEntries(), pattern.find(i, i));
+        n_entries += expected.size();
+    }
+    ASSERT_EQ(n_entries, pattern.getNEntries());
+    // Nodes (0,0) and (2,2) do not share an element.
+    ASSERT_EQ(pattern.getNEntries(), pattern.find(0, 2 * 7 + 2));
+
+    for (auto p : components)
+        delete p;
+}
@@ -0,0 +1,119 @@
+/**
+ * \copyright
+ * Copyright (c) 2013, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "AssemblerLib/LocalToGlobalIndexMap.h"
+#include "AssemblerLib/MeshComponentMap.h"
+
+#include "MeshLib/Elements/Element.h"
+#include "MeshLib/Location.h"
+#include "MeshLib/Mesh.h"
+#include "MeshLib/MeshGenerators/MeshGenerator.h"
+#include "MeshLib/MeshSubsets.h"
+#include "MeshLib/Node.h"
+
+class AssemblerLibLocalToGlobalIndexMapTest : public ::testing::Test
+{
+public:
+    AssemblerLibLocalToGlobalIndexMapTest()
+        : mesh(MeshLib::MeshGenerator::generateRegularQuadMesh(1.0, 5)),
+          nodes_subset(*mesh, mesh->getNodes())
+    {
+        // Two components on all nodes.
+        components.push_back(new MeshLib::MeshSubsets(&nodes_subset));
+        components.push_back(new MeshLib::MeshSubsets(&nodes_subset));
+    }
+
+    ~AssemblerLibLocalToGlobalIndexMapTest()
+    {
+        for (auto p : components)
+            delete p;
+    }
+
+    /// Global indices of the element's nodes obtained directly from the
+    /// component map.
+    template <AssemblerLib::ComponentOrder ORDER>
+    std::vector<std::size_t> expectedIndices(
+        AssemblerLib::MeshComponentMap const& cmap,
+        MeshLib::Element const& e) const
+    {
+        std::vector<MeshLib::Location> locations;
+        for (unsigned j = 0; j < e.getNNodes(); j++)
+            locations.emplace_back(mesh->getID(), MeshLib::MeshItemType::Node,
+                                   e.getNode(j)->getID());
+        return cmap.getGlobalIndices<ORDER>(locations);
+    }
+
+    template <AssemblerLib::ComponentOrder ORDER>
+    void checkMap() const
+    {
+        AssemblerLib::MeshComponentMap const cmap(components, ORDER);
+        AssemblerLib::LocalToGlobalIndexMap const dof_map(
+            mesh->getElements(), mesh->getID(), cmap, ORDER);
+
+        ASSERT_EQ(mesh->getNElements(), dof_map.size());
+        for (std::size_t i = 0; i < dof_map.size(); i++)
+        {
+            auto const expected =
+                expectedIndices<ORDER>(cmap, *mesh->getElement(i));
+            auto const rows = dof_map.rowIndices(i);
+            auto const columns = dof_map.columnIndices(i);
+            ASSERT_EQ(8u, rows.size());
+            ASSERT_EQ(expected.size(), rows.size());
+            ASSERT_TRUE(std::equal(rows.begin(), rows.end(),
+                                   expected.begin()));
+            ASSERT_TRUE(std::equal(columns.begin(), columns.end(),
+                                   expected.begin()));
+        }
+    }
+
+    std::unique_ptr<MeshLib::Mesh> mesh;
+    MeshLib::MeshSubset const nodes_subset;
+    std::vector<MeshLib::MeshSubsets*> components;
+};
+
+TEST_F(AssemblerLibLocalToGlobalIndexMapTest, FromMeshComponentMapByComponent)
+{
+    checkMap<AssemblerLib::ComponentOrder::BY_COMPONENT>();
+}
+
+TEST_F(AssemblerLibLocalToGlobalIndexMapTest, FromMeshComponentMapByLocation)
+{
+    checkMap<AssemblerLib::ComponentOrder::BY_LOCATION>();
+}
+
+TEST(AssemblerLibLocalToGlobalIndexMap, SeparateRowsAndColumns)
+{
+    std::vector<std::vector<std::size_t>> rows;
+    rows.push_back({0, 1});
+    rows.push_back({});
+    rows.push_back({2, 3, 4});
+    std::vector<std::vector<std::size_t>> columns;
+    columns.push_back({5});
+    columns.push_back({6, 7});
+    columns.push_back({8, 9, 10});
+
+    AssemblerLib::LocalToGlobalIndexMap const dof_map(rows, columns);
+    ASSERT_EQ(3u, dof_map.size());
+    for (std::size_t i = 0; i < dof_map.size(); i++)
+    {
+        auto const indices = dof_map[i];
+        ASSERT_EQ(rows[i].size(), indices.rows.size());
+        ASSERT_TRUE(std::equal(indices.rows.begin(), indices.rows.end(),
+                               rows[i].begin()));
+        ASSERT_EQ(columns[i].size(), indices.columns.size());
+        ASSERT_TRUE(std::equal(indices.columns.begin(), indices.columns.end(),
+                               columns[i].begin()));
+    }
+}
@@ -13,6 +13,7 @@
 #include <gtest/gtest.h>
 #include <vector>
 
+#include "AssemblerLib/ComponentGlobalIndexDict.h"
 #include "AssemblerLib/MeshComponentMap.h"
 
 #include "MeshLib/MeshGenerators/MeshGenerator.h"
@@ -120,6 +121,29 @@ TEST_F(AssemblerLibMeshComponentMapTest, CheckOrderByLocation)
     }
 }
 
+TEST_F(AssemblerLibMeshComponentMapTest, PermuteGlobalIndices)
+{
+    MeshComponentMap cmap_permuted(components,
+        AssemblerLib::ComponentOrder::BY_LOCATION);
+    cmap = new MeshComponentMap(components,
+        AssemblerLib::ComponentOrder::BY_LOCATION);
+
+    // reverse the numbering
+    std::size_t const n = cmap->size();
+    std::vector<std::size_t> po_perm(n);
+    for (std::size_t i = 0; i < n; i++)
+        po_perm[i] = n - 1 - i;
+    cmap_permuted.permuteGlobalIndices(po_perm);
+
+    for (std::size_t i = 0; i < mesh_size; i++)
+    {
+        Location const l(mesh->getID(), MeshItemType::Node, i);
+        for (std::size_t c = comp0_id; c <= comp1_id; c++)
+            ASSERT_EQ(n - 1 - cmap->getGlobalIndex(l, c),
+                cmap_permuted.getGlobalIndex(l, c));
+    }
+}
+
 TEST_F(AssemblerLibMeshComponentMapTest, OutOfRangeAccess)
 {
     cmap = new MeshComponentMap(components,
@@ -136,3 +160,93 @@ TEST_F(AssemblerLibMeshComponentMapTest, OutOfRangeAccess)
     ASSERT_EQ(MeshComponentMap::nop, cmap->getGlobalIndex(
         Location(mesh->getID(), MeshItemType::Node, 0), 10));
 }
+
+TEST_F(AssemblerLibMeshComponentMapTest, ComponentsOnDifferentSubsets)
+{
+    // component 0 on all nodes, component 1 on the first three nodes only
+    std::vector<MeshLib::Node*> const first_nodes(
+        mesh->getNodes().begin(), mesh->getNodes().begin() + 3);
+    MeshLib::MeshSubset const first_nodes_subset(*mesh, first_nodes);
+    MeshLib::MeshSubsets first_nodes_subsets(&first_nodes_subset);
+
+    std::vector<MeshLib::MeshSubsets*> mixed_components;
+    mixed_components.push_back(components[0]);
+    mixed_components.push_back(&first_nodes_subsets);
+
+    std::size_t const n_nodes = mesh->getNNodes();
+
+    {
+        MeshComponentMap const by_component(mixed_components,
+            AssemblerLib::ComponentOrder::BY_COMPONENT);
+        ASSERT_EQ(n_nodes + 3, by_component.size());
+        for (std::size_t i = 0; i < n_nodes; i++)
+        {
+            Location const l(mesh->getID(), MeshItemType::Node, i);
+            ASSERT_EQ(i, by_component.getGlobalIndex(l, comp0_id));
+            if (i < 3)
+            {
+                ASSERT_EQ(n_nodes + i, by_component.getGlobalIndex(l, comp1_id));
+                ASSERT_EQ(2u, by_component.getComponentIDs(l).size());
+            }
+            else
+            {
+                ASSERT_EQ(MeshComponentMap::nop,
+                    by_component.getGlobalIndex(l, comp1_id));
+                ASSERT_EQ(1u, by_component.getGlobalIndices(l).size());
+            }
+        }
+    }
+
+    {
+        MeshComponentMap const by_location(mixed_components,
+            AssemblerLib::ComponentOrder::BY_LOCATION);
+        ASSERT_EQ(n_nodes + 3, by_location.size());
+
+        std::vector<Location> ls;
+        for (std::size_t i = 0; i < n_nodes; i++)
+            ls.emplace_back(mesh->getID(), MeshItemType::Node, i);
+
+        // Sorted by location the global indices are consecutive.
+        std::vector<std::size_t> const gi_by_location =
+            by_location.getGlobalIndices<
+                AssemblerLib::ComponentOrder::BY_LOCATION>(ls);
+        ASSERT_EQ(n_nodes + 3, gi_by_location.size());
+        for (std::size_t i = 0; i < gi_by_location.size(); i++)
+            ASSERT_EQ(i, gi_by_location[i]);
+
+        // Sorted by component first come all component 0 indices.
+        std::vector<std::size_t> const gi_by_component =
+            by_location.getGlobalIndices<
+                AssemblerLib::ComponentOrder::BY_COMPONENT>(ls);
+        ASSERT_EQ(0u, gi_by_component[0]);  // node 0, comp 0
+        ASSERT_EQ(2u, gi_by_component[1]);  // node 1, comp 0
+        ASSERT_EQ(4u, gi_by_component[2]);  // node 2, comp 0
+        ASSERT_EQ(6u, gi_by_component[3]);  // node 3, comp 0
+        ASSERT_EQ(1u, gi_by_component[n_nodes]);      // node 0, comp 1
+        ASSERT_EQ(5u, gi_by_component[n_nodes + 2]);  // node 2, comp 1
+    }
+}
+
+TEST(AssemblerLibComponentGlobalIndexDict, DuplicateRangesAreRejected)
+{
+    using AssemblerLib::detail::ItemRange;
+    MeshLib::MeshItemType const node = MeshLib::MeshItemType::Node;
+    std::vector<ItemRange> ranges;
+    ranges.emplace_back(0, node, 4, 0);
+    ranges.emplace_back(0, node, 4, 0);    // duplicate
+    ranges.emplace_back(0, node, 2, 1);
+
+    AssemblerLib::detail::ComponentGlobalIndexDict const dict(ranges);
+    ASSERT_EQ(6u, dict.size());
+    for (std::size_t i = 0; i < 4; i++)
+    {
+        auto const lines = dict.find(MeshLib::Location(0, node, i));
+        ASSERT_EQ(i < 2 ? 2u : 1u, lines.second - lines.first);
+        ASSERT_EQ(0u, dict.getComponentID(lines.first));
+        ASSERT_EQ(i, dict.getGlobalIndex(lines.first));
+        if (i < 2)
+        {
+            ASSERT_EQ(4 + i, dict.getGlobalIndex(lines.first + 1));
+        }
+    }
+}
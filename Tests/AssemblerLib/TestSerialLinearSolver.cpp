@@ -10,12 +10,14 @@
  *
  */
 
+#include <algorithm>
 #include <cmath>
 #include <memory>
 #include <vector>
 
 #include <gtest/gtest.h>
 
+#include "AssemblerLib/LocalToGlobalIndexMap.h"
 #include "AssemblerLib/VectorMatrixAssembler.h"
 #include "AssemblerLib/MeshComponentMap.h"
 #include "AssemblerLib/SerialDenseSetup.h"
@@ -36,44 +38,91 @@
 #include "../TestTools.h"
 #include "SteadyDiffusion2DExample1.h"
 
-TEST(AssemblerLibSerialLinearSolver, Steady2DdiffusionQuadElem)
+class AssemblerLibSerialLinearSolver : public ::testing::Test
 {
+public:
+    typedef AssemblerLib::SerialDenseSetup GlobalSetup;
+    typedef GlobalSetup::VectorType GlobalVector;
+    typedef GlobalSetup::MatrixType GlobalMatrix;
+
+    AssemblerLibSerialLinearSolver()
+        : mesh_items_all_nodes(*ex1.msh, ex1.msh->getNodes())
+    {
+        // define a mesh item composition in a vector
+        vec_comp_dis.push_back(
+            new MeshLib::MeshSubsets(&mesh_items_all_nodes));
+        vec1_composition.reset(new AssemblerLib::MeshComponentMap(
+            vec_comp_dis, AssemblerLib::ComponentOrder::BY_COMPONENT));
+    }
+
+    ~AssemblerLibSerialLinearSolver()
+    {
+        std::remove_if(vec_comp_dis.begin(), vec_comp_dis.end(),
+            [](MeshLib::MeshSubsets * p) { delete p; return true; });
+    }
+
+    /// Assembles and solves the linear system with the given map from element
+    /// nodes to entries in the linear system and checks the solution.
+    void solveAndCheck(AssemblerLib::LocalToGlobalIndexMap const& dof_map)
+    {
+        //----------------------------------------------------------------------
+        // Allocate a coefficient matrix, RHS and solution vectors
+        //----------------------------------------------------------------------
+        const GlobalSetup globalSetup;
+        std::unique_ptr<GlobalMatrix> A(
+            globalSetup.createMatrix(*vec1_composition));
+        A->setZero();
+        std::unique_ptr<GlobalVector> rhs(
+            globalSetup.createVector(*vec1_composition));
+        std::unique_ptr<GlobalVector> x(
+            globalSetup.createVector(*vec1_composition));
+
+        //----------------------------------------------------------------------
+        // Construct a linear system
+        //----------------------------------------------------------------------
+        // Local and global assemblers.
+        typedef SteadyDiffusion2DExample1::LocalAssembler LocalAssembler;
+        LocalAssembler local_assembler;
+
+        typedef AssemblerLib::VectorMatrixAssembler<
+                GlobalMatrix, GlobalVector,
+                MeshLib::Element, LocalAssembler,
+                MathLib::DenseMatrix<double>,
+                MathLib::DenseVector<double>
+            > GlobalAssembler;
+
+        GlobalAssembler assembler(*A.get(), *rhs.get(), local_assembler,
+            dof_map);
+
+        // Call global assembler for each mesh element.
+        globalSetup.execute(assembler, ex1.msh->getElements());
+
+        // apply Dirichlet BC
+        MathLib::applyKnownSolution(*A, *rhs, ex1.vec_DirichletBC_id,
+                                    ex1.vec_DirichletBC_value);
+        MathLib::finalizeMatrixAssembly(*A);
+
+        //----------------------------------------------------------------------
+        // solve x=A^-1 rhs
+        //----------------------------------------------------------------------
+        MathLib::GaussAlgorithm<GlobalMatrix, GlobalVector> ls(*A);
+        ls.solve(*rhs, *x);
+
+        double* px = &(*x)[0];
+        ASSERT_ARRAY_NEAR(&ex1.exact_solutions[0], px, ex1.dim_eqs, 1.e-5);
+    }
+
+protected:
     // example
     SteadyDiffusion2DExample1 ex1;
-
-    //--------------------------------------------------------------------------
-    // Choose implementation type
-    //--------------------------------------------------------------------------
-    typedef AssemblerLib::SerialDenseSetup GlobalSetup;
-    const GlobalSetup globalSetup;
-
-    //--------------------------------------------------------------------------
-    // Prepare mesh items where data are assigned
-    //--------------------------------------------------------------------------
-    const MeshLib::MeshSubset mesh_items_all_nodes(*ex1.msh,
-                                                           ex1.msh->getNodes());
-
-    //--------------------------------------------------------------------------
-    // Allocate a coefficient matrix, RHS and solution vectors
-    //--------------------------------------------------------------------------
-    // define a mesh item composition in a vector
+    // mesh items where data are assigned
+    const MeshLib::MeshSubset mesh_items_all_nodes;
     std::vector<MeshLib::MeshSubsets*> vec_comp_dis;
-    vec_comp_dis.push_back(
-        new MeshLib::MeshSubsets(&mesh_items_all_nodes));
-    AssemblerLib::MeshComponentMap vec1_composition(
-        vec_comp_dis, AssemblerLib::ComponentOrder::BY_COMPONENT);
+    std::unique_ptr<AssemblerLib::MeshComponentMap> vec1_composition;
+};
 
-    // allocate a vector and matrix
-    typedef GlobalSetup::VectorType GlobalVector;
-    typedef GlobalSetup::MatrixType GlobalMatrix;
-    std::unique_ptr<GlobalMatrix> A(globalSetup.createMatrix(vec1_composition));
-    A->setZero();
-    std::unique_ptr<GlobalVector> rhs(globalSetup.createVector(vec1_composition));
-    std::unique_ptr<GlobalVector> x(globalSetup.createVector(vec1_composition));
-
-    //--------------------------------------------------------------------------
-    // Construct a linear system
-    //--------------------------------------------------------------------------
+TEST_F(AssemblerLibSerialLinearSolver, Steady2DdiffusionQuadElem)
+{
     // create a mapping table from element nodes to entries in the linear system
     auto &all_eles = ex1.msh->getElements();
     std::vector<std::vector<std::size_t> > map_ele_nodes2vec_entries;
@@ -91,50 +140,19 @@ TEST(AssemblerLibSerialLinearSolver, Steady2DdiffusionQuadElem)
                 (*e)->getNode(j)->getID());
 
         map_ele_nodes2vec_entries.push_back(
-            vec1_composition.getGlobalIndices
+            vec1_composition->getGlobalIndices
                 <AssemblerLib::ComponentOrder::BY_COMPONENT>(vec_items));
     }
 
-    // Local and global assemblers.
-    typedef SteadyDiffusion2DExample1::LocalAssembler LocalAssembler;
-    LocalAssembler local_assembler;
-
-    typedef AssemblerLib::VectorMatrixAssembler<
-            GlobalMatrix, GlobalVector,
-            MeshLib::Element, LocalAssembler,
-            MathLib::DenseMatrix<double>,
-            MathLib::DenseVector<double>
-        > GlobalAssembler;
-
-    GlobalAssembler assembler(*A.get(), *rhs.get(), local_assembler,
+    solveAndCheck(
         AssemblerLib::LocalToGlobalIndexMap(map_ele_nodes2vec_entries));
+}
 
-    // Call global assembler for each mesh element.
-    globalSetup.execute(assembler, ex1.msh->getElements());
-
-    //std::cout << "A=\n";
-    //A->write(std::cout);
-    //std::cout << "rhs=\n";
-    //rhs->write(std::cout);
-
-    // apply Dirichlet BC
-    MathLib::applyKnownSolution(*A, *rhs, ex1.vec_DirichletBC_id,
-                                ex1.vec_DirichletBC_value);
-    //std::cout << "A=\n";
-    //A->write(std::cout);
-    //std::cout << "rhs=\n";
-    //rhs->write(std::cout);
-
-    MathLib::finalizeMatrixAssembly(*A);
-    //--------------------------------------------------------------------------
-    // solve x=A^-1 rhs
-    //--------------------------------------------------------------------------
-    MathLib::GaussAlgorithm<GlobalMatrix, GlobalVector> ls(*A);
-    ls.solve(*rhs, *x);
-
-    double* px = &(*x)[0];
-    ASSERT_ARRAY_NEAR(&ex1.exact_solutions[0], px, ex1.dim_eqs, 1.e-5);
-
-    std::remove_if(vec_comp_dis.begin(), vec_comp_dis.end(),
-        [](MeshLib::MeshSubsets * p) { delete p; return true; });
+// Same as above with the LocalToGlobalIndexMap constructed from the
+// MeshComponentMap.
+TEST_F(AssemblerLibSerialLinearSolver, Steady2DdiffusionQuadElemMapFromComponentMap)
+{
+    solveAndCheck(AssemblerLib::LocalToGlobalIndexMap(ex1.msh->getElements(),
+        ex1.msh->getID(), *vec1_composition,
+        AssemblerLib::ComponentOrder::BY_COMPONENT));
 }
@@ -0,0 +1,180 @@
+/**
+ * \copyright
+ * Copyright (c) 2013, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+#include "AssemblerLib/FixedSizeLocalMatrixTypes.h"
+#include "AssemblerLib/LocalMatrixWorkspace.h"
+#include "AssemblerLib/LocalToGlobalIndexMap.h"
+#include "AssemblerLib/SerialDenseSetup.h"
+#include "AssemblerLib/VectorMatrixAssembler.h"
+
+#include "MathLib/LinAlg/Dense/DenseMatrix.h"
+#include "MathLib/LinAlg/Dense/DenseVector.h"
+
+#include "MeshLib/Elements/Element.h"
+#include "MeshLib/Elements/Quad.h"
+#include "MeshLib/Mesh.h"
+#include "MeshLib/MeshGenerators/MeshGenerator.h"
+#include "MeshLib/Node.h"
+
+namespace
+{
+
+/// Adds the element id to every local matrix entry and the number of element
+/// nodes to every local vector entry.
+struct AddingLocalAssembler
+{
+    template <typename LocalMatrix, typename LocalVector>
+    void operator()(MeshLib::Element const& e, LocalMatrix& localA,
+        LocalVector& localRhs) const
+    {
+        for (unsigned i = 0; i < e.getNNodes(); i++)
+        {
+            for (unsigned j = 0; j < e.getNNodes(); j++)
+                localA(i, j) += e.getID();
+            localRhs[i] += e.getNNodes();
+        }
+    }
+};
+
+}   // namespace
+
+class AssemblerLibVectorMatrixAssembler : public ::testing::Test
+{
+public:
+    typedef AssemblerLib::SerialDenseSetup GlobalSetup;
+    typedef GlobalSetup::MatrixType GlobalMatrix;
+    typedef GlobalSetup::VectorType GlobalVector;
+
+    AssemblerLibVectorMatrixAssembler()
+        : mesh(MeshLib::MeshGenerator::generateRegularQuadMesh(1.0, 4))
+    {
+        for (auto e : mesh->getElements())
+        {
+            std::vector<std::size_t> indices;
+            for (unsigned i = 0; i < e->getNNodes(); i++)
+                indices.push_back(e->getNode(i)->getID());
+            map_ele_nodes.push_back(indices);
+        }
+    }
+
+    template <typename LocalMatrix, typename LocalVector>
+    void assemble(GlobalMatrix& A, GlobalVector& rhs) const
+    {
+        typedef AssemblerLib::VectorMatrixAssembler<
+                GlobalMatrix, GlobalVector,
+                MeshLib::Element, AddingLocalAssembler const,
+                LocalMatrix, LocalVector
+            > GlobalAssembler;
+
+        AssemblerLib::LocalToGlobalIndexMap const dof_map(map_ele_nodes);
+        GlobalAssembler assembler(A, rhs, local_assembler, dof_map);
+
+        // Assemble twice to check the local data is reset between calls.
+        GlobalSetup::execute(assembler, mesh->getElements());
+        GlobalSetup::execute(assembler, mesh->getElements());
+    }
+
+    std::unique_ptr<MeshLib::Mesh> mesh;
+    std::vector<std::vector<std::size_t>> map_ele_nodes;
+    AddingLocalAssembler const local_assembler = AddingLocalAssembler();
+};
+
+TEST_F(AssemblerLibVectorMatrixAssembler, DynamicLocalMatrices)
+{
+    std::size_t const n = mesh->getNNodes();
+    GlobalMatrix A(n);
+    A.setZero();
+    GlobalVector rhs(n);
+
+    assemble<MathLib::DenseMatrix<double>, MathLib::DenseVector<double>>(
+        A, rhs);
+
+    // Each node of the regular quad mesh receives 4 times the number of
+    // elements connected to it from the right-hand-side.
+    for (std::size_t i = 0; i < n; i++)
+        ASSERT_DOUBLE_EQ(2 * 4. * mesh->getNode(i)->getNElements(), rhs[i]);
+
+    // The diagonal entry is the doubled sum of connected element ids.
+    for (std::size_t i = 0; i < n; i++)
+    {
+        double sum_ids = 0;
+        for (auto e : mesh->getNode(i)->getElements())
+            sum_ids += e->getID();
+        ASSERT_DOUBLE_EQ(2 * sum_ids, A(i, i));
+    }
+}
+
+#ifdef OGS_USE_EIGEN
+TEST_F(AssemblerLibVectorMatrixAssembler, FixedSizeLocalMatricesEqualDynamic)
+{
+    std::size_t const n = mesh->getNNodes();
+    GlobalMatrix A_dynamic(n);
+    A_dynamic.setZero();
+    GlobalVector rhs_dynamic(n);
+    assemble<MathLib::DenseMatrix<double>, MathLib::DenseVector<double>>(
+        A_dynamic, rhs_dynamic);
+
+    typedef AssemblerLib::FixedSizeLocalMatrixTypes<MeshLib::Quad> LocalTypes;
+    ASSERT_EQ(4u, LocalTypes::n_dofs);
+    GlobalMatrix A_fixed(n);
+    A_fixed.setZero();
+    GlobalVector rhs_fixed(n);
+    assemble<LocalTypes::LocalMatrix, LocalTypes::LocalVector>(
+        A_fixed, rhs_fixed);
+
+    for (std::size_t i = 0; i < n; i++)
+    {
+        ASSERT_DOUBLE_EQ(rhs_dynamic[i], rhs_fixed[i]);
+        for (std::size_t j = 0; j < n; j++)
+            ASSERT_DOUBLE_EQ(A_dynamic(i, j), A_fixed(i, j));
+    }
+}
+#endif  // OGS_USE_EIGEN
+
+TEST(AssemblerLibLocalMatrixWorkspace, MixedSizes)
+{
+    std::vector<std::vector<std::size_t>> rows;
+    rows.push_back({0, 1, 2});
+    rows.push_back({2, 3, 4, 5});
+    rows.push_back({5, 6, 7});
+    AssemblerLib::LocalToGlobalIndexMap const dof_map(rows);
+
+    typedef MathLib::DenseMatrix<double> LocalMatrix;
+    typedef MathLib::DenseVector<double> LocalVector;
+    AssemblerLib::LocalMatrixWorkspace<LocalMatrix, LocalVector> workspace(
+        dof_map);
+
+    LocalMatrix& m3 = workspace.matrix(3, 3);
+    ASSERT_EQ(3u, m3.getNRows());
+    ASSERT_EQ(3u, m3.getNCols());
+    m3(1, 1) = 42;
+
+    LocalMatrix& m4 = workspace.matrix(4, 4);
+    ASSERT_EQ(4u, m4.getNRows());
+    LocalVector& v4 = workspace.vector(4, 4);
+    ASSERT_EQ(4u, v4.size());
+
+    // Same buffer is returned and reset for the same size.
+    LocalMatrix& m3_again = workspace.matrix(3, 3);
+    ASSERT_EQ(&m3, &m3_again);
+    ASSERT_EQ(0., m3_again(1, 1));
+
+    // A size not in the map is allocated on request, the other buffers stay
+    // valid.
+    LocalMatrix& m5 = workspace.matrix(5, 2);
+    ASSERT_EQ(5u, m5.getNRows());
+    ASSERT_EQ(2u, m5.getNCols());
+    ASSERT_EQ(&m5, &workspace.matrix(5, 2));
+    ASSERT_EQ(&m3, &workspace.matrix(3, 3));
+}
@@ -0,0 +1,145 @@
+/**
+ * \copyright
+ * Copyright (c) 2013, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#include "gtest/gtest.h"
+
+#include <cstdlib>
+#include <sstream>
+#include <string>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "Profiler.h"
+
+namespace
+{
+
+std::string getJSON()
+{
+	std::ostringstream os;
+	BaseLib::Profiler::instance().writeJSON(os);
+	return os.str();
+}
+
+void innerRegion()
+{
+	BaseLib::ProfileScope const scope("Inner");
+}
+
+/// Enables the recording, which depends on the environment by default, for
+/// the lifetime of the object.
+class EnabledProfiler
+{
+public:
+	EnabledProfiler()
+		: _was_enabled(BaseLib::Profiler::instance().isEnabled())
+	{
+		BaseLib::Profiler::instance().setEnabled(true);
+	}
+
+	~EnabledProfiler()
+	{
+		BaseLib::Profiler::instance().setEnabled(_was_enabled);
+	}
+
+private:
+	bool const _was_enabled;
+};
+
+}
+
+TEST(BaseLib, ProfilerNestedScopes)
+{
+	BaseLib::Profiler& profiler (BaseLib::Profiler::instance());
+	EnabledProfiler const enabled;
+	profiler.reset();
+
+	for (int i=0; i<2; i++)
+	{
+		BaseLib::ProfileScope const scope("Outer");
+		innerRegion();
+		innerRegion();
+	}
+	innerRegion();
+
+	std::string const json (getJSON());
+	std::size_t const outer (json.find("{\"name\": \"Outer\", \"calls\": 2, \"threads\": 1,"));
+	std::size_t const nested (json.find("{\"name\": \"Inner\", \"calls\": 4, \"threads\": 1,"));
+	std::size_t const top (json.find("{\"name\": \"Inner\", \"calls\": 1, \"threads\": 1,"));
+	ASSERT_NE(std::string::npos, outer);
+	ASSERT_NE(std::string::npos, nested);
+	ASSERT_NE(std::string::npos, top);
+	ASSERT_LT(outer, nested);
+	ASSERT_LT(nested, top);
+
+	std::ostringstream summary;
+	profiler.writeSummary(summary);
+	ASSERT_NE(std::string::npos, summary.str().find("\nOuter "));
+	ASSERT_NE(std::string::npos, summary.str().find("\n  Inner "));
+	ASSERT_NE(std::string::npos, summary.str().find("\nInner "));
+
+	profiler.reset();
+	ASSERT_EQ("{\"regions\": []}\n", getJSON());
+}
+
+TEST(BaseLib, ProfilerThreads)
+{
+	BaseLib::Profiler& profiler (BaseLib::Profiler::instance());
+	EnabledProfiler const enabled;
+	profiler.reset();
+
+	int n_threads (1);
+	{
+		BaseLib::ProfileScope const scope("Parallel");
+#ifdef _OPENMP
+		#pragma omp parallel
+		{
+			#pragma omp master
+			n_threads = omp_get_num_threads();
+			for (int i=0; i<3; i++)
+				innerRegion();
+		}
+#else
+		for (int i=0; i<3; i++)
+			innerRegion();
+#endif
+	}
+
+	// the master thread enters the region within "Parallel", for the other
+	// threads of the team it is a top level region
+	std::string const json (getJSON());
+	std::size_t const parallel (json.find("{\"name\": \"Parallel\", \"calls\": 1, \"threads\": 1,"));
+	std::size_t const nested (json.find("{\"name\": \"Inner\", \"calls\": 3, \"threads\": 1,"));
+	ASSERT_NE(std::string::npos, parallel);
+	ASSERT_NE(std::string::npos, nested);
+	ASSERT_LT(parallel, nested);
+	if (n_threads > 1)
+	{
+		std::ostringstream expected;
+		expected << "{\"name\": \"Inner\", \"calls\": " << 3 * (n_threads - 1)
+		         << ", \"threads\": " << n_threads - 1 << ",";
+		ASSERT_NE(std::string::npos, json.find(expected.str()));
+	}
+	profiler.reset();
+}
+
+TEST(BaseLib, ProfilerDisabled)
+{
+	BaseLib::Profiler& profiler (BaseLib::Profiler::instance());
+	// recording is only enabled by default if a report is requested
+	ASSERT_EQ(std::getenv("OGS_PROFILE_REPORT") != nullptr, profiler.isEnabled());
+
+	EnabledProfiler const enabled;
+	profiler.reset();
+	profiler.setEnabled(false);
+	innerRegion();
+	ASSERT_EQ("{\"regions\": []}\n", getJSON());
+}
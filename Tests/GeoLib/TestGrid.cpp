@@ -13,6 +13,10 @@
 
 #include "gtest/gtest.h"
 
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
 #include "GeoLib/Point.h"
 #include "GeoLib/PointWithID.h"
 #include "GeoLib/Grid.h"
@@ -126,3 +130,106 @@ TEST(GeoLib, SearchNearestPointsInDenseGrid)
 	}
 
 }
+
+class GeoLibGridQueries : public testing::Test
+{
+public:
+	GeoLibGridQueries()
+	{
+		std::srand(1234);
+		for (std::size_t i(0); i < 5000; i++)
+			_pnts.push_back(new GeoLib::PointWithID(randomCoord(), randomCoord(),
+				0.1 * randomCoord(), i));
+		_grid = new GeoLib::Grid<GeoLib::PointWithID>(_pnts.begin(), _pnts.end(), 16);
+
+		// query points inside and outside of the point set
+		for (std::size_t i(0); i < 200; i++) {
+			_query_coords.push_back(1.4 * randomCoord() - 0.2);
+			_query_coords.push_back(1.4 * randomCoord() - 0.2);
+			_query_coords.push_back(0.1 * randomCoord());
+		}
+	}
+
+	~GeoLibGridQueries()
+	{
+		delete _grid;
+		for (auto p : _pnts)
+			delete p;
+	}
+
+	static double randomCoord()
+	{
+		return static_cast<double>(std::rand()) / RAND_MAX;
+	}
+
+	/// Squared distances of all points to the query point, sorted ascending.
+	std::vector<double> sortedSqrDistances(double const* q) const
+	{
+		std::vector<double> dists;
+		for (auto p : _pnts)
+			dists.push_back(MathLib::sqrDist(p->getCoords(), q));
+		std::sort(dists.begin(), dists.end());
+		return dists;
+	}
+
+protected:
+	std::vector<GeoLib::PointWithID*> _pnts;
+	GeoLib::Grid<GeoLib::PointWithID>* _grid;
+	std::vector<double> _query_coords;
+};
+
+TEST_F(GeoLibGridQueries, NearestPoints)
+{
+	std::size_t const n_queries(_query_coords.size() / 3);
+	std::vector<GeoLib::PointWithID*> nearest;
+	_grid->getNearestPoints(_query_coords.data(), n_queries, nearest);
+	ASSERT_EQ(n_queries, nearest.size());
+
+	for (std::size_t i(0); i < n_queries; i++) {
+		double const* const q(&_query_coords[3*i]);
+		ASSERT_EQ(_grid->getNearestPoint(q), nearest[i]);
+		ASSERT_EQ(sortedSqrDistances(q)[0], MathLib::sqrDist(nearest[i]->getCoords(), q));
+	}
+}
+
+TEST_F(GeoLibGridQueries, KNearestPoints)
+{
+	std::vector<GeoLib::PointWithID*> nearest;
+	for (std::size_t k : {1u, 7u, 50u}) {
+		for (std::size_t i(0); i < _query_coords.size() / 3; i++) {
+			double const* const q(&_query_coords[3*i]);
+			_grid->getKNearestPoints(GeoLib::PointWithID(q), k, nearest);
+			ASSERT_EQ(k, nearest.size());
+
+			std::vector<double> const expected(sortedSqrDistances(q));
+			for (std::size_t j(0); j < k; j++)
+				ASSERT_EQ(expected[j], MathLib::sqrDist(nearest[j]->getCoords(), q));
+		}
+	}
+
+	// more points requested than available
+	_grid->getKNearestPoints(GeoLib::PointWithID(&_query_coords[0]), _pnts.size() + 10, nearest);
+	ASSERT_EQ(_pnts.size(), nearest.size());
+}
+
+TEST_F(GeoLibGridQueries, PointsInRadius)
+{
+	std::vector<GeoLib::PointWithID*> found;
+	for (double radius : {0.0, 0.01, 0.1, 0.5}) {
+		for (std::size_t i(0); i < _query_coords.size() / 3; i++) {
+			double const* const q(&_query_coords[3*i]);
+			_grid->getPointsInRadius(GeoLib::PointWithID(q), radius, found);
+
+			std::vector<std::size_t> found_ids;
+			for (auto p : found)
+				found_ids.push_back(p->getID());
+			std::sort(found_ids.begin(), found_ids.end());
+
+			std::vector<std::size_t> expected_ids;
+			for (auto p : _pnts)
+				if (MathLib::sqrDist(q, p->getCoords()) <= radius * radius)
+					expected_ids.push_back(p->getID());
+			ASSERT_EQ(expected_ids, found_ids);
+		}
+	}
+}
@@ -7,10 +7,13 @@
  */
 
 #include "gtest/gtest.h"
+#include <cmath>
 #include <ctime>
+#include <limits>
 #include <random>
 
 #include "GeoLib/PointVec.h"
+#include "MathLib/MathTools.h"
 
 class PointVecTest : public testing::Test
 {
@@ -129,3 +132,54 @@ TEST_F(PointVecTest, TestPointVecCtorRandomPointsLargeEps)
 
 	delete point_vec;
 }
+
+// Testing input vector with random points and copies of them.
+TEST_F(PointVecTest, TestPointVecCtorRandomPointsWithCopies)
+{
+	generateRandomPoints(10000);
+	for (std::size_t k(0); k < 10000; k += 3)
+		ps_ptr->push_back(new GeoLib::Point((*ps_ptr)[k]->getCoords()));
+	std::vector<GeoLib::Point> const pnts([this]() {
+		std::vector<GeoLib::Point> copy;
+		for (auto p : *ps_ptr)
+			copy.push_back(*p);
+		return copy;
+	}());
+
+	GeoLib::PointVec point_vec(name, ps_ptr);
+	ASSERT_EQ(std::size_t(10000), point_vec.size());
+
+	std::vector<std::size_t> const& id_map(point_vec.getIDMap());
+	ASSERT_EQ(pnts.size(), id_map.size());
+	for (std::size_t k(0); k < 10000; k++)
+		ASSERT_EQ(k, id_map[k]);
+	for (std::size_t k(0); k < pnts.size(); k++)
+		for (std::size_t i(0); i < 3; i++)
+			ASSERT_EQ(pnts[k][i], (*(*point_vec.getVector())[id_map[k]])[i]);
+}
+
+// Testing push back of random points and copies of them.
+TEST_F(PointVecTest, TestPointVecPushBackRandomPoints)
+{
+	ps_ptr->push_back(new GeoLib::Point(0,0,0));
+	GeoLib::PointVec point_vec(name, ps_ptr);
+
+	std::uniform_real_distribution<double> rnd(-1, 1);
+	std::vector<GeoLib::Point> pnts;
+	for (std::size_t k(0); k < 2000; k++)
+		pnts.emplace_back(rnd(gen), rnd(gen), rnd(gen));
+
+	for (std::size_t k(0); k < pnts.size(); k++)
+		ASSERT_EQ(k+1, point_vec.push_back(new GeoLib::Point(pnts[k])));
+	for (std::size_t k(0); k < pnts.size(); k += 7)
+		ASSERT_EQ(k+1, point_vec.push_back(new GeoLib::Point(pnts[k])));
+	ASSERT_EQ(pnts.size()+1, point_vec.size());
+
+	double sqr_shortest_dist(std::numeric_limits<double>::max());
+	std::vector<GeoLib::Point*> const& vec(*point_vec.getVector());
+	for (std::size_t i(0); i < vec.size(); i++)
+		for (std::size_t j(i+1); j < vec.size(); j++)
+			sqr_shortest_dist = std::min(sqr_shortest_dist,
+				MathLib::sqrDist(*vec[i], *vec[j]));
+	ASSERT_EQ(std::sqrt(sqr_shortest_dist), point_vec.getShortestPointDistance());
+}
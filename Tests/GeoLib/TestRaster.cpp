@@ -0,0 +1,162 @@
+/**
+ * \copyright
+ * Copyright (c) 2013, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Configure.h"
+
+#include "BaseLib/Endianness.h"
+#include "GeoLib/Raster.h"
+
+class GeoLibRaster : public ::testing::Test
+{
+public:
+	GeoLibRaster()
+		: _file_name(std::string(PUT_TMP_DIR_IN) + "RasterTest.bras"),
+		  _asc_file_name(std::string(PUT_TMP_DIR_IN) + "RasterTest.asc")
+	{
+		std::vector<double> values(_n_cols*_n_rows);
+		for (std::size_t i = 0; i < values.size(); ++i)
+			values[i] = 0.25 * i - 3.0;
+		values[7] = -9999;
+		_raster.reset(new GeoLib::Raster(_n_cols, _n_rows, 100.0, 200.0, 2.5,
+			values.begin(), values.end(), -9999));
+	}
+
+	~GeoLibRaster()
+	{
+		std::remove(_file_name.c_str());
+		std::remove(_asc_file_name.c_str());
+	}
+
+protected:
+	void compare(GeoLib::Raster const& raster) const
+	{
+		ASSERT_EQ(_raster->getNCols(), raster.getNCols());
+		ASSERT_EQ(_raster->getNRows(), raster.getNRows());
+		ASSERT_EQ(_raster->getOrigin()[0], raster.getOrigin()[0]);
+		ASSERT_EQ(_raster->getOrigin()[1], raster.getOrigin()[1]);
+		ASSERT_EQ(_raster->getRasterPixelDistance(), raster.getRasterPixelDistance());
+		ASSERT_EQ(_raster->getNoDataValue(), raster.getNoDataValue());
+		ASSERT_EQ(std::size_t(_raster->end() - _raster->begin()),
+			std::size_t(raster.end() - raster.begin()));
+		for (std::size_t i = 0; i < _n_cols*_n_rows; ++i)
+			ASSERT_EQ(_raster->begin()[i], raster.begin()[i]);
+	}
+
+	std::size_t const _n_cols = 7;
+	std::size_t const _n_rows = 5;
+	std::string const _file_name;
+	std::string const _asc_file_name;
+	std::unique_ptr<GeoLib::Raster> _raster;
+};
+
+TEST_F(GeoLibRaster, WriteReadBinary)
+{
+	{
+		std::ofstream out(_file_name.c_str(), std::ios::binary);
+		ASSERT_TRUE(_raster->writeRasterAsBinary(out));
+	}
+	std::unique_ptr<GeoLib::Raster> raster(GeoLib::Raster::getRasterFromBinaryFile(_file_name));
+	ASSERT_TRUE(raster != nullptr);
+	compare(*raster);
+	ASSERT_EQ(_raster->interpolateValueAtPoint(106.0, 204.0),
+		raster->interpolateValueAtPoint(106.0, 204.0));
+
+	// the format is chosen by the file extension
+	raster.reset(GeoLib::Raster::getRasterFromFile(_file_name));
+	ASSERT_TRUE(raster != nullptr);
+	compare(*raster);
+
+	// the mapped raster is copied when refined
+	raster->refineRaster(2);
+	ASSERT_EQ(2*_n_cols, raster->getNCols());
+	ASSERT_EQ(_raster->begin()[_n_cols + 1], raster->begin()[4*_n_cols + 2]);
+}
+
+TEST_F(GeoLibRaster, ReadInvalidBinary)
+{
+	ASSERT_TRUE(GeoLib::Raster::getRasterFromBinaryFile(_file_name) == nullptr);
+
+	// ASCII file
+	{
+		std::ofstream out(_asc_file_name.c_str());
+		_raster->writeRasterAsASC(out);
+	}
+	ASSERT_TRUE(GeoLib::Raster::getRasterFromBinaryFile(_asc_file_name) == nullptr);
+	std::unique_ptr<GeoLib::Raster> raster(GeoLib::Raster::getRasterFromFile(_asc_file_name));
+	ASSERT_TRUE(raster != nullptr);
+	compare(*raster);
+
+	// truncated file
+	{
+		std::ofstream out(_file_name.c_str(), std::ios::binary);
+		_raster->writeRasterAsBinary(out);
+	}
+	std::ifstream in(_file_name.c_str(), std::ios::binary);
+	std::vector<char> content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+	in.close();
+	{
+		std::ofstream out(_file_name.c_str(), std::ios::binary);
+		out.write(content.data(), content.size() - sizeof(double));
+	}
+	ASSERT_TRUE(GeoLib::Raster::getRasterFromBinaryFile(_file_name) == nullptr);
+}
+
+TEST_F(GeoLibRaster, ReadCorruptedBinaryHeader)
+{
+	{
+		std::ofstream out(_file_name.c_str(), std::ios::binary);
+		_raster->writeRasterAsBinary(out);
+	}
+	std::ifstream in(_file_name.c_str(), std::ios::binary);
+	std::vector<char> const content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+	in.close();
+
+	// writes the file with the given header entries (n_cols, n_rows at byte
+	// 16 and 24, cell size at byte 48)
+	auto const writeCorrupted = [this, &content](std::uint64_t n_cols,
+		std::uint64_t n_rows, double cell_size)
+	{
+		std::vector<char> corrupted(content);
+		n_cols = BaseLib::toLittleEndian(n_cols);
+		n_rows = BaseLib::toLittleEndian(n_rows);
+		cell_size = BaseLib::toLittleEndian(cell_size);
+		std::memcpy(corrupted.data() + 16, &n_cols, sizeof(n_cols));
+		std::memcpy(corrupted.data() + 24, &n_rows, sizeof(n_rows));
+		std::memcpy(corrupted.data() + 48, &cell_size, sizeof(cell_size));
+		std::ofstream out(_file_name.c_str(), std::ios::binary);
+		out.write(corrupted.data(), corrupted.size());
+	};
+
+	writeCorrupted(_n_cols, _n_rows, 2.5);
+	std::unique_ptr<GeoLib::Raster> raster(GeoLib::Raster::getRasterFromBinaryFile(_file_name));
+	ASSERT_TRUE(raster != nullptr);
+	raster.reset();
+
+	writeCorrupted(0, _n_rows, 2.5);
+	ASSERT_TRUE(GeoLib::Raster::getRasterFromBinaryFile(_file_name) == nullptr);
+	writeCorrupted(_n_cols, 0, 2.5);
+	ASSERT_TRUE(GeoLib::Raster::getRasterFromBinaryFile(_file_name) == nullptr);
+	writeCorrupted(_n_cols, _n_rows, 0.0);
+	ASSERT_TRUE(GeoLib::Raster::getRasterFromBinaryFile(_file_name) == nullptr);
+	writeCorrupted(_n_cols, _n_rows, -2.5);
+	ASSERT_TRUE(GeoLib::Raster::getRasterFromBinaryFile(_file_name) == nullptr);
+	// the product of the dimensions overflows to zero
+	writeCorrupted(std::uint64_t(1) << 63, 2, 2.5);
+	ASSERT_TRUE(GeoLib::Raster::getRasterFromBinaryFile(_file_name) == nullptr);
+}
@@ -0,0 +1,56 @@
+/**
+ * \copyright
+ * Copyright (c) 2013, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#ifndef CRSTESTMATRIX_H_
+#define CRSTESTMATRIX_H_
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "MathLib/LinAlg/Sparse/CRSMatrix.h"
+
+/// Entries of a test matrix, the key is the pair (row, column).
+typedef std::map<std::pair<unsigned, unsigned>, double> CRSEntries;
+
+/// Creates the arrays of the compressed row storage of a n x n matrix with the
+/// given entries, the matrix takes the ownership of the arrays.
+template <typename MATRIX>
+MATRIX* createCRSMatrix(unsigned n, CRSEntries const& entries)
+{
+	unsigned* iA (new unsigned[n+1]);
+	unsigned* jA (new unsigned[entries.size()]);
+	double* A (new double[entries.size()]);
+	std::fill_n(iA, n+1, 0);
+	unsigned k (0);
+	for (CRSEntries::const_iterator it(entries.begin()); it != entries.end(); ++it, ++k) {
+		iA[it->first.first+1]++;
+		jA[k] = it->first.second;
+		A[k] = it->second;
+	}
+	for (unsigned i=0; i<n; i++)
+		iA[i+1] += iA[i];
+	return new MATRIX(n, iA, jA, A);
+}
+
+/// Euclidean norm of the residual b - A x.
+inline double getResidualNorm(MathLib::CRSMatrix<double, unsigned> const& mat,
+	std::vector<double> const& b, std::vector<double> const& x)
+{
+	std::vector<double> r(b.size());
+	mat.amux(1.0, x.data(), r.data());
+	double norm (0.0);
+	for (std::size_t i=0; i<b.size(); i++)
+		norm += (b[i] - r[i]) * (b[i] - r[i]);
+	return std::sqrt(norm);
+}
+
+#endif /* CRSTESTMATRIX_H_ */
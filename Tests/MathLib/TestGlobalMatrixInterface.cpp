@@ -15,6 +15,9 @@
 
 #include <gtest/gtest.h>
 
+#include <set>
+#include <stdexcept>
+
 #include "MathLib/LinAlg/Dense/DenseMatrix.h"
 #include "MathLib/LinAlg/Dense/GlobalDenseMatrix.h"
 #include "MathLib/LinAlg/FinalizeMatrixAssembly.h"
@@ -175,6 +178,34 @@ TEST(Math, CheckInterface_LisMatrix)
     MathLib::LisMatrix m(10);
     checkGlobalMatrixInterface(m);
 }
+
+TEST(Math, CheckInterface_LisMatrixPreallocated)
+{
+    // Tridiagonal pattern also containing the entries (1,3) and (3,1).
+    std::vector<std::set<std::size_t>> rows(10);
+    for (std::size_t i = 0; i < 10; i++)
+    {
+        rows[i].insert(i);
+        if (i > 0)
+            rows[i].insert(i - 1);
+        if (i < 9)
+            rows[i].insert(i + 1);
+    }
+    rows[1].insert(3);
+    rows[3].insert(1);
+    std::vector<std::size_t> row_ptr(1, 0);
+    std::vector<std::size_t> col_idx;
+    for (auto const& r : rows)
+    {
+        col_idx.insert(col_idx.end(), r.begin(), r.end());
+        row_ptr.push_back(col_idx.size());
+    }
+    MathLib::CRSSparsityPattern const pattern(row_ptr, col_idx);
+    MathLib::LisMatrix m(10, pattern);
+    ASSERT_TRUE(m.isPreallocated());
+    checkGlobalMatrixInterface(m);
+    ASSERT_THROW(m.add(0, 5, 1.0), std::out_of_range);
+}
 #endif
 
 #ifdef USE_PETSC // or MPI
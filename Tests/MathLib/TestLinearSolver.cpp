@@ -142,3 +142,79 @@ TEST(Math, CheckInterface_Lis)
 }
 #endif
 
+
+#ifdef USE_LIS
+TEST(Math, CheckInterface_LisPreconReuse)
+{
+    boost::property_tree::ptree t_root;
+    boost::property_tree::ptree t_solver;
+    t_solver.put("solver_type", "CG");
+    t_solver.put("precon_type", "ILU");
+    t_solver.put("error_tolerance", 1e-15);
+    t_solver.put("max_iteration_step", 1000);
+    t_solver.put("precon_reuse", true);
+    t_solver.put("precon_rebuild_interval", 2);
+    t_root.put_child("LinearSolver", t_solver);
+
+    Example1 ex1;
+    MathLib::LisMatrix A(Example1::dim_eqs);
+    for (size_t i=0; i<ex1.dim_eqs; i++)
+        for (size_t j=0; j<ex1.dim_eqs; j++)
+            if (ex1.mat(i, j)!=.0)
+                A.add(i, j, ex1.mat(i, j));
+    MathLib::LisVector rhs(ex1.dim_eqs);
+    MathLib::applyKnownSolution(A, rhs, ex1.vec_dirichlet_bc_id, ex1.vec_dirichlet_bc_value);
+    MathLib::finalizeMatrixAssembly(A);
+
+    // Repeated solves with the same matrix reuse the preconditioner.
+    MathLib::LisLinearSolver ls(A, &t_root);
+    for (int i=0; i<3; i++) {
+        MathLib::LisVector x(ex1.dim_eqs);
+        ls.solve(rhs, x);
+        ASSERT_ARRAY_NEAR(ex1.exH, x, ex1.dim_eqs, 1e-5);
+    }
+}
+#endif
+
+#ifdef USE_LIS
+TEST(Math, CheckInterface_LisPreconReuseMatrixChange)
+{
+    Example1 ex1;
+    // Without rebuild_on_change the preconditioner still has to be rebuilt
+    // because setZero() recreates the raw Lis matrix.
+    for (bool rebuild_on_change : {true, false}) {
+        for (bool reuse : {false, true}) {
+            boost::property_tree::ptree t_root;
+            boost::property_tree::ptree t_solver;
+            t_solver.put("solver_type", "CG");
+            t_solver.put("precon_type", "ILU");
+            t_solver.put("error_tolerance", 1e-15);
+            t_solver.put("max_iteration_step", 1000);
+            t_solver.put("precon_reuse", reuse);
+            t_solver.put("precon_rebuild_on_change", rebuild_on_change);
+            t_root.put_child("LinearSolver", t_solver);
+
+            MathLib::LisMatrix A(Example1::dim_eqs);
+            MathLib::LisLinearSolver ls(A, &t_root);
+            // The second system is scaled, i.e. it has the same solution but
+            // needs a new preconditioner.
+            for (double scaling : {1.0, 2.0}) {
+                unsigned long const structure_revision = A.getStructureRevision();
+                A.setZero();
+                ASSERT_EQ(structure_revision + 1, A.getStructureRevision());
+                for (size_t i=0; i<ex1.dim_eqs; i++)
+                    for (size_t j=0; j<ex1.dim_eqs; j++)
+                        if (ex1.mat(i, j)!=.0)
+                            A.add(i, j, scaling * ex1.mat(i, j));
+                MathLib::LisVector rhs(ex1.dim_eqs);
+                MathLib::applyKnownSolution(A, rhs, ex1.vec_dirichlet_bc_id, ex1.vec_dirichlet_bc_value);
+                MathLib::finalizeMatrixAssembly(A);
+
+                MathLib::LisVector x(ex1.dim_eqs);
+                ls.solve(rhs, x);
+                ASSERT_ARRAY_NEAR(ex1.exH, x, ex1.dim_eqs, 1e-5);
+            }
+        }
+    }
+}
+#endif
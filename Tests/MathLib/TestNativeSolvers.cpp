@@ -0,0 +1,200 @@
+/**
+ * \copyright
+ * Copyright (c) 2013, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "MathLib/LinAlg/Sparse/CRSMatrix.h"
+#include "MathLib/LinAlg/Sparse/CRSMatrixDiagPrecond.h"
+#include "MathLib/LinAlg/Solvers/BiCGStab.h"
+#include "MathLib/LinAlg/Solvers/CG.h"
+#include "MathLib/LinAlg/Solvers/SolverWorkspace.h"
+
+#include "CRSTestMatrix.h"
+
+namespace
+{
+
+/// Anisotropic five point stencil with varying coefficients on a nx x nx grid.
+template <typename MATRIX>
+MATRIX* createMatrix(unsigned nx)
+{
+	CRSEntries entries;
+	for (unsigned j=0; j<nx; j++) {
+		for (unsigned i=0; i<nx; i++) {
+			unsigned const row (j*nx + i);
+			double const c (1.0 + (row % 7));
+			if (j > 0)    entries[std::make_pair(row, row-nx)] = -c;
+			if (i > 0)    entries[std::make_pair(row, row-1)] = -0.1;
+			entries[std::make_pair(row, row)] = 2.0 * c + 0.2 + 1e-3;
+			if (i+1 < nx) entries[std::make_pair(row, row+1)] = -0.1;
+			if (j+1 < nx) entries[std::make_pair(row, row+nx)] = -c;
+		}
+	}
+	return createCRSMatrix<MATRIX>(nx*nx, entries);
+}
+
+/// Fixes the coefficients of the coupling entries and the diagonal, such
+/// that the matrix is symmetric and diagonally dominant.
+template <typename MATRIX>
+void symmetrize(MATRIX& mat, unsigned nx)
+{
+	unsigned const n (nx*nx);
+	for (unsigned row=nx; row<n; row++)
+		mat.setValue(row-nx, row, mat.getValue(row, row-nx));
+	for (unsigned row=0; row<n; row++) {
+		double sum (1e-2);
+		if (row >= nx)         sum -= mat.getValue(row, row-nx);
+		if (row % nx > 0)      sum -= mat.getValue(row, row-1);
+		if (row % nx + 1 < nx) sum -= mat.getValue(row, row+1);
+		if (row + nx < n)      sum -= mat.getValue(row, row+nx);
+		mat.setValue(row, row, sum);
+	}
+}
+
+}
+
+TEST(MathLib, NativeSolversCG)
+{
+	unsigned const nx (20);
+	std::unique_ptr<MathLib::CRSMatrixDiagPrecond> const mat (
+		createMatrix<MathLib::CRSMatrixDiagPrecond>(nx));
+	symmetrize(*mat, nx);
+	mat->calcPrecond();
+	unsigned const n (mat->getNRows());
+
+	// the workspace is reused for all systems
+	MathLib::SolverWorkspace workspace;
+	for (unsigned rhs=0; rhs<2; rhs++) {
+		std::vector<double> b(n);
+		for (unsigned i=0; i<n; i++)
+			b[i] = std::sin(0.1 * i + rhs);
+		double const nrmb (getResidualNorm(*mat, b, std::vector<double>(n, 0.0)));
+
+		std::vector<double> x0(n, 0.0);
+		double eps0 (1e-10);
+		unsigned steps0 (1000);
+		ASSERT_EQ(0u, MathLib::CG(mat.get(), b.data(), x0.data(), eps0, steps0, &workspace));
+		ASSERT_GT(1e-9 * nrmb, getResidualNorm(*mat, b, x0));
+
+		std::vector<double> x1(n, 0.0);
+		double eps1 (1e-10);
+		unsigned steps1 (1000);
+		ASSERT_EQ(0u, MathLib::PipelinedCG(mat.get(), b.data(), x1.data(), eps1, steps1, &workspace));
+		ASSERT_GT(1e-9 * nrmb, getResidualNorm(*mat, b, x1));
+		// same Krylov space, the number of iterations differs at most slightly
+		ASSERT_LE(steps1, steps0 + 2);
+		for (unsigned i=0; i<n; i++)
+			ASSERT_NEAR(x0[i], x1[i], 1e-7);
+
+#ifdef _OPENMP
+		std::vector<double> x2(n, 0.0);
+		double eps2 (1e-10);
+		unsigned steps2 (1000);
+		ASSERT_EQ(0u, MathLib::CGParallel(mat.get(), b.data(), x2.data(), eps2, steps2, &workspace));
+		ASSERT_GT(1e-9 * nrmb, getResidualNorm(*mat, b, x2));
+#endif
+	}
+
+	// initial guess is the solution
+	std::unique_ptr<MathLib::CRSMatrix<double, unsigned>> const small (
+		createMatrix<MathLib::CRSMatrix<double, unsigned>>(4));
+	symmetrize(*small, 4);
+	std::vector<double> x(16, 1.0), b(16);
+	small->amux(1.0, x.data(), b.data());
+	double eps (1e-10);
+	unsigned steps (100);
+	ASSERT_EQ(0u, MathLib::PipelinedCG(small.get(), b.data(), x.data(), eps, steps, &workspace));
+	ASSERT_EQ(0u, steps);
+}
+
+TEST(MathLib, NativeSolversBiCGStab)
+{
+	unsigned const nx (20);
+	std::unique_ptr<MathLib::CRSMatrixDiagPrecond> const mat (
+		createMatrix<MathLib::CRSMatrixDiagPrecond>(nx));
+	unsigned const n (mat->getNRows());
+	mat->calcPrecond();
+
+	MathLib::SolverWorkspace workspace;
+	for (unsigned rhs=0; rhs<2; rhs++) {
+		std::vector<double> b(n), x(n, 0.5);
+		for (unsigned i=0; i<n; i++)
+			b[i] = std::cos(0.3 * i + rhs);
+		double const nrmb (getResidualNorm(*mat, b, std::vector<double>(n, 0.0)));
+		std::vector<double> b_copy(b);
+		double eps (1e-10);
+		unsigned steps (1000);
+		ASSERT_EQ(0u, MathLib::BiCGStab(*mat, b_copy.data(), x.data(), eps, steps, &workspace));
+		ASSERT_LT(0u, steps);
+		ASSERT_GT(1e-9 * nrmb, getResidualNorm(*mat, b, x));
+	}
+}
+
+#ifdef _OPENMP
+// The scalar products of the solvers are fixed-order reductions, i.e. the
+// iterates are bitwise identical for any number of threads. The system is
+// large enough to be split into several reduction blocks.
+TEST(MathLib, NativeSolversThreadCountIndependent)
+{
+	unsigned const nx (100);
+	std::unique_ptr<MathLib::CRSMatrixDiagPrecond> const mat (
+		createMatrix<MathLib::CRSMatrixDiagPrecond>(nx));
+	mat->calcPrecond();
+	std::unique_ptr<MathLib::CRSMatrixDiagPrecond> const spd (
+		createMatrix<MathLib::CRSMatrixDiagPrecond>(nx));
+	symmetrize(*spd, nx);
+	spd->calcPrecond();
+	unsigned const n (mat->getNRows());
+
+	std::vector<double> b(n);
+	for (unsigned i=0; i<n; i++)
+		b[i] = std::cos(0.3 * i);
+	double const nrmb (getResidualNorm(*mat, b, std::vector<double>(n, 0.0)));
+
+	int const max_threads (omp_get_max_threads());
+	MathLib::SolverWorkspace workspace;
+	std::vector<std::vector<double>> x_bicgstab, x_pcg;
+	std::vector<unsigned> steps_bicgstab, steps_pcg;
+	for (int n_threads : {1, 4}) {
+		omp_set_num_threads(n_threads);
+
+		std::vector<double> b_copy(b), x(n, 0.0);
+		double eps (1e-10);
+		unsigned steps (2000);
+		ASSERT_EQ(0u, MathLib::BiCGStab(*mat, b_copy.data(), x.data(), eps, steps, &workspace));
+		x_bicgstab.push_back(x);
+		steps_bicgstab.push_back(steps);
+
+		std::fill(x.begin(), x.end(), 0.0);
+		eps = 1e-10;
+		steps = 2000;
+		ASSERT_EQ(0u, MathLib::PipelinedCG(spd.get(), b.data(), x.data(), eps, steps, &workspace));
+		x_pcg.push_back(x);
+		steps_pcg.push_back(steps);
+	}
+	omp_set_num_threads(max_threads);
+
+	ASSERT_GT(1e-9 * nrmb, getResidualNorm(*mat, b, x_bicgstab[0]));
+	ASSERT_EQ(steps_bicgstab[0], steps_bicgstab[1]);
+	ASSERT_TRUE(x_bicgstab[0] == x_bicgstab[1]);
+	ASSERT_GT(1e-9 * nrmb, getResidualNorm(*spd, b, x_pcg[0]));
+	ASSERT_EQ(steps_pcg[0], steps_pcg[1]);
+	ASSERT_TRUE(x_pcg[0] == x_pcg[1]);
+}
+#endif
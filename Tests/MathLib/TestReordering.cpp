@@ -0,0 +1,185 @@
+/**
+ * \copyright
+ * Copyright (c) 2013, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "MathLib/LinAlg/Sparse/CRSMatrix.h"
+#include "MathLib/LinAlg/Sparse/Reordering.h"
+
+namespace
+{
+
+/// Randomly numbered grid of nx x ny points.
+struct ShuffledGrid
+{
+	ShuffledGrid(std::size_t nx_, std::size_t ny_) : nx(nx_), ny(ny_),
+		op_perm(nx_*ny_)
+	{
+		std::iota(op_perm.begin(), op_perm.end(), 0);
+		std::shuffle(op_perm.begin(), op_perm.end(), std::mt19937(42));
+		po_perm = MathLib::invertPermutation(op_perm);
+	}
+
+	/// Five point stencil graph of the shuffled grid.
+	void getGraph(std::vector<std::size_t> &row_ptr,
+		std::vector<std::size_t> &col_idx) const
+	{
+		std::size_t const n (nx*ny);
+		row_ptr.assign(1, 0);
+		col_idx.clear();
+		for (std::size_t v(0); v < n; v++) {
+			std::size_t const i (op_perm[v] % nx), j (op_perm[v] / nx);
+			std::vector<std::size_t> adj;
+			if (i > 0)    adj.push_back(po_perm[op_perm[v] - 1]);
+			if (i+1 < nx) adj.push_back(po_perm[op_perm[v] + 1]);
+			if (j > 0)    adj.push_back(po_perm[op_perm[v] - nx]);
+			if (j+1 < ny) adj.push_back(po_perm[op_perm[v] + nx]);
+			std::sort(adj.begin(), adj.end());
+			col_idx.insert(col_idx.end(), adj.begin(), adj.end());
+			row_ptr.push_back(col_idx.size());
+		}
+	}
+
+	std::vector<double> getCoordinates() const
+	{
+		std::vector<double> coords(3*nx*ny, 0.0);
+		for (std::size_t v(0); v < nx*ny; v++) {
+			coords[3*v] = static_cast<double>(op_perm[v] % nx);
+			coords[3*v+1] = static_cast<double>(op_perm[v] / nx);
+		}
+		return coords;
+	}
+
+	std::size_t nx, ny;
+	std::vector<std::size_t> op_perm;
+	std::vector<std::size_t> po_perm;
+};
+
+bool isPermutation(std::vector<std::size_t> perm, std::size_t n)
+{
+	if (perm.size() != n)
+		return false;
+	std::sort(perm.begin(), perm.end());
+	for (std::size_t i(0); i < n; i++)
+		if (perm[i] != i)
+			return false;
+	return true;
+}
+
+/// Bandwidth of the graph renumbered by op_perm.
+std::size_t getPermutedBandwidth(std::vector<std::size_t> const& row_ptr,
+	std::vector<std::size_t> const& col_idx, std::vector<std::size_t> const& op_perm)
+{
+	std::vector<std::size_t> const po_perm (MathLib::invertPermutation(op_perm));
+	std::size_t bandwidth (0);
+	for (std::size_t v(0); v < op_perm.size(); v++)
+		for (std::size_t k(row_ptr[v]); k < row_ptr[v+1]; k++) {
+			std::size_t const a (po_perm[v]), b (po_perm[col_idx[k]]);
+			bandwidth = std::max(bandwidth, a > b ? a - b : b - a);
+		}
+	return bandwidth;
+}
+
+}
+
+TEST(MathLib, ReorderingReverseCuthillMcKee)
+{
+	ShuffledGrid const grid(30, 12);
+	std::vector<std::size_t> row_ptr, col_idx;
+	grid.getGraph(row_ptr, col_idx);
+	std::size_t const n (grid.nx * grid.ny);
+	ASSERT_LT(n / 2, MathLib::getBandwidth(n, row_ptr.data(), col_idx.data()));
+
+	std::vector<std::size_t> const op_perm (
+		MathLib::computeReverseCuthillMcKee(n, row_ptr.data(), col_idx.data()));
+	ASSERT_TRUE(isPermutation(op_perm, n));
+	// the level sets are diagonals across the short side of the grid
+	ASSERT_GE(grid.ny + 1, getPermutedBandwidth(row_ptr, col_idx, op_perm));
+
+	// two components and an isolated vertex
+	std::size_t const r[] = {0, 1, 2, 2, 3, 4};
+	std::size_t const c[] = {1, 0, 4, 3};
+	std::vector<std::size_t> const op_perm_small (
+		MathLib::computeReverseCuthillMcKee(5, r, c));
+	ASSERT_TRUE(isPermutation(op_perm_small, 5));
+
+	std::vector<std::size_t> const op_perm_nd (
+		MathLib::computeNestedDissection(n, row_ptr.data(), col_idx.data()));
+	ASSERT_TRUE(isPermutation(op_perm_nd, n));
+}
+
+TEST(MathLib, ReorderingSpaceFillingCurve)
+{
+	ShuffledGrid const grid(16, 16);
+	std::size_t const n (grid.nx * grid.ny);
+	std::vector<double> const coords (grid.getCoordinates());
+	std::vector<std::size_t> const op_perm (
+		MathLib::computeSpaceFillingCurveOrdering(n, coords.data()));
+	ASSERT_TRUE(isPermutation(op_perm, n));
+
+	// consecutive points are close to each other, in the shuffled order the
+	// average distance is about the third of the grid size
+	double length (0.0);
+	for (std::size_t i(1); i < n; i++) {
+		double const dx (coords[3*op_perm[i]] - coords[3*op_perm[i-1]]);
+		double const dy (coords[3*op_perm[i]+1] - coords[3*op_perm[i-1]+1]);
+		length += std::sqrt(dx*dx + dy*dy);
+	}
+	ASSERT_GT(1.5 * n, length);
+}
+
+TEST(MathLib, ReorderingMatrix)
+{
+	// non-symmetric pattern with a missing diagonal entry
+	unsigned const n (5);
+	unsigned* iA (new unsigned[n+1]);
+	unsigned* jA (new unsigned[9]);
+	double* A (new double[9]);
+	unsigned const row_ptr[] = {0, 2, 4, 6, 7, 9};
+	unsigned const col_idx[] = {0, 3, 1, 2, 0, 2, 1, 0, 4};
+	std::copy(row_ptr, row_ptr + n + 1, iA);
+	std::copy(col_idx, col_idx + 9, jA);
+	for (unsigned k(0); k < 9; k++)
+		A[k] = 1.0 + k;
+	MathLib::CRSMatrix<double, unsigned> mat (n, iA, jA, A);
+
+	std::vector<std::size_t> graph_row_ptr, graph_col_idx;
+	MathLib::getMatrixGraph(mat, graph_row_ptr, graph_col_idx);
+	std::size_t const expected_row_ptr[] = {0, 3, 5, 7, 9, 10};
+	std::size_t const expected_col_idx[] = {2, 3, 4, 2, 3, 0, 1, 0, 1, 0};
+	ASSERT_EQ(std::vector<std::size_t>(expected_row_ptr, expected_row_ptr + 6), graph_row_ptr);
+	ASSERT_EQ(std::vector<std::size_t>(expected_col_idx, expected_col_idx + 10), graph_col_idx);
+
+	std::size_t const perm[] = {3, 0, 4, 2, 1};
+	std::vector<std::size_t> const op_perm (perm, perm + n);
+	std::unique_ptr<MathLib::CRSMatrix<double, unsigned>> const reordered (
+		MathLib::createReorderedMatrix(mat, op_perm));
+	ASSERT_EQ(mat.getNNZ(), reordered->getNNZ());
+	for (unsigned i(0); i < n; i++)
+		for (unsigned j(0); j < n; j++)
+			ASSERT_EQ(mat.getValue(op_perm[i], op_perm[j]), reordered->getValue(i, j));
+
+	// (P A P^T) (P x) = P (A x)
+	std::vector<double> x(n), y(n), px(n), py(n), y_reordered(n);
+	for (unsigned i(0); i < n; i++)
+		x[i] = 0.5 + i;
+	mat.amux(1.0, x.data(), y.data());
+	MathLib::permuteVector(op_perm, x.data(), px.data());
+	MathLib::permuteVector(op_perm, y.data(), py.data());
+	reordered->amux(1.0, px.data(), y_reordered.data());
+	for (unsigned i(0); i < n; i++)
+		ASSERT_DOUBLE_EQ(py[i], y_reordered[i]);
+}
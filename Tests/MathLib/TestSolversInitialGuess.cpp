@@ -0,0 +1,94 @@
+/**
+ * \copyright
+ * Copyright (c) 2013, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "MathLib/LinAlg/Sparse/CRSMatrix.h"
+#include "MathLib/LinAlg/Solvers/BiCGStab.h"
+#include "MathLib/LinAlg/Solvers/CG.h"
+#include "MathLib/LinAlg/Solvers/GMRes.h"
+
+#include "CRSTestMatrix.h"
+
+namespace
+{
+
+typedef MathLib::CRSMatrix<double, unsigned> Matrix;
+
+/// Tridiagonal matrix of the one dimensional Laplace operator with a shifted
+/// diagonal.
+Matrix* createTridiagonalMatrix(unsigned n)
+{
+	CRSEntries entries;
+	for (unsigned row=0; row<n; row++) {
+		if (row > 0)   entries[std::make_pair(row, row-1)] = -1.0;
+		entries[std::make_pair(row, row)] = 2.1;
+		if (row+1 < n) entries[std::make_pair(row, row+1)] = -1.0;
+	}
+	return createCRSMatrix<Matrix>(n, entries);
+}
+
+}
+
+// The initial residual b - A x0 of the solvers used to be computed with an
+// accumulating amux, which does not exist. The solution is one, the solvers
+// start from zero and from a nonzero initial guess.
+TEST(MathLib, SolversInitialGuess)
+{
+	unsigned const n (50);
+	std::unique_ptr<Matrix> const mat (createTridiagonalMatrix(n));
+	std::vector<double> const ones(n, 1.0);
+	std::vector<double> b(n);
+	mat->amux(1.0, ones.data(), b.data());
+
+	for (double x0 : {0.0, 0.5}) {
+		{
+			std::vector<double> x(n, x0);
+			double eps (1e-10);
+			unsigned steps (1000);
+			ASSERT_EQ(0u, MathLib::CG(mat.get(), b.data(), x.data(), eps, steps));
+			ASSERT_LT(0u, steps);
+			for (unsigned i=0; i<n; i++)
+				ASSERT_NEAR(1.0, x[i], 1e-7);
+		}
+#ifdef _OPENMP
+		{
+			std::vector<double> x(n, x0);
+			double eps (1e-10);
+			unsigned steps (1000);
+			ASSERT_EQ(0u, MathLib::CGParallel(mat.get(), b.data(), x.data(), eps, steps));
+			ASSERT_LT(0u, steps);
+			for (unsigned i=0; i<n; i++)
+				ASSERT_NEAR(1.0, x[i], 1e-7);
+		}
+#endif
+		{
+			std::vector<double> x(n, x0), rhs(b);
+			double eps (1e-10);
+			unsigned steps (1000);
+			ASSERT_EQ(0u, MathLib::BiCGStab(*mat, rhs.data(), x.data(), eps, steps));
+			ASSERT_LT(0u, steps);
+			for (unsigned i=0; i<n; i++)
+				ASSERT_NEAR(1.0, x[i], 1e-7);
+		}
+		{
+			std::vector<double> x(n, x0), rhs(b);
+			double eps (1e-10);
+			unsigned steps (1000);
+			ASSERT_EQ(0u, MathLib::GMRes(*mat, rhs.data(), x.data(), eps, 30, steps));
+			ASSERT_LT(0u, steps);
+			for (unsigned i=0; i<n; i++)
+				ASSERT_NEAR(1.0, x[i], 1e-7);
+		}
+	}
+}
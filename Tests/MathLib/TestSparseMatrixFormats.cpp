@@ -0,0 +1,183 @@
+/**
+ * \copyright
+ * Copyright (c) 2013, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "MathLib/LinAlg/Sparse/CRSMatrix.h"
+#include "MathLib/LinAlg/Sparse/CRSMatrixBCSR.h"
+#include "MathLib/LinAlg/Sparse/CRSMatrixSELL.h"
+#include "MathLib/LinAlg/Solvers/BiCGStab.h"
+#include "MathLib/LinAlg/Solvers/CG.h"
+#include "MathLib/LinAlg/Solvers/GMRes.h"
+
+#include "CRSTestMatrix.h"
+
+namespace
+{
+
+/// Five point stencil on a nx x ny grid.
+CRSEntries createPoissonEntries(unsigned nx, unsigned ny)
+{
+	CRSEntries entries;
+	for (unsigned j=0; j<ny; j++) {
+		for (unsigned i=0; i<nx; i++) {
+			unsigned const row (j*nx + i);
+			entries[std::make_pair(row, row)] = 4.0;
+			if (i > 0)    entries[std::make_pair(row, row-1)] = -1.0;
+			if (i+1 < nx) entries[std::make_pair(row, row+1)] = -1.0;
+			if (j > 0)    entries[std::make_pair(row, row-nx)] = -1.0;
+			if (j+1 < ny) entries[std::make_pair(row, row+nx)] = -1.0;
+		}
+	}
+	return entries;
+}
+
+/// Non-symmetric matrix with strongly varying row lengths.
+CRSEntries createIrregularEntries(unsigned n)
+{
+	CRSEntries entries;
+	for (unsigned row=0; row<n; row++) {
+		entries[std::make_pair(row, row)] = 10.0 + row;
+		unsigned const len ((row * 7) % 23);
+		for (unsigned k=1; k<=len; k++)
+			entries[std::make_pair(row, (row * 13 + k * 17) % n)] = 1.0 / (k + row % 5);
+	}
+	return entries;
+}
+
+void checkAmux(MathLib::CRSMatrix<double, unsigned> const& expected,
+	MathLib::CRSMatrix<double, unsigned> const& mat)
+{
+	unsigned const n (expected.getNRows());
+	std::vector<double> x(n), y0(n), y1(n, -1.0);
+	for (unsigned i=0; i<n; i++)
+		x[i] = 1.0 + 0.25 * (i % 11);
+	expected.amux(2.5, x.data(), y0.data());
+	mat.amux(2.5, x.data(), y1.data());
+	for (unsigned i=0; i<n; i++)
+		ASSERT_NEAR(y0[i], y1[i], 1e-12 * std::abs(y0[i]) + 1e-14);
+}
+
+}
+
+// With OGS_SIMD set to AVX2 or AVX512 the SELL matrix uses the vectorized
+// kernel for double/unsigned.
+TEST(MathLib, SparseMatrixFormatsAmux)
+{
+	unsigned const n (143);
+	CRSEntries const entries (createIrregularEntries(n));
+	std::unique_ptr<MathLib::CRSMatrix<double, unsigned>> const crs (
+		createCRSMatrix<MathLib::CRSMatrix<double, unsigned>>(n, entries));
+
+	unsigned const sigmas[] = {1, 8, 256};
+	for (unsigned sigma : sigmas) {
+		MathLib::CRSMatrixSELL<double, unsigned> const sell (*crs, sigma);
+		checkAmux(*crs, sell);
+		ASSERT_LE(crs->getNNZ(), sell.getNStoredEntries());
+	}
+
+	// without sorting the padding is larger
+	MathLib::CRSMatrixSELL<double, unsigned> const unsorted (*crs, 1);
+	MathLib::CRSMatrixSELL<double, unsigned> const sorted (*crs, 256);
+	ASSERT_LT(sorted.getNStoredEntries(), unsorted.getNStoredEntries());
+
+	// n is not a multiple of the block size
+	MathLib::CRSMatrixBCSR<double, unsigned, 3> const bcsr3 (*crs);
+	checkAmux(*crs, bcsr3);
+	MathLib::CRSMatrixBCSR<double, unsigned, 4> const bcsr4 (*crs);
+	checkAmux(*crs, bcsr4);
+}
+
+TEST(MathLib, SparseMatrixFormatsUpdateValues)
+{
+	unsigned const n (60);
+	CRSEntries entries (createPoissonEntries(6, 10));
+	std::unique_ptr<MathLib::CRSMatrixSELL<double, unsigned>> sell (
+		createCRSMatrix<MathLib::CRSMatrixSELL<double, unsigned>>(n, entries));
+	std::unique_ptr<MathLib::CRSMatrixBCSR<double, unsigned, 2>> bcsr (
+		createCRSMatrix<MathLib::CRSMatrixBCSR<double, unsigned, 2>>(n, entries));
+
+	for (unsigned row=0; row<n; row+=7) {
+		ASSERT_TRUE(sell->setValue(row, row, 5.0 + row));
+		ASSERT_TRUE(bcsr->setValue(row, row, 5.0 + row));
+		entries[std::make_pair(row, row)] = 5.0 + row;
+	}
+	sell->updateValues();
+	bcsr->updateValues();
+
+	std::unique_ptr<MathLib::CRSMatrix<double, unsigned>> const crs (
+		createCRSMatrix<MathLib::CRSMatrix<double, unsigned>>(n, entries));
+	checkAmux(*crs, *sell);
+	checkAmux(*crs, *bcsr);
+}
+
+TEST(MathLib, SparseMatrixFormatsEraseEntries)
+{
+	unsigned const n (60);
+	CRSEntries const entries (createIrregularEntries(n));
+	std::unique_ptr<MathLib::CRSMatrix<double, unsigned>> const crs (
+		createCRSMatrix<MathLib::CRSMatrix<double, unsigned>>(n, entries));
+	std::unique_ptr<MathLib::CRSMatrixSELL<double, unsigned>> sell (
+		createCRSMatrix<MathLib::CRSMatrixSELL<double, unsigned>>(n, entries));
+	std::unique_ptr<MathLib::CRSMatrixBCSR<double, unsigned, 3>> bcsr (
+		createCRSMatrix<MathLib::CRSMatrixBCSR<double, unsigned, 3>>(n, entries));
+
+	// the formats are rebuilt for the smaller matrix
+	unsigned const erase[] = {0, 7, 8, 9, 31, 59};
+	crs->eraseEntries(6, erase);
+	sell->eraseEntries(6, erase);
+	bcsr->eraseEntries(6, erase);
+	ASSERT_EQ(n - 6, sell->getNRows());
+	checkAmux(*crs, *sell);
+	checkAmux(*crs, *bcsr);
+}
+
+TEST(MathLib, SparseMatrixFormatsSolvers)
+{
+	unsigned const nx (13), ny (11), n (nx*ny);
+	CRSEntries const entries (createPoissonEntries(nx, ny));
+	std::unique_ptr<MathLib::CRSMatrix<double, unsigned>> const crs (
+		createCRSMatrix<MathLib::CRSMatrix<double, unsigned>>(n, entries));
+	MathLib::CRSMatrixSELL<double, unsigned> const sell (*crs);
+	MathLib::CRSMatrixBCSR<double, unsigned, 2> const bcsr (*crs);
+
+	std::vector<double> b(n);
+	for (unsigned i=0; i<n; i++)
+		b[i] = 1.0 + (i % 3);
+	double const nrmb (getResidualNorm(*crs, b, std::vector<double>(n, 0.0)));
+
+	{
+		std::vector<double> x(n, 0.0);
+		double eps (1e-10);
+		unsigned nsteps (1000);
+		ASSERT_EQ(0u, MathLib::CG(&sell, b.data(), x.data(), eps, nsteps));
+		ASSERT_GT(1e-8 * nrmb, getResidualNorm(*crs, b, x));
+	}
+	{
+		std::vector<double> rhs(b), x(n, 0.0);
+		double eps (1e-10);
+		unsigned nsteps (1000);
+		ASSERT_EQ(0u, MathLib::BiCGStab(bcsr, rhs.data(), x.data(), eps, nsteps));
+		ASSERT_GT(1e-8 * nrmb, getResidualNorm(*crs, b, x));
+	}
+	{
+		std::vector<double> rhs(b), x(n, 0.0);
+		double eps (1e-10);
+		unsigned nsteps (1000);
+		ASSERT_EQ(0u, MathLib::GMRes(sell, rhs.data(), x.data(), eps, 30, nsteps));
+		ASSERT_GT(1e-8 * nrmb, getResidualNorm(*crs, b, x));
+	}
+}
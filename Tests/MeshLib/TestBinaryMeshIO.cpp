@@ -0,0 +1,169 @@
+/**
+ * \copyright
+ * Copyright (c) 2013, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+
+#include "Configure.h"
+
+#include "MeshLib/CompactMesh.h"
+#include "MeshLib/Mesh.h"
+#include "MeshLib/Node.h"
+#include "MeshLib/Elements/Element.h"
+#include "MeshLib/MeshGenerators/MeshGenerator.h"
+
+#include "FileIO/BinaryMeshIO.h"
+#include "FileIO/readMeshFromFile.h"
+
+class BinaryMeshIOTest : public ::testing::Test
+{
+public:
+	BinaryMeshIOTest()
+		: _mesh(MeshLib::MeshGenerator::generateRegularHexMesh(2.0, 6)),
+		  _file_name(std::string(PUT_TMP_DIR_IN) + "BinaryMeshIOTest.bmsh")
+	{
+		for (std::size_t i=0; i<_mesh->getNElements(); i++)
+			const_cast<MeshLib::Element*>(_mesh->getElement(i))->setValue(i % 4);
+	}
+
+	~BinaryMeshIOTest()
+	{
+		std::remove(_file_name.c_str());
+	}
+
+	void checkMesh(MeshLib::Mesh const& mesh) const
+	{
+		ASSERT_EQ(_mesh->getName(), mesh.getName());
+		ASSERT_EQ(_mesh->getNNodes(), mesh.getNNodes());
+		ASSERT_EQ(_mesh->getNElements(), mesh.getNElements());
+		ASSERT_EQ(_mesh->getDimension(), mesh.getDimension());
+		ASSERT_EQ(_mesh->getMinEdgeLength(), mesh.getMinEdgeLength());
+		ASSERT_EQ(_mesh->getMaxEdgeLength(), mesh.getMaxEdgeLength());
+		for (std::size_t i=0; i<mesh.getNNodes(); i++)
+		{
+			MeshLib::Node const& n0 (*_mesh->getNode(i));
+			MeshLib::Node const& n1 (*mesh.getNode(i));
+			for (std::size_t k=0; k<3; k++)
+				ASSERT_EQ(n0[k], n1[k]);
+			ASSERT_EQ(n0.getNElements(), n1.getNElements());
+			for (std::size_t k=0; k<n0.getNElements(); k++)
+				ASSERT_EQ(n0.getElement(k)->getID(), n1.getElement(k)->getID());
+		}
+		for (std::size_t i=0; i<mesh.getNElements(); i++)
+		{
+			MeshLib::Element const& e0 (*_mesh->getElement(i));
+			MeshLib::Element const& e1 (*mesh.getElement(i));
+			ASSERT_EQ(e0.getCellType(), e1.getCellType());
+			ASSERT_EQ(e0.getValue(), e1.getValue());
+			for (unsigned k=0; k<e0.getNNodes(); k++)
+				ASSERT_EQ(e0.getNode(k)->getID(), e1.getNode(k)->getID());
+			for (unsigned k=0; k<e0.getNNeighbors(); k++)
+			{
+				ASSERT_EQ(e0.getNeighbor(k) == nullptr, e1.getNeighbor(k) == nullptr);
+				if (e0.getNeighbor(k))
+				{
+					ASSERT_EQ(e0.getNeighbor(k)->getID(), e1.getNeighbor(k)->getID());
+				}
+			}
+		}
+	}
+
+protected:
+	std::unique_ptr<MeshLib::Mesh> _mesh;
+	std::string const _file_name;
+};
+
+TEST_F(BinaryMeshIOTest, WithTopology)
+{
+	FileIO::BinaryMeshIO io;
+	io.setMesh(_mesh.get());
+	ASSERT_TRUE(io.writeToFile(_file_name));
+
+	std::unique_ptr<MeshLib::Mesh> mesh (FileIO::readMeshFromFile(_file_name));
+	ASSERT_TRUE(mesh != nullptr);
+	checkMesh(*mesh);
+}
+
+TEST_F(BinaryMeshIOTest, WithoutTopology)
+{
+	FileIO::BinaryMeshIO io;
+	io.setMesh(_mesh.get());
+	io.setWriteTopology(false);
+	ASSERT_TRUE(io.writeToFile(_file_name));
+
+	std::unique_ptr<MeshLib::Mesh> mesh (io.loadMeshFromFile(_file_name));
+	ASSERT_TRUE(mesh != nullptr);
+	checkMesh(*mesh);
+}
+
+TEST_F(BinaryMeshIOTest, CompactMesh)
+{
+	MeshLib::CompactMesh const compact_mesh (*_mesh);
+	FileIO::BinaryMeshIO io;
+	io.setMesh(&compact_mesh);
+	ASSERT_TRUE(io.writeToFile(_file_name));
+
+	std::unique_ptr<MeshLib::CompactMesh> read_mesh (io.loadCompactMeshFromFile(_file_name));
+	ASSERT_TRUE(read_mesh != nullptr);
+	ASSERT_EQ(compact_mesh.getName(), read_mesh->getName());
+	ASSERT_EQ(compact_mesh.getNNodes(), read_mesh->getNNodes());
+	ASSERT_EQ(compact_mesh.getNElements(), read_mesh->getNElements());
+	for (std::size_t i=0; i<compact_mesh.getNNodes(); i++)
+		for (std::size_t k=0; k<3; k++)
+			ASSERT_EQ(compact_mesh.getNode(i)[k], read_mesh->getNode(i)[k]);
+	for (std::size_t i=0; i<compact_mesh.getNElements(); i++)
+	{
+		ASSERT_EQ(compact_mesh.getCellType(i), read_mesh->getCellType(i));
+		ASSERT_EQ(compact_mesh.getElementValue(i), read_mesh->getElementValue(i));
+		MeshLib::CompactMesh::NodeIDs const ids0 (compact_mesh.getElementNodeIDs(i));
+		MeshLib::CompactMesh::NodeIDs const ids1 (read_mesh->getElementNodeIDs(i));
+		ASSERT_TRUE(std::equal(ids0.begin(), ids0.end(), ids1.begin()));
+	}
+
+	// the mesh without topology tables can be read as MeshLib::Mesh as well
+	std::unique_ptr<MeshLib::Mesh> mesh (io.loadMeshFromFile(_file_name));
+	ASSERT_TRUE(mesh != nullptr);
+	ASSERT_EQ(_mesh->getNElements(), mesh->getNElements());
+	ASSERT_EQ(_mesh->getMaxEdgeLength(), mesh->getMaxEdgeLength());
+}
+
+TEST_F(BinaryMeshIOTest, InvalidFiles)
+{
+	FileIO::BinaryMeshIO io;
+	ASSERT_TRUE(io.loadMeshFromFile(_file_name) == nullptr);
+
+	io.setMesh(_mesh.get());
+	ASSERT_TRUE(io.writeToFile(_file_name));
+	std::string content;
+	{
+		std::ifstream in(_file_name.c_str(), std::ios::binary);
+		content.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+	}
+
+	// truncated file
+	{
+		std::ofstream out(_file_name.c_str(), std::ios::binary);
+		out << content.substr(0, content.size() - 8);
+	}
+	ASSERT_TRUE(io.loadMeshFromFile(_file_name) == nullptr);
+
+	// unknown version
+	{
+		std::string modified (content);
+		modified[8] = 2;
+		std::ofstream out(_file_name.c_str(), std::ios::binary);
+		out << modified;
+	}
+	ASSERT_TRUE(io.loadMeshFromFile(_file_name) == nullptr);
+}
@@ -0,0 +1,149 @@
+/**
+ * \copyright
+ * Copyright (c) 2013, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <vector>
+
+#include <Eigen/Eigen>
+
+#include "MeshLib/CompactMesh.h"
+#include "MeshLib/Mesh.h"
+#include "MeshLib/Node.h"
+#include "MeshLib/Elements/Quad.h"
+#include "MeshLib/MeshGenerators/MeshGenerator.h"
+
+#include "MeshGeoToolsLib/MeshNodeSearcher.h"
+
+#include "NumLib/Fem/CoordinatesMapping/NaturalCoordinatesMapping.h"
+#include "NumLib/Fem/CoordinatesMapping/ShapeMatrices.h"
+#include "NumLib/Fem/ShapeFunction/ShapeQuad4.h"
+
+#include "FileIO/Legacy/MeshIO.h"
+#include "FileIO/XmlIO/Boost/BoostVtuInterface.h"
+
+class MeshLibCompactMesh : public ::testing::Test
+{
+public:
+	MeshLibCompactMesh()
+		: _mesh(MeshLib::MeshGenerator::generateRegularQuadMesh(10.0, 20)),
+		  _compact_mesh(*_mesh)
+	{}
+
+protected:
+	std::unique_ptr<MeshLib::Mesh> _mesh;
+	MeshLib::CompactMesh const _compact_mesh;
+};
+
+TEST_F(MeshLibCompactMesh, CopyOfMesh)
+{
+	ASSERT_EQ(_mesh->getName(), _compact_mesh.getName());
+	ASSERT_EQ(_mesh->getNNodes(), _compact_mesh.getNNodes());
+	ASSERT_EQ(_mesh->getNElements(), _compact_mesh.getNElements());
+
+	double const* const coords (_compact_mesh.getCoordinates());
+	for (std::size_t i=0; i<_mesh->getNNodes(); i++)
+		for (std::size_t k=0; k<3; k++)
+		{
+			ASSERT_EQ((*_mesh->getNode(i))[k], coords[3*i+k]);
+			ASSERT_EQ((*_mesh->getNode(i))[k], _compact_mesh.getNode(i)[k]);
+		}
+
+	for (std::size_t i=0; i<_mesh->getNElements(); i++)
+	{
+		MeshLib::Element const& e (*_mesh->getElement(i));
+		ASSERT_EQ(e.getCellType(), _compact_mesh.getCellType(i));
+		ASSERT_EQ(e.getGeomType(), _compact_mesh.getElementType(i));
+		ASSERT_EQ(e.getValue(), _compact_mesh.getElementValue(i));
+		ASSERT_EQ(e.getNNodes(), _compact_mesh.getNElementNodes(i));
+		ASSERT_EQ(e.getNEdges(), _compact_mesh.getNElementEdges(i));
+
+		MeshLib::CompactMesh::NodeIDs const node_ids (_compact_mesh.getElementNodeIDs(i));
+		ASSERT_EQ(e.getNNodes(true), node_ids.size());
+		for (unsigned k=0; k<node_ids.size(); k++)
+			ASSERT_EQ(e.getNode(k)->getID(), node_ids[k]);
+
+		for (unsigned k=0; k<e.getNEdges(); k++)
+			ASSERT_NEAR(0.5, _compact_mesh.getElementEdgeLength(i, k), 1e-12);
+	}
+}
+
+TEST_F(MeshLibCompactMesh, NaturalCoordinatesMapping)
+{
+	typedef Eigen::Matrix<double, 4, 1> NodalVector;
+	typedef Eigen::Matrix<double, 2, 4, Eigen::RowMajor> DimNodalMatrix;
+	typedef Eigen::Matrix<double, 2, 2, Eigen::RowMajor> DimMatrix;
+	typedef NumLib::ShapeMatrices<NodalVector, DimNodalMatrix, DimMatrix> ShapeMatricesType;
+	typedef MeshLib::CompactElement<MeshLib::Quad> CompactQuad;
+
+	const double r[2] = {0.3, -0.2};
+	for (std::size_t i=0; i<_mesh->getNElements(); i++)
+	{
+		MeshLib::Quad const& quad (dynamic_cast<MeshLib::Quad const&>(*_mesh->getElement(i)));
+		ShapeMatricesType expected(2, 4);
+		NumLib::NaturalCoordinatesMapping<MeshLib::Quad, NumLib::ShapeQuad4, ShapeMatricesType>
+			::computeShapeMatrices(quad, r, expected);
+
+		CompactQuad const compact_quad (_compact_mesh, i);
+		ShapeMatricesType shape(2, 4);
+		NumLib::NaturalCoordinatesMapping<CompactQuad, NumLib::ShapeQuad4, ShapeMatricesType>
+			::computeShapeMatrices(compact_quad, r, shape);
+
+		ASSERT_EQ(expected.detJ, shape.detJ);
+		ASSERT_TRUE(expected.N == shape.N);
+		ASSERT_TRUE(expected.J == shape.J);
+		ASSERT_TRUE(expected.dNdx == shape.dNdx);
+	}
+}
+
+TEST_F(MeshLibCompactMesh, MeshNodeSearcher)
+{
+	MeshGeoToolsLib::MeshNodeSearcher mesh_searcher(*_mesh);
+	MeshGeoToolsLib::MeshNodeSearcher compact_mesh_searcher(_compact_mesh);
+
+	GeoLib::Point pnt(0.0, 0.0, 0.0);
+	for (std::size_t i=0; i<100; i++)
+	{
+		pnt[0] = 0.1 * i + 0.01;
+		pnt[1] = 0.07 * i;
+		ASSERT_EQ(mesh_searcher.getMeshNodeIDForPoint(pnt),
+			compact_mesh_searcher.getMeshNodeIDForPoint(pnt));
+	}
+
+	std::vector<GeoLib::Point*> pnts;
+	pnts.push_back(new GeoLib::Point(0.0, 0.0, 0.0));
+	pnts.push_back(new GeoLib::Point(10.0, 4.9, 0.0));
+	GeoLib::Polyline ply(pnts);
+	ply.addPoint(0);
+	ply.addPoint(1);
+
+	std::vector<std::size_t> const& ids (mesh_searcher.getMeshNodeIDsAlongPolyline(ply));
+	std::vector<std::size_t> const& compact_ids (compact_mesh_searcher.getMeshNodeIDsAlongPolyline(ply));
+	ASSERT_FALSE(ids.empty());
+	ASSERT_EQ(ids, compact_ids);
+
+	for (auto p : pnts)
+		delete p;
+}
+
+TEST_F(MeshLibCompactMesh, Writers)
+{
+	FileIO::Legacy::MeshIO msh_io;
+	msh_io.setMesh(_mesh.get());
+	std::string const msh (msh_io.writeToString());
+	msh_io.setMesh(&_compact_mesh);
+	ASSERT_EQ(msh, msh_io.writeToString());
+
+	FileIO::BoostVtuInterface vtu_io;
+	vtu_io.setMesh(_mesh.get());
+	std::string const vtu (vtu_io.writeToString());
+	vtu_io.setMesh(&_compact_mesh);
+	ASSERT_EQ(vtu, vtu_io.writeToString());
+}
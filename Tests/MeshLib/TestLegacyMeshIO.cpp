@@ -0,0 +1,154 @@
+/**
+ * \copyright
+ * Copyright (c) 2013, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+
+#include "Configure.h"
+
+#include "MeshLib/Mesh.h"
+#include "MeshLib/Node.h"
+#include "MeshLib/Elements/Element.h"
+#include "MeshLib/MeshGenerators/MeshGenerator.h"
+
+#include "FileIO/Legacy/MeshIO.h"
+
+class LegacyMeshIOTest : public ::testing::Test
+{
+public:
+	LegacyMeshIOTest()
+		: _file_name(std::string(PUT_TMP_DIR_IN) + "LegacyMeshIOTest.msh")
+	{}
+
+	~LegacyMeshIOTest()
+	{
+		std::remove(_file_name.c_str());
+	}
+
+	void writeString(std::string const& content) const
+	{
+		std::ofstream out(_file_name.c_str(), std::ios::binary);
+		out << content;
+	}
+
+protected:
+	std::string const _file_name;
+};
+
+TEST_F(LegacyMeshIOTest, WriteAndRead)
+{
+	// more nodes and elements than lines in one chunk of the parser
+	std::unique_ptr<MeshLib::Mesh> const mesh (
+		MeshLib::MeshGenerator::generateRegularHexMesh(1.0, 20));
+	for (std::size_t i=0; i<mesh->getNElements(); i++)
+		const_cast<MeshLib::Element*>(mesh->getElement(i))->setValue(i % 3);
+
+	FileIO::Legacy::MeshIO mesh_io;
+	mesh_io.setMesh(mesh.get());
+	ASSERT_TRUE(mesh_io.writeToFile(_file_name));
+
+	std::unique_ptr<MeshLib::Mesh> const read_mesh (mesh_io.loadMeshFromFile(_file_name));
+	ASSERT_TRUE(read_mesh != nullptr);
+	ASSERT_EQ(mesh->getNNodes(), read_mesh->getNNodes());
+	ASSERT_EQ(mesh->getNElements(), read_mesh->getNElements());
+	for (std::size_t i=0; i<mesh->getNNodes(); i++)
+		for (std::size_t k=0; k<3; k++)
+			ASSERT_NEAR((*mesh->getNode(i))[k], (*read_mesh->getNode(i))[k], 1e-12);
+	for (std::size_t i=0; i<mesh->getNElements(); i++)
+	{
+		MeshLib::Element const& e0 (*mesh->getElement(i));
+		MeshLib::Element const& e1 (*read_mesh->getElement(i));
+		ASSERT_EQ(e0.getCellType(), e1.getCellType());
+		ASSERT_EQ(e0.getValue(), e1.getValue());
+		for (unsigned k=0; k<e0.getNNodes(); k++)
+			ASSERT_EQ(e0.getNode(k)->getID(), e1.getNode(k)->getID());
+	}
+}
+
+TEST_F(LegacyMeshIOTest, MixedElements)
+{
+	writeString(
+		"#FEM_MSH\r\n"
+		"$PCS_TYPE\n"
+		"  NO_PCS\n"
+		"$NODES\n"
+		"  5\n"
+		"0 0 0 0\n"
+		"1 1.0 0 0 $AREA 0.5\n"
+		"2 1 1.0e0 0\n"
+		"3\t0 1 0 \r\n"
+		"4 0.5 0.5 1\n"
+		"$ELEMENTS\n"
+		"  3\n"
+		"0 2 -1 tri 0 1 2\n"
+		"1 1 quad 0 1 2 3\n"
+		"2 0 pyra 0 1 2 3 4\n"
+		" $LAYER\n"
+		"  0\n"
+		"#STOP\n");
+
+	FileIO::Legacy::MeshIO mesh_io;
+	std::unique_ptr<MeshLib::Mesh> const mesh (mesh_io.loadMeshFromFile(_file_name));
+	ASSERT_TRUE(mesh != nullptr);
+	ASSERT_EQ(5u, mesh->getNNodes());
+	ASSERT_EQ(3u, mesh->getNElements());
+	ASSERT_EQ(1.0, (*mesh->getNode(2))[1]);
+	ASSERT_EQ(0.5, (*mesh->getNode(4))[0]);
+	ASSERT_EQ(CellType::TRI3, mesh->getElement(0)->getCellType());
+	ASSERT_EQ(2u, mesh->getElement(0)->getValue());
+	ASSERT_EQ(CellType::QUAD4, mesh->getElement(1)->getCellType());
+	ASSERT_EQ(CellType::PYRAMID5, mesh->getElement(2)->getCellType());
+	ASSERT_EQ(4u, mesh->getElement(2)->getNode(4)->getID());
+}
+
+TEST_F(LegacyMeshIOTest, InvalidFiles)
+{
+	FileIO::Legacy::MeshIO mesh_io;
+	ASSERT_TRUE(mesh_io.loadMeshFromFile(_file_name) == nullptr);
+
+	// node id out of range
+	writeString(
+		"#FEM_MSH\n$NODES\n 3\n0 0 0 0\n1 1 0 0\n2 0 1 0\n"
+		"$ELEMENTS\n 1\n0 0 tri 0 1 3\n#STOP\n");
+	ASSERT_TRUE(mesh_io.loadMeshFromFile(_file_name) == nullptr);
+
+	// missing lines
+	writeString("#FEM_MSH\n$NODES\n 3\n0 0 0 0\n1 1 0 0\n");
+	ASSERT_TRUE(mesh_io.loadMeshFromFile(_file_name) == nullptr);
+
+	// invalid coordinate
+	writeString(
+		"#FEM_MSH\n$NODES\n 3\n0 0 0 0\n1 1 x 0\n2 0 1 0\n"
+		"$ELEMENTS\n 1\n0 0 tri 0 1 2\n#STOP\n");
+	ASSERT_TRUE(mesh_io.loadMeshFromFile(_file_name) == nullptr);
+}
+
+TEST_F(LegacyMeshIOTest, LongCoordinates)
+{
+	// coordinates with more digits than the parser's token buffer
+	std::string const long_one ("1." + std::string(80, '0'));
+	std::string const long_half ("0.5" + std::string(80, '0') + "e0");
+	writeString(
+		"#FEM_MSH\n$NODES\n 3\n0 0 0 0\n1 " + long_one + " 0 0\n"
+		"2 0 " + long_half + " 0\n"
+		"$ELEMENTS\n 1\n0 0 tri 0 1 2\n#STOP\n");
+
+	FileIO::Legacy::MeshIO mesh_io;
+	std::unique_ptr<MeshLib::Mesh> const mesh (mesh_io.loadMeshFromFile(_file_name));
+	ASSERT_TRUE(mesh != nullptr);
+	ASSERT_EQ(3u, mesh->getNNodes());
+	ASSERT_EQ(1.0, (*mesh->getNode(1))[0]);
+	ASSERT_EQ(0.0, (*mesh->getNode(1))[1]);
+	ASSERT_EQ(0.5, (*mesh->getNode(2))[1]);
+	ASSERT_EQ(0.0, (*mesh->getNode(2))[2]);
+}
@@ -0,0 +1,187 @@
+/**
+ * \copyright
+ * Copyright (c) 2013, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#include "gtest/gtest.h"
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "GeoLib/Point.h"
+
+#include "MeshLib/Mesh.h"
+#include "MeshLib/Node.h"
+#include "MeshLib/Elements/Element.h"
+#include "MeshLib/Elements/Hex.h"
+#include "MeshLib/Elements/Prism.h"
+#include "MeshLib/Elements/Pyramid.h"
+#include "MeshLib/Elements/Tet.h"
+#include "MeshLib/MeshEditing/Mesh2MeshPropertyInterpolation.h"
+#include "MeshLib/MeshGenerators/MeshGenerator.h"
+
+namespace
+{
+/// Sets the material id of the elements to 0 if the center is left of x and
+/// to 1 otherwise.
+void setMaterialsLeftAndRight(MeshLib::Mesh& mesh, double x)
+{
+	for (MeshLib::Element* e : mesh.getElements())
+		e->setValue(e->getCenterOfGravity()[0] < x ? 0 : 1);
+}
+
+/// Checks the interpolated properties of the destination elements that are
+/// completely left or right of x.
+void checkLeftAndRight(MeshLib::Mesh const& mesh,
+	std::vector<double> const& properties, double x, double left, double right)
+{
+	for (std::size_t i=0; i<mesh.getNElements(); i++)
+	{
+		MeshLib::Element const& e (*mesh.getElement(i));
+		ASSERT_EQ(i, e.getValue());
+		bool all_left (true);
+		bool all_right (true);
+		for (unsigned k=0; k<e.getNNodes(); k++)
+		{
+			all_left = all_left && (*e.getNode(k))[0] < x - 1.0;
+			all_right = all_right && (*e.getNode(k))[0] > x + 1.0;
+		}
+		if (all_left)
+			ASSERT_NEAR(left, properties[i], 1e-12);
+		else if (all_right)
+			ASSERT_NEAR(right, properties[i], 1e-12);
+		else
+		{
+			ASSERT_LE(left, properties[i]);
+			ASSERT_GE(right, properties[i]);
+		}
+	}
+}
+}
+
+TEST(MeshLib, Mesh2MeshPropertyInterpolation2D)
+{
+	std::unique_ptr<MeshLib::Mesh> src_mesh (
+		MeshLib::MeshGenerator::generateRegularQuadMesh(10.0, 20));
+	setMaterialsLeftAndRight(*src_mesh, 5.0);
+	std::vector<double> const src_properties = {1.0, 3.0};
+
+	std::unique_ptr<MeshLib::Mesh> dest_mesh (
+		MeshLib::MeshGenerator::generateRegularQuadMesh(10.0, 8));
+
+	typedef MeshLib::Mesh2MeshPropertyInterpolation::Mode Mode;
+	for (Mode mode : {Mode::ELEMENT_AVERAGE, Mode::INVERSE_DISTANCE, Mode::NEAREST})
+	{
+		MeshLib::Mesh2MeshPropertyInterpolation interpolation(
+			src_mesh.get(), &src_properties, mode);
+		std::vector<double> dest_properties(dest_mesh->getNElements());
+		ASSERT_TRUE(interpolation.setPropertiesForMesh(dest_mesh.get(), dest_properties));
+		checkLeftAndRight(*dest_mesh, dest_properties, 5.0, 1.0, 3.0);
+	}
+}
+
+TEST(MeshLib, Mesh2MeshPropertyInterpolation3D)
+{
+	std::unique_ptr<MeshLib::Mesh> src_mesh (
+		MeshLib::MeshGenerator::generateRegularHexMesh(10.0, 10));
+	setMaterialsLeftAndRight(*src_mesh, 5.0);
+	std::vector<double> const src_properties = {1.0, 3.0};
+
+	std::unique_ptr<MeshLib::Mesh> dest_mesh (
+		MeshLib::MeshGenerator::generateRegularHexMesh(10.0, 4));
+
+	typedef MeshLib::Mesh2MeshPropertyInterpolation::Mode Mode;
+	for (Mode mode : {Mode::ELEMENT_AVERAGE, Mode::INVERSE_DISTANCE, Mode::NEAREST})
+	{
+		MeshLib::Mesh2MeshPropertyInterpolation interpolation(
+			src_mesh.get(), &src_properties, mode);
+		std::vector<double> dest_properties(dest_mesh->getNElements());
+		ASSERT_TRUE(interpolation.setPropertiesForMesh(dest_mesh.get(), dest_properties));
+		checkLeftAndRight(*dest_mesh, dest_properties, 5.0, 1.0, 3.0);
+	}
+
+	// source and destination mesh dimension must match
+	std::unique_ptr<MeshLib::Mesh> quad_mesh (
+		MeshLib::MeshGenerator::generateRegularQuadMesh(10.0, 8));
+	MeshLib::Mesh2MeshPropertyInterpolation interpolation(src_mesh.get(), &src_properties);
+	std::vector<double> dest_properties(quad_mesh->getNElements());
+	ASSERT_FALSE(interpolation.setPropertiesForMesh(quad_mesh.get(), dest_properties));
+}
+
+TEST(MeshLib, CellIsPntInside)
+{
+	std::unique_ptr<MeshLib::Mesh> mesh (
+		MeshLib::MeshGenerator::generateRegularHexMesh(1.0, 1));
+	MeshLib::Hex const& hex (*static_cast<MeshLib::Hex const*>(mesh->getElement(0)));
+
+	ASSERT_TRUE(hex.isPntInside(GeoLib::Point(0.5, 0.5, 0.5)));
+	ASSERT_TRUE(hex.isPntInside(GeoLib::Point(0.9, 0.1, 0.7)));
+	ASSERT_TRUE(hex.isPntInside(GeoLib::Point(1.0, 1.0, 1.0)));
+	ASSERT_TRUE(hex.isPntInside(GeoLib::Point(0.0, 0.3, 0.2)));
+	ASSERT_FALSE(hex.isPntInside(GeoLib::Point(1.1, 0.5, 0.5)));
+	ASSERT_FALSE(hex.isPntInside(GeoLib::Point(0.5, -0.01, 0.5)));
+	ASSERT_FALSE(hex.isPntInside(GeoLib::Point(0.5, 0.5, 1.0 + 1e-9)));
+}
+
+TEST(MeshLib, CellIsPntInsideTet)
+{
+	MeshLib::Node n0(0, 0, 0), n1(1, 0, 0), n2(0, 1, 0), n3(0, 0, 1);
+	std::array<MeshLib::Node*, 4> const nodes = {{&n0, &n1, &n2, &n3}};
+	MeshLib::Tet const tet(nodes);
+
+	ASSERT_TRUE(tet.isPntInside(GeoLib::Point(0.2, 0.2, 0.2)));
+	// on the faces
+	ASSERT_TRUE(tet.isPntInside(GeoLib::Point(0.3, 0.3, 0.0)));
+	ASSERT_TRUE(tet.isPntInside(GeoLib::Point(0.5, 0.25, 0.25)));
+	ASSERT_TRUE(tet.isPntInside(GeoLib::Point(0.0, 0.0, 1.0)));
+	ASSERT_FALSE(tet.isPntInside(GeoLib::Point(0.4, 0.4, 0.4)));
+	ASSERT_FALSE(tet.isPntInside(GeoLib::Point(-0.01, 0.2, 0.2)));
+	ASSERT_FALSE(tet.isPntInside(GeoLib::Point(0.2, 0.2, -1e-9)));
+}
+
+TEST(MeshLib, CellIsPntInsidePrism)
+{
+	MeshLib::Node n0(0, 0, 0), n1(1, 0, 0), n2(0, 1, 0);
+	MeshLib::Node n3(0, 0, 1), n4(1, 0, 1), n5(0, 1, 1);
+	std::array<MeshLib::Node*, 6> const nodes = {{&n0, &n1, &n2, &n3, &n4, &n5}};
+	MeshLib::Prism const prism(nodes);
+
+	// points in the different tetrahedra of the decomposition
+	ASSERT_TRUE(prism.isPntInside(GeoLib::Point(0.1, 0.1, 0.1)));
+	ASSERT_TRUE(prism.isPntInside(GeoLib::Point(0.7, 0.1, 0.5)));
+	ASSERT_TRUE(prism.isPntInside(GeoLib::Point(0.1, 0.7, 0.9)));
+	// on the faces
+	ASSERT_TRUE(prism.isPntInside(GeoLib::Point(0.3, 0.3, 0.0)));
+	ASSERT_TRUE(prism.isPntInside(GeoLib::Point(0.3, 0.3, 1.0)));
+	ASSERT_TRUE(prism.isPntInside(GeoLib::Point(0.5, 0.5, 0.5)));
+	ASSERT_TRUE(prism.isPntInside(GeoLib::Point(0.5, 0.0, 0.25)));
+	ASSERT_FALSE(prism.isPntInside(GeoLib::Point(0.6, 0.6, 0.5)));
+	ASSERT_FALSE(prism.isPntInside(GeoLib::Point(0.2, 0.2, 1.1)));
+	ASSERT_FALSE(prism.isPntInside(GeoLib::Point(0.2, -0.01, 0.5)));
+}
+
+TEST(MeshLib, CellIsPntInsidePyramid)
+{
+	MeshLib::Node n0(0, 0, 0), n1(1, 0, 0), n2(1, 1, 0), n3(0, 1, 0);
+	MeshLib::Node n4(0.5, 0.5, 1);
+	std::array<MeshLib::Node*, 5> const nodes = {{&n0, &n1, &n2, &n3, &n4}};
+	MeshLib::Pyramid const pyramid(nodes);
+
+	// points in the different tetrahedra of the decomposition
+	ASSERT_TRUE(pyramid.isPntInside(GeoLib::Point(0.5, 0.5, 0.5)));
+	ASSERT_TRUE(pyramid.isPntInside(GeoLib::Point(0.8, 0.2, 0.1)));
+	ASSERT_TRUE(pyramid.isPntInside(GeoLib::Point(0.2, 0.8, 0.1)));
+	// on the faces
+	ASSERT_TRUE(pyramid.isPntInside(GeoLib::Point(0.3, 0.7, 0.0)));
+	ASSERT_TRUE(pyramid.isPntInside(GeoLib::Point(0.5, 0.0, 0.0)));
+	ASSERT_TRUE(pyramid.isPntInside(GeoLib::Point(0.75, 0.5, 0.5)));
+	ASSERT_TRUE(pyramid.isPntInside(GeoLib::Point(0.5, 0.5, 1.0)));
+	ASSERT_FALSE(pyramid.isPntInside(GeoLib::Point(0.9, 0.9, 0.5)));
+	ASSERT_FALSE(pyramid.isPntInside(GeoLib::Point(0.5, 0.5, 1.01)));
+	ASSERT_FALSE(pyramid.isPntInside(GeoLib::Point(0.5, 0.5, -0.01)));
+}
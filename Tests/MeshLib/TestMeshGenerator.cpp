@@ -112,3 +112,38 @@ TEST(MeshLib, MeshGeneratorRegularQuad)
 	ASSERT_DOUBLE_EQ(L, (*node)[0]);
 	ASSERT_DOUBLE_EQ(L, (*node)[1]);
 }
+
+TEST(MeshLib, RegularHexElementNeighbors)
+{
+	const unsigned n = 4;
+	std::unique_ptr<MeshLib::Mesh> msh(MeshLib::MeshGenerator::generateRegularHexMesh(1.0, n));
+
+	// Number of neighbors is six minus the number of faces on the boundary.
+	for (std::size_t k = 0; k < msh->getNElements(); ++k)
+	{
+		const MeshLib::Element* e = msh->getElement(k);
+		unsigned n_neighbors = 0;
+		for (unsigned i = 0; i < e->getNNeighbors(); ++i)
+		{
+			const MeshLib::Element* neighbor = e->getNeighbor(i);
+			if (neighbor == nullptr)
+				continue;
+			n_neighbors++;
+			// The relation is symmetric and the neighbor shares the face nodes.
+			bool is_symmetric = false;
+			for (unsigned j = 0; j < neighbor->getNNeighbors(); ++j)
+				is_symmetric |= (neighbor->getNeighbor(j) == e);
+			ASSERT_TRUE(is_symmetric);
+			const MeshLib::Element* face = e->getFace(i);
+			for (unsigned j = 0; j < face->getNNodes(); ++j)
+				ASSERT_LT(neighbor->getNodeIDinElement(face->getNode(j)), neighbor->getNNodes());
+			delete face;
+		}
+
+		const std::size_t x = k % n, y = (k / n) % n, z = k / (n * n);
+		unsigned n_boundary = 0;
+		for (std::size_t c : {x, y, z})
+			n_boundary += (c == 0) + (c == n - 1);
+		ASSERT_EQ(6u - n_boundary, n_neighbors);
+	}
+}
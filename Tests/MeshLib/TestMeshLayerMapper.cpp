@@ -0,0 +1,113 @@
+/**
+ * \copyright
+ * Copyright (c) 2013, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "GeoLib/Raster.h"
+#include "MeshLib/Elements/Element.h"
+#include "MeshLib/Mesh.h"
+#include "MeshLib/MeshGenerators/MeshGenerator.h"
+#include "MeshLib/MeshGenerators/MeshLayerMapper.h"
+#include "MeshLib/Node.h"
+
+namespace
+{
+
+/// Raster with the values of the linear function 2x + 3y + 1 at the pixel centres.
+GeoLib::Raster* createLinearRaster(std::size_t n, double x0, double y0, double cell_size)
+{
+	std::vector<double> values(n*n);
+	for (std::size_t row = 0; row < n; ++row)
+		for (std::size_t col = 0; col < n; ++col)
+			values[row*n + col] = 2 * (x0 + (col + 0.5) * cell_size)
+				+ 3 * (y0 + (row + 0.5) * cell_size) + 1;
+	return new GeoLib::Raster(n, n, x0, y0, cell_size, values.begin(), values.end());
+}
+
+}
+
+TEST(MeshLib, MeshLayerMapperCreateLayers)
+{
+	std::unique_ptr<MeshLib::Mesh> const sfc_mesh(
+		MeshLib::MeshGenerator::generateRegularQuadMesh(10.0, 10));
+	std::vector<float> const thickness = {2, 3};
+	std::unique_ptr<MeshLib::Mesh> const mesh(
+		MeshLayerMapper::CreateLayers(*sfc_mesh, thickness));
+	ASSERT_TRUE(mesh != nullptr);
+	ASSERT_EQ(3*121u, mesh->getNNodes());
+	ASSERT_EQ(2*100u, mesh->getNElements());
+
+	for (std::size_t i = 0; i < mesh->getNNodes(); ++i)
+	{
+		MeshLib::Node const& node (*mesh->getNode(i));
+		MeshLib::Node const& sfc_node (*sfc_mesh->getNode(i % 121));
+		double const z[] = {0, -2, -5};
+		ASSERT_EQ(i, node.getID());
+		ASSERT_EQ(sfc_node[0], node[0]);
+		ASSERT_EQ(sfc_node[1], node[1]);
+		ASSERT_EQ(z[i / 121], node[2]);
+	}
+
+	for (std::size_t k = 0; k < mesh->getNElements(); ++k)
+	{
+		MeshLib::Element const& e (*mesh->getElement(k));
+		ASSERT_EQ(MeshElemType::HEXAHEDRON, e.getGeomType());
+		ASSERT_EQ(1 - k / 100, e.getValue());
+		ASSERT_NEAR(k < 100 ? 2.0 : 3.0, e.getContent(), 1e-12);
+		// the top face is formed by the last four nodes
+		for (unsigned j = 0; j < 4; ++j)
+			ASSERT_EQ(e.getNode(j+4)->getID() + 121, e.getNode(j)->getID());
+	}
+}
+
+TEST(MeshLib, MeshLayerMapperLayerMapping)
+{
+	std::unique_ptr<MeshLib::Mesh> const sfc_mesh(
+		MeshLib::MeshGenerator::generateRegularQuadMesh(10.0, 10));
+	std::vector<float> const thickness = {2, 3};
+	std::unique_ptr<MeshLib::Mesh> const mesh(
+		MeshLayerMapper::CreateLayers(*sfc_mesh, thickness));
+
+	// the raster covers the mesh, bilinear interpolation is exact
+	std::unique_ptr<GeoLib::Raster> const raster(createLinearRaster(26, -1.0, -1.0, 0.5));
+	ASSERT_EQ(1, MeshLayerMapper::LayerMapping(*mesh, *raster, 2, 0, 0.0));
+	for (std::size_t i = 0; i < 121; ++i)
+	{
+		MeshLib::Node const& node (*mesh->getNode(i));
+		ASSERT_NEAR(2 * node[0] + 3 * node[1] + 1, node[2], 1e-10);
+	}
+
+	// the raster covers [0,5]x[0,5], the other nodes get the replacement value,
+	// at the border the values of the nearest pixels are used
+	std::unique_ptr<GeoLib::Raster> const small_raster(createLinearRaster(10, 0.0, 0.0, 0.5));
+	ASSERT_EQ(1, MeshLayerMapper::LayerMapping(*mesh, *small_raster, 2, 2, -100.0));
+	for (std::size_t i = 2*121; i < 3*121; ++i)
+	{
+		MeshLib::Node const& node (*mesh->getNode(i));
+		if (node[0] > 5 || node[1] > 5)
+		{
+			ASSERT_EQ(-100.0, node[2]);
+		}
+		else if (node[0] >= 1 && node[0] <= 4 && node[1] >= 1 && node[1] <= 4)
+		{
+			ASSERT_NEAR(2 * node[0] + 3 * node[1] + 1, node[2], 1e-10);
+		}
+	}
+
+	// pixels without data are ignored
+	std::vector<double> values(4, -9999);
+	values[0] = 7.0;
+	GeoLib::Raster const no_data_raster(2, 2, 0.0, 0.0, 1.0, values.begin(), values.end());
+	ASSERT_NEAR(7.0, no_data_raster.interpolateValueAtPoint(1.0, 1.0), 1e-12);
+	ASSERT_EQ(-9999, no_data_raster.interpolateValueAtPoint(1.5, 1.5));
+	ASSERT_EQ(-9999, no_data_raster.interpolateValueAtPoint(2.5, 1.0));
+}
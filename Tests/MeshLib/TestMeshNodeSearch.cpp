@@ -13,6 +13,7 @@
 
 #include "gtest/gtest.h"
 
+#include <algorithm>
 #include <memory>
 
 #include "Mesh.h"
@@ -226,6 +227,65 @@ TEST_F(MeshLibMeshNodeSearchInSimpleQuadMesh, SurfaceSearch)
 	std::for_each(pnts.begin(), pnts.end(), [](GeoLib::Point* pnt) { delete pnt; });
 }
 
+TEST_F(MeshLibMeshNodeSearchInSimpleQuadMesh, PolylinesAndSurfacesSearch)
+{
+	ASSERT_TRUE(_quad_mesh != nullptr);
+	// create geometry: diagonal zig-zag polylines crossing many grid cells
+	std::vector<GeoLib::Point*> pnts;
+	const std::size_t n_plys(8);
+	for (std::size_t k(0); k<n_plys; k++) {
+		double const y(k * _geometric_size / n_plys);
+		pnts.push_back(new GeoLib::Point(0.0, y, 0.0));
+		pnts.push_back(new GeoLib::Point(0.5*_geometric_size, y + 0.3, 0.0));
+		pnts.push_back(new GeoLib::Point(_geometric_size, y, 0.0));
+	}
+	std::vector<GeoLib::Polyline*> plys;
+	for (std::size_t k(0); k<n_plys; k++) {
+		plys.push_back(new GeoLib::Polyline(pnts));
+		plys.back()->addPoint(3*k);
+		plys.back()->addPoint(3*k+1);
+		plys.back()->addPoint(3*k+2);
+	}
+	// every second polyline is closed and used as surface boundary
+	std::vector<GeoLib::Surface*> sfcs;
+	for (std::size_t k(0); k+1<n_plys; k+=2) {
+		GeoLib::Polyline ply(pnts);
+		ply.addPoint(3*k);
+		ply.addPoint(3*k+2);
+		ply.addPoint(3*(k+1)+2);
+		ply.addPoint(3*(k+1));
+		ply.addPoint(3*k);
+		sfcs.push_back(GeoLib::Surface::createSurface(ply));
+	}
+
+	// search all geometries at once and one by one with a second searcher
+	MeshGeoToolsLib::MeshNodeSearcher mesh_node_searcher(*_quad_mesh);
+	mesh_node_searcher.searchMeshNodesAlongPolylines(plys);
+	mesh_node_searcher.searchMeshNodesAlongSurfaces(sfcs);
+	MeshGeoToolsLib::MeshNodeSearcher single_searcher(*_quad_mesh);
+
+	for (auto const* ply : plys) {
+		std::vector<std::size_t> const& ids(mesh_node_searcher.getMeshNodeIDsAlongPolyline(*ply));
+		ASSERT_FALSE(ids.empty());
+		ASSERT_EQ(single_searcher.getMeshNodeIDsAlongPolyline(*ply), ids);
+	}
+	for (auto const* sfc : sfcs) {
+		std::vector<std::size_t> const& ids(mesh_node_searcher.getMeshNodeIDsAlongSurface(*sfc));
+		ASSERT_FALSE(ids.empty());
+		ASSERT_EQ(single_searcher.getMeshNodeIDsAlongSurface(*sfc), ids);
+		ASSERT_TRUE(std::is_sorted(ids.begin(), ids.end()));
+	}
+
+	// a repeated search does not create new results
+	std::vector<std::size_t> const* ids0(&mesh_node_searcher.getMeshNodeIDsAlongPolyline(*plys[0]));
+	mesh_node_searcher.searchMeshNodesAlongPolylines(plys);
+	ASSERT_EQ(ids0, &mesh_node_searcher.getMeshNodeIDsAlongPolyline(*plys[0]));
+
+	std::for_each(sfcs.begin(), sfcs.end(), [](GeoLib::Surface* sfc) { delete sfc; });
+	std::for_each(plys.begin(), plys.end(), [](GeoLib::Polyline* ply) { delete ply; });
+	std::for_each(pnts.begin(), pnts.end(), [](GeoLib::Point* pnt) { delete pnt; });
+}
+
 TEST_F(MeshLibMeshNodeSearchInSimpleHexMesh, SurfaceSearch)
 {
 	ASSERT_TRUE(_hex_mesh != nullptr);
@@ -0,0 +1,88 @@
+/**
+ * \copyright
+ * Copyright (c) 2013, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "MeshLib/Elements/Element.h"
+#include "MeshLib/Mesh.h"
+#include "MeshLib/MeshGenerators/MeshGenerator.h"
+#include "MeshLib/MeshReordering.h"
+#include "MeshLib/Node.h"
+#include "MeshLib/NodeAdjacency.h"
+
+namespace
+{
+
+std::size_t getBandwidth(MeshLib::Mesh const& mesh)
+{
+	MeshLib::NodeAdjacency const& adjacency = mesh.getNodeAdjacency();
+	return MathLib::getBandwidth(adjacency.size(),
+		adjacency.getOffsets().data(), adjacency.getAdjacentNodes().data());
+}
+
+/// Coordinates of the element nodes.
+std::vector<double> getElementCoordinates(MeshLib::Mesh const& mesh)
+{
+	std::vector<double> coords;
+	for (auto const* e : mesh.getElements())
+		for (unsigned i = 0; i < e->getNNodes(); ++i)
+			for (unsigned d = 0; d < 3; ++d)
+				coords.push_back((*e->getNode(i))[d]);
+	return coords;
+}
+
+}
+
+TEST(MeshLib, MeshReordering)
+{
+	std::size_t const nx = 24;
+	std::unique_ptr<MeshLib::Mesh> mesh(
+		MeshLib::MeshGenerator::generateRegularQuadMesh(1.0, nx));
+	std::vector<double> const coords = getElementCoordinates(*mesh);
+	std::size_t const n_nodes = mesh->getNNodes();
+
+	// shuffle the nodes
+	std::vector<std::size_t> shuffle(n_nodes);
+	std::iota(shuffle.begin(), shuffle.end(), 0);
+	std::shuffle(shuffle.begin(), shuffle.end(), std::mt19937(7));
+	std::vector<MeshLib::Node const*> const old_nodes(
+		mesh->getNodes().begin(), mesh->getNodes().end());
+	mesh->reorderNodes(shuffle);
+	for (std::size_t i = 0; i < n_nodes; ++i)
+	{
+		ASSERT_EQ(old_nodes[shuffle[i]], mesh->getNode(i));
+		ASSERT_EQ(i, mesh->getNode(i)->getID());
+	}
+	ASSERT_LT(n_nodes / 2, getBandwidth(*mesh));
+
+	std::vector<MathLib::ReorderingMethod> const methods = {
+		MathLib::ReorderingMethod::REVERSE_CUTHILL_MCKEE,
+		MathLib::ReorderingMethod::NESTED_DISSECTION,
+		MathLib::ReorderingMethod::SPACE_FILLING_CURVE };
+	for (auto const method : methods)
+	{
+		std::vector<std::size_t> op_perm =
+			MeshLib::reorderMeshNodes(*mesh, method);
+		std::sort(op_perm.begin(), op_perm.end());
+		for (std::size_t i = 0; i < n_nodes; ++i)
+			ASSERT_EQ(i, op_perm[i]);
+		// the elements keep their geometry
+		ASSERT_EQ(coords, getElementCoordinates(*mesh));
+	}
+
+	MeshLib::reorderMeshNodes(*mesh,
+		MathLib::ReorderingMethod::REVERSE_CUTHILL_MCKEE);
+	ASSERT_GE(2 * (nx + 2), getBandwidth(*mesh));
+}
@@ -13,6 +13,7 @@
 
 #include "MeshLib/MeshGenerators/MeshGenerator.h"
 #include "MeshLib/Mesh.h"
+#include "MeshLib/NodeAdjacency.h"
 #include "MeshLib/Elements/Quad.h"
 
 class MeshLibQuadMesh : public ::testing::Test
@@ -320,3 +321,51 @@ TEST_F(MeshLibQuadMesh, NodeToElementConnectivity)
             EXPECT_EQ(getElement(i,   j  ), node->getElement(3));
         });
 }
+
+TEST_F(MeshLibQuadMesh, CopiedElementNeighbors)
+{
+    MeshLib::Mesh const copy(*mesh);
+    for (std::size_t i = 0; i < mesh->getNElements(); ++i)
+    {
+        MeshLib::Element const* const e = mesh->getElement(i);
+        MeshLib::Element const* const e_copy = copy.getElement(i);
+        for (unsigned k = 0; k < e->getNNeighbors(); ++k)
+        {
+            if (e->getNeighbor(k) == nullptr)
+                EXPECT_EQ(nullptr, e_copy->getNeighbor(k));
+            else
+                EXPECT_EQ(copy.getElement(e->getNeighbor(k)->getID()),
+                          e_copy->getNeighbor(k));
+        }
+    }
+}
+
+// A node is adjacent to eight nodes inside the mesh, five on the boundary,
+// and three in the corner.
+TEST_F(MeshLibQuadMesh, NodeAdjacency)
+{
+    MeshLib::NodeAdjacency const& adjacency = mesh->getNodeAdjacency();
+    ASSERT_EQ(mesh->getNNodes(), adjacency.size());
+
+    testCornerNodes([&adjacency](MeshLib::Node const* const node, ...)
+        {
+            EXPECT_EQ(3u, adjacency.getNAdjacentNodes(node->getID()));
+        });
+    testBoundaryNodes([&adjacency](MeshLib::Node const* const node, ...)
+        {
+            EXPECT_EQ(5u, adjacency.getNAdjacentNodes(node->getID()));
+        });
+    testInsideNodes([this, &adjacency](MeshLib::Node const* const node,
+        std::size_t const i, std::size_t const j)
+        {
+            ASSERT_EQ(8u, adjacency.getNAdjacentNodes(node->getID()));
+            // Sorted ids of the surrounding nodes.
+            MeshLib::NodeAdjacency::ConstIterator it = adjacency.begin(node->getID());
+            for (int di = -1; di <= 1; di++)
+                for (int dj = -1; dj <= 1; dj++)
+                    if (di != 0 || dj != 0)
+                    {
+                        EXPECT_EQ(getNode(i + di, j + dj)->getID(), *it++);
+                    }
+        });
+}
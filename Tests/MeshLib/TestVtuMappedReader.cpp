@@ -0,0 +1,195 @@
+/**
+ * \copyright
+ * Copyright (c) 2013, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+
+#include "Configure.h"
+
+#include "MeshLib/CompactMesh.h"
+#include "MeshLib/Mesh.h"
+#include "MeshLib/Node.h"
+#include "MeshLib/Elements/Element.h"
+#include "MeshLib/MeshGenerators/MeshGenerator.h"
+
+#include "FileIO/XmlIO/VtuMappedReader.h"
+#include "FileIO/XmlIO/VtuStreamWriter.h"
+#include "FileIO/XmlIO/Boost/BoostVtuInterface.h"
+
+class VtuMappedReaderTest : public ::testing::Test
+{
+public:
+	VtuMappedReaderTest()
+		: _mesh(MeshLib::MeshGenerator::generateRegularHexMesh(3.0, 4)),
+		  _file_name(std::string(PUT_TMP_DIR_IN) + "VtuMappedReaderTest.vtu")
+	{
+		for (std::size_t i=0; i<_mesh->getNElements(); i++)
+			const_cast<MeshLib::Element*>(_mesh->getElement(i))->setValue(i % 5);
+	}
+
+	~VtuMappedReaderTest()
+	{
+		std::remove(_file_name.c_str());
+	}
+
+	void checkMesh(MeshLib::Mesh const& mesh) const
+	{
+		ASSERT_EQ(_mesh->getNNodes(), mesh.getNNodes());
+		ASSERT_EQ(_mesh->getNElements(), mesh.getNElements());
+		for (std::size_t i=0; i<mesh.getNNodes(); i++)
+			for (std::size_t k=0; k<3; k++)
+				ASSERT_DOUBLE_EQ((*_mesh->getNode(i))[k], (*mesh.getNode(i))[k]);
+		for (std::size_t i=0; i<mesh.getNElements(); i++)
+		{
+			MeshLib::Element const& e0 (*_mesh->getElement(i));
+			MeshLib::Element const& e1 (*mesh.getElement(i));
+			ASSERT_EQ(e0.getCellType(), e1.getCellType());
+			ASSERT_EQ(e0.getValue(), e1.getValue());
+			for (unsigned k=0; k<e0.getNNodes(); k++)
+				ASSERT_EQ(e0.getNode(k)->getID(), e1.getNode(k)->getID());
+		}
+	}
+
+	void checkCompactMesh(MeshLib::CompactMesh const& mesh) const
+	{
+		ASSERT_EQ(_mesh->getNNodes(), mesh.getNNodes());
+		ASSERT_EQ(_mesh->getNElements(), mesh.getNElements());
+		for (std::size_t i=0; i<mesh.getNNodes(); i++)
+			for (std::size_t k=0; k<3; k++)
+				ASSERT_DOUBLE_EQ((*_mesh->getNode(i))[k], mesh.getNode(i)[k]);
+		for (std::size_t i=0; i<mesh.getNElements(); i++)
+		{
+			MeshLib::Element const& e (*_mesh->getElement(i));
+			ASSERT_EQ(e.getCellType(), mesh.getCellType(i));
+			ASSERT_EQ(e.getValue(), mesh.getElementValue(i));
+			MeshLib::CompactMesh::NodeIDs const ids (mesh.getElementNodeIDs(i));
+			ASSERT_EQ(e.getNNodes(), ids.size());
+			for (unsigned k=0; k<e.getNNodes(); k++)
+				ASSERT_EQ(e.getNode(k)->getID(), ids[k]);
+		}
+	}
+
+	void writeString(std::string const& content) const
+	{
+		std::ofstream out(_file_name.c_str(), std::ios::binary);
+		out << content;
+	}
+
+protected:
+	std::unique_ptr<MeshLib::Mesh> _mesh;
+	std::string const _file_name;
+};
+
+TEST_F(VtuMappedReaderTest, AppendedRaw)
+{
+	FileIO::VtuStreamWriter writer;
+	writer.setMesh(_mesh.get());
+	ASSERT_TRUE(writer.writeToFile(_file_name));
+
+	std::unique_ptr<MeshLib::Mesh> mesh (FileIO::VtuMappedReader::readVTUFile(_file_name));
+	ASSERT_TRUE(mesh != nullptr);
+	checkMesh(*mesh);
+
+	std::unique_ptr<MeshLib::CompactMesh> compact_mesh (
+		FileIO::VtuMappedReader::readCompactMesh(_file_name));
+	ASSERT_TRUE(compact_mesh != nullptr);
+	checkCompactMesh(*compact_mesh);
+}
+
+TEST_F(VtuMappedReaderTest, AppendedCompressed)
+{
+	// small blocks to test the parallel decompression
+	FileIO::VtuStreamWriter writer(true, 64);
+	writer.setMesh(_mesh.get());
+	ASSERT_TRUE(writer.writeToFile(_file_name));
+
+	std::unique_ptr<MeshLib::Mesh> mesh (FileIO::VtuMappedReader::readVTUFile(_file_name));
+	ASSERT_TRUE(mesh != nullptr);
+	checkMesh(*mesh);
+}
+
+TEST_F(VtuMappedReaderTest, Ascii)
+{
+	FileIO::BoostVtuInterface vtu_interface;
+	vtu_interface.setMesh(_mesh.get());
+	ASSERT_TRUE(vtu_interface.writeToFile(_file_name));
+
+	std::unique_ptr<MeshLib::CompactMesh> compact_mesh (
+		FileIO::VtuMappedReader::readCompactMesh(_file_name));
+	ASSERT_TRUE(compact_mesh != nullptr);
+	checkCompactMesh(*compact_mesh);
+}
+
+TEST_F(VtuMappedReaderTest, InlineBase64)
+{
+	// two triangles, Float32 points, UInt32 headers; the headers of the first
+	// arrays are encoded separately, the one of the connectivity together with
+	// the data
+	writeString(
+		"<?xml version=\"1.0\"?>\n"
+		"<VTKFile type=\"UnstructuredGrid\" version=\"0.1\" byte_order=\"LittleEndian\">\n"
+		"<UnstructuredGrid><Piece NumberOfPoints=\"4\" NumberOfCells=\"2\">\n"
+		"<Points><DataArray type=\"Float32\" NumberOfComponents=\"3\" format=\"binary\">\n"
+		"MAAAAA==AAAAAAAAAAAAAAAAAACAPwAAAAAAAAAAAAAAAAAAgD8AAA\n"
+		"  AAAACAPwAAgD8AAAAA\n"
+		"</DataArray></Points>\n"
+		"<CellData><DataArray type=\"Int32\" Name=\"MaterialIDs\" format=\"binary\">"
+		"CAAAAA==BAAAAAIAAAA=</DataArray></CellData>\n"
+		"<Cells>\n"
+		"<DataArray type=\"Int32\" Name=\"connectivity\" format=\"binary\">"
+		"GAAAAAAAAAABAAAAAgAAAAEAAAADAAAAAgAAAA==</DataArray>\n"
+		"<DataArray type=\"Int32\" Name=\"offsets\" format=\"binary\">CAAAAA==AwAAAAYAAAA=</DataArray>\n"
+		"<DataArray type=\"UInt8\" Name=\"types\" format=\"binary\">AgAAAA==BQU=</DataArray>\n"
+		"</Cells></Piece></UnstructuredGrid></VTKFile>\n");
+
+	std::unique_ptr<MeshLib::Mesh> mesh (FileIO::VtuMappedReader::readVTUFile(_file_name));
+	ASSERT_TRUE(mesh != nullptr);
+	ASSERT_EQ(4u, mesh->getNNodes());
+	ASSERT_EQ(2u, mesh->getNElements());
+	ASSERT_EQ(1.0, (*mesh->getNode(3))[0]);
+	ASSERT_EQ(1.0, (*mesh->getNode(3))[1]);
+	ASSERT_EQ(CellType::TRI3, mesh->getElement(1)->getCellType());
+	ASSERT_EQ(4u, mesh->getElement(0)->getValue());
+	ASSERT_EQ(2u, mesh->getElement(1)->getValue());
+	ASSERT_EQ(3u, mesh->getElement(1)->getNode(1)->getID());
+}
+
+TEST_F(VtuMappedReaderTest, InvalidFiles)
+{
+	ASSERT_TRUE(FileIO::VtuMappedReader::readVTUFile(_file_name) == nullptr);
+
+	// truncated appended data
+	FileIO::VtuStreamWriter writer;
+	writer.setMesh(_mesh.get());
+	ASSERT_TRUE(writer.writeToFile(_file_name));
+	std::string content;
+	{
+		std::ifstream in(_file_name.c_str(), std::ios::binary);
+		content.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+	}
+	writeString(content.substr(0, content.size() - 100));
+	ASSERT_TRUE(FileIO::VtuMappedReader::readVTUFile(_file_name) == nullptr);
+
+	// node id out of range
+	writeString(
+		"<VTKFile type=\"UnstructuredGrid\" version=\"0.1\" byte_order=\"LittleEndian\">\n"
+		"<UnstructuredGrid><Piece NumberOfPoints=\"3\" NumberOfCells=\"1\">\n"
+		"<Points><DataArray type=\"Float64\" NumberOfComponents=\"3\" format=\"ascii\">"
+		"0 0 0 1 0 0 0 1 0</DataArray></Points>\n"
+		"<Cells><DataArray type=\"Int32\" Name=\"connectivity\" format=\"ascii\">0 1 3</DataArray>\n"
+		"<DataArray type=\"Int32\" Name=\"offsets\" format=\"ascii\">3</DataArray>\n"
+		"<DataArray type=\"UInt8\" Name=\"types\" format=\"ascii\">5</DataArray>\n"
+		"</Cells></Piece></UnstructuredGrid></VTKFile>\n");
+	ASSERT_TRUE(FileIO::VtuMappedReader::readVTUFile(_file_name) == nullptr);
+}
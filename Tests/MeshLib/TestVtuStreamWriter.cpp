@@ -0,0 +1,192 @@
+/**
+ * \copyright
+ * Copyright (c) 2013, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "Configure.h"
+
+#include "MeshLib/CompactMesh.h"
+#include "MeshLib/Mesh.h"
+#include "MeshLib/Node.h"
+#include "MeshLib/Elements/Element.h"
+#include "MeshLib/MeshGenerators/MeshGenerator.h"
+
+#include "FileIO/XmlIO/VtuStreamWriter.h"
+#include "FileIO/XmlIO/Boost/zLibDataCompressor.h"
+
+namespace
+{
+/// Reads the data arrays of a vtu file with appended raw data. Returns a map
+/// from the array names to the uncompressed binary data.
+std::map<std::string, std::string> readAppendedArrays(std::string const& file_name,
+                                                      bool compressed)
+{
+	std::ifstream in(file_name.c_str(), std::ios::binary);
+	std::stringstream ss;
+	ss << in.rdbuf();
+	std::string const content (ss.str());
+
+	std::size_t const data_begin (content.find('_', content.find("<AppendedData")) + 1);
+	std::map<std::string, std::string> arrays;
+	for (std::size_t pos (content.find("<DataArray")); pos < data_begin;
+	     pos = content.find("<DataArray", pos + 1))
+	{
+		std::size_t const name_pos (content.find("Name=\"", pos) + 6);
+		std::string const name (content.substr(name_pos, content.find('"', name_pos) - name_pos));
+		std::size_t const offset (std::stoul(content.substr(content.find("offset=\"", pos) + 8)));
+
+		char const* data (content.data() + data_begin + offset);
+		auto const read = [&data]() {
+			std::uint64_t v;
+			std::memcpy(&v, data, sizeof(v));
+			data += sizeof(v);
+			return v;
+		};
+
+		std::string& array (arrays[name]);
+		if (!compressed)
+		{
+			std::uint64_t const n_bytes (read());
+			array.assign(data, n_bytes);
+			continue;
+		}
+
+		std::uint64_t const n_blocks (read());
+		std::uint64_t const block_size (read());
+		std::uint64_t const last_block_size (read());
+		std::vector<std::uint64_t> sizes;
+		for (std::uint64_t i = 0; i < n_blocks; i++)
+			sizes.push_back(read());
+		for (std::uint64_t i = 0; i < n_blocks; i++)
+		{
+			std::uint64_t const size ((i+1 == n_blocks && last_block_size) ? last_block_size : block_size);
+			std::vector<unsigned char> block(size);
+			EXPECT_EQ(size, zLibDataCompressor::UncompressBuffer(
+				reinterpret_cast<unsigned char const*>(data), sizes[i], block.data(), size));
+			array.append(block.begin(), block.end());
+			data += sizes[i];
+		}
+	}
+	return arrays;
+}
+
+template <typename T>
+std::vector<T> toVector(std::string const& data)
+{
+	std::vector<T> v(data.size() / sizeof(T));
+	std::memcpy(v.data(), data.data(), data.size());
+	return v;
+}
+}
+
+class VtuStreamWriterTest : public ::testing::TestWithParam<bool>
+{
+public:
+	VtuStreamWriterTest()
+		: _mesh(MeshLib::MeshGenerator::generateRegularQuadMesh(10.0, 15)),
+		  _file_name(std::string(PUT_TMP_DIR_IN) + "VtuStreamWriterTest.vtu")
+	{
+		for (std::size_t i=0; i<_mesh->getNElements(); i++)
+			const_cast<MeshLib::Element*>(_mesh->getElement(i))->setValue(i % 7);
+		for (std::size_t i=0; i<_mesh->getNNodes(); i++)
+			_node_values.push_back(0.5 * i);
+		for (std::size_t i=0; i<_mesh->getNElements(); i++)
+		{
+			_elem_values.push_back(i);
+			_elem_values.push_back(-1.0 * i);
+		}
+	}
+
+	~VtuStreamWriterTest()
+	{
+		std::remove(_file_name.c_str());
+	}
+
+	void checkArrays(bool compressed) const
+	{
+		std::map<std::string, std::string> arrays (readAppendedArrays(_file_name, compressed));
+		ASSERT_EQ(7u, arrays.size());
+
+		std::vector<double> const points (toVector<double>(arrays["Points"]));
+		ASSERT_EQ(3 * _mesh->getNNodes(), points.size());
+		for (std::size_t i=0; i<_mesh->getNNodes(); i++)
+			for (std::size_t k=0; k<3; k++)
+				ASSERT_EQ((*_mesh->getNode(i))[k], points[3*i+k]);
+
+		ASSERT_EQ(_node_values, toVector<double>(arrays["node_values"]));
+		ASSERT_EQ(_elem_values, toVector<double>(arrays["elem_values"]));
+
+		std::vector<std::int32_t> const mat_ids (toVector<std::int32_t>(arrays["MaterialIDs"]));
+		std::vector<std::int64_t> const connectivity (toVector<std::int64_t>(arrays["connectivity"]));
+		std::vector<std::int64_t> const offsets (toVector<std::int64_t>(arrays["offsets"]));
+		std::vector<std::uint8_t> const types (toVector<std::uint8_t>(arrays["types"]));
+		ASSERT_EQ(_mesh->getNElements(), mat_ids.size());
+		ASSERT_EQ(_mesh->getNElements(), offsets.size());
+		ASSERT_EQ(_mesh->getNElements(), types.size());
+		ASSERT_EQ(4 * _mesh->getNElements(), connectivity.size());
+		for (std::size_t i=0; i<_mesh->getNElements(); i++)
+		{
+			MeshLib::Element const& e (*_mesh->getElement(i));
+			ASSERT_EQ(static_cast<std::int32_t>(e.getValue()), mat_ids[i]);
+			ASSERT_EQ(static_cast<std::int64_t>(4*(i+1)), offsets[i]);
+			ASSERT_EQ(9u, types[i]);
+			for (unsigned k=0; k<4; k++)
+				ASSERT_EQ(static_cast<std::int64_t>(e.getNode(k)->getID()), connectivity[4*i+k]);
+		}
+	}
+
+protected:
+	std::unique_ptr<MeshLib::Mesh> _mesh;
+	std::string const _file_name;
+	std::vector<double> _node_values;
+	std::vector<double> _elem_values;
+};
+
+TEST_P(VtuStreamWriterTest, Mesh)
+{
+	// small blocks to test the splitting of the arrays
+	FileIO::VtuStreamWriter writer(GetParam(), 100);
+	writer.setMesh(_mesh.get());
+	writer.addPointProperty("node_values", _node_values);
+	writer.addCellProperty("elem_values", _elem_values, 2);
+	ASSERT_TRUE(writer.writeToFile(_file_name));
+	checkArrays(GetParam());
+}
+
+TEST_P(VtuStreamWriterTest, CompactMesh)
+{
+	MeshLib::CompactMesh const compact_mesh (*_mesh);
+	FileIO::VtuStreamWriter writer(GetParam());
+	writer.setMesh(&compact_mesh);
+	writer.addPointProperty("node_values", _node_values);
+	writer.addCellProperty("elem_values", _elem_values, 2);
+	ASSERT_TRUE(writer.writeToFile(_file_name));
+	checkArrays(GetParam());
+}
+
+TEST_P(VtuStreamWriterTest, WrongPropertySize)
+{
+	std::vector<double> const values(_mesh->getNNodes() - 1);
+	FileIO::VtuStreamWriter writer(GetParam());
+	writer.setMesh(_mesh.get());
+	writer.addPointProperty("values", values);
+	ASSERT_FALSE(writer.writeToFile(_file_name));
+}
+
+INSTANTIATE_TEST_CASE_P(MeshLib, VtuStreamWriterTest, ::testing::Bool());
@@ -0,0 +1,123 @@
+/**
+ * \copyright
+ * Copyright (c) 2013, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/LICENSE.txt
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#ifdef OGS_USE_EIGEN
+#include <Eigen/Eigen>
+#endif
+
+#include "MeshLib/Elements/Hex.h"
+#include "MeshLib/Elements/Quad.h"
+#include "MeshLib/Mesh.h"
+#include "MeshLib/MeshGenerators/MeshGenerator.h"
+#include "MeshLib/Node.h"
+#include "NumLib/Fem/CoordinatesMapping/BatchedNaturalCoordinatesMapping.h"
+#include "NumLib/Fem/CoordinatesMapping/NaturalCoordinatesMapping.h"
+#include "NumLib/Fem/CoordinatesMapping/ShapeFunctionTable.h"
+#include "NumLib/Fem/CoordinatesMapping/ShapeMatrices.h"
+#include "NumLib/Fem/Integration/IntegrationGaussRegular.h"
+#include "NumLib/Fem/ShapeFunction/ShapeHex8.h"
+#include "NumLib/Fem/ShapeFunction/ShapeQuad4.h"
+
+#ifdef OGS_USE_EIGEN
+namespace
+{
+
+/// Moves the nodes of the mesh, such that the elements are distorted.
+void distortMesh(MeshLib::Mesh const& mesh)
+{
+    for (MeshLib::Node* node : mesh.getNodes())
+    {
+        MeshLib::Node& p = *node;
+        double const x = p[0], y = p[1], z = p[2];
+        p[0] = x + 0.05 * std::sin(3 * y + z);
+        p[1] = y + 0.04 * std::cos(2 * x + z);
+        p[2] = z + 0.03 * std::sin(x + y);
+    }
+}
+
+/// Compares the batched mapping of all elements of the mesh in blocks with
+/// the element-wise mapping.
+template <class T_ELEMENT, class T_SHAPE, std::size_t DIM, std::size_t BLOCK_SIZE>
+void checkBatchedMapping(MeshLib::Mesh const& mesh)
+{
+    typedef Eigen::Matrix<double, Eigen::Dynamic, 1> NodalVector;
+    typedef Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> Matrix;
+    typedef NumLib::ShapeMatrices<NodalVector, Matrix, Matrix> ShapeMatricesType;
+    typedef NumLib::NaturalCoordinatesMapping<T_ELEMENT, T_SHAPE, ShapeMatricesType> Mapping;
+    typedef NumLib::ShapeFunctionTable<T_ELEMENT, T_SHAPE, NumLib::IntegrationGaussRegular<DIM>> Table;
+    typedef NumLib::BatchedNaturalCoordinatesMapping<T_ELEMENT, DIM, BLOCK_SIZE> BatchedMapping;
+
+    std::size_t const n_nodes = T_ELEMENT::n_all_nodes;
+    double const eps = 1e-12;
+    std::vector<T_ELEMENT const*> elements;
+    for (auto const* e : mesh.getElements())
+        elements.push_back(static_cast<T_ELEMENT const*>(e));
+
+    Table const& table = Table::get(2);
+    std::unique_ptr<BatchedMapping> batch(new BatchedMapping);
+    ShapeMatricesType expected(DIM, n_nodes);
+    ShapeMatricesType shape(DIM, n_nodes);
+    // the number of elements is not a multiple of the block size
+    ASSERT_NE(0u, elements.size() % BLOCK_SIZE);
+    for (std::size_t first = 0; first < elements.size(); first += BLOCK_SIZE)
+    {
+        std::size_t const n = std::min(BLOCK_SIZE, elements.size() - first);
+        batch->setElements(elements.data() + first, n);
+        ASSERT_EQ(n, batch->getNElements());
+        for (std::size_t igp = 0; igp < table.getNPoints(); igp++)
+        {
+            batch->computeShapeMatrices(table.getDNdr(igp));
+            for (std::size_t l = 0; l < n; l++)
+            {
+                expected.setZero();
+                Mapping::computeShapeMatrices(*elements[first + l],
+                    table.getNaturalCoordinates(igp), expected);
+                shape.setZero();
+                batch->getShapeMatrices(l, shape);
+
+                ASSERT_NEAR(expected.detJ, shape.detJ, eps * std::abs(expected.detJ));
+                for (std::size_t i = 0; i < DIM; i++)
+                {
+                    for (std::size_t j = 0; j < DIM; j++)
+                    {
+                        ASSERT_NEAR(expected.J(i,j), shape.J(i,j), eps);
+                        ASSERT_NEAR(expected.invJ(i,j), shape.invJ(i,j), eps * expected.invJ.norm());
+                    }
+                    for (std::size_t k = 0; k < n_nodes; k++)
+                        ASSERT_NEAR(expected.dNdx(i,k), shape.dNdx(i,k), eps * expected.dNdx.norm());
+                }
+            }
+        }
+    }
+}
+
+}
+
+TEST(NumLib, BatchedCoordinatesMappingHex8)
+{
+    std::unique_ptr<MeshLib::Mesh> mesh(
+        MeshLib::MeshGenerator::generateRegularHexMesh(1.0, 3));
+    distortMesh(*mesh);
+    checkBatchedMapping<MeshLib::Hex, NumLib::ShapeHex8, 3, 8>(*mesh);
+    checkBatchedMapping<MeshLib::Hex, NumLib::ShapeHex8, 3, 16>(*mesh);
+}
+
+TEST(NumLib, BatchedCoordinatesMappingQuad4)
+{
+    std::unique_ptr<MeshLib::Mesh> mesh(
+        MeshLib::MeshGenerator::generateRegularQuadMesh(1.0, 5));
+    distortMesh(*mesh);
+    checkBatchedMapping<MeshLib::Quad, NumLib::ShapeQuad4, 2, 8>(*mesh);
+}
+#endif // OGS_USE_EIGEN
@@ -274,3 +274,47 @@ TYPED_TEST(NumLibFemIsoTest, CheckGaussIntegrationLevel)
 }
 
 
+
+TYPED_TEST(NumLibFemIsoTest, CheckShapeFunctionTable)
+{
+    // Refer to typedefs in the fixture
+    typedef typename TestFixture::FeType FeType;
+    typedef typename TestFixture::NodalMatrix NodalMatrix;
+    typedef typename TestFixture::ShapeMatricesType ShapeMatricesType;
+    typedef typename FeType::ShapeFunctionTableType ShapeFunctionTableType;
+
+    // create a finite element object
+    FeType fe(*this->mesh_element);
+
+    ShapeMatricesType shape(this->dim, this->e_nnodes);
+    ShapeMatricesType expected_shape(this->dim, this->e_nnodes);
+    for (std::size_t order = 2; order <= 3; order++) {
+        this->integration_method.setIntegrationOrder(order);
+        ShapeFunctionTableType const& table = FeType::getShapeFunctionTable(order);
+        ASSERT_EQ(order, table.getIntegrationOrder());
+        ASSERT_EQ(this->integration_method.getNPoints(), table.getNPoints());
+
+        // evaluate both mass and laplace matrices from the table
+        NodalMatrix M(this->e_nnodes, this->e_nnodes);
+        M.setZero();
+        NodalMatrix K(this->e_nnodes, this->e_nnodes);
+        K.setZero();
+        for (std::size_t igp=0; igp < table.getNPoints(); igp++) {
+            auto wp = this->integration_method.getWeightedPoint(igp);
+            ASSERT_EQ(wp.getWeight(), table.getWeight(igp));
+            ASSERT_ARRAY_NEAR(wp.getCoords(), table.getNaturalCoordinates(igp), this->dim, 0);
+
+            shape.setZero();
+            fe.computeShapeFunctionsAtIntegrationPoint(order, igp, shape);
+            expected_shape.setZero();
+            fe.computeShapeFunctions(wp.getCoords(), expected_shape);
+            ASSERT_ARRAY_NEAR(expected_shape.dNdx.data(), shape.dNdx.data(), shape.dNdx.size(), this->eps);
+            ASSERT_EQ(expected_shape.detJ, shape.detJ);
+
+            M.noalias() += shape.N * shape.N.transpose() * shape.detJ * table.getWeight(igp);
+            K.noalias() += shape.dNdx.transpose() * this->D * shape.dNdx * shape.detJ * table.getWeight(igp);
+        }
+        ASSERT_ARRAY_NEAR(this->expectedM.data(), M.data(), M.size(), this->eps);
+        ASSERT_ARRAY_NEAR(this->expectedK.data(), K.data(), K.size(), this->eps);
+    }
+}
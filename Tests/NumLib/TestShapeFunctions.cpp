@@ -16,6 +16,9 @@
 #include <algorithm>
 
 #include "NumLib/Fem/ShapeFunction/ShapeQuad4.h"
+#include "NumLib/Fem/ShapeFunction/ShapeTet4.h"
+#include "NumLib/Fem/ShapeFunction/ShapePrism6.h"
+#include "NumLib/Fem/ShapeFunction/ShapePyra5.h"
 
 #include "../TestTools.h"
 
@@ -69,3 +72,70 @@ TEST(NumLib, FemShapeQuad4)
 }
 
 
+namespace
+{
+
+/// Checks the partition of unity, the Kronecker property at the nodes and
+/// the gradient against central differences.
+template <class T_SHAPE>
+void checkShapeFunction(double const* node_coords, double const* sample_pt)
+{
+    static const std::size_t dim = T_SHAPE::DIM;
+    static const std::size_t n_nodes = T_SHAPE::NPOINTS;
+    static const double eps = 1e-14;
+    double N[n_nodes];
+    double dN[dim*n_nodes];
+
+    for (std::size_t k=0; k<n_nodes; k++)
+    {
+        double exp_N[n_nodes] = {};
+        exp_N[k] = 1.0;
+        T_SHAPE::computeShapeFunction(node_coords + k*dim, N);
+        ASSERT_ARRAY_NEAR(exp_N, N, n_nodes, eps);
+    }
+
+    T_SHAPE::computeShapeFunction(sample_pt, N);
+    double sum = 0.0;
+    for (std::size_t k=0; k<n_nodes; k++)
+        sum += N[k];
+    ASSERT_NEAR(1.0, sum, eps);
+
+    T_SHAPE::computeGradShapeFunction(sample_pt, dN);
+    const double h = 1e-6;
+    for (std::size_t d=0; d<dim; d++)
+    {
+        double r_p[dim], r_m[dim];
+        for (std::size_t j=0; j<dim; j++)
+            r_p[j] = r_m[j] = sample_pt[j];
+        r_p[d] += h;
+        r_m[d] -= h;
+        double N_p[n_nodes], N_m[n_nodes];
+        T_SHAPE::computeShapeFunction(r_p, N_p);
+        T_SHAPE::computeShapeFunction(r_m, N_m);
+        for (std::size_t k=0; k<n_nodes; k++)
+            ASSERT_NEAR((N_p[k] - N_m[k]) / (2*h), dN[d*n_nodes + k], 1e-8);
+    }
+}
+
+}
+
+TEST(NumLib, FemShapeTet4)
+{
+    double const nodes[] = {0,0,0, 1,0,0, 0,1,0, 0,0,1};
+    double const r[] = {0.2, 0.3, 0.1};
+    checkShapeFunction<ShapeTet4>(nodes, r);
+}
+
+TEST(NumLib, FemShapePrism6)
+{
+    double const nodes[] = {0,0,-1, 1,0,-1, 0,1,-1, 0,0,1, 1,0,1, 0,1,1};
+    double const r[] = {0.2, 0.3, -0.4};
+    checkShapeFunction<ShapePrism6>(nodes, r);
+}
+
+TEST(NumLib, FemShapePyra5)
+{
+    double const nodes[] = {-1,-1,-1, 1,-1,-1, 1,1,-1, -1,1,-1, 0,0,1};
+    double const r[] = {0.2, -0.3, 0.1};
+    checkShapeFunction<ShapePyra5>(nodes, r);
+}
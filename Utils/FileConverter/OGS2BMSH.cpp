@@ -0,0 +1,72 @@
+/**
+ * \file
+ * \brief  Converts a mesh into the binary mesh format.
+ *
+ * \copyright
+ * Copyright (c) 2013, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+// STL
+#include <string>
+
+// TCLAP
+#include "tclap/CmdLine.h"
+
+// ThirdParty/logog
+#include "logog/include/logog.hpp"
+
+// BaseLib
+#include "LogogSimpleFormatter.h"
+
+// FileIO
+#include "BinaryMeshIO.h"
+#include "readMeshFromFile.h"
+
+// MeshLib
+#include "Mesh.h"
+
+int main (int argc, char* argv[])
+{
+	LOGOG_INITIALIZE();
+	logog::Cout* logog_cout (new logog::Cout);
+	BaseLib::LogogSimpleFormatter *custom_format (new BaseLib::LogogSimpleFormatter);
+	logog_cout->SetFormatter(*custom_format);
+
+	TCLAP::CmdLine cmd("Converts a mesh (msh, vtu) into the binary mesh format (bmsh).", ' ', "0.1");
+	TCLAP::ValueArg<std::string> mesh_in("i", "mesh-input-file",
+	                                     "the name of the file containing the input mesh", true,
+	                                     "", "file name of input mesh");
+	cmd.add(mesh_in);
+	TCLAP::ValueArg<std::string> mesh_out("o", "mesh-output-file",
+	                                      "the name of the file the mesh will be written to", true,
+	                                      "", "file name of output mesh");
+	cmd.add(mesh_out);
+	TCLAP::SwitchArg no_topology_arg("", "no-topology",
+	                                 "do not store the element neighbors and node-element table", false);
+	cmd.add(no_topology_arg);
+	cmd.parse(argc, argv);
+
+	int return_value (0);
+	MeshLib::Mesh* mesh (FileIO::readMeshFromFile(mesh_in.getValue()));
+	if (mesh) {
+		INFO("Mesh read: %d nodes, %d elements.", mesh->getNNodes(), mesh->getNElements());
+		FileIO::BinaryMeshIO mesh_io;
+		mesh_io.setMesh(mesh);
+		mesh_io.setWriteTopology(!no_topology_arg.getValue());
+		if (!mesh_io.writeToFile(mesh_out.getValue()))
+			return_value = 1;
+		delete mesh;
+	} else {
+		return_value = 1;
+	}
+
+	delete custom_format;
+	delete logog_cout;
+	LOGOG_SHUTDOWN();
+
+	return return_value;
+}
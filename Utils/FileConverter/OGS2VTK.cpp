@@ -25,6 +25,7 @@
 
 // FileIO
 #include "XmlIO/Boost/BoostVtuInterface.h"
+#include "XmlIO/VtuStreamWriter.h"
 #include "readMeshFromFile.h"
 
 // MeshLib
@@ -46,14 +47,26 @@ int main (int argc, char* argv[])
 	                                      "the name of the file the mesh will be written to", true,
 	                                      "", "file name of output mesh");
 	cmd.add(mesh_out);
+	TCLAP::SwitchArg binary_arg("b", "binary",
+	                            "write the data arrays in appended raw binary format", false);
+	cmd.add(binary_arg);
+	TCLAP::SwitchArg compress_arg("z", "compress",
+	                              "compress the binary data arrays with zlib", false);
+	cmd.add(compress_arg);
 	cmd.parse(argc, argv);
 
 	MeshLib::Mesh* mesh (FileIO::readMeshFromFile(mesh_in.getValue()));
 	INFO("Mesh read: %d nodes, %d elements.", mesh->getNNodes(), mesh->getNElements());
 
-	FileIO::BoostVtuInterface vtu;
-	vtu.setMesh(mesh);
-	vtu.writeToFile(mesh_out.getValue());
+	if (binary_arg.getValue() || compress_arg.getValue()) {
+		FileIO::VtuStreamWriter vtu(compress_arg.getValue());
+		vtu.setMesh(mesh);
+		vtu.writeToFile(mesh_out.getValue());
+	} else {
+		FileIO::BoostVtuInterface vtu;
+		vtu.setMesh(mesh);
+		vtu.writeToFile(mesh_out.getValue());
+	}
 
 	delete custom_format;
 	delete logog_cout;
@@ -0,0 +1,66 @@
+/**
+ * \file
+ * \brief  Converts a raster into the binary raster format.
+ *
+ * \copyright
+ * Copyright (c) 2013, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+// STL
+#include <fstream>
+#include <string>
+
+// TCLAP
+#include "tclap/CmdLine.h"
+
+// ThirdParty/logog
+#include "logog/include/logog.hpp"
+
+// BaseLib
+#include "LogogSimpleFormatter.h"
+
+// GeoLib
+#include "Raster.h"
+
+int main (int argc, char* argv[])
+{
+	LOGOG_INITIALIZE();
+	logog::Cout* logog_cout (new logog::Cout);
+	BaseLib::LogogSimpleFormatter *custom_format (new BaseLib::LogogSimpleFormatter);
+	logog_cout->SetFormatter(*custom_format);
+
+	TCLAP::CmdLine cmd("Converts a raster (asc, grd) into the binary raster format (bras).", ' ', "0.1");
+	TCLAP::ValueArg<std::string> raster_in("i", "raster-input-file",
+	                                       "the name of the file containing the input raster", true,
+	                                       "", "file name of input raster");
+	cmd.add(raster_in);
+	TCLAP::ValueArg<std::string> raster_out("o", "raster-output-file",
+	                                        "the name of the file the raster will be written to", true,
+	                                        "", "file name of output raster");
+	cmd.add(raster_out);
+	cmd.parse(argc, argv);
+
+	int return_value (0);
+	GeoLib::Raster* raster (GeoLib::Raster::getRasterFromFile(raster_in.getValue()));
+	if (raster) {
+		INFO("Raster read: %d columns, %d rows.", raster->getNCols(), raster->getNRows());
+		std::ofstream out (raster_out.getValue().c_str(), std::ios::binary);
+		if (!out || !raster->writeRasterAsBinary(out)) {
+			ERR("Could not write raster to file %s.", raster_out.getValue().c_str());
+			return_value = 1;
+		}
+		delete raster;
+	} else {
+		return_value = 1;
+	}
+
+	delete custom_format;
+	delete logog_cout;
+	LOGOG_SHUTDOWN();
+
+	return return_value;
+}
@@ -114,6 +114,25 @@ ENDIF() # GEOTIFF_FOUND
 ## lis ##
 IF(OGS_USE_LIS)
 	FIND_PACKAGE( LIS REQUIRED )
+	# The preconditioner reuse in LisLinearSolver needs lis_solve_kernel() and
+	# access to the members of the solver struct, which are not part of the
+	# public Lis API.
+	INCLUDE(CheckCXXSourceCompiles)
+	SET(CMAKE_REQUIRED_INCLUDES ${LIS_INCLUDE_DIR})
+	SET(CMAKE_REQUIRED_LIBRARIES ${LIS_LIBRARIES})
+	CHECK_CXX_SOURCE_COMPILES("
+		#include \"lis.h\"
+		int main() {
+			LIS_MATRIX A = 0; LIS_VECTOR b = 0, x = 0;
+			LIS_SOLVER solver = 0; LIS_PRECON precon = 0;
+			solver->A = A; solver->b = b; solver->x = x;
+			return lis_solve_kernel(A, b, x, solver, precon);
+		}" LIS_HAS_SOLVE_KERNEL)
+	UNSET(CMAKE_REQUIRED_INCLUDES)
+	UNSET(CMAKE_REQUIRED_LIBRARIES)
+	IF(LIS_HAS_SOLVE_KERNEL)
+		ADD_DEFINITIONS(-DLIS_HAS_SOLVE_KERNEL)
+	ENDIF()
 ENDIF()
 
 
@@ -7,6 +7,11 @@ IF(OGS_DISABLE_LOGGING)
 	SET(OGS_LOG_LEVEL LOGOG_LEVEL_NONE)
 ENDIF()
 
+# Profiling
+IF(OGS_DISABLE_PROFILING)
+	ADD_DEFINITIONS(-DOGS_DISABLE_PROFILING)
+ENDIF()
+
 IF(NOT DEFINED OGS_LOG_LEVEL)
 	IF(CMAKE_BUILD_TYPE STREQUAL "Debug")
 		ADD_DEFINITIONS(-DLOGOG_LEVEL=LOGOG_LEVEL_DEBUG)